@@ -0,0 +1,57 @@
+#include <dtCore/dtLog>
+#include "dtCore/src/dtDAQ/grpc/dtLogPublisherGrpc.hpp"
+
+#include <iostream>
+#include <thread>
+
+// Serves filtered RtLog tailing on 0.0.0.0:50054 (see example_grpc_log_sub).
+int main(int argc, char** argv)
+{
+    dt::Log::Initialize("grpc_log_pub", "logs/grpc_log_pub.txt");
+    dt::Log::SetLogLevel(dt::Log::LogLevel::trace);
+    dt::Log::Create("motion", "logs/grpc_log_pub_motion.txt");
+
+    dt::DAQ::LogPublisherGrpc pub("0.0.0.0:50054");
+
+    std::atomic<bool> bRun;
+    bRun.store(true);
+
+    std::thread proc_ctrl = std::thread([&bRun]() {
+        uint32_t seq = 0;
+        while (bRun.load())
+        {
+            LOG(debug) << "ctrl loop seq=" << seq;
+            if (seq % 50 == 0)
+            {
+                LOG(warn) << "ctrl overrun at seq=" << seq;
+            }
+            seq++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+
+    std::thread proc_motion = std::thread([&bRun]() {
+        uint32_t seq = 0;
+        while (bRun.load())
+        {
+            LOG_U(motion, info) << "joint[" << (seq % 6) << "] target reached";
+            seq++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    });
+
+    while (bRun.load()) {
+        std::cout << "(type \'q\' to quit) >\n";
+        std::string cmd;
+        std::cin >> cmd;
+        if (cmd == "q" || cmd == "quit") {
+            bRun = false;
+        }
+    }
+
+    proc_ctrl.join();
+    proc_motion.join();
+    dt::Log::Terminate();
+
+    return 0;
+}
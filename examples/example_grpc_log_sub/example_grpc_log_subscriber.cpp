@@ -0,0 +1,62 @@
+#include <grpcpp/grpcpp.h>
+#include "dtProto/Service.grpc.pb.h"
+#include "dtProto/std_msgs/Log.pb.h"
+
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+// Subscribes to RtLog output of example_grpc_log_pub with a server-side filter.
+//
+//   $ ./example_grpc_log_sub [server] [min_level 0-5] [regex] [logger ...]
+//   $ ./example_grpc_log_sub localhost:50054 3             # warn and above
+//   $ ./example_grpc_log_sub localhost:50054 0 "joint\[3\]" motion
+int main(int argc, char** argv)
+{
+    std::string server = (argc > 1) ? argv[1] : "localhost:50054";
+
+    dtproto::std_msgs::LogFilter filter;
+    if (argc > 2) {
+        filter.set_min_level(static_cast<dtproto::std_msgs::LogLevel>(std::atoi(argv[2])));
+    }
+    if (argc > 3) {
+        filter.set_regex(argv[3]);
+    }
+    for (int i = 4; i < argc; i++) {
+        filter.add_logger_names(argv[i]);
+    }
+
+    auto stub = dtproto::dtService::NewStub(grpc::CreateChannel(server, grpc::InsecureChannelCredentials()));
+    grpc::ClientContext ctx;
+    std::unique_ptr<grpc::ClientReader<dtproto::std_msgs::LogBatch>> reader(stub->SubscribeLog(&ctx, filter));
+
+    static const char LEVEL_CHAR[] = "TDIWEC";
+    uint64_t dropped = 0;
+    dtproto::std_msgs::LogBatch batch;
+    while (reader->Read(&batch)) {
+        if (batch.dropped() != dropped) {
+            printf("--- %llu entries dropped by server ---\n", (unsigned long long)(batch.dropped() - dropped));
+            dropped = batch.dropped();
+        }
+        for (const auto &e : batch.entries()) {
+            time_t sec = static_cast<time_t>(e.timestamp_ns() / 1000000000LL);
+            struct tm tmv{};
+            localtime_r(&sec, &tmv);
+            char tbuf[16];
+            strftime(tbuf, sizeof(tbuf), "%H:%M:%S", &tmv);
+            printf("[%c][%s.%06lld] %s%s%s\n",
+                   (e.level() >= 0 && e.level() < 6) ? LEVEL_CHAR[e.level()] : '?',
+                   tbuf, (long long)((e.timestamp_ns() % 1000000000LL) / 1000),
+                   e.logger_name().c_str(), e.logger_name().empty() ? "" : ": ", e.msg().c_str());
+        }
+        fflush(stdout);
+    }
+
+    grpc::Status status = reader->Finish();
+    if (!status.ok()) {
+        std::cerr << "SubscribeLog failed: " << status.error_message() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,243 @@
+// Reference collector for the RtLog network sink (dtRtLogNetSink.hpp).
+//
+//   $ ./example_rtlog_collector tcp:0.0.0.0:9400
+//   $ ./example_rtlog_collector unix:/tmp/dtlog.sock
+//
+// Accepts any number of clients, decodes frames and prints one line per record:
+//   <client> [L][YYYY-mm-dd HH:MM:SS.uuuuuu] <logger>: <message>
+// A gap in the record sequence of a sender (records dropped by its RtLog queue or spill buffer)
+// is reported, also when it falls between two connections of the same sender.
+#include <dtCore/src/dtLog/dtRtLogNetSink.hpp>
+#include <arpa/inet.h>
+#include <csignal>
+#include <map>
+#include <cstdio>
+#include <vector>
+
+using namespace dt::Log;
+
+namespace
+{
+
+volatile sig_atomic_t g_run = 1;
+
+struct Client
+{
+    int               fd{-1};
+    std::string       name;
+    std::vector<char> buf;
+};
+
+std::map<uint32_t, uint32_t> g_nextSeq;  // stream -> expected record number, kept across connections
+
+int OpenListener(const NetLogEndpoint &ep)
+{
+    int fd = -1;
+    if (ep.isUnix)
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un un{};
+        un.sun_family = AF_UNIX;
+        strncpy(un.sun_path, ep.path.c_str(), sizeof(un.sun_path) - 1);
+        unlink(ep.path.c_str());
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr *>(&un), sizeof(un)) < 0)
+        {
+            perror("bind");
+            return -1;
+        }
+    }
+    else
+    {
+        addrinfo hints{};
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags    = AI_PASSIVE;
+        addrinfo *res = nullptr;
+        if (getaddrinfo(ep.host.c_str(), std::to_string(ep.port).c_str(), &hints, &res) != 0 || !res)
+        {
+            fprintf(stderr, "cannot resolve %s\n", ep.host.c_str());
+            return -1;
+        }
+        fd = socket(res->ai_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (fd < 0 || bind(fd, res->ai_addr, res->ai_addrlen) < 0)
+        {
+            perror("bind");
+            freeaddrinfo(res);
+            return -1;
+        }
+        freeaddrinfo(res);
+    }
+
+    if (listen(fd, 16) < 0)
+    {
+        perror("listen");
+        return -1;
+    }
+    return fd;
+}
+
+void PrintRecord(const Client &c, const NetLogRecordHeader &rh, const char *name, const char *msg, size_t msgLen)
+{
+    static const char LEVEL_CHAR[] = "TDIWEC";
+    char   lc     = (rh.level < 6) ? LEVEL_CHAR[rh.level] : '?';
+    time_t sec    = static_cast<time_t>(rh.timeStamp_ns / 1'000'000'000LL);
+    long   usec   = static_cast<long>((rh.timeStamp_ns % 1'000'000'000LL) / 1000);
+    struct tm tmv{};
+    localtime_r(&sec, &tmv);
+    char tbuf[32];
+    strftime(tbuf, sizeof(tbuf), "%Y-%m-%d %H:%M:%S", &tmv);
+
+    printf("%s [%c][%s.%06ld] %.*s: %.*s\n", c.name.c_str(), lc, tbuf, usec,
+           static_cast<int>(rh.nameLen), name, static_cast<int>(msgLen), msg);
+}
+
+// Decode all complete frames in the client buffer. Returns false on a protocol error.
+bool Decode(Client &c)
+{
+    size_t pos = 0;
+    while (c.buf.size() - pos >= sizeof(NetLogFrameHeader))
+    {
+        NetLogFrameHeader fh{};
+        memcpy(&fh, c.buf.data() + pos, sizeof(fh));
+        if (fh.magic != NetLogConstant::FRAME_MAGIC || fh.version != NetLogConstant::FRAME_VERSION)
+        {
+            fprintf(stderr, "%s: bad frame header\n", c.name.c_str());
+            return false;
+        }
+        if (c.buf.size() - pos < sizeof(fh) + fh.length)
+        {
+            break;  // wait for the rest of the frame
+        }
+
+        auto it = g_nextSeq.find(fh.stream);
+        if (it != g_nextSeq.end() && static_cast<int32_t>(fh.seq - it->second) > 0)
+        {
+            printf("%s --- %u record(s) lost ---\n", c.name.c_str(), fh.seq - it->second);
+        }
+        g_nextSeq[fh.stream] = fh.seq + fh.count;
+
+        const char *p   = c.buf.data() + pos + sizeof(fh);
+        const char *end = p + fh.length;
+        for (uint16_t i = 0; i < fh.count && p + sizeof(NetLogRecordHeader) <= end; ++i)
+        {
+            NetLogRecordHeader rh{};
+            memcpy(&rh, p, sizeof(rh));
+            const char *rec_end = p + sizeof(uint16_t) + rh.length;
+            if (rec_end > end)
+            {
+                return false;
+            }
+            const char *name = p + sizeof(rh);
+            const char *msg  = name + rh.nameLen;
+            PrintRecord(c, rh, name, msg, static_cast<size_t>(rec_end - msg));
+            p = rec_end;
+        }
+        pos += sizeof(fh) + fh.length;
+    }
+
+    c.buf.erase(c.buf.begin(), c.buf.begin() + pos);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, const char **argv)
+{
+    NetLogEndpoint ep;
+    if (argc < 2 || !NetLogEndpoint::Parse(argv[1], ep))
+    {
+        fprintf(stderr, "usage: %s tcp:<host>:<port> | unix:<path>\n", argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, [](int) { g_run = 0; });
+    signal(SIGTERM, [](int) { g_run = 0; });
+    signal(SIGPIPE, SIG_IGN);
+
+    int lfd = OpenListener(ep);
+    if (lfd < 0)
+    {
+        return 1;
+    }
+    fprintf(stderr, "listening on %s\n", argv[1]);
+
+    std::vector<Client> clients;
+    std::vector<char>   rbuf(64 * 1024);
+
+    while (g_run)
+    {
+        std::vector<pollfd> pfds;
+        pfds.push_back({lfd, POLLIN, 0});
+        for (auto &c : clients)
+        {
+            pfds.push_back({c.fd, POLLIN, 0});
+        }
+
+        if (poll(pfds.data(), pfds.size(), 200) <= 0)
+        {
+            continue;
+        }
+
+        if (pfds[0].revents & POLLIN)
+        {
+            sockaddr_storage addr{};
+            socklen_t alen = sizeof(addr);
+            int cfd = accept4(lfd, reinterpret_cast<sockaddr *>(&addr), &alen, SOCK_CLOEXEC);
+            if (cfd >= 0)
+            {
+                Client c;
+                c.fd = cfd;
+                char host[INET6_ADDRSTRLEN] = "local";
+                if (addr.ss_family == AF_INET)
+                {
+                    inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in *>(&addr)->sin_addr, host, sizeof(host));
+                }
+                else if (addr.ss_family == AF_INET6)
+                {
+                    inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6 *>(&addr)->sin6_addr, host, sizeof(host));
+                }
+                c.name = std::string(host) + "#" + std::to_string(cfd);
+                fprintf(stderr, "%s connected\n", c.name.c_str());
+                clients.push_back(std::move(c));
+            }
+        }
+
+        for (size_t i = 1; i < pfds.size(); ++i)
+        {
+            if (!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+            Client &c = clients[i - 1];
+            ssize_t n = read(c.fd, rbuf.data(), rbuf.size());
+            if (n > 0)
+            {
+                c.buf.insert(c.buf.end(), rbuf.data(), rbuf.data() + n);
+                if (Decode(c))
+                {
+                    continue;
+                }
+            }
+            fprintf(stderr, "%s disconnected\n", c.name.c_str());
+            close(c.fd);
+            c.fd = -1;
+        }
+
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client &c) { return c.fd < 0; }),
+                      clients.end());
+        fflush(stdout);
+    }
+
+    for (auto &c : clients)
+    {
+        close(c.fd);
+    }
+    close(lfd);
+    if (ep.isUnix)
+    {
+        unlink(ep.path.c_str());
+    }
+    return 0;
+}
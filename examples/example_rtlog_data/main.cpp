@@ -0,0 +1,78 @@
+#include <dtCore/dtLog>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+// LOG_DATA() telemetry: 1 kHz x 100 columns of raw doubles + a small mixed-type channel.
+//
+//   $ ./example_rtlog_data            # writes logs/joint_*.dtd (binary) and logs/status_*.csv
+//   $ ./example_rtlog_data_dump logs/joint.dtd | head
+//
+// The producer loop never formats text: values are copied into the data queue and the
+// drain thread writes them. Text logs (LOG(...)) use their own queue.
+int main(int argc, const char **argv)
+{
+    constexpr int    NUM_JOINTS = 50;      // q + tau = 100 columns
+    constexpr long   PERIOD_NS  = 1'000'000L;
+    const int        seconds    = (argc > 1) ? std::atoi(argv[1]) : 5;
+
+    dt::Log::Initialize("data", "logs/example_rtlog_data.txt");
+
+    std::vector<std::string> columns;
+    for (int i = 0; i < NUM_JOINTS; i++)
+    {
+        columns.push_back("q" + std::to_string(i));
+    }
+    for (int i = 0; i < NUM_JOINTS; i++)
+    {
+        columns.push_back("tau" + std::to_string(i));
+    }
+    dt::Log::CreateDataChannel("joint", "logs/joint.dtd", columns);
+    dt::Log::CreateDataChannel("status", "logs/status.csv", {"seq", "mode", "enabled", "loop_us"}, dt::Log::DataFormat::csv);
+
+    auto rt_thread = std::thread([&]() {
+        double data[2 * NUM_JOINTS];
+        struct timespec next;
+        clock_gettime(CLOCK_MONOTONIC, &next);
+
+        for (uint32_t seq = 0; seq < static_cast<uint32_t>(seconds) * 1000; seq++)
+        {
+            const int64_t t0 = dt::Utils::MonotonicNs();
+
+            for (int i = 0; i < NUM_JOINTS; i++)
+            {
+                data[i]              = std::sin(seq * 0.001 * (i + 1));
+                data[NUM_JOINTS + i] = std::cos(seq * 0.001 * (i + 1));
+            }
+            LOG_DATA_ARRAY(joint, data, 2 * NUM_JOINTS);
+
+            float loop_us = static_cast<float>(dt::Utils::MonotonicNs() - t0) / 1e3f;
+            LOG_DATA(status, seq, static_cast<uint8_t>(seq / 1000), (seq % 2) == 0, loop_us);
+
+            if (seq % 1000 == 0)
+            {
+                LOG(info) << "seq=" << seq;
+            }
+
+            next.tv_nsec += PERIOD_NS;
+            if (next.tv_nsec >= 1'000'000'000L)
+            {
+                next.tv_nsec -= 1'000'000'000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+        }
+    });
+    rt_thread.join();
+
+    dt::Log::DataChannelStats stats{};
+    if (dt::Log::RtLog::GetDataStats("joint", stats))
+    {
+        LOG(info) << "joint: columns=" << stats.columns << " dropped=" << stats.dropped << " rejected=" << stats.rejected;
+    }
+
+    dt::Log::Terminate();
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Converts a LOG_DATA() binary file (DataFormat::binary) to CSV on stdout.
+//
+//   $ ./example_rtlog_data_dump logs/joint.dtd > joint.csv
+//   $ ./example_rtlog_data_dump -h logs/joint.dtd      # header (schema) only
+#include <dtCore/src/dtLog/dtRtLogData.hpp>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace dt::Log;
+
+namespace
+{
+
+void PrintValue(DataType type, const char *p)
+{
+    switch (type)
+    {
+        case DataType::i8:      { int8_t v;   memcpy(&v, p, 1); printf("%d", v); break; }
+        case DataType::u8:      { uint8_t v;  memcpy(&v, p, 1); printf("%u", v); break; }
+        case DataType::boolean: { uint8_t v;  memcpy(&v, p, 1); printf("%d", v ? 1 : 0); break; }
+        case DataType::i16:     { int16_t v;  memcpy(&v, p, 2); printf("%d", v); break; }
+        case DataType::u16:     { uint16_t v; memcpy(&v, p, 2); printf("%u", v); break; }
+        case DataType::i32:     { int32_t v;  memcpy(&v, p, 4); printf("%" PRId32, v); break; }
+        case DataType::u32:     { uint32_t v; memcpy(&v, p, 4); printf("%" PRIu32, v); break; }
+        case DataType::i64:     { int64_t v;  memcpy(&v, p, 8); printf("%" PRId64, v); break; }
+        case DataType::u64:     { uint64_t v; memcpy(&v, p, 8); printf("%" PRIu64, v); break; }
+        case DataType::f32:     { float v;    memcpy(&v, p, 4); printf("%.9g", v); break; }
+        case DataType::f64:     { double v;   memcpy(&v, p, 8); printf("%.17g", v); break; }
+        default:                printf("?"); break;
+    }
+}
+
+}  // namespace
+
+int main(int argc, const char **argv)
+{
+    bool headerOnly = (argc > 2 && std::string(argv[1]) == "-h");
+    const char *path = (argc > 1) ? argv[argc - 1] : nullptr;
+    FILE *fp = path ? fopen(path, "rb") : nullptr;
+    if (!fp)
+    {
+        fprintf(stderr, "usage: %s [-h] <file.dtd>\n", argv[0]);
+        return 1;
+    }
+
+    DataFileHeader hdr{};
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || hdr.magic != RtLogDataConstant::FILE_MAGIC)
+    {
+        fprintf(stderr, "%s: not a LOG_DATA file\n", path);
+        return 1;
+    }
+
+    std::vector<DataColumnDesc> cols(hdr.columns);
+    if (fread(cols.data(), sizeof(DataColumnDesc), cols.size(), fp) != cols.size())
+    {
+        fprintf(stderr, "%s: truncated header\n", path);
+        return 1;
+    }
+
+    if (headerOnly)
+    {
+        printf("channel %.*s, version %u, %u columns\n", (int)sizeof(hdr.channel), hdr.channel, hdr.version, hdr.columns);
+        for (const auto &c : cols)
+        {
+            printf("  %-8s %.*s\n", DataTypeName(static_cast<DataType>(c.type)), (int)sizeof(c.name), c.name);
+        }
+        return 0;
+    }
+
+    printf("timestamp");
+    for (const auto &c : cols)
+    {
+        printf(",%.*s", (int)sizeof(c.name), c.name);
+    }
+    printf("\n");
+
+    std::vector<char> block;
+    size_t blocks = 0, rows = 0;
+    DataBlockHeader bh{};
+    while (fread(&bh, sizeof(bh), 1, fp) == 1)
+    {
+        if (bh.magic != RtLogDataConstant::BLOCK_MAGIC)
+        {
+            fprintf(stderr, "%s: bad block header after %zu blocks\n", path, blocks);
+            return 1;
+        }
+
+        size_t rowBytes = sizeof(int64_t);
+        for (const auto &c : cols)
+        {
+            rowBytes += DataTypeSize(static_cast<DataType>(c.type));
+        }
+        block.resize(bh.rows * rowBytes);
+        if (fread(block.data(), 1, block.size(), fp) != block.size())
+        {
+            fprintf(stderr, "%s: truncated block %zu\n", path, blocks);
+            return 1;
+        }
+
+        // column offsets within this block: [ts x rows][col0 x rows][col1 x rows]...
+        std::vector<size_t> colBase(cols.size());
+        size_t base = bh.rows * sizeof(int64_t);
+        for (size_t i = 0; i < cols.size(); i++)
+        {
+            colBase[i] = base;
+            base += bh.rows * DataTypeSize(static_cast<DataType>(cols[i].type));
+        }
+
+        for (uint32_t r = 0; r < bh.rows; r++)
+        {
+            int64_t ts;
+            memcpy(&ts, block.data() + r * sizeof(int64_t), sizeof(ts));
+            printf("%" PRId64 ".%09" PRId64, ts / INT64_C(1000000000), ts % INT64_C(1000000000));
+            for (size_t i = 0; i < cols.size(); i++)
+            {
+                DataType type = static_cast<DataType>(cols[i].type);
+                printf(",");
+                PrintValue(type, block.data() + colBase[i] + r * DataTypeSize(type));
+            }
+            printf("\n");
+        }
+        blocks++;
+        rows += bh.rows;
+    }
+
+    fprintf(stderr, "%zu rows in %zu blocks\n", rows, blocks);
+    fclose(fp);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <dtCore/dtLog>
+#include <thread>
+#include <string>
+
+// Streams RtLog output to a collector (see example_rtlog_collector).
+//
+//   $ ./example_rtlog_collector tcp:127.0.0.1:9400
+//   $ ./example_rtlog_netsink _NET_:tcp:127.0.0.1:9400
+//
+// Start / stop the collector while this example runs to see reconnection with
+// backoff; messages logged while it is down are kept in the spill buffer.
+int main(int argc, const char **argv)
+{
+    std::string target = (argc > 1) ? argv[1] : "_NET_:tcp:127.0.0.1:9400";
+
+    dt::Log::Initialize("netsink", target);
+    dt::Log::SetLogLevel(dt::Log::LogLevel::trace);
+
+    dt::Log::Create("logger_2", target);
+
+    auto thread_1 = std::thread([]() {
+        for (int i = 0; i < 1000; i++)
+        {
+            LOG(info) << "default logger: " << i;
+            usleep(10 * 1000);
+        }
+    });
+
+    auto thread_2 = std::thread([]() {
+        for (int i = 0; i < 1000; i++)
+        {
+            LOG_U(logger_2, warn) << "logger_2: " << i;
+            usleep(10 * 1000);
+        }
+    });
+
+    thread_1.join();
+    thread_2.join();
+
+    dt::Log::Terminate();
+    return 0;
+}
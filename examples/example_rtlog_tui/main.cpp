@@ -1,6 +1,9 @@
 #include <signal.h>
+#include <atomic>
 #include <thread>
 #include <random>
+#include <chrono>
+#include <cmath>
 #include <dtCore/dtLog>
 #include <dtCore/dtThread>
 
@@ -9,6 +12,7 @@ static constexpr int L0_GRP_THREAD = 0;
 static constexpr int L0_GRP_TASK   = 1;
 static constexpr int L0_GRP_R_JOINT = 2;
 static constexpr int L0_GRP_L_JOINT = 3;
+static constexpr int L0_GRP_SIGNAL  = 4;
 
 // Layout 1 ("Layout#1") group indices
 static constexpr int L1_GRP_THREAD = 0;
@@ -32,12 +36,16 @@ static void UpdatePerceivedObject();
 static void UpdateQRInfo();
 static void UpdatePludState();
 static void UpdateEtherCAT();
+static void UpdateSignalPlots();
 static void KeyHandle(char c);
 
 static std::random_device rd;
 static int random_int_list[50] = {0,};
 static double random_double_list[50] = {0,};
-static bool bRun = true;
+static std::atomic<bool> bRun{true};
+static int plotPeriod = -1;
+static int plotTorque = -1;
+static dt::Thread::ThreadInfo ctrlThread;
 
 static void CatchSignal(int sig)
 {
@@ -61,7 +69,21 @@ int main(int argc, const char **argv)
     bool enableTui = true;
     uint32_t debug_cnt = 0;
 
-    dt::Log::Initialize(logName, logFilepath, enableTui);
+    // optional: example_rtlog_tui /dttui → also publish the TUI to shared memory
+    // (view it with dttui-attach /dttui; with stdout redirected the TUI runs headless)
+    dt::Log::RtLogQueueConfig queueConfig;
+    if (argc > 1)
+    {
+        queueConfig.tuiShmName = argv[1];
+    }
+
+    dt::Log::Initialize(logName, logFilepath, enableTui,
+                        dt::Log::RtLogConstant::THREAD_CPU_ID,
+                        dt::Log::RtLogConstant::DEFAULT_MAX_FILES,
+                        dt::Log::RtLogConstant::DEFAULT_MAX_SIZE,
+                        dt::Log::RtLogConstant::THREAD_PRIORITY,
+                        dt::Log::RtLogConstant::THREAD_STACK_SIZE,
+                        true, false, queueConfig);
     dt::Log::SetLogLevel(static_cast<dt::Log::LogLevel>(logLevelVal));
     // FlushOn is not necessary for RT Log because it is designed to be non-blocking and thread-safe automatically flushes on periodic intervals.
     dt::Log::FlushOn(dt::Log::LogLevel::info);
@@ -78,8 +100,14 @@ int main(int argc, const char **argv)
     std::uniform_int_distribution<int> distrib(1, INT32_MAX);
     std::uniform_real_distribution<double> distrib_double(1, 10);
 
-    while (bRun)
-    {
+    // 10 ms control loop: absolute deadlines, timing statistics shown in the "Ctrl" row
+    ctrlThread.name = "ctrl";
+    ctrlThread.cpuIdx = 1;
+    ctrlThread.priority = 80;
+    dt::Thread::PeriodicConfig ctrlConfig;
+    ctrlConfig.period_ns = 10 * 1000 * 1000;
+    ctrlConfig.realtime = false; // SCHED_FIFO needs CAP_SYS_NICE; use true on the robot PC
+    dt::Thread::CreatePeriodicThread(ctrlThread, ctrlConfig, [&](uint64_t) {
         for (int i = 0; i < 50; i++) 
         {
             random_int_list[i] = distrib(gen);
@@ -89,6 +117,7 @@ int main(int argc, const char **argv)
         UpdateThreadState(0);
         UpdateRobotTaskData();
         UpdateRobotJointData();
+        UpdateSignalPlots();
 
         UpdateThreadState(1);
         UpdateEtherCAT();
@@ -96,8 +125,11 @@ int main(int argc, const char **argv)
         UpdatePerceivedObject();
         UpdateQRInfo();
         UpdatePludState();
+        return bRun.load();
+    });
 
-        // 10ms delay
+    while (bRun)
+    {
         dt::Thread::SleepForMillis(10);
 
         // key
@@ -115,6 +147,7 @@ int main(int argc, const char **argv)
         }
     }
 
+    dt::Thread::DeleteThread(ctrlThread);
     dt::Log::Terminate();
     return 0;
 }
@@ -130,6 +163,14 @@ void SetupTuiLayout0()
     // TUI_SET_GROUP(0, L0_GRP_PLUD, "Plud State", "[status]", "desPos", "actPos", "absPos", "actVel", "tgtTPU", "tgtTor");
     TUI_SET_GROUP(0, L0_GRP_R_JOINT, "Right Arm Joint", "state", "desPos", "actPos", "absPos", "actVel", "tgtTPU", "tgtTor");
     TUI_SET_GROUP(0, L0_GRP_L_JOINT, "Left Arm Joint", "state", "desPos", "actPos", "absPos", "actVel", "tgtTPU", "tgtTor");
+
+    // sparkline + rolling min/max/avg/p99 (1 column = 5 samples, stats over the last 500 samples)
+    TUI_SET_GROUP(0, L0_GRP_SIGNAL, "Signals");
+    dt::Log::TuiPlotConfig cfg;
+    cfg.window     = 500;
+    cfg.decimation = 5;
+    plotPeriod = TUI_ADD_PLOT(0, L0_GRP_SIGNAL, 0, "loop period [ms]", cfg);
+    plotTorque = TUI_ADD_PLOT(0, L0_GRP_SIGNAL, 1, "R1 torque [Nm]", cfg);
 }
 
 void SetupTuiLayout1()
@@ -149,12 +190,14 @@ void SetupTuiLayout1()
 void UpdateThreadState(int layout)
 {
     int grp = (layout == 0) ? L0_GRP_THREAD : L1_GRP_THREAD;
+    dt::Thread::ThreadTimeInfo timeInfo;
+    dt::Thread::GetThreadTimeInfo(ctrlThread, timeInfo);
     TUI_SET_TEXT_ROW_FMT(layout, grp, 0, "Ctrl",
                         "period: %6.3f ms   load: %6.3f ms   maxLoad: %6.3f ms   overrun: %d",
-                        random_double_list[0],
-                        random_double_list[1],
-                        random_double_list[2],
-                        random_int_list[0]);
+                        timeInfo.period_ms,
+                        timeInfo.algo_ms,
+                        timeInfo.algoMax_ms,
+                        timeInfo.overrun);
 }
 
 void UpdateRobotTaskData()
@@ -196,33 +239,48 @@ void UpdateRobotJointData()
     for (int i = 0; i < 8; i++)
     {
         double u = (i == 0) ? 1000.0f : RAD2DEG;
-        TUI_SET_ROW_COLS(0, L0_GRP_R_JOINT, i, jointName[i],
-            TUI_COL("0x%04X", random_int_list[i]),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8d",   random_int_list[i]),
-            TUI_COL("%+8.1f", random_double_list[i]));
+        TUI_SET_ROW_VALS(0, L0_GRP_R_JOINT, i, jointName[i],
+            TUI_VAL("0x%04X", random_int_list[i]),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8d",   random_int_list[i]),
+            TUI_VAL("%+8.1f", random_double_list[i]));
     }
 
     for (int i = 0; i < 8; i++)
     {
         double u = (i == 0) ? 1000.0f : RAD2DEG;
-        TUI_SET_ROW_COLS(0, L0_GRP_L_JOINT, i, jointName[8 + i],
-            TUI_COL("0x%04X", random_int_list[i]),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8.1f", random_double_list[i] * u),
-            TUI_COL("%+8d",   random_int_list[i]),
-            TUI_COL("%+8.1f", random_double_list[i]));
+        TUI_SET_ROW_VALS(0, L0_GRP_L_JOINT, i, jointName[8 + i],
+            TUI_VAL("0x%04X", random_int_list[i]),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8.1f", random_double_list[i] * u),
+            TUI_VAL("%+8d",   random_int_list[i]),
+            TUI_VAL("%+8.1f", random_double_list[i]));
+    }
+}
+
+void UpdateSignalPlots()
+{
+    static auto prev = std::chrono::steady_clock::now();
+    static double t = 0.0;
+    auto now = std::chrono::steady_clock::now();
+    double period_ms = std::chrono::duration<double, std::milli>(now - prev).count();
+    if (t > 0.0)
+    {
+        TUI_PLOT(plotPeriod, period_ms);
     }
+    TUI_PLOT(plotTorque, 20.0 * std::sin(t) + random_double_list[0] - 5.5);
+    prev = now;
+    t += 0.05;
 }
 
 void UpdateGripperData()
 {
-    TUI_SET_ROW(1, L1_GRP_GRIP, 0, "Right", "%d",
+    TUI_SET_ROW_RAW(1, L1_GRP_GRIP, 0, "Right", "%d",
                     random_int_list[10],
                     random_int_list[11],
                     random_int_list[12] & (0x01 << 0) ? 1 : 0,
@@ -230,7 +288,7 @@ void UpdateGripperData()
                     random_int_list[12] & (0x01 << 2) ? 1 : 0,
                     random_int_list[12] & (0x01 << 3) ? 1 : 0);
 
-    TUI_SET_ROW(1, L1_GRP_GRIP, 1, "Left ", "%d",
+    TUI_SET_ROW_RAW(1, L1_GRP_GRIP, 1, "Left ", "%d",
                     random_int_list[13],
                     random_int_list[14],
                     random_int_list[15] & (0x01 << 0) ? 1 : 0,
@@ -0,0 +1,47 @@
+#include <dtCore/dtLog>
+#include <dtCore/src/dtLog/dtRtTuiShm.hpp>
+#include <dtCore/dtThread>
+
+// dttui-attach: renders the TUI of another process from its shared-memory snapshot.
+//
+//   $ ./example_rtlog_tui /dttui > tui.log     (stdout redirected → TUI runs headless)
+//   $ ./dttui-attach /dttui                    (any number of viewers, attach / detach freely)
+//
+// Layout keys, log scrolling and '/' search work as in the publisher's own TUI.
+// 'q' or Ctrl-C quits. The viewer re-attaches automatically when the publisher restarts.
+int main(int argc, const char **argv)
+{
+    const char *shmName = (argc > 1) ? argv[1] : "/dttui";
+
+    dt::Log::TuiHistoryConfig history;
+    history.bytes = 2u << 20;   // only lines received while attached
+
+    dt::Log::RtTui tui;
+    if (!tui.Init(64, 256, dt::Utils::RtMemOptions{}, history))
+    {
+        fprintf(stderr, "dttui-attach: cannot initialize the terminal\n");
+        return 1;
+    }
+    if (!tui.AttachSnapshot(shmName))
+    {
+        tui.Stop();
+        fprintf(stderr, "dttui-attach: invalid shm name '%s' (expected \"/name\")\n", shmName);
+        return 1;
+    }
+    dt::Log::RtTui::AcceptResizeSignal();
+
+    for (;;)
+    {
+        tui.Tick();
+
+        char key = tui.PopPendingKey();
+        if (key == 'q' || key == 0x03)
+        {
+            break;
+        }
+        dt::Thread::SleepForMillis(40);
+    }
+
+    tui.Stop();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <dtCore/dtLog>
+#include <dtCore/dtThread>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+// example_thread_coscheduler: many small non-RT jobs on one thread with CoScheduler.
+//  1. 1000 periodic "watchdog" jobs (10 ~ 100 ms) with Every()
+//  2. a consumer task waiting on a CoSemaphore (with timeout) fed by another thread
+//  3. a task that moves a slow computation to a ThreadPool and awaits its CoFuture
+// After 2 s it prints what the jobs cost: task memory, task steps and how often the
+// scheduler thread had to sleep (about one context switch each).
+
+namespace
+{
+constexpr int NUM_JOBS = 1000;
+std::atomic<uint64_t> g_jobRuns{0};
+
+// stackless task: state that survives a DT_CO_* point is kept in members
+struct Consumer
+{
+    dt::Thread::CoSemaphore *sem;
+    int received = 0;
+    int timeouts = 0;
+
+    dt::Thread::CoStatus operator()(dt::Thread::CoContext &co)
+    {
+        DT_CO_BEGIN(co);
+        while (received < 20)
+        {
+            DT_CO_AWAIT_FOR(co, *sem, 200000000); // 200 ms
+            if (co.timedOut)
+                timeouts++;
+            else
+                received++;
+        }
+        printf("consumer: %d items, %d timeouts\n", received, timeouts);
+        DT_CO_END(co);
+    }
+};
+
+struct Offload
+{
+    dt::Thread::ThreadPool *pool;
+    dt::Thread::CoFuture<double> result;
+
+    dt::Thread::CoStatus operator()(dt::Thread::CoContext &co)
+    {
+        DT_CO_BEGIN(co);
+        result = dt::Thread::CoSubmit(*pool, [] {
+            double sum = 0;
+            for (int i = 1; i < 20000000; ++i) sum += 1.0 / ((double)i * i);
+            return sum;
+        });
+        DT_CO_AWAIT(co, result); // the scheduler keeps running the other jobs meanwhile
+        printf("offload: sum 1/n^2 = %.9f\n", result.Get());
+        DT_CO_END(co);
+    }
+};
+} // namespace
+
+int main()
+{
+    dt::Log::Initialize("example_thread_coscheduler");
+
+    dt::Thread::ThreadPool pool;
+    pool.Start();
+
+    dt::Thread::CoSchedulerConfig cfg;
+    cfg.name = "jobs";
+    dt::Thread::CoScheduler sched(cfg);
+    for (int i = 0; i < NUM_JOBS; ++i)
+    {
+        const int64_t period = (10 + (i % 10) * 10) * 1000000LL;
+        sched.Every("watchdog", period, [] {
+            g_jobRuns.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }, (i % 97) * 100000LL);
+    }
+    dt::Thread::CoSemaphore sem;
+    sched.Spawn("consumer", Consumer{&sem});
+    sched.Spawn("offload", Offload{&pool, {}});
+    sched.After("hello", 500000000, [] { printf("after: 500 ms\n"); });
+    sched.Start();
+
+    // producer on another thread: 20 items, with a gap longer than the consumer's timeout
+    std::thread producer([&sem] {
+        for (int i = 0; i < 20; ++i)
+        {
+            dt::Thread::SleepForMillis(i == 10 ? 500 : 30);
+            sem.Post();
+        }
+    });
+
+    dt::Thread::SleepForMillis(2000);
+    producer.join();
+
+    dt::Thread::CoSchedulerStats s;
+    sched.GetStats(s);
+    printf("%llu tasks x %zu B, %llu job runs, %llu task steps, %llu timer / %llu signal wakes, %llu idle sleeps\n",
+           (unsigned long long)s.tasks, dt::Thread::CoScheduler::TaskSize(), (unsigned long long)g_jobRuns.load(),
+           (unsigned long long)s.resumes, (unsigned long long)s.timerWakes, (unsigned long long)s.signalWakes,
+           (unsigned long long)s.idleSleeps);
+
+    sched.Stop();
+    pool.Stop();
+    dt::Thread::DeleteAllThread();
+    dt::Log::Terminate();
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include <dtCore/dtLog>
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+
+#include <getopt.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/utsname.h>
+#include <time.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// dt_latency_bench: cyclictest-style wake-up latency of dt::Thread threads.
+//
+// One thread per CPU (CreateThread: pinned, SCHED_FIFO) sleeps on absolute deadlines
+// (clock_nanosleep TIMER_ABSTIME) and records "wake-up time - deadline" into a 1 µs
+// histogram. Without CAP_SYS_NICE the threads fall back to SCHED_OTHER (reported in the
+// output) so the tool also runs unprivileged.
+//
+//   $ ./dt_latency_bench -c 2,3 -i 1000 -d 60 --json robot-pc.json
+//   $ ./dt_latency_bench -c 2-5 --load rtlog,data      # with RtLog text bursts + LOG_DATA file writes
+//
+// Compare two machines/kernels by diffing the JSON (per-CPU max / p99 / p99.99 / histogram).
+
+namespace
+{
+
+struct BenchConfig
+{
+    std::vector<int> cpus;
+    long             interval_us = 1000;
+    double           duration_s  = 10.0;
+    int              priority    = 80;
+    int              histMax_us  = 10000;   // last bucket collects everything above
+    bool             loadLog     = false;
+    bool             loadData    = false;
+    const char      *jsonPath    = nullptr;
+};
+
+struct CpuResult
+{
+    dt::Thread::ThreadInfo thread;
+    char                   name[32]{};
+    int                    cpu = 0;
+    bool                   realtime = false;
+    std::vector<uint64_t>  hist;            // [us] = count, allocated before the run
+    uint64_t               cycles = 0;
+    int64_t                min_ns = INT64_MAX;
+    int64_t                max_ns = 0;
+    double                 sum_ns = 0.0;
+};
+
+std::atomic<bool> g_run{true};
+std::atomic<bool> g_go{false};
+BenchConfig       g_cfg;
+
+void *LatencyProc(void *arg)
+{
+    CpuResult *r = static_cast<CpuResult *>(arg);
+    const int64_t interval = g_cfg.interval_us * 1000;
+    const int64_t maxCycles = (int64_t)(g_cfg.duration_s * 1e9) / interval;
+    const size_t last = r->hist.size() - 1;
+
+    while (!g_go.load(std::memory_order_acquire))
+    {
+        dt::Thread::SleepForMillis(1);
+    }
+
+    int64_t deadline = dt::Utils::MonotonicNs() + interval;
+    for (int64_t n = 0; n < maxCycles && g_run.load(std::memory_order_relaxed); ++n)
+    {
+        struct timespec ts;
+        ts.tv_sec = deadline / 1000000000LL;
+        ts.tv_nsec = deadline % 1000000000LL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+
+        const int64_t lat = dt::Utils::MonotonicNs() - deadline;
+        const size_t us = (size_t)(lat / 1000);
+        r->hist[us < last ? us : last]++;
+        r->min_ns = std::min(r->min_ns, lat);
+        r->max_ns = std::max(r->max_ns, lat);
+        r->sum_ns += (double)lat;
+        r->cycles++;
+
+        deadline += interval;
+        if (deadline < dt::Utils::MonotonicNs())
+        {
+            deadline = dt::Utils::MonotonicNs() + interval; // lost more than a period: restart the grid
+        }
+    }
+    return nullptr;
+}
+
+// smallest bucket upper bound [us] below which 'q' of the samples fall
+double Percentile(const CpuResult &r, double q)
+{
+    if (r.cycles == 0)
+    {
+        return 0.0;
+    }
+    const uint64_t target = (uint64_t)std::ceil(q * (double)r.cycles);
+    uint64_t acc = 0;
+    for (size_t us = 0; us < r.hist.size(); ++us)
+    {
+        acc += r.hist[us];
+        if (acc >= target)
+        {
+            return (us + 1 < r.hist.size()) ? (double)(us + 1) : r.max_ns / 1e3;
+        }
+    }
+    return r.max_ns / 1e3;
+}
+
+// ─── synthetic load ───
+void LogBurstLoad()
+{
+    // 200-line bursts every 10 ms: exercises the RtLog queue and the drain thread's file I/O
+    uint64_t seq = 0;
+    while (g_run.load(std::memory_order_relaxed))
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            LOG(debug).printf("latency bench load burst %llu line %d: %f", (unsigned long long)seq, i, seq * 0.001 * i);
+        }
+        ++seq;
+        dt::Thread::SleepForMillis(10);
+    }
+}
+
+void DataWriteLoad()
+{
+    // 1 kHz x 100 doubles into a binary LOG_DATA channel (bulk file writes like a recorder)
+    double data[100];
+    uint64_t seq = 0;
+    int64_t next = dt::Utils::MonotonicNs();
+    while (g_run.load(std::memory_order_relaxed))
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            data[i] = std::sin(seq * 0.001 * (i + 1));
+        }
+        LOG_DATA_ARRAY(bench_load, data, 100);
+        ++seq;
+
+        next += 1000000;
+        struct timespec ts;
+        ts.tv_sec = next / 1000000000LL;
+        ts.tv_nsec = next % 1000000000LL;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+    }
+}
+
+// ─── options ───
+void Usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -c, --cpus LIST        CPUs to measure, e.g. 2,3 or 2-5 (default: current affinity)\n"
+            "  -i, --interval US      wake-up interval in us (default 1000)\n"
+            "  -d, --duration SEC     run time in seconds (default 10)\n"
+            "  -p, --priority PRIO    SCHED_FIFO priority (default 80)\n"
+            "  -H, --hist-max US      histogram range in us (default 10000)\n"
+            "  -l, --load LIST        synthetic load: rtlog, data (comma separated)\n"
+            "  -j, --json FILE        write results as JSON\n",
+            prog);
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"cpus", required_argument, nullptr, 'c'},     {"interval", required_argument, nullptr, 'i'},
+        {"duration", required_argument, nullptr, 'd'}, {"priority", required_argument, nullptr, 'p'},
+        {"hist-max", required_argument, nullptr, 'H'}, {"load", required_argument, nullptr, 'l'},
+        {"json", required_argument, nullptr, 'j'},     {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "c:i:d:p:H:l:j:h", opts, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'c':
+            if (dt::Thread::ParseCpuList(optarg, g_cfg.cpus) || g_cfg.cpus.empty())
+            {
+                fprintf(stderr, "invalid cpu list '%s'\n", optarg);
+                return false;
+            }
+            break;
+        case 'i': g_cfg.interval_us = atol(optarg); break;
+        case 'd': g_cfg.duration_s = atof(optarg); break;
+        case 'p': g_cfg.priority = atoi(optarg); break;
+        case 'H': g_cfg.histMax_us = atoi(optarg); break;
+        case 'l':
+            g_cfg.loadLog = strstr(optarg, "rtlog") != nullptr;
+            g_cfg.loadData = strstr(optarg, "data") != nullptr;
+            if (!g_cfg.loadLog && !g_cfg.loadData)
+            {
+                fprintf(stderr, "invalid load '%s' (rtlog, data)\n", optarg);
+                return false;
+            }
+            break;
+        case 'j': g_cfg.jsonPath = optarg; break;
+        default: return false;
+        }
+    }
+    if (g_cfg.interval_us <= 0 || g_cfg.duration_s <= 0 || g_cfg.histMax_us <= 0)
+    {
+        fprintf(stderr, "interval, duration and hist-max must be positive\n");
+        return false;
+    }
+
+    if (g_cfg.cpus.empty())
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        sched_getaffinity(0, sizeof(set), &set);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                g_cfg.cpus.push_back(cpu);
+            }
+        }
+    }
+    return true;
+}
+
+// ─── output ───
+void WriteJson(FILE *fp, const std::vector<CpuResult> &results, bool mlocked)
+{
+    struct utsname un{};
+    uname(&un);
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"host\": \"%s\",\n  \"kernel\": \"%s %s\",\n", un.nodename, un.release, un.version);
+    fprintf(fp, "  \"config\": {\"interval_us\": %ld, \"duration_s\": %.3f, \"priority\": %d, \"hist_max_us\": %d, "
+                "\"load\": [%s%s%s], \"mlockall\": %s},\n",
+            g_cfg.interval_us, g_cfg.duration_s, g_cfg.priority, g_cfg.histMax_us,
+            g_cfg.loadLog ? "\"rtlog\"" : "", (g_cfg.loadLog && g_cfg.loadData) ? ", " : "",
+            g_cfg.loadData ? "\"data\"" : "", mlocked ? "true" : "false");
+    fprintf(fp, "  \"cpus\": [\n");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const CpuResult &r = results[i];
+        fprintf(fp, "    {\"cpu\": %d, \"policy\": \"%s\", \"cycles\": %llu, \"min_us\": %.3f, \"avg_us\": %.3f, "
+                    "\"max_us\": %.3f, \"p99_us\": %.0f, \"p99.9_us\": %.0f, \"p99.99_us\": %.0f, \"overflow\": %llu,\n",
+                r.cpu, r.realtime ? "SCHED_FIFO" : "SCHED_OTHER", (unsigned long long)r.cycles,
+                r.cycles ? r.min_ns / 1e3 : 0.0, r.cycles ? r.sum_ns / r.cycles / 1e3 : 0.0, r.max_ns / 1e3,
+                Percentile(r, 0.99), Percentile(r, 0.999), Percentile(r, 0.9999),
+                (unsigned long long)r.hist.back());
+        // sparse histogram: [bucket_us, count] of non-empty buckets
+        fprintf(fp, "     \"histogram\": [");
+        bool first = true;
+        for (size_t us = 0; us < r.hist.size(); ++us)
+        {
+            if (r.hist[us])
+            {
+                fprintf(fp, "%s[%zu, %llu]", first ? "" : ", ", us, (unsigned long long)r.hist[us]);
+                first = false;
+            }
+        }
+        fprintf(fp, "]}%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+}
+
+void CatchSignal(int)
+{
+    g_run.store(false);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+    signal(SIGINT, CatchSignal);
+    signal(SIGTERM, CatchSignal);
+
+    const bool mlocked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+    if (!mlocked)
+    {
+        fprintf(stderr, "dt_latency_bench: mlockall failed (%s), page faults may show up as latency\n", strerror(errno));
+    }
+
+    const bool anyLoad = g_cfg.loadLog || g_cfg.loadData;
+    if (anyLoad)
+    {
+        dt::Log::Initialize("latency_bench", "logs/dt_latency_bench.txt");
+        dt::Log::SetLogLevel(dt::Log::LogLevel::trace);
+        if (g_cfg.loadData)
+        {
+            dt::Log::CreateDataChannel("bench_load", "logs/dt_latency_bench.dtd");
+        }
+    }
+
+    // histograms are allocated and touched here, never in the measuring threads
+    std::vector<CpuResult> results(g_cfg.cpus.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        CpuResult &r = results[i];
+        r.cpu = g_cfg.cpus[i];
+        r.hist.assign((size_t)g_cfg.histMax_us + 1, 0);
+        snprintf(r.name, sizeof(r.name), "lat_cpu%d", r.cpu);
+
+        r.thread.name = r.name;
+        r.thread.cpuIdx = r.cpu;
+        r.thread.priority = g_cfg.priority;
+        r.thread.stackSz = 256 * 1024;
+        r.thread.procFunc = LatencyProc;
+        r.thread.procFuncArg = &r;
+
+        r.realtime = (dt::Thread::CreateThread(r.thread, true, false) == 0);
+        if (!r.realtime)
+        {
+            // typically EPERM without CAP_SYS_NICE / rtprio limit: measure SCHED_OTHER instead
+            r.thread.priority = 0;
+            if (dt::Thread::CreateThread(r.thread, false, false) != 0)
+            {
+                fprintf(stderr, "dt_latency_bench: cannot create a thread on cpu %d\n", r.cpu);
+                g_run.store(false);
+                g_go.store(true);
+                results.resize(i);
+                break;
+            }
+        }
+    }
+
+    std::vector<std::thread> loads;
+    if (g_cfg.loadLog)
+    {
+        loads.emplace_back(LogBurstLoad);
+    }
+    if (g_cfg.loadData)
+    {
+        loads.emplace_back(DataWriteLoad);
+    }
+
+    fprintf(stderr, "dt_latency_bench: %zu cpu(s), interval %ld us, %.1f s%s ...\n", results.size(),
+            g_cfg.interval_us, g_cfg.duration_s, anyLoad ? ", with load" : "");
+    g_go.store(true, std::memory_order_release);
+    for (CpuResult &r : results)
+    {
+        dt::Thread::DeleteThread(r.thread);
+    }
+    g_run.store(false);
+    for (std::thread &t : loads)
+    {
+        t.join();
+    }
+
+    printf("%-5s %-11s %10s %9s %9s %9s %8s %8s %9s %9s\n", "CPU", "POLICY", "CYCLES", "MIN[us]", "AVG[us]",
+           "MAX[us]", "P99", "P99.9", "P99.99", "OVERFLOW");
+    for (const CpuResult &r : results)
+    {
+        printf("%-5d %-11s %10llu %9.1f %9.1f %9.1f %8.0f %8.0f %9.0f %9llu\n", r.cpu,
+               r.realtime ? "SCHED_FIFO" : "SCHED_OTHER", (unsigned long long)r.cycles,
+               r.cycles ? r.min_ns / 1e3 : 0.0, r.cycles ? r.sum_ns / r.cycles / 1e3 : 0.0, r.max_ns / 1e3,
+               Percentile(r, 0.99), Percentile(r, 0.999), Percentile(r, 0.9999), (unsigned long long)r.hist.back());
+    }
+
+    if (g_cfg.jsonPath)
+    {
+        FILE *fp = fopen(g_cfg.jsonPath, "w");
+        if (!fp)
+        {
+            fprintf(stderr, "dt_latency_bench: cannot open %s: %s\n", g_cfg.jsonPath, strerror(errno));
+        }
+        else
+        {
+            WriteJson(fp, results, mlocked);
+            fclose(fp);
+        }
+    }
+
+    if (anyLoad)
+    {
+        dt::Log::Terminate();
+    }
+    return results.empty() ? 1 : 0;
+}
@@ -3,6 +3,7 @@
 #include "dtCore/src/dtUtils/dtTerminal.h"
 #include <atomic>
 #include <iostream>
+#include <mutex>
 
 using namespace dt::Thread;
 constexpr int num_thread = 20;
@@ -11,12 +12,12 @@ constexpr int inc_per_thread = 500;
 #ifdef NO_LOCK
 typedef struct _DummyLock
 {
-    bool lock() { return true; }
-    bool unlock() { return true;}
+    void lock() {}
+    void unlock() {}
 } DummyLock;
 DummyLock lock;
 #else 
-dt::Utils::Lock lock;
+dt::Utils::SpinLock lock;
 #endif
 
 void *threadProc(void *arg)
@@ -24,10 +25,10 @@ void *threadProc(void *arg)
     int *sum = (int *)arg;
     for (int i = 0; i < inc_per_thread; i++)
     {
-        while (!lock.lock()); // spin lock
-
-        *sum = *sum + 1;
-        lock.unlock();
+        {
+            std::lock_guard<decltype(lock)> guard(lock);
+            *sum = *sum + 1;
+        }
 
         SleepForMillis(1);
     }
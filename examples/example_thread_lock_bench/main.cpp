@@ -0,0 +1,322 @@
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtLock.hpp>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+
+#include <getopt.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// dt_lock_bench: contention benchmark of the dtLock.hpp lock family vs. std::mutex / pthread mutex.
+//
+// For 2..N threads, each pinned to its own CPU (dt::Thread::CreateThread, SCHED_FIFO if permitted),
+// every thread loops: lock -> touch a few shared cache lines -> unlock -> a little private work.
+// Reported per lock and thread count:
+//   Mops/s     total lock/unlock pairs per second
+//   fair       min / max acquisitions of one thread (1.00: perfectly fair)
+//   acquire    time spent in lock() (p50 / p99 / max, ns)
+// and the shared counter is checked against the number of acquisitions (mutual exclusion).
+//
+//   $ ./dt_lock_bench -c 2-7              # threads on CPUs 2..7: 2, 4, 6 threads
+//   $ ./dt_lock_bench -c 2-5 -t 2,4 -w 8  # longer critical section (8 cache lines)
+//
+// Spinning locks with more threads than CPUs are skipped under SCHED_FIFO: a spinning waiter
+// would never let the preempted holder run.
+
+namespace
+{
+
+struct BenchConfig
+{
+    std::vector<int> cpus;
+    std::vector<int> threadCounts;
+    double duration_s = 1.0;
+    int    lines      = 2;     // cache lines written in the critical section
+    int    outside    = 200;   // pause loops between two acquisitions
+    bool   realtime   = true;
+    int    priority   = 10;
+};
+
+BenchConfig g_cfg;
+
+// shared data guarded by the lock under test, one counter per cache line
+struct alignas(64) Line
+{
+    uint64_t value;
+};
+Line g_shared[64];
+
+// lock adapters ---------------------------------------------------------------------
+struct StdMutex
+{
+    static constexpr const char *name = "std::mutex";
+    static constexpr bool spins = false;
+    std::mutex m;
+    void lock() { m.lock(); }
+    void unlock() { m.unlock(); }
+};
+
+template <bool PI>
+struct PthreadMutex
+{
+    static constexpr const char *name = PI ? "MtxInfo PRIO_INHERIT" : "MtxInfo";
+    static constexpr bool spins = false;
+    dt::Thread::MtxInfo info;
+    PthreadMutex() { dt::Thread::CreateMutex(info, PI); }
+    ~PthreadMutex() { dt::Thread::DeleteMutex(info); }
+    void lock() { dt::Thread::MutexLock(info); }
+    void unlock() { dt::Thread::MutexUnlock(info); }
+};
+
+struct Spin
+{
+    static constexpr const char *name = "SpinLock";
+    static constexpr bool spins = true;
+    dt::Utils::SpinLock l;
+    void lock() { l.lock(); }
+    void unlock() { l.unlock(); }
+};
+
+struct Ticket
+{
+    static constexpr const char *name = "TicketLock";
+    static constexpr bool spins = true;
+    dt::Utils::TicketLock l;
+    void lock() { l.lock(); }
+    void unlock() { l.unlock(); }
+};
+
+struct Adaptive
+{
+    static constexpr const char *name = "AdaptiveMutex";
+    static constexpr bool spins = false;
+    dt::Utils::AdaptiveMutex l;
+    void lock() { l.lock(); }
+    void unlock() { l.unlock(); }
+};
+
+struct Legacy
+{
+    static constexpr const char *name = "Lock (legacy try-spin)";
+    static constexpr bool spins = true;
+    dt::Utils::Lock l;
+    void lock() { while (!l.lock()) {} }
+    void unlock() { l.unlock(); }
+};
+
+// worker ----------------------------------------------------------------------------
+struct Worker
+{
+    dt::Thread::ThreadInfo thread;
+    char name[16]{};
+    void *ctx = nullptr;
+    uint64_t ops = 0;
+    std::vector<int64_t> acquire; // reserved before the run
+};
+
+template <typename L>
+struct Context
+{
+    L lock;
+    std::atomic<int> ready{0};
+    std::atomic<int64_t> start{0}; // set by main once every worker is ready
+    int64_t duration = 0;
+};
+
+template <typename L>
+void *WorkerProc(void *arg)
+{
+    Worker *w = static_cast<Worker *>(arg);
+    Context<L> *ctx = static_cast<Context<L> *>(w->ctx);
+    // wait for the start by sleeping and stop on our own deadline: a SCHED_FIFO worker
+    // sharing a CPU with main would otherwise never let it set a flag
+    ctx->ready.fetch_add(1);
+    int64_t start;
+    while ((start = ctx->start.load(std::memory_order_acquire)) == 0) dt::Thread::SleepForMillis(1);
+    const int64_t end = start + ctx->duration;
+
+    const size_t cap = w->acquire.capacity();
+    while (dt::Utils::MonotonicNs() < end)
+    {
+        const int64_t t0 = dt::Utils::MonotonicNs();
+        ctx->lock.lock();
+        const int64_t t1 = dt::Utils::MonotonicNs();
+        for (int i = 0; i < g_cfg.lines; ++i) g_shared[i].value++;
+        ctx->lock.unlock();
+
+        if (w->acquire.size() < cap) w->acquire.push_back(t1 - t0);
+        w->ops++;
+        for (int i = 0; i < g_cfg.outside; ++i) dt::Utils::CpuRelax();
+    }
+    return nullptr;
+}
+
+template <typename L>
+void RunCase(int nthreads)
+{
+    if (L::spins && g_cfg.realtime && nthreads > (int)g_cfg.cpus.size())
+    {
+        printf("%-24s %3d   skipped (more SCHED_FIFO spinners than CPUs)\n", L::name, nthreads);
+        return;
+    }
+
+    Context<L> ctx;
+    ctx.duration = (int64_t)(g_cfg.duration_s * 1e9);
+    std::vector<Worker> workers(nthreads);
+    for (Line &l : g_shared) l.value = 0;
+
+    bool realtime = g_cfg.realtime;
+    for (int i = 0; i < nthreads; ++i)
+    {
+        Worker &w = workers[i];
+        w.ctx = &ctx;
+        w.acquire.reserve(1 << 20);
+        snprintf(w.name, sizeof(w.name), "lock%d", i);
+        w.thread.name = w.name;
+        w.thread.cpuIdx = g_cfg.cpus[i % g_cfg.cpus.size()];
+        w.thread.priority = g_cfg.priority;
+        w.thread.procFunc = WorkerProc<L>;
+        w.thread.procFuncArg = &w;
+        if (realtime && dt::Thread::CreateThread(w.thread, true, false) == 0) continue;
+        if (realtime && i == 0)
+        {
+            realtime = g_cfg.realtime = false; // no CAP_SYS_NICE: SCHED_OTHER for the rest of the run
+            fprintf(stderr, "dt_lock_bench: SCHED_FIFO not permitted, using SCHED_OTHER\n");
+        }
+        w.thread.priority = 0;
+        if (dt::Thread::CreateThread(w.thread, false, false) != 0)
+        {
+            fprintf(stderr, "dt_lock_bench: cannot create thread %d\n", i);
+            exit(1);
+        }
+    }
+    while (ctx.ready.load() < nthreads) dt::Thread::SleepForMillis(1);
+
+    const int64_t start = dt::Utils::MonotonicNs() + 5000000; // 5 ms: every worker is back from its sleep
+    ctx.start.store(start, std::memory_order_release);
+    for (Worker &w : workers) dt::Thread::DeleteThread(w.thread);
+    const double sec = (dt::Utils::MonotonicNs() - start) * 1e-9;
+
+    uint64_t total = 0, minOps = UINT64_MAX, maxOps = 0;
+    std::vector<int64_t> acq;
+    for (Worker &w : workers)
+    {
+        total += w.ops;
+        minOps = std::min(minOps, w.ops);
+        maxOps = std::max(maxOps, w.ops);
+        acq.insert(acq.end(), w.acquire.begin(), w.acquire.end());
+    }
+    std::sort(acq.begin(), acq.end());
+    auto pct = [&acq](double p) { return acq.empty() ? 0LL : (long long)acq[std::min(acq.size() - 1, (size_t)(p * acq.size()))]; };
+    bool exclusive = true;
+    for (int i = 0; i < g_cfg.lines; ++i) exclusive &= (g_shared[i].value == total);
+
+    printf("%-24s %3d %8.2f %6.2f %8lld %8lld %10lld %s\n", L::name, nthreads, total / sec * 1e-6,
+           maxOps ? (double)minOps / (double)maxOps : 0.0, pct(0.5), pct(0.99), acq.empty() ? 0LL : (long long)acq.back(),
+           exclusive ? "" : "  MUTUAL EXCLUSION BROKEN");
+}
+
+void RunAll(int nthreads)
+{
+    RunCase<StdMutex>(nthreads);
+    RunCase<PthreadMutex<false>>(nthreads);
+    RunCase<PthreadMutex<true>>(nthreads);
+    RunCase<Spin>(nthreads);
+    RunCase<Ticket>(nthreads);
+    RunCase<Adaptive>(nthreads);
+    RunCase<Legacy>(nthreads);
+    printf("\n");
+}
+
+void Usage(const char *prog)
+{
+    printf("usage: %s [options]\n"
+           "  -c, --cpus LIST       CPUs of the threads, one thread per CPU (default: housekeeping CPUs)\n"
+           "  -t, --threads LIST    thread counts, e.g. 2,4,8 (default: 2, 4, ... up to the CPU count)\n"
+           "  -d, --duration SEC    seconds per case (default 1)\n"
+           "  -w, --lines N         cache lines written inside the lock (1..64, default 2)\n"
+           "  -o, --outside N       pause loops outside the lock (default 200)\n"
+           "  -n, --nonrt           SCHED_OTHER threads (default SCHED_FIFO priority 10 if permitted)\n",
+           prog);
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"cpus", required_argument, nullptr, 'c'},
+        {"threads", required_argument, nullptr, 't'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"lines", required_argument, nullptr, 'w'},
+        {"outside", required_argument, nullptr, 'o'},
+        {"nonrt", no_argument, nullptr, 'n'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int c;
+    while ((c = getopt_long(argc, argv, "c:t:d:w:o:nh", opts, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'c':
+            if (dt::Thread::ParseCpuList(optarg, g_cfg.cpus) || g_cfg.cpus.empty())
+            {
+                fprintf(stderr, "invalid cpu list '%s'\n", optarg);
+                return false;
+            }
+            break;
+        case 't':
+            if (dt::Thread::ParseCpuList(optarg, g_cfg.threadCounts) || g_cfg.threadCounts.empty())
+            {
+                fprintf(stderr, "invalid thread counts '%s'\n", optarg);
+                return false;
+            }
+            break;
+        case 'd': g_cfg.duration_s = atof(optarg); break;
+        case 'w': g_cfg.lines = atoi(optarg); break;
+        case 'o': g_cfg.outside = atoi(optarg); break;
+        case 'n': g_cfg.realtime = false; break;
+        default: Usage(argv[0]); return false;
+        }
+    }
+    if (g_cfg.duration_s <= 0 || g_cfg.lines < 1 || g_cfg.lines > 64 || g_cfg.outside < 0)
+    {
+        fprintf(stderr, "invalid option value\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        return 1;
+    }
+    if (g_cfg.cpus.empty())
+    {
+        g_cfg.cpus = dt::Thread::GetHousekeepingCpus(dt::Thread::GetCpuTopology(), {});
+    }
+    if (g_cfg.threadCounts.empty())
+    {
+        const int n = std::max(2, (int)g_cfg.cpus.size());
+        for (int t = 2; t < n; t *= 2) g_cfg.threadCounts.push_back(t);
+        g_cfg.threadCounts.push_back(n);
+    }
+
+    printf("dt_lock_bench: cpus %s, %d line(s) in the lock, %.1f s per case\n\n",
+           dt::Thread::FormatCpuList(g_cfg.cpus).c_str(), g_cfg.lines, g_cfg.duration_s);
+    printf("%-24s %3s %8s %6s %8s %8s %10s\n", "LOCK", "THR", "Mops/s", "fair", "acq p50", "acq p99", "acq max[ns]");
+    for (int n : g_cfg.threadCounts)
+    {
+        RunAll(n);
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include <dtCore/dtThread>
+
+#include <getopt.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// dt_pool_bench: throughput and work-stealing efficiency of dt::Thread::ThreadPool.
+//
+//   flat      N tiny tasks posted from main                     -> tasks/s (submit + dispatch cost)
+//   tree      a binary task tree spawned inside the workers     -> tasks/s, share of stolen tasks
+//   pfor      ParallelFor over a uniform kernel vs. serial      -> speed-up
+//   skewed    ParallelFor where cost grows with the index       -> speed-up (needs stealing)
+//
+//   $ ./dt_pool_bench -c 4-7              # workers float over CPUs 4..7 (keep RT cores out)
+//   $ ./dt_pool_bench -c 4-7 -p -n 200000 # one worker pinned per CPU
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig
+{
+    std::vector<int> cpus;
+    int  threads = 0;
+    bool pinEach = false;
+    long tasks   = 100000;
+    int  depth   = 16;      // tree: 2^depth - 1 tasks
+    long items   = 2000000; // pfor/skewed
+};
+
+BenchConfig g_cfg;
+
+double Seconds(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// a few hundred ns of arithmetic the optimizer cannot drop
+double Kernel(size_t i, int rounds)
+{
+    double x = (double)i * 1e-6;
+    for (int r = 0; r < rounds; ++r)
+    {
+        x = std::sin(x) + 1.000001 * x;
+    }
+    return x;
+}
+
+void PrintWorkerStats(dt::Thread::ThreadPool &pool, std::vector<dt::Thread::ThreadPoolWorkerStats> &base)
+{
+    std::vector<dt::Thread::ThreadPoolWorkerStats> now;
+    pool.GetStats(now);
+    uint64_t exec = 0, stolen = 0;
+    printf("    worker  executed    stolen   sleeps\n");
+    for (size_t i = 0; i < now.size(); ++i)
+    {
+        const uint64_t e = now[i].executed - base[i].executed;
+        const uint64_t s = now[i].stolen - base[i].stolen;
+        printf("    %6zu %9llu %9llu %8llu\n", i, (unsigned long long)e, (unsigned long long)s,
+               (unsigned long long)(now[i].sleeps - base[i].sleeps));
+        exec += e;
+        stolen += s;
+    }
+    printf("    total  %9llu %9llu  (stolen %.1f%%)\n", (unsigned long long)exec, (unsigned long long)stolen,
+           exec ? 100.0 * (double)stolen / (double)exec : 0.0);
+    base = now;
+}
+
+void Spawn(dt::Thread::ThreadPool &pool, std::atomic<long> &left, int depth)
+{
+    if (depth > 1)
+    {
+        pool.Post([&pool, &left, depth]() { Spawn(pool, left, depth - 1); });
+        pool.Post([&pool, &left, depth]() { Spawn(pool, left, depth - 1); });
+    }
+    Kernel((size_t)depth, 20);
+    left.fetch_sub(1, std::memory_order_release);
+}
+
+void Usage(const char *prog)
+{
+    printf("usage: %s [options]\n"
+           "  -c, --cpus LIST     worker CPUs, e.g. 4-7 or 2,3 (default: housekeeping CPUs)\n"
+           "  -t, --threads N     number of workers (default: one per CPU)\n"
+           "  -p, --pin           pin worker i to one CPU instead of floating over the set\n"
+           "  -n, --tasks N       tasks of the flat test (default 100000)\n"
+           "  -D, --depth N       depth of the task tree (default 16)\n"
+           "  -m, --items N       indices of the ParallelFor tests (default 2000000)\n",
+           prog);
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"cpus", required_argument, nullptr, 'c'},
+        {"threads", required_argument, nullptr, 't'},
+        {"pin", no_argument, nullptr, 'p'},
+        {"tasks", required_argument, nullptr, 'n'},
+        {"depth", required_argument, nullptr, 'D'},
+        {"items", required_argument, nullptr, 'm'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int c;
+    while ((c = getopt_long(argc, argv, "c:t:pn:D:m:h", opts, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'c':
+            if (dt::Thread::ParseCpuList(optarg, g_cfg.cpus) || g_cfg.cpus.empty())
+            {
+                fprintf(stderr, "invalid cpu list '%s'\n", optarg);
+                return false;
+            }
+            break;
+        case 't': g_cfg.threads = atoi(optarg); break;
+        case 'p': g_cfg.pinEach = true; break;
+        case 'n': g_cfg.tasks = atol(optarg); break;
+        case 'D': g_cfg.depth = atoi(optarg); break;
+        case 'm': g_cfg.items = atol(optarg); break;
+        default: Usage(argv[0]); return false;
+        }
+    }
+    if (g_cfg.tasks <= 0 || g_cfg.depth < 1 || g_cfg.depth > 24 || g_cfg.items <= 0)
+    {
+        fprintf(stderr, "invalid size\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    dt::Thread::ThreadPoolConfig config;
+    config.name = "bench";
+    config.cpus = g_cfg.cpus;
+    config.numThreads = g_cfg.threads;
+    config.pinEach = g_cfg.pinEach;
+    dt::Thread::ThreadPool pool(config);
+    if (pool.Start())
+    {
+        fprintf(stderr, "failed to start the pool\n");
+        return 1;
+    }
+    printf("dt_pool_bench: %d workers (%s)\n", pool.GetThreadCount(), g_cfg.pinEach ? "pinned" : "floating");
+
+    std::vector<dt::Thread::ThreadPoolWorkerStats> base;
+    pool.GetStats(base);
+
+    // flat ------------------------------------------------------------------
+    {
+        std::atomic<long> left{g_cfg.tasks};
+        auto t0 = Clock::now();
+        for (long i = 0; i < g_cfg.tasks; ++i)
+        {
+            pool.Post([&left]() { left.fetch_sub(1, std::memory_order_release); });
+        }
+        pool.HelpUntil([&left]() { return left.load(std::memory_order_acquire) == 0; });
+        const double sec = Seconds(t0);
+        printf("\n[flat]   %ld tasks in %.3f s : %.0f tasks/s\n", g_cfg.tasks, sec, g_cfg.tasks / sec);
+        PrintWorkerStats(pool, base);
+    }
+
+    // tree ------------------------------------------------------------------
+    {
+        const long total = (1L << g_cfg.depth) - 1;
+        std::atomic<long> left{total};
+        auto t0 = Clock::now();
+        pool.Post([&pool, &left]() { Spawn(pool, left, g_cfg.depth); });
+        pool.HelpUntil([&left]() { return left.load(std::memory_order_acquire) == 0; });
+        const double sec = Seconds(t0);
+        printf("\n[tree]   %ld tasks in %.3f s : %.0f tasks/s\n", total, sec, total / sec);
+        PrintWorkerStats(pool, base);
+    }
+
+    // pfor / skewed -----------------------------------------------------------
+    const size_t n = (size_t)g_cfg.items;
+    std::vector<double> out(n);
+    for (int skewed = 0; skewed < 2; ++skewed)
+    {
+        auto body = [&out, n, skewed](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i)
+            {
+                out[i] = Kernel(i, skewed ? (int)(1 + 40 * i / n) : 20);
+            }
+        };
+        auto t0 = Clock::now();
+        body(0, n);
+        const double serial = Seconds(t0);
+
+        t0 = Clock::now();
+        pool.ParallelFor(0, n, 0, body);
+        const double parallel = Seconds(t0);
+        printf("\n[%s] %zu items : serial %.3f s, pool %.3f s, speed-up %.2fx\n", skewed ? "skewed" : "pfor  ", n,
+               serial, parallel, serial / parallel);
+        PrintWorkerStats(pool, base);
+    }
+
+    pool.Stop();
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <dtCore/dtLog>
+#include <dtCore/dtThread>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Print the CPU topology and the placement dt::Thread would choose.
+//
+//   $ ./example_thread_topology                 # this machine
+//   $ ./example_thread_topology 3               # partner core of RT core 3
+//   $ ./example_thread_topology 3 /tmp/sys-ipc  # sysfs copied from the target PC
+
+int main(int argc, char **argv)
+{
+    dt::Log::Initialize("topology");
+
+    const int rtCpu = (argc > 1) ? atoi(argv[1]) : -1;
+    dt::Thread::CpuTopology topo;
+    if (dt::Thread::ReadCpuTopology(topo, (argc > 2) ? argv[2] : "/sys"))
+    {
+        dt::Log::Terminate();
+        return 1;
+    }
+    dt::Thread::PrintCpuTopology(topo);
+
+    // place two RT threads, then the housekeeping work around them
+    std::vector<int> rtCpus;
+    if (rtCpu >= 0)
+    {
+        rtCpus.push_back(rtCpu);
+    }
+    while (rtCpus.size() < 2)
+    {
+        const int cpu = dt::Thread::PickRtCpu(topo, rtCpus);
+        if (cpu < 0) break;
+        rtCpus.push_back(cpu);
+    }
+    LOG(info).printf("RT cores              : %s", dt::Thread::FormatCpuList(rtCpus).c_str());
+    LOG(info).printf("housekeeping cores    : %s",
+                     dt::Thread::FormatCpuList(dt::Thread::GetHousekeepingCpus(topo, rtCpus)).c_str());
+    for (int cpu : rtCpus)
+    {
+        LOG(info).printf("partner of RT core %-3d: %d", cpu, dt::Thread::PickHousekeepingCpu(topo, rtCpus, cpu));
+    }
+
+    dt::Log::Terminate();
+    return 0;
+}
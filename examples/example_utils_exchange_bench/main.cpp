@@ -0,0 +1,467 @@
+#include <dtCore/src/dtUtils/dtRing.hpp>
+#include <dtCore/src/dtUtils/dtSeqLock.hpp>
+#include <dtCore/src/dtUtils/dtTripleBuffer.hpp>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+
+#include <getopt.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// dt_exchange_bench: correctness stress tests and latency microbenchmarks of the RT <-> nonRT
+// exchange primitives (dtTripleBuffer.hpp, dtRing.hpp, dtSeqLock.hpp) against std::mutex.
+//
+//   stress  TripleBuffer / SeqLock : every snapshot read is complete (no torn values) and never older
+//                                    than the previous one
+//           SpscRing / MpmcRing    : every item arrives exactly once, in per-producer order, and
+//                                    every constructed T is destroyed
+//   bench   writer cost            : time of one Store/Publish/push on the writer (RT) side while
+//                                    readers are busy (p50 / p99 / max), the number that matters for RT
+//           handoff latency        : time from the writer's publish to the reader seeing it
+//           queue throughput       : items/s through each ring vs. std::mutex + std::deque
+//
+//   $ ./dt_exchange_bench                 # stress + bench, 1 s per case
+//   $ ./dt_exchange_bench -m stress -d 10 # longer stress only
+//
+// Run it on at least 2 CPUs; on a single CPU the numbers only show scheduler switches.
+
+namespace
+{
+
+struct BenchConfig
+{
+    bool   stress     = true;
+    bool   bench      = true;
+    double duration_s = 1.0;
+    int    producers  = 2;
+    int    consumers  = 2;
+};
+
+BenchConfig g_cfg;
+int g_failures = 0;
+
+void Check(bool ok, const char *name, const char *what)
+{
+    printf("  %-28s %s%s%s\n", name, ok ? "ok" : "FAILED", ok ? "" : ": ", ok ? "" : what);
+    if (!ok) g_failures++;
+}
+
+// 128 byte snapshot whose fields all derive from 'seq': a torn read breaks the relation
+struct Snapshot
+{
+    uint64_t seq;
+    uint64_t v[15];
+
+    void Fill(uint64_t s)
+    {
+        seq = s;
+        for (int i = 0; i < 15; ++i) v[i] = s * 2654435761ULL + (uint64_t)i;
+    }
+    bool Valid() const
+    {
+        for (int i = 0; i < 15; ++i)
+        {
+            if (v[i] != seq * 2654435761ULL + (uint64_t)i) return false;
+        }
+        return true;
+    }
+};
+
+// payload with a heap member and a live-instance counter: checks construct/destroy pairing
+std::atomic<long> g_live{0};
+struct Item
+{
+    uint32_t producer = 0;
+    uint64_t seq = 0;
+    std::string tag;
+
+    Item() { g_live++; }
+    Item(uint32_t p, uint64_t s) : producer(p), seq(s), tag("item-with-heap-storage-" + std::to_string(s)) { g_live++; }
+    Item(const Item &o) : producer(o.producer), seq(o.seq), tag(o.tag) { g_live++; }
+    Item(Item &&o) noexcept : producer(o.producer), seq(o.seq), tag(std::move(o.tag)) { g_live++; }
+    Item &operator=(const Item &) = default;
+    Item &operator=(Item &&) noexcept = default;
+    ~Item() { g_live--; }
+};
+
+struct Stats
+{
+    std::vector<int64_t> samples;
+    void Add(int64_t ns) { samples.push_back(ns); }
+    void Print(const char *name)
+    {
+        if (samples.empty())
+        {
+            printf("  %-28s (no samples)\n", name);
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto pct = [this](double p) { return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))]; };
+        printf("  %-28s p50 %7lld  p99 %7lld  p99.9 %8lld  max %9lld ns  (n=%zu)\n", name, (long long)pct(0.5),
+               (long long)pct(0.99), (long long)pct(0.999), (long long)samples.back(), samples.size());
+    }
+};
+
+// Snapshot exchanges with one interface for the stress/bench templates ---------------
+struct TripleBufferX
+{
+    static constexpr const char *name = "TripleBuffer";
+    dt::Utils::TripleBuffer<Snapshot> tb;
+    void Store(const Snapshot &s) { tb.Write(s); }
+    bool Load(Snapshot &s) { tb.Read(s); return true; }
+    static constexpr bool multiReader = false;
+};
+
+struct SeqLockX
+{
+    static constexpr const char *name = "SeqLock";
+    dt::Utils::SeqLock<Snapshot> sl;
+    void Store(const Snapshot &s) { sl.Store(s); }
+    bool Load(Snapshot &s) { return sl.TryLoad(s, 1 << 20); }
+    static constexpr bool multiReader = true;
+};
+
+struct MutexX
+{
+    static constexpr const char *name = "std::mutex";
+    std::mutex mtx;
+    Snapshot data{};
+    void Store(const Snapshot &s) { std::lock_guard<std::mutex> lock(mtx); data = s; }
+    bool Load(Snapshot &s) { std::lock_guard<std::mutex> lock(mtx); s = data; return true; }
+    static constexpr bool multiReader = true;
+};
+
+template <typename X>
+void StressSnapshot()
+{
+    X x;
+    Snapshot init;
+    init.Fill(0);
+    x.Store(init);
+
+    std::atomic<bool> run{true};
+    std::atomic<bool> torn{false}, backwards{false};
+    std::atomic<uint64_t> reads{0};
+    const int readers = X::multiReader ? 3 : 1;
+    std::vector<std::thread> th;
+    for (int r = 0; r < readers; ++r)
+    {
+        th.emplace_back([&]() {
+            uint64_t last = 0, n = 0;
+            Snapshot s;
+            while (run.load(std::memory_order_relaxed))
+            {
+                if (!x.Load(s)) continue;
+                if (!s.Valid()) torn = true;
+                if (s.seq < last) backwards = true;
+                last = s.seq;
+                n++;
+            }
+            reads += n;
+        });
+    }
+    uint64_t seq = 0;
+    const int64_t end = dt::Utils::MonotonicNs() + (int64_t)(g_cfg.duration_s * 1e9);
+    Snapshot s;
+    while (dt::Utils::MonotonicNs() < end)
+    {
+        s.Fill(++seq);
+        x.Store(s);
+    }
+    run = false;
+    for (auto &t : th) t.join();
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s (%llu w, %llu r)", X::name, (unsigned long long)seq, (unsigned long long)reads.load());
+    Check(!torn && !backwards, name, torn ? "torn snapshot" : "snapshot went backwards");
+}
+
+template <typename Ring>
+void StressRing(const char *ringName, int producers, int consumers)
+{
+    Ring ring;
+    ring.Allocate(1024);
+    const long live0 = g_live.load();
+    std::atomic<bool> producing{true};
+    std::atomic<bool> orderErr{false};
+    std::vector<uint64_t> pushed(producers, 0);
+    std::vector<std::vector<uint64_t>> seen(consumers, std::vector<uint64_t>(producers, 0)); // last seq + 1
+    std::vector<std::vector<uint64_t>> count(consumers, std::vector<uint64_t>(producers, 0));
+
+    std::vector<std::thread> th;
+    for (int c = 0; c < consumers; ++c)
+    {
+        th.emplace_back([&, c]() {
+            Item item;
+            for (;;)
+            {
+                // read the flag first: a failed pop after the producers finished means empty
+                const bool done = !producing.load();
+                if (!ring.TryPop(item))
+                {
+                    if (done) break;
+                    continue;
+                }
+                // one producer's items must leave in the order they entered
+                if (item.seq + 1 <= seen[c][item.producer]) orderErr = true;
+                if (item.tag != "item-with-heap-storage-" + std::to_string(item.seq)) orderErr = true;
+                seen[c][item.producer] = item.seq + 1;
+                count[c][item.producer]++;
+            }
+        });
+    }
+    const int64_t end = dt::Utils::MonotonicNs() + (int64_t)(g_cfg.duration_s * 1e9);
+    std::vector<std::thread> prod;
+    for (int p = 0; p < producers; ++p)
+    {
+        prod.emplace_back([&, p]() {
+            uint64_t seq = 0;
+            while (dt::Utils::MonotonicNs() < end)
+            {
+                for (int k = 0; k < 64; ++k)
+                {
+                    if (ring.TryEmplace((uint32_t)p, seq)) seq++;
+                }
+            }
+            pushed[p] = seq;
+        });
+    }
+    for (auto &t : prod) t.join();
+    producing = false;
+    for (auto &t : th) t.join();
+
+    bool countOk = true;
+    uint64_t total = 0;
+    for (int p = 0; p < producers; ++p)
+    {
+        uint64_t got = 0;
+        for (int c = 0; c < consumers; ++c) got += count[c][p];
+        countOk &= (got == pushed[p]);
+        total += pushed[p];
+    }
+    ring.Release();
+    char name[64];
+    snprintf(name, sizeof(name), "%s %dP%dC (%llu items)", ringName, producers, consumers, (unsigned long long)total);
+    Check(!orderErr && countOk && g_live.load() == live0, name,
+          orderErr ? "out of order / corrupted item" : (!countOk ? "lost or duplicated items" : "T leaked"));
+}
+
+// writer-side cost and handoff latency ---------------------------------------------
+template <typename X>
+void BenchSnapshot()
+{
+    X x;
+    std::atomic<bool> run{true};
+    Stats handoff;
+    handoff.samples.reserve(1 << 20);
+    std::thread reader([&]() {
+        Snapshot s;
+        uint64_t last = 0;
+        while (run.load(std::memory_order_relaxed))
+        {
+            if (!x.Load(s) || s.seq == last) continue;
+            last = s.seq;
+            if (handoff.samples.size() < (1 << 20)) handoff.Add(dt::Utils::MonotonicNs() - (int64_t)s.v[0]);
+        }
+    });
+
+    Stats writer;
+    writer.samples.reserve(1 << 20);
+    const int64_t end = dt::Utils::MonotonicNs() + (int64_t)(g_cfg.duration_s * 1e9);
+    Snapshot s{};
+    for (uint64_t seq = 1; dt::Utils::MonotonicNs() < end; ++seq)
+    {
+        s.seq = seq;
+        const int64_t t0 = dt::Utils::MonotonicNs();
+        s.v[0] = (uint64_t)t0;
+        x.Store(s);
+        const int64_t t1 = dt::Utils::MonotonicNs();
+        if (writer.samples.size() < (1 << 20)) writer.Add(t1 - t0);
+        while (dt::Utils::MonotonicNs() - t1 < 2000) {} // ~500 kHz, leaves the reader time to see each value
+    }
+    run = false;
+    reader.join();
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s store", X::name);
+    writer.Print(name);
+    snprintf(name, sizeof(name), "%s handoff", X::name);
+    handoff.Print(name);
+}
+
+struct MutexDeque
+{
+    std::mutex mtx;
+    std::deque<Item> q;
+    size_t cap = 1024;
+    void Allocate(size_t c) { cap = c; }
+    void Release() { q.clear(); }
+    template <typename... Args>
+    bool TryEmplace(Args &&...args)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (q.size() >= cap) return false;
+        q.emplace_back(std::forward<Args>(args)...);
+        return true;
+    }
+    bool TryPop(Item &out)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (q.empty()) return false;
+        out = std::move(q.front());
+        q.pop_front();
+        return true;
+    }
+};
+
+template <typename Ring>
+void BenchRing(const char *ringName, int producers, int consumers)
+{
+    Ring ring;
+    ring.Allocate(1024);
+    std::atomic<bool> run{true};
+    std::atomic<uint64_t> popped{0};
+    std::vector<Stats> push(producers);
+    std::vector<std::thread> th;
+    for (int c = 0; c < consumers; ++c)
+    {
+        th.emplace_back([&]() {
+            Item item;
+            uint64_t n = 0;
+            while (run.load(std::memory_order_relaxed))
+            {
+                if (ring.TryPop(item)) n++;
+            }
+            while (ring.TryPop(item)) n++;
+            popped += n;
+        });
+    }
+    const int64_t start = dt::Utils::MonotonicNs();
+    const int64_t end = start + (int64_t)(g_cfg.duration_s * 1e9);
+    std::vector<std::thread> prod;
+    for (int p = 0; p < producers; ++p)
+    {
+        prod.emplace_back([&, p]() {
+            push[p].samples.reserve(1 << 20);
+            uint64_t seq = 0;
+            while (dt::Utils::MonotonicNs() < end)
+            {
+                const int64_t t0 = dt::Utils::MonotonicNs();
+                const bool ok = ring.TryEmplace((uint32_t)p, seq);
+                const int64_t t1 = dt::Utils::MonotonicNs();
+                if (ok)
+                {
+                    seq++;
+                    if (push[p].samples.size() < (1 << 20)) push[p].Add(t1 - t0);
+                }
+            }
+        });
+    }
+    for (auto &t : prod) t.join();
+    run = false;
+    for (auto &t : th) t.join();
+    const double sec = (dt::Utils::MonotonicNs() - start) * 1e-9;
+
+    Stats all;
+    for (auto &p : push) all.samples.insert(all.samples.end(), p.samples.begin(), p.samples.end());
+    char name[64];
+    snprintf(name, sizeof(name), "%s %dP%dC push", ringName, producers, consumers);
+    all.Print(name);
+    printf("  %-28s %.2f M items/s\n", "", popped.load() / sec * 1e-6);
+    ring.Release();
+}
+
+void Usage(const char *prog)
+{
+    printf("usage: %s [options]\n"
+           "  -m, --mode MODE       stress | bench | all (default all)\n"
+           "  -d, --duration SEC    seconds per case (default 1)\n"
+           "  -p, --producers N     producers of the MPMC cases (default 2)\n"
+           "  -c, --consumers N     consumers of the MPMC cases (default 2)\n",
+           prog);
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"mode", required_argument, nullptr, 'm'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"producers", required_argument, nullptr, 'p'},
+        {"consumers", required_argument, nullptr, 'c'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int c;
+    while ((c = getopt_long(argc, argv, "m:d:p:c:h", opts, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'm':
+            g_cfg.stress = !strcmp(optarg, "stress") || !strcmp(optarg, "all");
+            g_cfg.bench = !strcmp(optarg, "bench") || !strcmp(optarg, "all");
+            if (!g_cfg.stress && !g_cfg.bench)
+            {
+                fprintf(stderr, "invalid mode '%s'\n", optarg);
+                return false;
+            }
+            break;
+        case 'd': g_cfg.duration_s = atof(optarg); break;
+        case 'p': g_cfg.producers = atoi(optarg); break;
+        case 'c': g_cfg.consumers = atoi(optarg); break;
+        default: Usage(argv[0]); return false;
+        }
+    }
+    if (g_cfg.duration_s <= 0 || g_cfg.producers < 1 || g_cfg.consumers < 1)
+    {
+        fprintf(stderr, "invalid duration / thread count\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        return 1;
+    }
+    printf("dt_exchange_bench: %u CPUs, %.1f s per case\n", std::thread::hardware_concurrency(), g_cfg.duration_s);
+
+    if (g_cfg.stress)
+    {
+        printf("\n[stress]\n");
+        StressSnapshot<TripleBufferX>();
+        StressSnapshot<SeqLockX>();
+        StressRing<dt::Utils::SpscRing<Item>>("SpscRing", 1, 1);
+        StressRing<dt::Utils::MpmcRing<Item>>("MpmcRing", 1, 1);
+        StressRing<dt::Utils::MpmcRing<Item>>("MpmcRing", g_cfg.producers, g_cfg.consumers);
+    }
+
+    if (g_cfg.bench)
+    {
+        printf("\n[snapshot: writer cost / handoff latency]\n");
+        BenchSnapshot<TripleBufferX>();
+        BenchSnapshot<SeqLockX>();
+        BenchSnapshot<MutexX>();
+
+        printf("\n[queue: push cost / throughput]\n");
+        BenchRing<dt::Utils::SpscRing<Item>>("SpscRing", 1, 1);
+        BenchRing<dt::Utils::MpmcRing<Item>>("MpmcRing", 1, 1);
+        BenchRing<MutexDeque>("mutex+deque", 1, 1);
+        BenchRing<dt::Utils::MpmcRing<Item>>("MpmcRing", g_cfg.producers, g_cfg.consumers);
+        BenchRing<MutexDeque>("mutex+deque", g_cfg.producers, g_cfg.consumers);
+    }
+
+    printf("\n%s\n", g_failures ? "FAILED" : "all ok");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+#include <dtCore/dtLog>
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtProfiler.h>
+#include <dtCore/src/dtUtils/dtTimeCheck.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+// example_utils_profiler: DT_PROFILE_SCOPE zones in a 1 kHz loop, reported once a second
+//  1. cost of an empty zone (enabled / disabled) compared with TimeCheck Start() / Stop()
+//  2. a periodic thread with nested zones ("cycle" > "sense", "plan", "act")
+//  3. a CoScheduler job that prints the report through RtLog and writes profile.json,
+//     one interval per report (reset)
+
+namespace
+{
+volatile double g_sink = 0;
+
+void Work(int n)
+{
+    double x = 0;
+    for (int i = 0; i < n; ++i) x += std::sqrt((double)i);
+    g_sink = x;
+}
+
+void Empty() { DT_PROFILE_SCOPE("empty"); }
+void Sense() { DT_PROFILE_FUNCTION(); Work(200); }
+void Act()   { DT_PROFILE_FUNCTION(); Work(50); }
+void Plan(uint64_t cycle)
+{
+    DT_PROFILE_SCOPE("plan");
+    Work(cycle % 100 == 0 ? 5000 : 500); // a slow cycle every 100: see p99 / max
+}
+
+template <typename F>
+double NsPerCall(F f)
+{
+    constexpr int N = 1000000;
+    dt::Utils::TimeCheck tc;
+    tc.Start();
+    for (int i = 0; i < N; ++i) f();
+    tc.Stop();
+    return (double)tc.GetElapsedTime_nsec() / N;
+}
+} // namespace
+
+int main()
+{
+    dt::Log::Initialize("example_utils_profiler");
+
+    // 1. overhead
+    const double empty = NsPerCall(Empty);
+    dt::Utils::ProfileSetZoneEnabled("empty", false);
+    const double disabled = NsPerCall(Empty);
+    dt::Utils::TimeCheck inner;
+    const double timecheck = NsPerCall([&inner] { inner.Start(); inner.Stop(); });
+    printf("clock %s (%.3f ns/tick): zone %.1f ns, disabled zone %.1f ns, TimeCheck %.1f ns\n",
+           dt::Utils::ProfileClock::Source(), dt::Utils::ProfileClock::NsPerTick(), empty, disabled, timecheck);
+    dt::Utils::ProfilerReset();
+
+    // 2. control loop
+    std::atomic<uint64_t> cycles{0};
+    dt::Thread::ThreadInfo th;
+    th.name = "ctrl";
+    th.cpuIdx = dt::Thread::CPU_AUTO;
+    th.priority = 80;
+    dt::Thread::PeriodicConfig cfg;
+    cfg.period_ns = 1000000;
+    auto cycle = [&](uint64_t n) {
+        if (n == 0)
+        {
+            dt::Utils::ProfilerRegisterThread();
+        }
+        {
+            DT_PROFILE_SCOPE("cycle");
+            Sense();
+            Plan(n);
+            Act();
+        }
+        cycles.store(n + 1, std::memory_order_release);
+        return n < 2999;
+    };
+    if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+    {
+        cfg.realtime = false;
+        th.priority = 0;
+        if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+        {
+            fprintf(stderr, "cannot create the periodic thread\n");
+            return 1;
+        }
+    }
+
+    // 3. report job
+    dt::Thread::CoSchedulerConfig scfg;
+    scfg.name = "report";
+    dt::Thread::CoScheduler sched(scfg);
+    sched.Every("profile", 1000000000, [] {
+        dt::Utils::ProfileReportConfig rc;
+        rc.jsonFile = "profile.json";
+        rc.reset = true;
+        dt::Utils::ProfileReport(rc);
+        return true;
+    });
+    sched.Start();
+
+    while (cycles.load(std::memory_order_acquire) < 3000)
+    {
+        dt::Thread::SleepForMillis(10);
+    }
+    dt::Thread::SleepForMillis(100);
+    sched.Stop();
+    dt::Thread::DeleteAllThread();
+    dt::Log::Terminate();
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtRcu.h>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// example_utils_rcu: sharing data between a 1 kHz RT loop and non-RT writers with dtRcu.h
+//  - RcuPtr<Gains>: a writer thread replaces the gain table every 2 ms (copy, modify, publish)
+//  - RcuList<shared_ptr<Observer>>: another thread attaches / detaches observers the RT loop calls
+// The RT loop checks every table it reads (all entries from the same version, never a deleted
+// one) and measures the cost of its read sections. Old versions are deleted on the writers.
+
+namespace
+{
+constexpr int NUM_GAINS = 64;
+std::atomic<int> g_liveTables{0};
+
+struct Gains
+{
+    uint64_t version = 0;
+    double kp[NUM_GAINS] = {};
+    bool alive = true;
+
+    Gains() { g_liveTables.fetch_add(1, std::memory_order_relaxed); }
+    Gains(const Gains &o) : version(o.version), alive(true)
+    {
+        std::copy(o.kp, o.kp + NUM_GAINS, kp);
+        g_liveTables.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~Gains()
+    {
+        alive = false; // a reader seeing this read a deleted version
+        g_liveTables.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+struct Observer
+{
+    std::atomic<uint64_t> calls{0};
+    void OnCycle(uint64_t) { calls.fetch_add(1, std::memory_order_relaxed); }
+};
+} // namespace
+
+int main()
+{
+    dt::Utils::RcuPtr<Gains> gains(new Gains());
+    dt::Utils::RcuList<std::shared_ptr<Observer>> observers;
+
+    std::atomic<uint64_t> cycles{0}, torn{0}, dead{0}, versions{0};
+    int64_t maxRead_ns = 0, sumRead_ns = 0;
+
+    dt::Thread::ThreadInfo th;
+    th.name = "ctrl";
+    th.cpuIdx = dt::Thread::CPU_AUTO;
+    th.priority = 80;
+    dt::Thread::PeriodicConfig cfg;
+    cfg.period_ns = 1000000;
+    uint64_t lastVersion = 0;
+    auto cycle = [&](uint64_t n) {
+        if (n == 0)
+        {
+            dt::Utils::RcuRegisterThread(); // claim the reader slot before the first RT cycle
+        }
+        const int64_t t0 = dt::Utils::MonotonicNs();
+        {
+            dt::Utils::RcuReadGuard guard;
+            const Gains *g = gains.Read();
+            double sum = 0;
+            for (int i = 0; i < NUM_GAINS; ++i)
+            {
+                sum += g->kp[i];
+            }
+            if (sum != (double)g->version * NUM_GAINS) torn.fetch_add(1, std::memory_order_relaxed);
+            if (!g->alive) dead.fetch_add(1, std::memory_order_relaxed);
+            if (g->version != lastVersion)
+            {
+                lastVersion = g->version;
+                versions.fetch_add(1, std::memory_order_relaxed);
+            }
+            for (const auto &o : observers.Read())
+            {
+                o->OnCycle(n);
+            }
+        }
+        const int64_t dt_ns = dt::Utils::MonotonicNs() - t0;
+        maxRead_ns = std::max(maxRead_ns, dt_ns);
+        sumRead_ns += dt_ns;
+        cycles.store(n + 1, std::memory_order_release);
+        return n < 1999;
+    };
+    if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+    {
+        cfg.realtime = false;
+        th.priority = 0;
+        if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+        {
+            fprintf(stderr, "cannot create the periodic thread\n");
+            return 1;
+        }
+    }
+
+    std::atomic<bool> run{true};
+    std::thread writer([&] {
+        for (uint64_t v = 1; run.load(std::memory_order_acquire); ++v)
+        {
+            gains.Update([v](Gains &next) {
+                next.version = v;
+                std::fill(next.kp, next.kp + NUM_GAINS, (double)v);
+            });
+            dt::Thread::SleepForMillis(2);
+        }
+    });
+    auto kept = std::make_shared<Observer>();
+    observers.Append(kept);
+    std::thread attacher([&] {
+        while (run.load(std::memory_order_acquire))
+        {
+            auto tmp = std::make_shared<Observer>();
+            observers.Append(tmp);
+            dt::Thread::SleepForMillis(3);
+            observers.Remove(tmp); // freed here or by a later reclaim, never on the RT thread
+        }
+    });
+
+    while (cycles.load(std::memory_order_acquire) < 2000)
+    {
+        dt::Thread::SleepForMillis(10);
+    }
+    run.store(false, std::memory_order_release);
+    writer.join();
+    attacher.join();
+    dt::Thread::DeleteThread(th);
+    dt::Utils::RcuSynchronize();
+
+    dt::Utils::RcuStats s;
+    dt::Utils::GetRcuStats(s);
+    printf("%llu cycles (%s): %llu versions seen, %llu torn, %llu deleted reads\n",
+           (unsigned long long)cycles.load(), cfg.realtime ? "SCHED_FIFO" : "SCHED_OTHER",
+           (unsigned long long)versions.load(), (unsigned long long)torn.load(), (unsigned long long)dead.load());
+    printf("read section: avg %.0f ns, max %lld ns; observer calls %llu\n",
+           (double)sumRead_ns / (double)cycles.load(), (long long)maxRead_ns, (unsigned long long)kept->calls.load());
+    printf("rcu: epoch %llu, retired %llu, reclaimed %llu, pending %llu, live tables %d\n",
+           (unsigned long long)s.epoch, (unsigned long long)s.retired, (unsigned long long)s.reclaimed,
+           (unsigned long long)s.pending, g_liveTables.load());
+    return 0;
+}
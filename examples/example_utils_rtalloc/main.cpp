@@ -0,0 +1,167 @@
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtRtAlloc.h>
+#include <dtCore/src/dtUtils/dtTimeUtil.hpp>
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+// example_utils_rtalloc: RT memory with dtRtAlloc.h
+//  1. cost of malloc/free vs. RtBlockPool (thread cache) vs. RtArena
+//  2. std containers on RtPoolSet / RtArena allocators
+//  3. a 1 kHz periodic loop that must not touch the heap. With a library built with
+//     -DBUILD_dtCore_RT_ALLOC_TRAP=ON, the deliberate std::string allocation of cycle 50
+//     ('-l' option) is reported with a backtrace.
+//
+//   $ ./example_utils_rtalloc        # allocation-free cycle
+//   $ ./example_utils_rtalloc -l     # one heap allocation in cycle 50
+
+namespace
+{
+using PoolString = std::basic_string<char, std::char_traits<char>, dt::Utils::RtPoolAllocator<char>>;
+template <typename T>
+using ArenaVector = std::vector<T, dt::Utils::RtArenaAllocator<T>>;
+
+void BenchAlloc(dt::Utils::RtBlockPool &pool, dt::Utils::RtArena &arena)
+{
+    constexpr int N = 64;       // live blocks per round
+    constexpr int ROUNDS = 20000;
+    void *ptrs[N];
+
+    int64_t t0 = dt::Utils::MonotonicNs();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        for (int i = 0; i < N; ++i) ptrs[i] = malloc(64);
+        for (int i = 0; i < N; ++i) free(ptrs[i]);
+    }
+    const double mallocNs = (double)(dt::Utils::MonotonicNs() - t0) / (ROUNDS * N);
+
+    pool.WarmUp();
+    t0 = dt::Utils::MonotonicNs();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        for (int i = 0; i < N; ++i) ptrs[i] = pool.Alloc();
+        for (int i = 0; i < N; ++i) pool.Free(ptrs[i]);
+    }
+    const double poolNs = (double)(dt::Utils::MonotonicNs() - t0) / (ROUNDS * N);
+
+    t0 = dt::Utils::MonotonicNs();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        for (int i = 0; i < N; ++i) ptrs[i] = arena.Alloc(64);
+        arena.Reset();
+    }
+    const double arenaNs = (double)(dt::Utils::MonotonicNs() - t0) / (ROUNDS * N);
+
+    printf("alloc + free of 64 B (ns/op): malloc %.1f, RtBlockPool %.1f, RtArena %.1f\n", mallocNs, poolNs, arenaNs);
+}
+
+void Containers(dt::Utils::RtPoolSet &pools, dt::Utils::RtArena &arena)
+{
+    {
+        PoolString s{dt::Utils::RtPoolAllocator<char>(pools)};
+        s.assign("joint_state/arm_left/position"); // longer than the SSO buffer: taken from the pool
+        s += "/filtered";
+        std::list<int, dt::Utils::RtPoolAllocator<int>> lst{dt::Utils::RtPoolAllocator<int>(pools)};
+        for (int i = 0; i < 100; ++i) lst.push_back(i);
+        printf("pool string '%s', list of %zu nodes, all from the pools: %s\n", s.c_str(), lst.size(),
+               pools.Owns(s.data()) ? "yes" : "no");
+    }
+
+    const size_t mark = arena.Mark();
+    {
+        ArenaVector<double> v{dt::Utils::RtArenaAllocator<double>(arena)};
+        v.reserve(256);
+        for (int i = 0; i < 256; ++i) v.push_back(i * 0.5);
+        printf("arena vector of %zu doubles, arena used %zu / %zu bytes\n", v.size(), arena.Used(), arena.Capacity());
+    }
+    arena.Rewind(mark);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const bool leak = (argc > 1 && std::string(argv[1]) == "-l");
+
+    // nonRT init: map, prefault and lock everything the cycle will use
+    dt::Utils::RtMemOptions opt;
+    opt.lockMemory = true;
+    dt::Utils::RtPoolSet pools;
+    dt::Utils::RtBlockPool pool;
+    dt::Utils::RtArena arena;
+    if (!pools.Allocate(256, opt) || !pool.Allocate(64, 1024, opt) || !arena.Allocate(64 * 1024, opt))
+    {
+        fprintf(stderr, "cannot map RT memory\n");
+        return 1;
+    }
+    printf("pools: %d classes up to %zu B, mlock %s\n", pools.ClassCount(), pools.MaxSize(),
+           pool.IsLocked() ? "ok" : "failed (RLIMIT_MEMLOCK)");
+
+    BenchAlloc(pool, arena);
+    Containers(pools, arena);
+
+    // RT cycle ------------------------------------------------------------------------
+    printf("RT allocation trap: %s\n", dt::Utils::RtAllocTrapCompiled() ? "compiled in" : "not compiled (BUILD_dtCore_RT_ALLOC_TRAP=OFF)");
+    dt::Utils::SetRtAllocTrapAction(dt::Utils::RtAllocTrapAction::Report);
+    dt::Utils::ResetRtAllocTrapStats();
+
+    size_t maxUsed = 0;
+    std::string lastMessage;
+    std::atomic<uint64_t> cycles{0};
+    dt::Thread::ThreadInfo th;
+    th.name = "ctrl";
+    th.cpuIdx = dt::Thread::CPU_AUTO;
+    th.priority = 80;
+    dt::Thread::PeriodicConfig cfg;
+    cfg.period_ns = 1000000;
+    auto cycle = [&](uint64_t n) {
+        if (n == 0)
+        {
+            dt::Utils::RtAllocAllowed init; // first cycle: fill this thread's pool caches
+            pools.WarmUp();
+        }
+        dt::Utils::RtSection rt; // periodic RT threads are already marked; also covers the SCHED_OTHER fallback
+
+        arena.Reset();
+        ArenaVector<float> torque{dt::Utils::RtArenaAllocator<float>(arena)};
+        torque.resize(32, 0.0f);
+        PoolString topic{dt::Utils::RtPoolAllocator<char>(pools)};
+        topic.assign("ctrl/torque/command/joint_0123456789");
+        if (leak && n == 50)
+        {
+            lastMessage.assign(100, 'x'); // std::string grows on the heap: trapped
+        }
+        maxUsed = std::max(maxUsed, arena.Used());
+        cycles.store(n + 1, std::memory_order_release);
+        return n < 99;
+    };
+    if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+    {
+        cfg.realtime = false;
+        th.priority = 0;
+        if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+        {
+            fprintf(stderr, "cannot create the periodic thread\n");
+            return 1;
+        }
+    }
+    while (cycles.load(std::memory_order_acquire) < 100)
+    {
+        dt::Thread::SleepForMillis(10);
+    }
+    dt::Thread::DeleteThread(th);
+
+    dt::Utils::RtAllocTrapStats stats;
+    dt::Utils::GetRtAllocTrapStats(stats);
+    printf("100 cycles (%s): arena high water %zu B, heap allocations on the RT path %llu, frees %llu\n",
+           cfg.realtime ? "SCHED_FIFO" : "SCHED_OTHER", maxUsed, (unsigned long long)stats.allocs,
+           (unsigned long long)stats.frees);
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <dtCore/dtLog>
+#include <dtCore/dtThread>
+#include <dtCore/src/dtUtils/dtWatchdogBank.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// example_utils_watchdog_bank: heartbeat monitoring of many streams with one WatchdogBank
+//  1. cost of one Check() over 4096 channels (no event)
+//  2. 2000 sensor channels (timeout 20 ms) and 6 task channels (timeout 5 ms) fed by a
+//     producer thread; sensors 0, 100, ... pause from 1.0 s to 1.5 s and task_3 stalls at 2.0 s.
+//     A 1 kHz periodic thread runs Check(); events go to RtLog and to a callback.
+
+namespace
+{
+constexpr int NUM_SENSORS = 2000;
+constexpr int NUM_TASKS = 6;
+std::atomic<int> g_expired{0}, g_recovered{0};
+} // namespace
+
+int main()
+{
+    dt::Log::Initialize("example_utils_watchdog_bank");
+
+    // 1. scan cost
+    {
+        dt::Utils::WatchdogBank bench;
+        bench.Allocate(4096);
+        bench.SetLogEvents(false);
+        for (int i = 0; i < 4096; ++i) bench.AddChannel("ch" + std::to_string(i), 1000000000);
+        constexpr int N = 100000;
+        const int64_t t0 = dt::Utils::MonotonicNs();
+        for (int i = 0; i < N; ++i) bench.Check(t0);
+        const int64_t t1 = dt::Utils::MonotonicNs();
+        printf("scan kernel %s: Check() over 4096 channels %.0f ns\n", dt::Utils::WatchdogBank::ScanKernel(),
+               (double)(t1 - t0) / N);
+    }
+
+    // 2. sensors and tasks
+    dt::Utils::WatchdogBank bank;
+    bank.Allocate(NUM_SENSORS + NUM_TASKS);
+    int sensor[NUM_SENSORS], task[NUM_TASKS];
+    for (int i = 0; i < NUM_SENSORS; ++i) sensor[i] = bank.AddChannel("sensor_" + std::to_string(i), 20000000);
+    for (int i = 0; i < NUM_TASKS; ++i) task[i] = bank.AddChannel("task_" + std::to_string(i), 5000000);
+    bank.SetLogEvents(false); // 40 sensors at once: counted in the callback, tasks logged there
+    bank.SetCallback([](const dt::Utils::WatchdogEvent &ev) {
+        (ev.expired ? g_expired : g_recovered).fetch_add(1, std::memory_order_relaxed);
+        if (ev.name[0] == 't')
+        {
+            LOG(warn).printf("%s %s (%.1f ms)", ev.name, ev.expired ? "expired" : "recovered", (double)ev.age_ns * 1e-6);
+        }
+    });
+
+    std::atomic<bool> run{true};
+    std::thread producer([&] {
+        const int64_t start = dt::Utils::MonotonicNs();
+        while (run.load(std::memory_order_acquire))
+        {
+            const int64_t now = dt::Utils::MonotonicNs();
+            const int64_t t = now - start;
+            const bool pause = t > 1000000000 && t < 1500000000;
+            for (int i = 0; i < NUM_SENSORS; ++i)
+            {
+                if (!(pause && i % 100 == 0)) bank.Feed(sensor[i], now);
+            }
+            for (int i = 0; i < NUM_TASKS; ++i)
+            {
+                if (!(i == 3 && t > 2000000000)) bank.Feed(task[i], now);
+            }
+            dt::Thread::SleepForMillis(1);
+        }
+    });
+
+    std::atomic<uint64_t> cycles{0};
+    dt::Thread::ThreadInfo th;
+    th.name = "monitor";
+    th.cpuIdx = dt::Thread::CPU_AUTO;
+    th.priority = 70;
+    dt::Thread::PeriodicConfig cfg;
+    cfg.period_ns = 1000000;
+    auto cycle = [&](uint64_t n) {
+        bank.Check();
+        cycles.store(n + 1, std::memory_order_release);
+        return n < 2499;
+    };
+    if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+    {
+        cfg.realtime = false;
+        th.priority = 0;
+        if (dt::Thread::CreatePeriodicThread(th, cfg, cycle) != 0)
+        {
+            fprintf(stderr, "cannot create the periodic thread\n");
+            return 1;
+        }
+    }
+    while (cycles.load(std::memory_order_acquire) < 2500)
+    {
+        dt::Thread::SleepForMillis(10);
+    }
+    run.store(false, std::memory_order_release);
+    producer.join();
+    dt::Thread::DeleteThread(th);
+
+    dt::Utils::WatchdogBankStats s;
+    bank.GetStats(s);
+    printf("%d channels, %llu checks: %llu expiries, %llu recoveries, %d expired now (%s), scan last %lld ns / max %lld ns\n",
+           s.channels, (unsigned long long)s.checks, (unsigned long long)s.expiries, (unsigned long long)s.recoveries,
+           s.expired, s.expired ? bank.ChannelName(task[3]) : "-", (long long)s.lastScan_ns, (long long)s.maxScan_ns);
+    printf("callback: %d expired, %d recovered\n", g_expired.load(), g_recovered.load());
+    dt::Log::Terminate();
+    return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <thread>
 #include <mutex>
+#include <list>
 #include "dtDataSource.h"
 
 namespace dt
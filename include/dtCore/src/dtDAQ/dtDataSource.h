@@ -16,6 +16,7 @@
 #include <list>
 #include <memory>
 #include "dtDataSink.h"
+#include "../dtUtils/dtRcu.h"
 
 namespace dt
 {
@@ -30,27 +31,27 @@ public:
     {
         if (UpdateData(context))
         {
-            std::lock_guard<std::mutex> lock(_sink_mtx);
+            // RT side: wait-free while sinks are added/removed on other threads
+            dt::Utils::RcuReadGuard guard;
             UpdateSink(context);
         }
     }
     void AppendDataSink(std::shared_ptr<DataSink> sink)
     {
-        std::lock_guard<std::mutex> lock(_sink_mtx);
-        _data_sinks.push_back(sink);
+        _data_sinks.Append(sink);
     }
+    // not from UpdateSink(): waits for running Update() calls so the sink is released here
     void RemoveDataSink(std::shared_ptr<DataSink> sink)
     {
-        std::lock_guard<std::mutex> lock(_sink_mtx);
-        _data_sinks.remove(sink);
+        _data_sinks.Remove(sink);
+        dt::Utils::RcuSynchronize();
     }
 
 protected:
     virtual bool UpdateData(void* context) = 0;
     virtual void UpdateSink(void* context) = 0;
 protected:
-    std::list<std::shared_ptr<DataSink>> _data_sinks;
-    std::mutex _sink_mtx;
+    dt::Utils::RcuList<std::shared_ptr<DataSink>> _data_sinks; // iterate _data_sinks.Read() in UpdateSink
 };
 
 } // namespace DAQ
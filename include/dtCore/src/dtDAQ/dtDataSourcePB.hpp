@@ -27,7 +27,7 @@ protected:
     bool UpdateData(void* context) { UNUSED(context); return false; }
     void UpdateSink(void* context) {
         UNUSED(context);
-        for (const std::shared_ptr<DataSink> &sink : _data_sinks)
+        for (const std::shared_ptr<DataSink> &sink : _data_sinks.Read())
         {
             std::shared_ptr<DataSinkPB<T>> s = std::dynamic_pointer_cast<DataSinkPB<T>>(sink);
             if (s) {
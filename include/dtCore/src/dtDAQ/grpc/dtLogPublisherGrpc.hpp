@@ -0,0 +1,419 @@
+// This file is part of dtCore, a C++ library for robotics software
+// development.
+//
+// This library is commercial and cannot be redistributed, and/or modified
+// WITHOUT ANY ALLOWANCE OR PERMISSION OF Hyundai Motor Company.
+
+#ifndef __DT_DAQ_LOGPUBLISHERGRPC_H__
+#define __DT_DAQ_LOGPUBLISHERGRPC_H__
+
+/** \defgroup dtDAQ
+ *
+ */
+#include <grpc/grpc.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <pthread.h>
+
+#include "dtProto/Service.grpc.pb.h"
+#include "dtProto/std_msgs/Log.pb.h"
+
+#include "../../dtLog/dtRtLog.hpp"
+
+namespace dt
+{
+namespace DAQ
+{
+
+// LogPublisherGrpc — streams RtLog output to remote subscribers (dtService.SubscribeLog)
+//
+// Registered as an RtLogTap, so every drained entry is seen once on the RtLog drain
+// thread and fanned out to the subscribers whose LogFilter (level, logger names, regex)
+// matches. Only matching lines are queued and sent. Each subscriber has its own bounded
+// queue (LogFilter.queue_size, capped at queue_size): while a write is in flight, new entries are queued and the oldest ones are
+// dropped on overflow (reported in LogBatch.dropped). Queued entries are sent in
+// batches of up to batch_size entries per message.
+//
+// RtLog must be initialized before this object is created.
+class LogPublisherGrpc : public Log::RtLogTap
+{
+public:
+    static constexpr uint32_t DEFAULT_QUEUE_SIZE = 1024;
+    static constexpr uint32_t DEFAULT_BATCH_SIZE = 256;
+
+    LogPublisherGrpc(const std::string &server_address, uint32_t queue_size = DEFAULT_QUEUE_SIZE, uint32_t batch_size = DEFAULT_BATCH_SIZE);
+    ~LogPublisherGrpc();
+
+    // Log::RtLogTap (called on the RtLog drain thread)
+    void OnLogLine(Log::LogLevel lvl, int64_t wall_ns, const char *loggerName, const char *msg, size_t msgLen) noexcept override;
+
+protected:
+    void Run();
+    void Stop();
+    bool IsRunning();
+
+    bool AddSession();
+    void RemoveSession(uint64_t session_id);
+
+    class Session {
+    public:
+        Session(LogPublisherGrpc *server, dtproto::dtService::AsyncService *service, grpc::ServerCompletionQueue *cq);
+        Session() = delete;
+        virtual ~Session();
+        virtual void OnCompletionEvent();
+        void OnCompletionError();
+        bool Matches(Log::LogLevel lvl, const char *loggerName, const char *msg, size_t msgLen) const;
+        void Publish(const dtproto::std_msgs::LogEntry &entry);
+        uint64_t GetId();
+        void TryCancelCallAndShutdown();
+
+    protected:
+        uint64_t _id;
+        LogPublisherGrpc *_server;
+        dtproto::dtService::AsyncService* _service;
+        grpc::ServerCompletionQueue* _cq;
+        grpc::ServerContext _ctx;
+        std::mutex _proc_mtx;
+
+        enum class CallState {
+            WAIT_CONNECT,
+            READY_TO_WRITE,
+            WAIT_WRITE_DONE,
+            WAIT_FINISH,
+            FINISHED,
+            PEER_DISCONNECTED
+        };
+        CallState _call_state;
+
+        // filter — fixed once the call is accepted
+        dtproto::std_msgs::LogFilter _request;
+        std::atomic<bool> _active{false};
+        int _min_level{0};
+        std::vector<std::string> _logger_names;
+        bool _has_regex{false};
+        std::regex _regex;
+        uint32_t _queue_size{DEFAULT_QUEUE_SIZE};
+
+        grpc::ServerAsyncWriter<dtproto::std_msgs::LogBatch> _responder;
+        dtproto::std_msgs::LogBatch _msg;
+        std::deque<dtproto::std_msgs::LogEntry> _msg_queue{};
+        uint64_t _dropped{0};
+
+        bool Accept();
+        void WriteQueued();
+
+    public:
+        static uint64_t AllocSessionId();
+    };
+
+    friend class Session;
+
+protected:
+    std::string _server_address;
+    std::unique_ptr<grpc::Server> _server;
+    std::unique_ptr<grpc::ServerCompletionQueue> _cq;
+    dtproto::dtService::AsyncService _service;
+    std::atomic<bool> _running {false};
+    pthread_t _rpc_thread{};
+    std::mutex _session_mtx;
+    std::unordered_map<uint64_t, std::shared_ptr<Session> > _sessions;
+    uint32_t _msg_queue_size;
+    uint32_t _batch_size;
+    bool _tap_registered{false};
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Implementation of LogPublisherGrpc::Session
+//
+inline uint64_t LogPublisherGrpc::Session::AllocSessionId()
+{
+    static std::atomic<uint64_t> _session_id_allocator{0};
+    return (++_session_id_allocator);
+}
+
+inline LogPublisherGrpc::Session::Session(LogPublisherGrpc *server, dtproto::dtService::AsyncService *service, grpc::ServerCompletionQueue *cq)
+    : _server(server), _service(service), _cq(cq), _call_state(CallState::WAIT_CONNECT), _responder(&_ctx)
+{
+    _id = AllocSessionId();
+    _service->RequestSubscribeLog(&_ctx, &_request, &_responder, _cq, _cq, this);
+}
+
+inline LogPublisherGrpc::Session::~Session()
+{
+}
+
+// Compile the subscriber's filter. Returns false (and finishes the call) on an invalid regex.
+inline bool LogPublisherGrpc::Session::Accept()
+{
+    _min_level = static_cast<int>(_request.min_level());
+    _logger_names.assign(_request.logger_names().begin(), _request.logger_names().end());
+    // a subscriber may ask for a smaller queue, never a larger one than the server allows
+    _queue_size = (_request.queue_size() > 0) ? std::min(_request.queue_size(), _server->_msg_queue_size) : _server->_msg_queue_size;
+
+    if (!_request.regex().empty())
+    {
+        try
+        {
+            _regex     = std::regex(_request.regex(), std::regex::ECMAScript | std::regex::optimize);
+            _has_regex = true;
+        }
+        catch (const std::regex_error &e)
+        {
+            _call_state = CallState::WAIT_FINISH;
+            _responder.Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, std::string("invalid regex: ") + e.what()), this);
+            return false;
+        }
+    }
+
+    _call_state = CallState::READY_TO_WRITE;
+    _active.store(true, std::memory_order_release);
+    return true;
+}
+
+inline void LogPublisherGrpc::Session::OnCompletionEvent()
+{
+    if (_call_state == CallState::WAIT_CONNECT) {
+        _server->AddSession();  // wait for the next SubscribeLog() call
+        std::lock_guard<std::mutex> lock(_proc_mtx);
+        Accept();
+    }
+    else if (_call_state == CallState::WAIT_WRITE_DONE) {
+        std::lock_guard<std::mutex> lock(_proc_mtx);
+        if (!_msg_queue.empty()) {
+            WriteQueued();
+        }
+        else {
+            _call_state = CallState::READY_TO_WRITE;
+        }
+    }
+    else if (_call_state == CallState::WAIT_FINISH) {
+        _server->RemoveSession(_id);
+    }
+}
+
+// Write failed or the call was cancelled: the peer is gone.
+inline void LogPublisherGrpc::Session::OnCompletionError()
+{
+    bool connected = (_call_state != CallState::WAIT_CONNECT);
+    TryCancelCallAndShutdown();
+    if (connected && _server->IsRunning()) {
+        _server->RemoveSession(_id);
+    }
+}
+
+// Drain thread. Filter fields are immutable once _active is set.
+inline bool LogPublisherGrpc::Session::Matches(Log::LogLevel lvl, const char *loggerName, const char *msg, size_t msgLen) const
+{
+    if (!_active.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (static_cast<int>(lvl) < _min_level) {
+        return false;
+    }
+    if (!_logger_names.empty() &&
+        std::find(_logger_names.begin(), _logger_names.end(), loggerName) == _logger_names.end()) {
+        return false;
+    }
+    if (_has_regex && !std::regex_search(msg, msg + msgLen, _regex)) {
+        return false;
+    }
+    return true;
+}
+
+// Move up to batch_size queued entries into one LogBatch and start the write. Called with _proc_mtx held.
+inline void LogPublisherGrpc::Session::WriteQueued()
+{
+    _msg.Clear();
+    size_t n = std::min<size_t>(_msg_queue.size(), _server->_batch_size);
+    for (size_t i = 0; i < n; ++i) {
+        _msg.add_entries()->Swap(&_msg_queue.front());
+        _msg_queue.pop_front();
+    }
+    _msg.set_dropped(_dropped);
+    _call_state = CallState::WAIT_WRITE_DONE;
+    _responder.Write(_msg, this);
+}
+
+inline void LogPublisherGrpc::Session::Publish(const dtproto::std_msgs::LogEntry &entry)
+{
+    std::lock_guard<std::mutex> lock(_proc_mtx);
+
+    if (_call_state == CallState::WAIT_WRITE_DONE) {
+        if (_msg_queue.size() >= _queue_size) {
+            _msg_queue.pop_front(); // delete the oldest message.
+            _dropped++;
+        }
+        _msg_queue.push_back(entry);
+    }
+    else if (_call_state == CallState::READY_TO_WRITE) {
+        _msg_queue.push_back(entry);
+        WriteQueued();
+    }
+}
+
+inline uint64_t LogPublisherGrpc::Session::GetId()
+{
+    return _id;
+}
+
+inline void LogPublisherGrpc::Session::TryCancelCallAndShutdown()
+{
+    _active.store(false, std::memory_order_release);
+    if (_call_state != CallState::WAIT_CONNECT &&
+        _call_state != CallState::WAIT_FINISH &&
+        _call_state != CallState::FINISHED) {
+        _ctx.TryCancel();
+
+        std::lock_guard<std::mutex> lock(_proc_mtx);
+        _call_state = CallState::FINISHED;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Implementation of LogPublisherGrpc
+//
+inline LogPublisherGrpc::LogPublisherGrpc(const std::string &server_address, uint32_t queue_size, uint32_t batch_size)
+    : _server_address(server_address), _msg_queue_size(std::max<uint32_t>(queue_size, 1)), _batch_size(std::max<uint32_t>(batch_size, 1))
+{
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(_server_address, grpc::InsecureServerCredentials());
+    builder.RegisterService(&_service);
+    _cq = builder.AddCompletionQueue();
+    _server = builder.BuildAndStart();
+
+    AddSession();
+    Run();
+
+    _tap_registered = Log::RtLog::AddTap(this);
+    if (!_tap_registered)
+    {
+        Log::RtLog::LogRaw(Log::LogLevel::err, "[LogPublisherGrpc] Cannot register RtLog tap (max %zu)", Log::RtLogConstant::MAX_TAPS);
+    }
+}
+
+inline LogPublisherGrpc::~LogPublisherGrpc()
+{
+    Stop();
+}
+
+inline void LogPublisherGrpc::OnLogLine(Log::LogLevel lvl, int64_t wall_ns, const char *loggerName, const char *msg, size_t msgLen) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(_session_mtx);
+
+        // Build the entry once, only if at least one subscriber wants it.
+        bool built = false;
+        dtproto::std_msgs::LogEntry entry;
+        for (auto &it : _sessions) {
+            if (!it.second->Matches(lvl, loggerName, msg, msgLen)) {
+                continue;
+            }
+            if (!built) {
+                entry.set_timestamp_ns(wall_ns);
+                entry.set_level(static_cast<dtproto::std_msgs::LogLevel>(lvl));
+                entry.set_logger_name(loggerName);
+                entry.set_msg(msg, msgLen);
+                built = true;
+            }
+            it.second->Publish(entry);
+        }
+    }
+    catch (...)
+    {
+        // bad_alloc: drop this line for all subscribers, never propagate into the drain thread
+    }
+}
+
+inline bool LogPublisherGrpc::AddSession()
+{
+    std::shared_ptr<Session> session = std::make_shared<Session>(this, &_service, _cq.get());
+    std::lock_guard<std::mutex> lock(_session_mtx);
+    _sessions[session->GetId()] = session;
+    return true;
+}
+
+inline void LogPublisherGrpc::RemoveSession(uint64_t session_id)
+{
+    std::lock_guard<std::mutex> lock(_session_mtx);
+    _sessions.erase(session_id);
+}
+
+// Stop all pending rpc calls and close sessions
+inline void LogPublisherGrpc::Stop()
+{
+    // detach from the drain thread first: OnLogLine() is not called after RemoveTap() returns
+    if (_tap_registered)
+    {
+        Log::RtLog::RemoveTap(this);
+        _tap_registered = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_session_mtx);
+        for (auto it : _sessions) {
+            it.second->TryCancelCallAndShutdown();
+        }
+    }
+
+    _running = false;
+    _server->Shutdown();
+    _cq->Shutdown();
+    if (_rpc_thread)
+    {
+        pthread_join(_rpc_thread, nullptr);
+        _rpc_thread = (pthread_t)0;
+    }
+}
+
+inline bool LogPublisherGrpc::IsRunning()
+{
+    return _running.load();
+}
+
+// Run grpc message-dispatcher
+inline void LogPublisherGrpc::Run()
+{
+    _running = true;
+
+    pthread_create(
+        &_rpc_thread, NULL,
+        [](void *arg) -> void * {
+            LogPublisherGrpc *server = (LogPublisherGrpc *)arg;
+
+            void *tag;
+            bool ok;
+            while (server->_cq->Next(&tag, &ok))
+            {
+                if (ok)
+                {
+                    static_cast<LogPublisherGrpc::Session *>(tag)->OnCompletionEvent();
+                }
+                else
+                {
+                    static_cast<LogPublisherGrpc::Session *>(tag)->OnCompletionError();
+                }
+            }
+            return 0;
+        },
+        (void *)this);
+    pthread_setname_np(_rpc_thread, "LogPubGrpc");
+}
+
+} // namespace DAQ
+} // namespace dt
+
+#endif // __DT_DAQ_LOGPUBLISHERGRPC_H__
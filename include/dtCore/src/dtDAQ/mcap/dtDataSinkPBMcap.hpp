@@ -199,14 +199,15 @@ public:
         mcap::Timestamp publishTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
                                         std::chrono::system_clock::now().time_since_epoch()).count();
 
-        std::string serialized = msg.SerializeAsString();
+        // reuse the buffer: no heap allocation once it has grown to the largest message
+        msg.SerializeToString(&_serialized);
         mcap::Message mcap_msg;
         mcap_msg.channelId = _channel_id;
         mcap_msg.sequence = _msg_count++;
         mcap_msg.publishTime = publishTime;
         mcap_msg.logTime = publishTime;
-        mcap_msg.data = reinterpret_cast<const std::byte*>(serialized.data());
-        mcap_msg.dataSize = serialized.size();
+        mcap_msg.data = reinterpret_cast<const std::byte*>(_serialized.data());
+        mcap_msg.dataSize = _serialized.size();
         const auto res = _writer.write(mcap_msg);
         if (!res.ok()) {
             HandleWriteError();
@@ -276,6 +277,7 @@ protected:
     mcap::ChannelId _channel_id{0};
     std::atomic<uint32_t> _msg_count{0};
     std::atomic<bool> _is_open{false};
+    std::string _serialized; // Publish() buffer
 };
 
 } // namespace DAQ
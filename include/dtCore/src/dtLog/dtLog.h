@@ -17,8 +17,16 @@
 #include <spdlog/sinks/syslog_sink.h>
 #include <spdlog/spdlog.h>
 #include <spdlog/details/os.h>
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <ostream>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #if defined(_WIN32) || defined(__CYGWIN__)
 #else
 #include <unistd.h>
@@ -130,6 +138,7 @@ public:
             logger->set_pattern("%^[%L][%H:%M:%S.%f]%$%v");
         }
         spdlog::set_default_logger(logger);
+        _logger_generation.fetch_add(1, std::memory_order_release);
     }
 
     /**
@@ -185,6 +194,7 @@ public:
             logger->set_pattern("%^[%L][%H:%M:%S.%f]%$%v");
         }
         // spdlog::register_logger(logger); // all loggers create by spdlog::create<Sink>() or spdlog::..._mt() functions are registered automatically.
+        _logger_generation.fetch_add(1, std::memory_order_release);
     }
 
     /**
@@ -194,6 +204,7 @@ public:
     {
         // flush all peding log message
         spdlog::shutdown();
+        _logger_generation.fetch_add(1, std::memory_order_release);
     }
 
     /**
@@ -412,40 +423,124 @@ public:
         spdlog::set_pattern(pattern);
     }
 
+private:
+    /**
+     * Initialize() / Create() / Terminate() 호출마다 증가. NamedLogStream 의 thread-local logger cache 무효화에 사용.
+     * spdlog API 로 직접 logger 를 등록/삭제한 경우에는 cache 에 반영되지 않음.
+     */
+    static inline std::atomic<uint32_t> _logger_generation{0};
+
+    /**
+     * 이름으로 logger 검색. spdlog::get() 은 registry mutex 를 잡으므로 결과를 thread 별로 cache 하고,
+     * _logger_generation 이 바뀐 경우에만 다시 조회한다. 등록되지 않은 이름은 nullptr.
+     */
+    static spdlog::logger* find_logger_cached(const char* log_name)
+    {
+        struct CacheEntry {
+            std::string name;
+            std::shared_ptr<spdlog::logger> logger;
+        };
+        thread_local uint32_t cache_generation{0};
+        thread_local std::vector<CacheEntry> cache;
+
+        uint32_t generation = _logger_generation.load(std::memory_order_acquire);
+        if (cache_generation != generation) {
+            cache.clear();
+            cache_generation = generation;
+        }
+        for (const auto& entry : cache) {
+            if (entry.name == log_name)
+                return entry.logger.get();
+        }
+        cache.push_back(CacheEntry{log_name, spdlog::get(log_name)});
+        return cache.back().logger.get();
+    }
+
 public:
+    /**
+     * LogStream / NamedLogStream 의 메시지 버퍼.
+     * INLINE_LEN 이하의 메시지는 stack 에서 처리(heap 할당 없음). 숫자/문자/문자열은 fmt 로 직접 변환하고,
+     * 그 외 타입(사용자 정의 operator<<, std::hex / std::setprecision 등의 manipulator)이 처음 들어오면
+     * 같은 버퍼에 쓰는 std::ostream 으로 전환하여 이후 값은 모두 ostream 으로 출력한다(std::ostringstream 과 같은 결과).
+     */
+    class LogLineBuffer {
+    public:
+        static constexpr size_t INLINE_LEN = 256;
+
+        LogLineBuffer() = default;
+        LogLineBuffer(const LogLineBuffer&) = delete;
+        LogLineBuffer& operator=(const LogLineBuffer&) = delete;
+
+        template <typename T> void append(const T& value);
+        template<typename... Args> inline void format(spdlog::format_string_t<Args...> fmt_string, Args &&...args);
+        spdlog::string_view_t view() const { return spdlog::string_view_t(_buf.data(), _buf.size()); }
+
+    private:
+        using buffer_t = fmt::basic_memory_buffer<char, INLINE_LEN>;
+
+        class StreamBuf : public std::streambuf {
+        public:
+            explicit StreamBuf(buffer_t& buf) : _buf(buf) {}
+        protected:
+            int_type overflow(int_type ch) override {
+                if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                    _buf.push_back(traits_type::to_char_type(ch));
+                return traits_type::not_eof(ch);
+            }
+            std::streamsize xsputn(const char* s, std::streamsize n) override {
+                _buf.append(s, s + n);
+                return n;
+            }
+        private:
+            buffer_t& _buf;
+        };
+
+        buffer_t _buf;
+        StreamBuf _sbuf{_buf};
+        std::optional<std::ostream> _ostream{};
+    };
+
     class LogStream {
     public:
         explicit LogStream(const spdlog::level::level_enum log_level)
-            : _log_level(log_level) {
+            : _logger(spdlog::default_logger_raw()), _log_level(log_level) {
+            _enabled = (_logger != nullptr) && _logger->should_log(_log_level);
         }
         template <typename T> LogStream& operator<<(const T& value);
         template<typename... Args> inline void format(spdlog::format_string_t<Args...> fmt_string, Args &&...args);
         ~LogStream() {
-            spdlog::log(_log_level, "{}", _log_stream.str());
+            if (_enabled)
+                _logger->log(_log_level, _log_buffer.view());
         }
     private:
+        spdlog::logger* _logger;
         spdlog::level::level_enum _log_level;
-        std::ostringstream _log_stream;
+        bool _enabled;
+        LogLineBuffer _log_buffer;
     };
 
     class NamedLogStream {
     public:
-        explicit NamedLogStream(const std::string log_name, const spdlog::level::level_enum log_level)
-            : _log_name(log_name), _log_level(log_level) {
+        explicit NamedLogStream(const char* log_name, const spdlog::level::level_enum log_level)
+            : _logger(find_logger_cached(log_name)), _log_level(log_level) {
+            if (!_logger)
+                _logger = spdlog::default_logger_raw();
+            _enabled = (_logger != nullptr) && _logger->should_log(_log_level);
+        }
+        explicit NamedLogStream(const std::string& log_name, const spdlog::level::level_enum log_level)
+            : NamedLogStream(log_name.c_str(), log_level) {
         }
         template <typename T> NamedLogStream& operator<<(const T& value);
         template<typename... Args> inline void format(spdlog::format_string_t<Args...> fmt_string, Args &&...args);
         ~NamedLogStream() {
-            std::shared_ptr<spdlog::logger> logger = spdlog::get(_log_name);
-            if (logger)
-                logger->log(_log_level, "{}", _log_stream.str());
-            else
-                spdlog::log(_log_level, "{}", _log_stream.str());
+            if (_enabled)
+                _logger->log(_log_level, _log_buffer.view());
         }
     private:
-        std::string _log_name{};
+        spdlog::logger* _logger;
         spdlog::level::level_enum _log_level;
-        std::ostringstream _log_stream;
+        bool _enabled;
+        LogLineBuffer _log_buffer;
     };
 
 };
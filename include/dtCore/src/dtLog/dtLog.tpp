@@ -1,30 +1,77 @@
 namespace dt
 {
 
+template <typename T>
+void Log::LogLineBuffer::append(const T &value)
+{
+    using value_t = std::remove_cv_t<T>;
+
+    if (_ostream) {
+        *_ostream << value;
+    }
+    else if constexpr (std::is_same_v<value_t, bool>) {
+        _buf.push_back(value ? '1' : '0');
+    }
+    else if constexpr (std::is_same_v<value_t, char> || std::is_same_v<value_t, signed char> || std::is_same_v<value_t, unsigned char>) {
+        _buf.push_back(static_cast<char>(value));
+    }
+    else if constexpr (std::is_floating_point_v<value_t>) {
+        // same as std::ostream default (precision 6, %g)
+        fmt::format_to(std::back_inserter(_buf), "{:g}", value);
+    }
+    else if constexpr (std::is_integral_v<value_t> && !std::is_same_v<value_t, wchar_t> &&
+                       !std::is_same_v<value_t, char16_t> && !std::is_same_v<value_t, char32_t>) {
+        fmt::format_int str(value);
+        _buf.append(str.data(), str.data() + str.size());
+    }
+    else if constexpr (std::is_same_v<value_t, const char *> || std::is_same_v<value_t, char *>) {
+        const char *str = value ? value : "(null)";
+        _buf.append(str, str + std::char_traits<char>::length(str));
+    }
+    else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        std::string_view str = value;
+        _buf.append(str.data(), str.data() + str.size());
+    }
+    else {
+        _ostream.emplace(&_sbuf);
+        *_ostream << value;
+    }
+}
+
+template <typename... Args>
+inline void Log::LogLineBuffer::format(spdlog::format_string_t<Args...> fmt_string, Args &&... args)
+{
+    fmt::format_to(std::back_inserter(_buf), fmt_string, std::forward<Args>(args)...);
+}
+
 template <typename T>
 Log::LogStream &Log::LogStream::operator<<(const T &value)
 {
-    _log_stream << value;
+    if (_enabled)
+        _log_buffer.append(value);
     return *this;
 }
 
 template <typename... Args>
 inline void Log::LogStream::format(spdlog::format_string_t<Args...> fmt_string, Args &&... args)
 {
-    _log_stream << fmt::format(fmt_string, std::forward<Args>(args)...);
+    if (_enabled)
+        _log_buffer.format(fmt_string, std::forward<Args>(args)...);
 }
 
 template <typename T>
 Log::NamedLogStream &Log::NamedLogStream::operator<<(const T &value)
 {
-    _log_stream << value;
+    if (_enabled)
+        _log_buffer.append(value);
     return *this;
 }
 
 template <typename... Args>
 inline void Log::NamedLogStream::format(spdlog::format_string_t<Args...> fmt_string, Args &&... args)
 {
-    _log_stream << fmt::format(fmt_string, std::forward<Args>(args)...);
+    if (_enabled)
+        _log_buffer.format(fmt_string, std::forward<Args>(args)...);
 }
 
-} // namespace dt
\ No newline at end of file
+} // namespace dt
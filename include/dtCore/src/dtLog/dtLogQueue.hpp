@@ -17,11 +17,18 @@
 #include <cstdarg>
 #include <cstdio>
 #include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "../dtUtils/dtRtMem.hpp"
 
 // MPSC (Multi-Producer Single-Consumer) Ring Buffer
 // - Multi RT or nonRT task → Producer
 // - Single logging task → Consumer
 // - lock-free, no syscall
+// - slot storage is allocated at runtime by Allocate(): capacity and per-slot message
+//   length come from configuration, m_capacity / m_msgLen are the defaults / upper bound
+//   of the message length (Entry buffer size)
 template<size_t m_capacity = 32, size_t m_msgLen = 256>
 class LogQueue 
 {
@@ -69,15 +76,13 @@ public:
         }
     };
 
-    LogQueue() noexcept 
-    {
-        for (size_t i = 0; i < m_capacity; ++i)
-        {
-            m_slots[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
-        }
+    // Storage is not allocated until Allocate() is called.
+    // TryPush()/TryPop() on an unallocated queue simply return false.
+    LogQueue() noexcept = default;
 
-        m_head.store(0, std::memory_order_relaxed);
-        m_tail.store(0, std::memory_order_relaxed);
+    ~LogQueue()
+    {
+        Release();
     }
 
     // remove copy / move operator
@@ -86,6 +91,63 @@ public:
     LogQueue(LogQueue&&) = delete;
     LogQueue& operator= (LogQueue&&) = delete;
 
+    /**
+     * @brief allocate slot storage (nonRT, before any producer/consumer is running)
+     *
+     * @param capacity: number of slots. Rounded up to power of 2 (2 ~ MAX_CAPACITY).
+     * @param msgLen: bytes per message slot including '\0' (MIN_MSGLEN ~ m_msgLen).
+     *                Longer messages are truncated on push.
+     * @param opt: huge page / mlock / prefault options for the slot region
+     * @return bool: false if memory could not be mapped. The queue is left unallocated.
+     */
+    bool Allocate(size_t capacity = m_capacity, size_t msgLen = m_msgLen,
+                  const dt::Utils::RtMemOptions& opt = dt::Utils::RtMemOptions{}) noexcept
+    {
+        Release();
+
+        capacity = std::min(std::max(capacity, static_cast<size_t>(2)), MAX_CAPACITY);
+        size_t cap = 2;
+        while (cap < capacity)
+        {
+            cap <<= 1;
+        }
+        msgLen = std::min(std::max(msgLen, MIN_MSGLEN), m_msgLen);
+
+        // slot = [SlotHeader | msg bytes], padded to a cache line to avoid false sharing
+        const size_t stride = (sizeof(SlotHeader) + msgLen + 63) & ~static_cast<size_t>(63);
+        if (!dt::Utils::AllocRtMem(cap * stride, opt, m_mem))
+        {
+            return false;
+        }
+
+        m_base        = static_cast<char*>(m_mem.ptr);
+        m_stride      = stride;
+        m_mask        = cap - 1;
+        m_slotCap     = cap;
+        m_slotMsgLen  = msgLen;
+
+        for (size_t i = 0; i < cap; ++i)
+        {
+            SlotHeader* hdr = new (m_base + i * stride) SlotHeader{};
+            hdr->seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // release slot storage (nonRT, after producers/consumer have stopped)
+    void Release() noexcept
+    {
+        dt::Utils::FreeRtMem(m_mem);
+        m_base       = nullptr;
+        m_stride     = 0;
+        m_mask       = 0;
+        m_slotCap    = 0;
+        m_slotMsgLen = 0;
+    }
+
     /**
      * @brief push log message into MPSC queue (for producer)
      *
@@ -94,12 +156,17 @@ public:
      */
     bool TryPush(const Entry& entry) noexcept 
     {
+        if (!m_base)
+        {
+            return false;
+        }
+
         uint32_t head = m_head.load(std::memory_order_relaxed);
 
         for (;;) 
         {
-            Slot& slot = m_slots[head & (m_capacity - 1)];
-            uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            SlotHeader* slot = SlotAt(head);
+            uint32_t seq = slot->seq.load(std::memory_order_acquire);
             int32_t diff = (int32_t)seq - (int32_t)head;
 
             if (diff == 0) 
@@ -107,8 +174,16 @@ public:
                 // CAS (Compare And Swap)
                 if (m_head.compare_exchange_strong(head, head + 1, std::memory_order_relaxed, std::memory_order_relaxed)) 
                 {
-                    slot.data = entry;
-                    slot.seq.store(head + 1, std::memory_order_release);
+                    // copy only the used part of the entry (not the whole m_msgLen buffer)
+                    size_t len = std::min(entry.msgLen, m_slotMsgLen - 1);
+                    slot->timeStamp_ns = entry.timeStamp_ns;
+                    slot->level        = entry.level;
+                    slot->msgLen       = static_cast<uint32_t>(len);
+                    size_t nameLen = strnlen(entry.loggerName, sizeof(slot->loggerName) - 1);
+                    std::memcpy(slot->loggerName, entry.loggerName, nameLen);
+                    slot->loggerName[nameLen] = '\0';
+                    std::memcpy(MsgOf(slot), entry.msg, len);
+                    slot->seq.store(head + 1, std::memory_order_release);
                     return true;
                 }
             }
@@ -133,16 +208,26 @@ public:
      */
     bool TryPop(Entry& out) noexcept 
     {
+        if (!m_base)
+        {
+            return false;
+        }
+
         uint32_t tail = m_tail.load(std::memory_order_relaxed);
-        Slot &slot = m_slots[tail & (m_capacity - 1)];
-        uint32_t seq  = slot.seq.load(std::memory_order_acquire);
+        SlotHeader* slot = SlotAt(tail);
+        uint32_t seq  = slot->seq.load(std::memory_order_acquire);
         int32_t  diff = (int32_t)seq - (int32_t)(tail + 1);
 
         if (diff == 0) 
         {
-            out = slot.data;
+            out.timeStamp_ns = slot->timeStamp_ns;
+            out.level        = slot->level;
+            out.msgLen       = slot->msgLen;
+            std::memcpy(out.msg, MsgOf(slot), out.msgLen);
+            out.msg[out.msgLen] = '\0';
+            std::memcpy(out.loggerName, slot->loggerName, sizeof(out.loggerName));
             m_tail.store(tail + 1, std::memory_order_relaxed);
-            slot.seq.store(tail + m_capacity, std::memory_order_release);
+            slot->seq.store(tail + static_cast<uint32_t>(m_slotCap), std::memory_order_release);
             return true;
         }
 
@@ -166,19 +251,46 @@ public:
         return static_cast<size_t>(h - t);
     }
 
-    static constexpr size_t Capacity() noexcept { return m_capacity; }
+    // Runtime slot count / per-slot message length (0 before Allocate())
+    size_t Capacity() const noexcept { return m_slotCap; }
+    size_t SlotMsgLen() const noexcept { return m_slotMsgLen; }
+    // Entry buffer length: upper bound of SlotMsgLen(), usable for stack buffers on the producer side
     static constexpr size_t MsgLen() noexcept { return m_msgLen; }
 
+    const dt::Utils::RtMemBlock& Memory() const noexcept { return m_mem; }
+
+    static constexpr size_t MAX_CAPACITY = size_t{1} << 20;
+    static constexpr size_t MIN_MSGLEN   = 64;
+
 private:
-    struct Slot 
+    struct SlotHeader 
     {
         std::atomic<uint32_t> seq{0};   // queue number
-        Entry                 data;
+        uint32_t              msgLen{0};
+        int64_t               timeStamp_ns{0};
+        log_level             level{log_level::info};
+        char                  loggerName[64];
+        // followed by m_slotMsgLen message bytes
     };
 
+    SlotHeader* SlotAt(uint32_t idx) const noexcept
+    {
+        return reinterpret_cast<SlotHeader*>(m_base + (idx & m_mask) * m_stride);
+    }
+
+    static char* MsgOf(SlotHeader* slot) noexcept
+    {
+        return reinterpret_cast<char*>(slot) + sizeof(SlotHeader);
+    }
+
     alignas(64) std::atomic<uint32_t> m_head{0};
     alignas(64) std::atomic<uint32_t> m_tail{0};
-    alignas(64) std::array<Slot, m_capacity> m_slots;
+    alignas(64) char*                 m_base{nullptr};
+    size_t                            m_stride{0};
+    size_t                            m_mask{0};
+    size_t                            m_slotCap{0};
+    size_t                            m_slotMsgLen{0};
+    dt::Utils::RtMemBlock             m_mem{};
 };
 
 #endif  // _DT_LOG_QUEUE_H_
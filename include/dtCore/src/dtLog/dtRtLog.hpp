@@ -27,9 +27,12 @@
 #include <type_traits>
 #include <vector>
 #include <iomanip>
+#include <mutex>
 
 #include "dtLogQueue.hpp"
+#include "dtRtLogData.hpp"
 #include "dtRtTui.hpp"
+#include "../dtUtils/dtTimeUtil.hpp"
 
 // Forward declaration for optional Eigen support (include dtRtLogEigen.hpp for the implementation)
 namespace Eigen
@@ -95,13 +98,40 @@ namespace RtLogConstant
     inline constexpr long TUI_FLUSH_INTERVAL_NS = 40'000'000L;  // 40ms (25Hz)
     // Thread info
     inline constexpr size_t THREAD_STACK_SIZE   = 1024 * 1024; // 1MB
-    inline constexpr int THREAD_CPU_ID          = 2;  // default CPU core(#2)
+    inline constexpr int THREAD_CPU_ID          = 2;  // default CPU core(#2), -1(dt::Thread::CPU_AUTO): housekeeping core picked from the topology
     inline constexpr int THREAD_PRIORITY        = 0;  // nonRt
     // Visible prefix width of pattern "%^[%L][%H:%M:%S.%f]%$ %v":
     // "[I]"=3 + "[HH:MM:SS.ffffff]"=17 + " "=1 = 21 chars
     inline constexpr size_t DEFAULT_CONT_INDENT = 21;
+    // Max number of RtLogTap observers registered at the same time
+    inline constexpr size_t MAX_TAPS            = 8;
+    // Max number of network sinks ("_NET_:...") whose queue drops are tracked
+    inline constexpr size_t MAX_NET_SINKS       = 8;
 }   // namespace RtLogConstant
 
+// Queue sizing and memory options passed to Initialize().
+//
+// 큐 슬롯 메모리는 Initialize() 시점(nonRT)에 한 번 할당되며, RT 경로에서 page fault가
+// 나지 않도록 기본적으로 prefault된다. msgLen은 QUEUE_MSGLEN(Entry 버퍼 크기)을
+// 넘을 수 없으며, 더 긴 메시지는 push 시 잘린다.
+struct RtLogQueueConfig
+{
+    size_t capacity{RtLogConstant::QUEUE_CAPACITY};  // log queue slots (rounded up to power of 2)
+    size_t msgLen{RtLogConstant::QUEUE_MSGLEN};      // bytes per log message slot (64 ~ QUEUE_MSGLEN)
+    size_t tuiCapacity{RtTui::QUEUE_CAPACITY};       // TUI log queue slots
+    size_t tuiMsgLen{RtTui::QUEUE_MSG_LEN};          // bytes per TUI log message slot
+    size_t tuiHistoryBytes{TuiHistoryConfig{}.bytes}; // Area 2 history text (variable-length lines)
+    const char *tuiHistoryFile{nullptr};             // keep the history in this mmap'd file instead of RAM
+    const char *tuiShmName{nullptr};                 // publish the TUI to POSIX shm ("/name") for dttui-attach;
+                                                     // without a terminal the TUI then runs headless
+    bool   tuiHeadless{false};                       // TUI without terminal output (needs tuiShmName to be seen)
+    size_t dataCapacity{RtLogDataConstant::QUEUE_CAPACITY};  // LOG_DATA sample slots (0: LOG_DATA disabled)
+    size_t dataSlotBytes{RtLogDataConstant::SLOT_BYTES};     // max bytes per LOG_DATA sample
+    bool   hugePages{false};                         // back queues with huge pages if available
+    bool   lockMemory{false};                        // mlock() queue memory
+    bool   prefault{true};                           // touch all queue pages at Initialize()
+};
+
 // Colored stdout sink using a single write() syscall per message.
 //
 // All LOG_RT() entries are produced by RT tasks into the MPSC queue and
@@ -634,11 +664,27 @@ private:
 using BasicFileSink   = BasicFileSinkT<spdlog::details::null_mutex>;
 using BasicFileSinkMt = BasicFileSinkT<std::mutex>;
 
+// RtLogTap — drain-thread observer of flushed log lines (e.g. remote log tailing)
+//
+// OnLogLine() is called on the drain thread (nonRT) once per entry that passed the
+// RtLog level filter, right after it was handed to the spdlog sinks. LOG_CONT output
+// is delivered per completed line. The drain thread serves every RT producer, so
+// implementations should only filter and enqueue, never block.
+class RtLogTap
+{
+public:
+    virtual ~RtLogTap() = default;
+
+    // loggerName: "" for the default logger, wall_ns: CLOCK_REALTIME ns since epoch
+    virtual void OnLogLine(LogLevel lvl, int64_t wall_ns, const char *loggerName,
+                           const char *msg, size_t msgLen) noexcept = 0;
+};
+
 class RtLog {
 public:
-    // Increased capacity from 256 to 2048 to handle high-frequency burst logging
-    // if system generates total message per ~3400 msg/sec
-    // With 2048 capacity, can buffer ~600ms worth of messages during drain delays
+    // Template arguments are the default slot count and the maximum message length.
+    // Actual capacity / message length are set at Initialize() from RtLogQueueConfig
+    // (e.g. 4096 slots x 256 B for high-frequency burst logging of short messages).
     using QueueType = LogQueue<RtLogConstant::QUEUE_CAPACITY, RtLogConstant::QUEUE_MSGLEN>;
     using Entry = QueueType::Entry;
 
@@ -682,12 +728,15 @@ public:
         int threadPriority = RtLogConstant::THREAD_PRIORITY,
         size_t threadStack = RtLogConstant::THREAD_STACK_SIZE,
         bool annotDatetime = true,
-        bool truncate = false);
+        bool truncate = false,
+        const RtLogQueueConfig &queueConfig = RtLogQueueConfig{});
 
     /**
      * Default logger 외에 새로운 로거를 생성하고 spdlog 레지스트리에 등록.
      * @param logName logger 이름.
-     * @param fileBasename 로그 파일 이름. "_STDOUT_"인 경우 terminal. 그 외는 해당 파일명으로 로그 생성.
+     * @param fileBasename 로그 파일 이름. "_STDOUT_"인 경우 terminal, "_SYSLOG_"인 경우 syslog,
+     *                     "_NET_:tcp:<host>:<port>" / "_NET_:unix:<path>"인 경우 collector로 스트리밍.
+     *                     그 외는 해당 파일명으로 로그 생성.
      * @param annotDatetime 파일 로그의 경우 파일 이름에 생성 날짜 및 시간을 뒤에 붙일지 여부.
      * @param truncate 동일 이름의 로그 파일이 있는 경우 해당 파일을 지우고 새로 만들지 여부.
      * @param maxFiles 최대 로그 파일 개수 (파일 rotation 시).
@@ -761,6 +810,24 @@ public:
         }
     }
 
+    template<typename... Vals>
+    void TuiSetRowVals(int layoutIdx, int groupIdx, int rowIdx, const char *label, const Vals &...vals) noexcept
+    {
+        if (m_tui)
+        {
+            m_tui->SetRowVals(layoutIdx, groupIdx, rowIdx, label, vals...);
+        }
+    }
+
+    template<typename... Args>
+    void TuiSetRowRaw(int layoutIdx, int groupIdx, int rowIdx, const char *label, uint16_t fmtId, Args... args) noexcept
+    {
+        if (m_tui)
+        {
+            m_tui->SetRowRaw(layoutIdx, groupIdx, rowIdx, label, fmtId, args...);
+        }
+    }
+
     template<typename... Args>
     void TuiSetGroup(int layoutIdx, int groupIdx, const char *label, Args... args) noexcept
     {
@@ -775,6 +842,15 @@ public:
     void TuiSetTextRowFmt(int layoutIdx, int groupIdx, int rowIdx, const char *label, const char *fmt, ...) noexcept
         __attribute__((format(printf, 6, 7)));
     void TuiSetLayoutName(int layoutIdx, const char *name) noexcept;
+    int  TuiAddPlot(int layoutIdx, int groupIdx, int rowIdx, const char *label,
+                    const TuiPlotConfig &cfg = TuiPlotConfig{}) noexcept;
+    void TuiPushPlot(int plotId, double value) noexcept
+    {
+        if (m_tui)
+        {
+            m_tui->PushPlot(plotId, value);
+        }
+    }
     bool IsInitialized() const noexcept;
     void RefreshTimebase() noexcept;
 
@@ -803,6 +879,35 @@ public:
     // Can only be used in a non-RT context (uses clock_nanosleep).
     static void Sync() noexcept;
 
+    // Register a drain-thread observer (up to RtLogConstant::MAX_TAPS). Returns false if full.
+    static bool AddTap(RtLogTap *tap) noexcept;
+
+    // Unregister an observer. After return the drain thread no longer calls it, so the
+    // tap may be destroyed. nonRT only; must not be called from OnLogLine() itself.
+    static void RemoveTap(RtLogTap *tap) noexcept;
+
+    /**
+     * LOG_DATA() 용 telemetry channel 생성 (nonRT, Initialize() 이후).
+     * @param channel channel 이름. LOG_DATA(channel, ...)의 첫 인자와 같아야 함.
+     * @param fileBasename 출력 파일 이름.
+     * @param columns column 이름. 비어 있으면 c0, c1, ... 개수를 지정한 경우 LOG_DATA() 값 개수와 같아야 함.
+     * @param format DataFormat::binary (column block) 또는 DataFormat::csv.
+     * @param annotDatetime 파일 이름에 생성 날짜 및 시간을 뒤에 붙일지 여부.
+     * @return 실패(이름 중복, channel 수 초과, 파일 생성 실패) 시 false.
+     */
+    static bool CreateDataChannel(
+        const std::string &channel,
+        const std::string &fileBasename,
+        const std::vector<std::string> &columns = {},
+        DataFormat format = DataFormat::binary,
+        bool annotDatetime = true);
+
+    // Telemetry channel statistics. Returns false if the channel does not exist.
+    static bool GetDataStats(const std::string &channel, DataChannelStats &stats) noexcept;
+
+    // LOG_DATA() backend
+    RtLogData &Data() noexcept { return m_data; }
+
     // Immediate raw output to STDERR, bypassing the drain thread and log queue.
     //
     // When to use (LOG_RT_RAW):
@@ -947,6 +1052,10 @@ public:
     {
         size_t current_size;      // Current number of messages in queue
         size_t capacity;          // Maximum queue capacity
+        size_t msg_len;           // Bytes per message slot
+        size_t memory_bytes;      // Mapped queue memory
+        bool   huge_pages;        // Queue memory backed by huge pages
+        bool   locked;            // Queue memory mlock()'ed
         size_t utilization_pct;   // Utilization percentage (0-100)
         uint64_t total_drops;     // Total number of dropped messages
     };
@@ -1313,8 +1422,31 @@ private:
     char                             m_contBuf[CONT_BUF_SIZE];
     size_t                           m_contBufLen{0};
     spdlog::level::level_enum        m_contLevel{spdlog::level::info};
+    int64_t                          m_contTime_ns{0};
     std::string                      m_patternStr;  // current spdlog pattern, restored after %v switch
 
+    // Drain-thread observers (AddTap / RemoveTap)
+    std::array<std::atomic<RtLogTap *>, RtLogConstant::MAX_TAPS> m_taps{};
+    std::atomic<int>                 m_tapCount{0};
+
+    // LOG_DATA() channels and their sample queue (separate from m_queue)
+    RtLogData                        m_data;
+
+    // Network sinks (NetSinkMt): queue drops of their logger are passed on as record
+    // sequence gaps. Enqueue() counts a drop in the slot whose logger name matches
+    // ("" = default logger, also for names without a slot); slots are published by
+    // m_netSlotCount and written under m_netSinkMtx.
+    struct NetDropSlot
+    {
+        char                                 logger[sizeof(Entry::loggerName)]{};
+        std::atomic<uint64_t>                drops{0};
+        uint64_t                             reported{0};   // drain thread
+        std::shared_ptr<spdlog::sinks::sink> sink;
+    };
+    std::mutex                       m_netSinkMtx;
+    std::array<NetDropSlot, RtLogConstant::MAX_NET_SINKS> m_netSlots{};
+    std::atomic<int>                 m_netSlotCount{0};
+
 private:
     RtLog() noexcept;
     ~RtLog();
@@ -1327,6 +1459,10 @@ private:
 
     void Poll() noexcept;
     void FlushEntry(const Entry &entry) noexcept;
+    void CountNetDrop(const char *loggerName) noexcept;
+    void ReportNetDrops() noexcept;
+    void NotifyTaps(LogLevel lvl, int64_t wall_ns, const char *loggerName, const char *msg, size_t msgLen) noexcept;
+    void ReportQueueMemory(const char *what, const Utils::RtMemBlock &mem, const Utils::RtMemOptions &opt) noexcept;
     void LogRtCont(LogLevel lvl, const char *msg, size_t msgLen) noexcept;
 
     // Flush complete lines (ending with '\n') from m_contBuf.
@@ -1339,15 +1475,11 @@ private:
 
     inline int64_t MonoNow_ns() const noexcept
     {
-        struct timespec ts;
-        // CLOCK_MONOTONIC is intercepted by Xenomai POSIX skin and runs in primary
-        // mode. CLOCK_MONOTONIC_RAW is a Linux-only clock that falls through to the
-        // Linux kernel, triggering a primary -> secondary mode switch on every call.
-        clock_gettime(CLOCK_MONOTONIC, &ts);
-        return (static_cast<int64_t>(ts.tv_sec) * 1'000'000'000LL + static_cast<int64_t>(ts.tv_nsec));
+        return dt::Utils::MonotonicNs();  // CLOCK_MONOTONIC, see dtTimeUtil.hpp
     }
 
     std::string AnnotateFilenameDatetime(const std::string &fileBasename);
+    std::shared_ptr<spdlog::sinks::sink> CreateNetSink(const std::string &fileBasename, const char *loggerName);
     std::tuple<std::string, std::string> SplitByDirectory(const std::string &fname);
     bool EnsureDirectoryExistes(const std::string &dname, std::error_code &ec);
 };  // class RtLog
@@ -1397,6 +1529,25 @@ private:
 #define LOG_CONT(level) \
     dt::Log::RtLog::LogRtContStream(dt::Log::LogLevel::level)
 
+// LOG_DATA(channel, v1, v2, ...): push one raw sample to a telemetry channel (RT-safe).
+// The channel must be created with CreateDataChannel(); its column types are taken from
+// the first LOG_DATA() call. Values are copied as-is (no formatting) into a separate data
+// queue and written by the drain thread as binary column blocks or CSV.
+//   dt::Log::CreateDataChannel("joint", "logs/joint.dtd", {"q0", "q1", "tau0", "tau1"});
+//   LOG_DATA(joint, q[0], q[1], tau[0], tau[1]);
+#define LOG_DATA(channel, ...) \
+    do { \
+        static dt::Log::RtLogData::Site _dtDataSite_{#channel}; \
+        dt::Log::RtLog::Instance().Data().Write(_dtDataSite_, __VA_ARGS__); \
+    } while (0)
+
+// LOG_DATA_ARRAY(channel, ptr, count): all columns of the same type from a contiguous array
+#define LOG_DATA_ARRAY(channel, values, count) \
+    do { \
+        static dt::Log::RtLogData::Site _dtDataSite_{#channel}; \
+        dt::Log::RtLog::Instance().Data().WriteArray(_dtDataSite_, values, count); \
+    } while (0)
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TUI Area 1 macros — RT-safe, no-op when TUI is disabled
 // All macros take layoutIdx as the first argument (0-based, key '1'~'9').
@@ -1430,6 +1581,23 @@ private:
 #define TUI_SET_ROW_COLS(layout, grp, row, label, ...) \
     dt::Log::RtLog::Instance().TuiSetRowCols(layout, grp, row, label, ##__VA_ARGS__)
 
+// Raw-value row updates — values are stored as-is and formatted only when a frame is
+// drawn (no snprintf on the calling thread). fmt must be a string literal with a single
+// numeric conversion; it is interned once per call site.
+// Example: TUI_SET_ROW_VALS(0, grp, row, "R1",
+//              TUI_VAL("0x%04X", status), TUI_VAL("%+8.1f", pos), TUI_VAL("%+8d", tpu))
+//          TUI_SET_ROW_RAW(1, grp, row, "Right", "%d", v1, v2, v3)
+#define DT_TUI_FMT_ID(fmt) \
+    ([]() noexcept { static const uint16_t _dtTuiFmt_ = dt::Log::RtTui::InternFormat(fmt); return _dtTuiFmt_; }())
+
+#define TUI_VAL(fmt, val)   dt::Log::RtTui::TuiVal(DT_TUI_FMT_ID(fmt), val)
+
+#define TUI_SET_ROW_VALS(layout, grp, row, label, ...) \
+    dt::Log::RtLog::Instance().TuiSetRowVals(layout, grp, row, label, ##__VA_ARGS__)
+
+#define TUI_SET_ROW_RAW(layout, grp, row, label, fmt, ...) \
+    dt::Log::RtLog::Instance().TuiSetRowRaw(layout, grp, row, label, DT_TUI_FMT_ID(fmt), ##__VA_ARGS__)
+
 // Full-width text row — ignores column layout, max 200 chars
 // Example: TUI_SET_TEXT_ROW(0, grp, row, "label", text)
 #define TUI_SET_TEXT_ROW(layout, grp, row, label, text) \
@@ -1440,6 +1608,17 @@ private:
 #define TUI_SET_TEXT_ROW_FMT(layout, grp, row, label, fmt, ...) \
     dt::Log::RtLog::Instance().TuiSetTextRowFmt(layout, grp, row, label, fmt, ##__VA_ARGS__)
 
+// Numeric-channel widget — sparkline + rolling min/max/mean/p99, fed at full rate.
+// TUI_ADD_PLOT at setup returns the channel id (-1 if TUI is disabled); TUI_PLOT is
+// RT-safe (one producer thread per channel).
+// Example: static int tauId = TUI_ADD_PLOT(0, grp, row, "tau0");   // optional TuiPlotConfig
+//          TUI_PLOT(tauId, tau[0]);
+#define TUI_ADD_PLOT(layout, grp, row, label, ...) \
+    dt::Log::RtLog::Instance().TuiAddPlot(layout, grp, row, label, ##__VA_ARGS__)
+
+#define TUI_PLOT(id, value) \
+    dt::Log::RtLog::Instance().TuiPushPlot(id, value)
+
 // Keyboard input from TUI (non-blocking, returns 0 if none)
 #define TUI_GET_PENDING_KEY()   dt::Log::RtLog::Instance().GetPendingKey()
 
@@ -1494,12 +1673,11 @@ void TuiSinkT<Mutex>::sink_it_(const spdlog::details::log_msg &msg)
         safe_copy("\033[m", 3);                                                    // reset
         safe_copy(buf.data() + msg.color_range_end, sz - msg.color_range_end);     // message body
 
-        tmp[pos] = '\0';
-        m_tui->Log(msg.level, "%s", tmp);
+        m_tui->LogText(msg.level, msg.logger_name.data(), msg.logger_name.size(), tmp, pos);
     }
     else
     {
-        m_tui->Log(msg.level, "%.*s", (int)sz, buf.data());
+        m_tui->LogText(msg.level, msg.logger_name.data(), msg.logger_name.size(), buf.data(), sz);
     }
 }
 
@@ -1644,9 +1822,10 @@ inline void Initialize(
     int threadPriority = RtLogConstant::THREAD_PRIORITY,
     size_t threadStack = RtLogConstant::THREAD_STACK_SIZE,
     bool annotDatetime = true,
-    bool truncate = false)
+    bool truncate = false,
+    const RtLogQueueConfig &queueConfig = RtLogQueueConfig{})
 {
-    RtLog::Initialize(logName, fileBasename, enableTui, threadCpuId, maxFiles, maxFileSize, threadPriority, threadStack, annotDatetime, truncate);
+    RtLog::Initialize(logName, fileBasename, enableTui, threadCpuId, maxFiles, maxFileSize, threadPriority, threadStack, annotDatetime, truncate, queueConfig);
 }
 
 inline void Create(
@@ -1665,6 +1844,16 @@ inline void Terminate()
     RtLog::Terminate();
 }
 
+inline bool CreateDataChannel(
+    const std::string &channel,
+    const std::string &fileBasename,
+    const std::vector<std::string> &columns = {},
+    DataFormat format = DataFormat::binary,
+    bool annotDatetime = true)
+{
+    return RtLog::CreateDataChannel(channel, fileBasename, columns, format, annotDatetime);
+}
+
 inline void FlushOn(LogLevel lvl)
 {
     RtLog::FlushOn(lvl);
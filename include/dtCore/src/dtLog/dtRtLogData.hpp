@@ -0,0 +1,473 @@
+/*!
+ \file      dtRtLogData.hpp
+ \brief     Typed numeric telemetry channels for RtLog (LOG_DATA)
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTLOG_DATA_H_
+#define _DT_RTLOG_DATA_H_
+
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../dtUtils/dtRtMem.hpp"
+#include "../dtUtils/dtTimeUtil.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+namespace RtLogDataConstant
+{
+    inline constexpr size_t   MAX_CHANNELS      = 32;
+    inline constexpr size_t   MAX_COLUMNS       = 256;
+    inline constexpr size_t   NAME_LEN          = 48;          // channel / column name incl. '\0'
+    inline constexpr size_t   QUEUE_CAPACITY    = 1024;        // sample slots (power of 2)
+    inline constexpr size_t   SLOT_BYTES        = 1024;        // payload bytes per sample (128 x double)
+    inline constexpr size_t   MAX_SLOT_BYTES    = 8192;
+    inline constexpr size_t   BLOCK_ROWS        = 1024;        // rows per binary column block
+    inline constexpr long     FLUSH_INTERVAL_NS = 500'000'000L;  // write partial blocks every 500 ms
+    inline constexpr uint32_t FILE_MAGIC        = 0x444C5444;  // "DTLD" (little endian)
+    inline constexpr uint32_t BLOCK_MAGIC       = 0x424C5444;  // "DTLB"
+    inline constexpr uint16_t FILE_VERSION      = 1;
+}   // namespace RtLogDataConstant
+
+// Column value type. Stored in the binary file header, so values must not change.
+enum class DataType : uint8_t
+{
+    none = 0,
+    i8, u8, i16, u16, i32, u32, i64, u64, f32, f64, boolean
+};
+
+enum class DataFormat : uint8_t
+{
+    binary,   // columnar blocks (see DataFileHeader)
+    csv,      // text, one row per sample (formatted on the drain thread)
+};
+
+inline constexpr size_t DataTypeSize(DataType type) noexcept
+{
+    switch (type)
+    {
+        case DataType::i8:  case DataType::u8:  case DataType::boolean: return 1;
+        case DataType::i16: case DataType::u16: return 2;
+        case DataType::i32: case DataType::u32: case DataType::f32: return 4;
+        case DataType::i64: case DataType::u64: case DataType::f64: return 8;
+        default: return 0;
+    }
+}
+
+inline const char *DataTypeName(DataType type) noexcept
+{
+    switch (type)
+    {
+        case DataType::i8:      return "i8";
+        case DataType::u8:      return "u8";
+        case DataType::i16:     return "i16";
+        case DataType::u16:     return "u16";
+        case DataType::i32:     return "i32";
+        case DataType::u32:     return "u32";
+        case DataType::i64:     return "i64";
+        case DataType::u64:     return "u64";
+        case DataType::f32:     return "f32";
+        case DataType::f64:     return "f64";
+        case DataType::boolean: return "bool";
+        default:                return "?";
+    }
+}
+
+template<typename T>
+constexpr DataType DataTypeOf() noexcept
+{
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "LOG_DATA accepts arithmetic values only");
+    if constexpr (std::is_enum<T>::value)
+    {
+        return DataTypeOf<std::underlying_type_t<T>>();
+    }
+    else if constexpr (std::is_same<T, bool>::value)
+    {
+        return DataType::boolean;
+    }
+    else if constexpr (std::is_floating_point<T>::value)
+    {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "long double is not supported");
+        return (sizeof(T) == 4) ? DataType::f32 : DataType::f64;
+    }
+    else if constexpr (std::is_signed<T>::value)
+    {
+        return (sizeof(T) == 1) ? DataType::i8 : (sizeof(T) == 2) ? DataType::i16 : (sizeof(T) == 4) ? DataType::i32 : DataType::i64;
+    }
+    else
+    {
+        return (sizeof(T) == 1) ? DataType::u8 : (sizeof(T) == 2) ? DataType::u16 : (sizeof(T) == 4) ? DataType::u32 : DataType::u64;
+    }
+}
+
+// Binary file layout (little endian, packed):
+//
+//   DataFileHeader
+//   DataColumnDesc x columns
+//   { DataBlockHeader, int64_t wall_ns[rows], column 0 values[rows], column 1 values[rows], ... } x N
+//
+// Each block stores one column after another, so a reader can mmap a column without
+// touching the others. The last block may have fewer than BLOCK_ROWS rows.
+#pragma pack(push, 1)
+struct DataFileHeader
+{
+    uint32_t magic;                                // RtLogDataConstant::FILE_MAGIC
+    uint16_t version;                              // RtLogDataConstant::FILE_VERSION
+    uint16_t columns;
+    int64_t  created_ns;                           // CLOCK_REALTIME
+    char     channel[RtLogDataConstant::NAME_LEN];
+};
+
+struct DataColumnDesc
+{
+    uint8_t type;                                  // DataType
+    char    name[RtLogDataConstant::NAME_LEN];
+};
+
+struct DataBlockHeader
+{
+    uint32_t magic;                                // RtLogDataConstant::BLOCK_MAGIC
+    uint32_t rows;
+};
+#pragma pack(pop)
+
+// MPSC queue of raw samples, separate from the text log queue.
+// Producers reserve a slot, write values straight into it and commit it — no
+// intermediate Entry copy. Same sequence scheme as LogQueue.
+class DataQueue
+{
+public:
+    struct SlotHeader
+    {
+        std::atomic<uint32_t> seq{0};
+        uint16_t              channel{0};
+        uint16_t              bytes{0};
+        int64_t               timeStamp_ns{0};
+        // followed by SlotBytes() payload bytes
+    };
+
+    DataQueue() noexcept = default;
+    ~DataQueue() { Release(); }
+
+    DataQueue(const DataQueue &)            = delete;
+    DataQueue &operator=(const DataQueue &) = delete;
+
+    // nonRT: capacity rounded up to power of 2, slotBytes rounded up to 8
+    bool Allocate(size_t capacity, size_t slotBytes, const dt::Utils::RtMemOptions &opt) noexcept;
+    void Release() noexcept;
+
+    // producer: returns the slot to fill, or nullptr if the queue is full
+    SlotHeader *Reserve(uint32_t &pos) noexcept
+    {
+        if (!m_base)
+        {
+            return nullptr;
+        }
+
+        pos = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            SlotHeader *slot = SlotAt(pos);
+            int32_t diff = (int32_t)slot->seq.load(std::memory_order_acquire) - (int32_t)pos;
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    return slot;
+                }
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Commit(SlotHeader *slot, uint32_t pos) noexcept
+    {
+        slot->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    // consumer: next committed slot or nullptr; Pop() after processing it
+    const SlotHeader *Front() const noexcept
+    {
+        if (!m_base)
+        {
+            return nullptr;
+        }
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        SlotHeader *slot = SlotAt(tail);
+        return (slot->seq.load(std::memory_order_acquire) == tail + 1) ? slot : nullptr;
+    }
+
+    void Pop() noexcept
+    {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        m_tail.store(tail + 1, std::memory_order_relaxed);
+        SlotAt(tail)->seq.store(tail + static_cast<uint32_t>(m_slotCap), std::memory_order_release);
+    }
+
+    static char *Payload(SlotHeader *slot) noexcept { return reinterpret_cast<char *>(slot) + sizeof(SlotHeader); }
+    static const char *Payload(const SlotHeader *slot) noexcept { return reinterpret_cast<const char *>(slot) + sizeof(SlotHeader); }
+
+    size_t ApproxSize() const noexcept { return static_cast<size_t>(m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire)); }
+    size_t Capacity() const noexcept { return m_slotCap; }
+    size_t SlotBytes() const noexcept { return m_slotBytes; }
+    const dt::Utils::RtMemBlock &Memory() const noexcept { return m_mem; }
+
+private:
+    SlotHeader *SlotAt(uint32_t idx) const noexcept
+    {
+        return reinterpret_cast<SlotHeader *>(m_base + (idx & m_mask) * m_stride);
+    }
+
+    alignas(64) std::atomic<uint32_t> m_head{0};
+    alignas(64) std::atomic<uint32_t> m_tail{0};
+    alignas(64) char                 *m_base{nullptr};
+    size_t                            m_stride{0};
+    size_t                            m_mask{0};
+    size_t                            m_slotCap{0};
+    size_t                            m_slotBytes{0};
+    dt::Utils::RtMemBlock             m_mem{};
+};
+
+struct DataChannelStats
+{
+    uint64_t samples;    // samples written to the file
+    uint64_t dropped;    // data queue full, or written while another producer registered the schema
+    uint64_t rejected;   // value count / types do not match the channel schema, too many values or sample too large
+    uint16_t columns;    // 0 until the first sample registered the schema
+    bool     schemaReady;
+};
+
+// RtLogData — LOG_DATA() telemetry channels, owned by RtLog.
+//
+// Channel 은 nonRT 에서 CreateDataChannel() 로 만들고(파일, 포맷, 컬럼 이름), column 타입은
+// 해당 channel 의 첫 LOG_DATA() 호출 인자 타입으로 한 번 등록된다. 이후 샘플은 schema 와
+// 비교하여 다르면 버린다(rejected). Producer 는 값을 포맷하지 않고 raw bytes 로 data queue
+// 에 넣으며, drain 스레드가 binary column block 또는 CSV 로 기록한다.
+class RtLogData
+{
+public:
+    // Per call-site cache of the channel lookup / schema check (static in LOG_DATA()).
+    // Packed in one word so concurrent callers of the same site see a consistent value:
+    //   [63:32] generation  [31:24] channel  [23:8] value count  [7:0] verdict
+    struct Site
+    {
+        constexpr explicit Site(const char *channelName) noexcept : name(channelName) {}
+        const char           *name;
+        std::atomic<uint64_t> cache{0};
+    };
+
+    RtLogData() noexcept = default;
+    ~RtLogData();
+
+    RtLogData(const RtLogData &)            = delete;
+    RtLogData &operator=(const RtLogData &) = delete;
+
+    // nonRT (RtLog::Initialize / Terminate). capacity 0 disables LOG_DATA().
+    bool Open(size_t capacity, size_t slotBytes, const dt::Utils::RtMemOptions &opt) noexcept;
+    void Close() noexcept;
+    // nonRT. Close() and unmap the queue. Only while no producer can hold a slot, i.e. no
+    // channel was created since Open() (RtLog::Initialize failure path).
+    void Release() noexcept;
+
+    // nonRT. Takes ownership of fd. columns may be empty (named c0, c1, ... once the schema is known).
+    // Returns false if the name is taken, the channel table is full or there are too many columns.
+    bool CreateChannel(const std::string &name, int fd, const std::vector<std::string> &columns, DataFormat format);
+
+    // RT-safe producer paths (no formatting, no syscall other than clock_gettime)
+    template<typename... Ts>
+    void Write(Site &site, Ts... values) noexcept;
+
+    template<typename T>
+    void WriteArray(Site &site, const T *values, size_t count) noexcept;
+
+    // drain thread: move queued samples into the channel buffers, write full blocks.
+    // wallOffset_ns = CLOCK_REALTIME - CLOCK_MONOTONIC
+    size_t Drain(int64_t wallOffset_ns) noexcept;
+
+    // drain thread: write partially filled blocks (force, or every FLUSH_INTERVAL_NS)
+    void Flush(int64_t now_ns, bool force) noexcept;
+
+    bool GetStats(const char *channelName, DataChannelStats &stats) const noexcept;
+
+    // fn(const char *name, const DataChannelStats &) for every created channel (nonRT)
+    template<typename Fn>
+    void ForEachChannel(Fn &&fn) const
+    {
+        for (const auto &ch : m_channels)
+        {
+            DataChannelStats stats{};
+            if (ch.used.load(std::memory_order_acquire) && GetStats(ch.name, stats))
+            {
+                fn(ch.name, stats);
+            }
+        }
+    }
+    uint64_t UnknownChannelCount() const noexcept { return m_unknown.load(std::memory_order_relaxed); }
+    const DataQueue &Queue() const noexcept { return m_queue; }
+
+private:
+    enum Verdict : uint8_t { VERDICT_NONE = 0, VERDICT_OK = 1, VERDICT_REJECT = 2 };
+    enum SchemaState : uint8_t { SCHEMA_NONE = 0, SCHEMA_WRITING = 1, SCHEMA_READY = 2 };
+
+    struct Channel
+    {
+        // shared with producers
+        std::atomic<bool>     used{false};
+        std::atomic<uint8_t>  schema{SCHEMA_NONE};
+        char                  name[RtLogDataConstant::NAME_LEN]{};
+        uint16_t              namedColumns{0};   // from CreateChannel(), 0 = auto names
+        uint16_t              columns{0};
+        uint32_t              rowBytes{0};
+        std::array<DataType, RtLogDataConstant::MAX_COLUMNS> types{};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> rejected{0};
+
+        // drain thread only
+        int                      fd{-1};
+        DataFormat               format{DataFormat::binary};
+        std::vector<std::string> columnNames;
+        std::vector<uint32_t>    offsets;        // value offset in a sample
+        std::vector<char>        block;          // binary: column-major block, csv: text
+        uint32_t                 rows{0};
+        bool                     headerWritten{false};
+        bool                     failed{false};
+        int64_t                  lastFlush_ns{0};
+        std::atomic<uint64_t>    samples{0};
+    };
+
+    uint64_t Resolve(Site &site, const DataType *types, DataType uniform, uint16_t count, size_t bytes, uint32_t gen) noexcept;
+    void Reject(uint64_t cache) noexcept;
+
+    void Append(Channel &ch, int64_t wall_ns, const char *payload) noexcept;
+    void WriteHeader(Channel &ch) noexcept;
+    void WriteBlock(Channel &ch) noexcept;
+    void WriteAll(Channel &ch, const void *data, size_t len) noexcept;
+
+    template<typename T>
+    static void Store(char *&dst, T value) noexcept
+    {
+        std::memcpy(dst, &value, sizeof(T));
+        dst += sizeof(T);
+    }
+
+    DataQueue                                                m_queue;
+    std::array<Channel, RtLogDataConstant::MAX_CHANNELS>     m_channels{};
+    std::atomic<uint32_t>                                    m_generation{1};
+    std::atomic<bool>                                        m_enabled{false};
+    std::atomic<uint64_t>                                    m_unknown{0};
+    std::mutex                                               m_createMutex;
+};
+
+template<typename... Ts>
+void RtLogData::Write(Site &site, Ts... values) noexcept
+{
+    static_assert(sizeof...(Ts) > 0, "LOG_DATA needs at least one value");
+    static_assert(sizeof...(Ts) <= RtLogDataConstant::MAX_COLUMNS, "too many LOG_DATA values");
+    static constexpr DataType TYPES[] = {DataTypeOf<Ts>()...};
+    static constexpr size_t   BYTES   = (sizeof(Ts) + ... + 0);
+
+    if (!m_enabled.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    const uint32_t gen = m_generation.load(std::memory_order_acquire);
+    uint64_t cache = site.cache.load(std::memory_order_acquire);
+    if (static_cast<uint32_t>(cache >> 32) != gen || static_cast<uint8_t>(cache) == VERDICT_NONE)
+    {
+        cache = Resolve(site, TYPES, DataType::none, static_cast<uint16_t>(sizeof...(Ts)), BYTES, gen);
+    }
+    if (static_cast<uint8_t>(cache) != VERDICT_OK)
+    {
+        Reject(cache);
+        return;
+    }
+
+    const uint16_t chIdx = static_cast<uint16_t>((cache >> 24) & 0xFF);
+    uint32_t pos;
+    DataQueue::SlotHeader *slot = m_queue.Reserve(pos);
+    if (!slot)
+    {
+        m_channels[chIdx].dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    char *dst = DataQueue::Payload(slot);
+    (Store(dst, values), ...);
+    slot->channel      = chIdx;
+    slot->bytes        = static_cast<uint16_t>(BYTES);
+    slot->timeStamp_ns = dt::Utils::MonotonicNs();
+    m_queue.Commit(slot, pos);
+}
+
+template<typename T>
+void RtLogData::WriteArray(Site &site, const T *values, size_t count) noexcept
+{
+    if (!m_enabled.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    const uint32_t gen = m_generation.load(std::memory_order_acquire);
+    uint64_t cache = site.cache.load(std::memory_order_acquire);
+    if (static_cast<uint32_t>(cache >> 32) != gen || static_cast<uint8_t>(cache) == VERDICT_NONE ||
+        static_cast<uint16_t>(cache >> 8) != count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        // more than MAX_COLUMNS values: Resolve() rejects it (counted in the channel's 'rejected')
+        const size_t n = std::min(count, RtLogDataConstant::MAX_COLUMNS + 1);
+        cache = Resolve(site, nullptr, DataTypeOf<T>(), static_cast<uint16_t>(n), n * sizeof(T), gen);
+    }
+    if (static_cast<uint8_t>(cache) != VERDICT_OK)
+    {
+        Reject(cache);
+        return;
+    }
+
+    const uint16_t chIdx = static_cast<uint16_t>((cache >> 24) & 0xFF);
+    uint32_t pos;
+    DataQueue::SlotHeader *slot = m_queue.Reserve(pos);
+    if (!slot)
+    {
+        m_channels[chIdx].dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::memcpy(DataQueue::Payload(slot), values, count * sizeof(T));
+    slot->channel      = chIdx;
+    slot->bytes        = static_cast<uint16_t>(count * sizeof(T));
+    slot->timeStamp_ns = dt::Utils::MonotonicNs();
+    m_queue.Commit(slot, pos);
+}
+
+}   // namespace Log
+
+}   // namespace dt
+
+#endif  // _DT_RTLOG_DATA_H_
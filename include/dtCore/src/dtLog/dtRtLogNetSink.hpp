@@ -0,0 +1,545 @@
+/*!
+ \file      dtRtLogNetSink.hpp
+ \brief     Network log streaming sink (TCP / UNIX socket) for RtLog
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTLOG_NETSINK_H_
+#define _DT_RTLOG_NETSINK_H_
+
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/base_sink.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../dtUtils/dtTimeUtil.hpp"
+
+namespace dt
+{
+namespace Log
+{
+
+// ─── Wire format ────────────────────────────────────────────────────────────
+//
+// Byte stream of frames. All integers are little-endian (host order on x86_64 / aarch64).
+//
+//   Frame  = NetLogFrameHeader + 'count' records ('length' bytes)
+//   Record = NetLogRecordHeader + name[nameLen] + msg[length - (sizeof(NetLogRecordHeader) - 2) - nameLen]
+//
+// msg is the line formatted by the sink pattern, without the trailing newline.
+// Every record is numbered when the sink takes it, and the number survives reconnects:
+// 'seq' is the number of the first record of the frame, so the next frame of the same
+// 'stream' starts at seq + count. A gap on the collector side, also across connections,
+// means records were lost: frames dropped from the spill buffer while the collector was
+// unreachable, or entries the RtLog queue dropped when it was full (NoteDropped()).
+namespace NetLogConstant
+{
+    inline constexpr uint32_t FRAME_MAGIC        = 0x464C5444;   // "DTLF"
+    inline constexpr uint16_t FRAME_VERSION      = 2;
+    inline constexpr size_t   FRAME_MAX_BYTES    = 64 * 1024;    // sealed when the next record does not fit
+    inline constexpr size_t   SPILL_MAX_BYTES    = 4 * 1024 * 1024;
+    inline constexpr long     BACKOFF_MIN_NS     = 100'000'000L;   // 100 ms
+    inline constexpr long     BACKOFF_MAX_NS     = 5'000'000'000L; // 5 s
+    inline constexpr int      CLOSE_FLUSH_MS     = 200;            // best-effort send at sink destruction
+    inline constexpr const char *SELECTOR        = "_NET_:";       // fileBasename prefix
+}   // namespace NetLogConstant
+
+#pragma pack(push, 1)
+struct NetLogFrameHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;     // records in this frame
+    uint32_t length;    // payload bytes following this header
+    uint32_t seq;       // sequence number of the first record
+    uint32_t stream;    // sender id, fixed for the lifetime of the sink
+};
+
+struct NetLogRecordHeader
+{
+    uint16_t length;        // bytes following this field
+    uint8_t  level;         // spdlog::level::level_enum
+    uint8_t  nameLen;       // logger name bytes
+    int64_t  timeStamp_ns;  // wall clock, ns since epoch
+};
+#pragma pack(pop)
+
+// Collector endpoint, parsed from "tcp:<host>:<port>" or "unix:<path>".
+struct NetLogEndpoint
+{
+    bool        isUnix{false};
+    std::string host;
+    uint16_t    port{0};
+    std::string path;
+
+    // Accepts the spec with or without the "_NET_:" selector prefix.
+    static bool Parse(const std::string &spec, NetLogEndpoint &out)
+    {
+        std::string s = spec;
+        const size_t selLen = std::strlen(NetLogConstant::SELECTOR);
+        if (s.compare(0, selLen, NetLogConstant::SELECTOR) == 0)
+        {
+            s = s.substr(selLen);
+        }
+
+        out = NetLogEndpoint{};
+        if (s.compare(0, 5, "unix:") == 0)
+        {
+            out.isUnix = true;
+            out.path   = s.substr(5);
+            return !out.path.empty() && out.path.size() < sizeof(sockaddr_un::sun_path);
+        }
+
+        if (s.compare(0, 4, "tcp:") == 0)
+        {
+            s = s.substr(4);
+            size_t colon = s.rfind(':');
+            if (colon == std::string::npos || colon == 0)
+            {
+                return false;
+            }
+            out.host = s.substr(0, colon);
+            if (out.host.size() >= 2 && out.host.front() == '[' && out.host.back() == ']')
+            {
+                out.host = out.host.substr(1, out.host.size() - 2);  // IPv6 literal: "[::1]:port"
+            }
+            char *end = nullptr;
+            long port = std::strtol(s.c_str() + colon + 1, &end, 10);
+            if (!end || *end != '\0' || port <= 0 || port > 65535)
+            {
+                return false;
+            }
+            out.port = static_cast<uint16_t>(port);
+            return true;
+        }
+
+        return false;
+    }
+
+    static bool IsSelector(const std::string &fileBasename) noexcept
+    {
+        return fileBasename.compare(0, std::strlen(NetLogConstant::SELECTOR), NetLogConstant::SELECTOR) == 0;
+    }
+};
+
+// NetSinkT — streams formatted log lines to a collector over TCP or a UNIX socket
+//
+// Design:
+//   sink_it_(): appends one record to the current frame (no syscall)
+//   flush_()  : seals the frame into the spill buffer, then sends as much as the
+//               socket accepts with non-blocking send(). Called every FLUSH_INTERVAL_NS
+//               by the RtLog drain thread, so it never blocks the drain loop.
+//
+// Connection loss: the socket is closed and re-opened with exponential backoff
+// (BACKOFF_MIN_NS ~ BACKOFF_MAX_NS). Frames stay in the spill buffer meanwhile;
+// when it exceeds spillBytes the oldest frames are dropped (see Stats()).
+// A frame that was partially sent before the loss is re-sent from its start.
+// Record numbers are not reset on reconnect, so the collector sees every loss as a gap.
+//
+// Two aliases:
+//   NetSink   — null_mutex, drain thread
+//   NetSinkMt — std::mutex, multi-threaded usage
+template<typename Mutex>
+class NetSinkT final : public spdlog::sinks::base_sink<Mutex>
+{
+    using Base = spdlog::sinks::base_sink<Mutex>;
+
+public:
+    struct Stats
+    {
+        uint64_t framesSent{0};
+        uint64_t framesDropped{0};   // dropped from the spill buffer (overflow)
+        uint64_t recordsDropped{0};
+        uint64_t recordsSkipped{0};  // reported by NoteDropped()
+        uint64_t connects{0};        // successful (re)connections
+        size_t   spillBytes{0};      // bytes currently waiting in the spill buffer
+        bool     connected{false};
+    };
+
+    explicit NetSinkT(const NetLogEndpoint &endpoint, size_t spillBytes = NetLogConstant::SPILL_MAX_BYTES)
+        : m_endpoint(endpoint), m_spillMax(spillBytes)
+    {
+        m_streamId = static_cast<uint32_t>(dt::Utils::MonotonicNs() ^ (static_cast<int64_t>(::getpid()) << 32));
+        m_frame.reserve(NetLogConstant::FRAME_MAX_BYTES);
+        ResetFrame();
+        ResolveEndpoint();
+    }
+
+    ~NetSinkT() override
+    {
+        // Best effort: give the collector a short window to take the last frames.
+        SealFrame();
+        int64_t deadline = dt::Utils::MonotonicNs() + NetLogConstant::CLOSE_FLUSH_MS * 1'000'000LL;
+        while (m_addrValid && !m_spill.empty() && dt::Utils::MonotonicNs() < deadline)
+        {
+            if (m_state != State::CONNECTED)
+            {
+                m_nextConnect_ns = 0;
+                TryConnect();
+            }
+            if (m_state == State::CONNECTED)
+            {
+                SendPending();
+            }
+            if (!m_spill.empty())
+            {
+                struct pollfd pfd{m_fd, POLLOUT, 0};
+                (void)::poll(&pfd, (m_fd >= 0) ? 1 : 0, 10);
+            }
+        }
+        CloseSocket();
+    }
+
+    NetSinkT(const NetSinkT &)            = delete;
+    NetSinkT &operator=(const NetSinkT &) = delete;
+
+    Stats GetStats()
+    {
+        std::lock_guard<Mutex> lock(Base::mutex_);
+        Stats st = m_stats;
+        st.spillBytes = m_spillSize;
+        st.connected  = (m_state == State::CONNECTED);
+        return st;
+    }
+
+    // n records were lost before reaching the sink (e.g. the RtLog queue was full): skip
+    // their numbers so the collector reports the gap at this point of the stream.
+    void NoteDropped(uint32_t n)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+        std::lock_guard<Mutex> lock(Base::mutex_);
+        if (m_frameCount > 0)
+        {
+            SealFrame();  // records of a frame are numbered consecutively
+        }
+        m_recordSeq += n;
+        m_stats.recordsSkipped += n;
+    }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg &msg) override
+    {
+        spdlog::memory_buf_t buf;
+        Base::formatter_->format(msg, buf);
+
+        size_t len = buf.size();
+        while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == '\r'))
+        {
+            --len;
+        }
+
+        const size_t nameLen = std::min(msg.logger_name.size(), static_cast<size_t>(255));
+        const size_t maxMsg  = 0xFFFF - (sizeof(NetLogRecordHeader) - sizeof(uint16_t)) - nameLen;
+        len = std::min(len, maxMsg);
+
+        const size_t recBytes = sizeof(NetLogRecordHeader) + nameLen + len;
+        if (m_frameCount > 0 && (m_frame.size() + recBytes > NetLogConstant::FRAME_MAX_BYTES || m_frameCount == UINT16_MAX))
+        {
+            SealFrame();
+        }
+        if (m_frameCount == 0)
+        {
+            m_frameSeq = m_recordSeq;
+        }
+        ++m_recordSeq;
+
+        NetLogRecordHeader rh{};
+        rh.length       = static_cast<uint16_t>(recBytes - sizeof(uint16_t));
+        rh.level        = static_cast<uint8_t>(msg.level);
+        rh.nameLen      = static_cast<uint8_t>(nameLen);
+        rh.timeStamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+
+        const char *p = reinterpret_cast<const char *>(&rh);
+        m_frame.insert(m_frame.end(), p, p + sizeof(rh));
+        m_frame.insert(m_frame.end(), msg.logger_name.data(), msg.logger_name.data() + nameLen);
+        m_frame.insert(m_frame.end(), buf.data(), buf.data() + len);
+        ++m_frameCount;
+    }
+
+    void flush_() override
+    {
+        SealFrame();
+
+        if (m_state != State::CONNECTED)
+        {
+            TryConnect();
+        }
+
+        if (m_state == State::CONNECTED)
+        {
+            SendPending();
+        }
+    }
+
+private:
+    enum class State { DISCONNECTED, CONNECTING, CONNECTED };
+
+    NetLogEndpoint           m_endpoint;
+    sockaddr_storage         m_addr{};
+    socklen_t                m_addrLen{0};
+    bool                     m_addrValid{false};
+    bool                     m_resolveWarned{false};
+
+    int                      m_fd{-1};
+    State                    m_state{State::DISCONNECTED};
+    int64_t                  m_nextConnect_ns{0};
+    int64_t                  m_backoff_ns{NetLogConstant::BACKOFF_MIN_NS};
+
+    std::vector<char>        m_frame;           // frame being built (header + records)
+    uint16_t                 m_frameCount{0};
+    uint32_t                 m_frameSeq{0};     // number of the first record in m_frame
+    uint32_t                 m_recordSeq{0};    // number of the next record, kept across reconnects
+    uint32_t                 m_streamId{0};
+
+    std::deque<std::vector<char>> m_spill;      // sealed frames waiting to be sent
+    size_t                   m_spillSize{0};
+    size_t                   m_spillMax;
+    size_t                   m_sendOffset{0};   // bytes of m_spill.front() already sent
+
+    Stats                    m_stats{};
+
+private:
+    void ResetFrame()
+    {
+        m_frame.resize(sizeof(NetLogFrameHeader));
+        m_frameCount = 0;
+    }
+
+    void SealFrame()
+    {
+        if (m_frameCount == 0)
+        {
+            return;
+        }
+
+        NetLogFrameHeader fh{};
+        fh.magic   = NetLogConstant::FRAME_MAGIC;
+        fh.version = NetLogConstant::FRAME_VERSION;
+        fh.count   = m_frameCount;
+        fh.length  = static_cast<uint32_t>(m_frame.size() - sizeof(NetLogFrameHeader));
+        fh.seq     = m_frameSeq;
+        fh.stream  = m_streamId;
+        std::memcpy(m_frame.data(), &fh, sizeof(fh));
+
+        m_spillSize += m_frame.size();
+        m_spill.emplace_back(std::move(m_frame));
+        m_frame = std::vector<char>();
+        m_frame.reserve(NetLogConstant::FRAME_MAX_BYTES);
+        ResetFrame();
+
+        // Bound the spill buffer: drop oldest frames, but never the one being sent.
+        while (m_spillSize > m_spillMax && m_spill.size() > 1)
+        {
+            auto it = m_spill.begin();
+            if (m_sendOffset > 0)
+            {
+                ++it;
+            }
+            if (it == m_spill.end())
+            {
+                break;
+            }
+            NetLogFrameHeader dh{};
+            std::memcpy(&dh, it->data(), sizeof(dh));
+            m_stats.framesDropped++;
+            m_stats.recordsDropped += dh.count;
+            m_spillSize -= it->size();
+            m_spill.erase(it);
+        }
+    }
+
+    void ResolveEndpoint() noexcept
+    {
+        m_addrValid = false;
+        if (m_endpoint.isUnix)
+        {
+            sockaddr_un un{};
+            un.sun_family = AF_UNIX;
+            std::strncpy(un.sun_path, m_endpoint.path.c_str(), sizeof(un.sun_path) - 1);
+            std::memcpy(&m_addr, &un, sizeof(un));
+            m_addrLen   = sizeof(un);
+            m_addrValid = true;
+            return;
+        }
+
+        // Resolved here first (nonRT, Initialize()). On failure TryConnect() retries on the
+        // reconnect backoff, so the drain thread does a DNS lookup at most once per backoff.
+        addrinfo hints{};
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *res = nullptr;
+        char port[8];
+        std::snprintf(port, sizeof(port), "%u", static_cast<unsigned>(m_endpoint.port));
+        int rtn = getaddrinfo(m_endpoint.host.c_str(), port, &hints, &res);
+        if (rtn == 0 && res)
+        {
+            std::memcpy(&m_addr, res->ai_addr, res->ai_addrlen);
+            m_addrLen   = res->ai_addrlen;
+            m_addrValid = true;
+            freeaddrinfo(res);
+            return;
+        }
+
+        // Written to stderr, not RtLog: this runs on the drain thread that feeds this sink.
+        if (!m_resolveWarned)
+        {
+            std::fprintf(stderr, "[RtLog] NetSink: cannot resolve '%s' (%s), retrying\n",
+                         m_endpoint.host.c_str(), (rtn != 0) ? gai_strerror(rtn) : "no address");
+            m_resolveWarned = true;
+        }
+    }
+
+    void CloseSocket() noexcept
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+        m_state = State::DISCONNECTED;
+    }
+
+    void ScheduleReconnect() noexcept
+    {
+        CloseSocket();
+        m_sendOffset     = 0;  // new stream: resend the interrupted frame from its start
+        m_nextConnect_ns = dt::Utils::MonotonicNs() + m_backoff_ns;
+        m_backoff_ns     = std::min(m_backoff_ns * 2, NetLogConstant::BACKOFF_MAX_NS);
+    }
+
+    void TryConnect() noexcept
+    {
+        if (!m_addrValid)
+        {
+            if (dt::Utils::MonotonicNs() < m_nextConnect_ns)
+            {
+                return;
+            }
+            ResolveEndpoint();
+            if (!m_addrValid)
+            {
+                ScheduleReconnect();
+                return;
+            }
+        }
+
+        if (m_state == State::DISCONNECTED)
+        {
+            if (dt::Utils::MonotonicNs() < m_nextConnect_ns)
+            {
+                return;
+            }
+
+            int family = m_endpoint.isUnix ? AF_UNIX : m_addr.ss_family;
+            m_fd = ::socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (m_fd < 0)
+            {
+                ScheduleReconnect();
+                return;
+            }
+
+            if (!m_endpoint.isUnix)
+            {
+                int one = 1;
+                (void)setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+
+            int rtn = ::connect(m_fd, reinterpret_cast<const sockaddr *>(&m_addr), m_addrLen);
+            if (rtn == 0)
+            {
+                OnConnected();
+                return;
+            }
+            if (errno != EINPROGRESS && errno != EAGAIN)
+            {
+                ScheduleReconnect();
+                return;
+            }
+            m_state = State::CONNECTING;
+        }
+
+        // CONNECTING: check completion without blocking
+        struct pollfd pfd{m_fd, POLLOUT, 0};
+        int n = ::poll(&pfd, 1, 0);
+        if (n <= 0)
+        {
+            return;  // still in progress
+        }
+
+        int       err = 0;
+        socklen_t len = sizeof(err);
+        if (getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0)
+        {
+            ScheduleReconnect();
+            return;
+        }
+        OnConnected();
+    }
+
+    void OnConnected() noexcept
+    {
+        m_state      = State::CONNECTED;
+        m_backoff_ns = NetLogConstant::BACKOFF_MIN_NS;
+        m_sendOffset = 0;
+        m_stats.connects++;
+    }
+
+    void SendPending() noexcept
+    {
+        while (!m_spill.empty())
+        {
+            std::vector<char> &f = m_spill.front();
+            ssize_t n = ::send(m_fd, f.data() + m_sendOffset, f.size() - m_sendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    ScheduleReconnect();  // EPIPE / ECONNRESET ...
+                }
+                return;  // socket buffer full: retry on next flush
+            }
+
+            m_sendOffset += static_cast<size_t>(n);
+            if (m_sendOffset >= f.size())
+            {
+                m_spillSize -= f.size();
+                m_spill.pop_front();
+                m_sendOffset = 0;
+                m_stats.framesSent++;
+            }
+        }
+    }
+};
+
+using NetSink   = NetSinkT<spdlog::details::null_mutex>;
+using NetSinkMt = NetSinkT<std::mutex>;
+
+} // namespace Log
+} // namespace dt
+
+#endif  // _DT_RTLOG_NETSINK_H_
@@ -4,16 +4,24 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdarg.h>
+#include <string.h>
 #include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 #include "dtLogQueue.hpp"
+#include "dtRtTuiHistory.hpp"
+#include "dtRtTuiPlot.hpp"
 
 namespace dt
 {
 namespace Log
 {
 
+struct TuiShmSegment;
+
 // ───────────────────────────────────────────────
 // RtTui : main class
 // ───────────────────────────────────────────────
@@ -29,26 +37,84 @@ public:
     static constexpr int    TUI_MAX_COLS           = 10;   // max columns per row
     static constexpr size_t TUI_TEXT_ROW_LEN       = 200;  // max text length for text-mode rows
     static constexpr int    AREA2_MIN_ROWS         = 5;    // minimum Area 2 height (rows)
-    static constexpr size_t LOG_KEEP               = 2000; // log history circular buffer capacity
     static constexpr size_t OUT_BUF_SIZE           = 262144; // 256 KB output buffer
     static constexpr int    MAX_LAYOUTS            = 9;    // layouts switchable via keys '1'–'9'
-    static constexpr size_t QUEUE_CAPACITY         = 1024;
-    static constexpr size_t QUEUE_MSG_LEN          = 1024;
-
-    // TUI uses MpscLogQueue with QUEUE_CAPACITY capacity and QUEUE_MSG_LEN-byte messages
+    static constexpr size_t QUEUE_CAPACITY         = 1024; // default queue slots
+    static constexpr size_t QUEUE_MSG_LEN          = 1024; // max message length (Entry buffer)
+    static constexpr size_t TUI_MAX_PLOTS          = 32;   // numeric-channel widgets (all layouts)
+    static constexpr size_t TUI_MAX_FORMATS        = 128;  // distinct TUI_VAL format specs (process-wide)
+    static constexpr int    DIFF_MAX_GAP           = 6;    // unchanged cells re-sent instead of a cursor move
+    static constexpr long   SIZE_CHECK_INTERVAL_NS = 1'000'000'000L; // fallback ioctl when SIGWINCH is not delivered
+    static constexpr size_t PROMPT_LEN             = 128;  // Area 2 search / filter prompt ('/')
+    static constexpr size_t SEARCH_STEP_LINES      = 20000; // history lines searched per Tick()
+    static constexpr long   ATTACH_STALE_NS        = 1'000'000'000L; // viewer: re-attach when the snapshot stops changing
+
+    // TUI uses MpscLogQueue; slot count / message length are set at Init()
     using TuiLogQueue = LogQueue<QUEUE_CAPACITY, QUEUE_MSG_LEN>;
     using TuiLogEntry = TuiLogQueue::Entry;
 
     // ───────────────────────────────────────────────
     // Area 1 data structures (double-buffered, RT-safe)
     // ───────────────────────────────────────────────
+    // Raw typed column value for SetRowVals()/SetRowRaw(): the value is stored as-is with an
+    // interned format-spec id and formatted by RenderArea1 only when the row is drawn.
+    // Construct via TUI_VAL("%+8.1f", pos) so the format is interned once per call site.
+    struct TuiVal
+    {
+        enum Kind : uint8_t { SIGNED, UNSIGNED, FLOAT };
+
+        uint16_t fmtId{0};   // InternFormat() id, 0 = invalid format ("?")
+        uint8_t  kind{SIGNED};
+        uint8_t  bytes{8};   // source width: a negative int shown with %X keeps its own width
+        union
+        {
+            int64_t  i;
+            uint64_t u;
+            double   d;
+        };
+
+        TuiVal() noexcept : i(0) {}
+
+        template<typename T>
+        TuiVal(uint16_t id, T value) noexcept : fmtId(id), bytes((uint8_t)sizeof(T))
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                          "TuiVal: arithmetic or enum value required (use TUI_COL for strings)");
+            if constexpr (std::is_enum_v<T>)
+            {
+                using U = std::underlying_type_t<T>;
+                kind = std::is_signed_v<U> ? SIGNED : UNSIGNED;
+                i    = static_cast<int64_t>(static_cast<U>(value));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                kind = FLOAT;
+                d    = static_cast<double>(value);
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                kind = SIGNED;
+                i    = static_cast<int64_t>(value);
+            }
+            else
+            {
+                kind = UNSIGNED;
+                u    = static_cast<uint64_t>(value);
+            }
+        }
+    };
+
     struct TuiDataRow 
     {
-        char label[TUI_DATA_COL_LEN]{};
-        char col[TUI_MAX_COLS][TUI_DATA_COL_LEN]{};
-        int  ncols{0};
-        bool textMode{false};
-        char text[TUI_TEXT_ROW_LEN]{};
+        char   label[TUI_DATA_COL_LEN]{};
+        char   col[TUI_MAX_COLS][TUI_DATA_COL_LEN]{};
+        TuiVal vals[TUI_MAX_COLS]{};   // rawMode: formatted at render time
+        int    ncols{0};
+        bool   textMode{false};
+        bool   rawMode{false};
+        bool   plotMode{false};        // plot row imported from a snapshot: text = sparkline
+        char   text[TUI_TEXT_ROW_LEN]{};
+        TuiPlotStats plot{};           // plotMode
     };
 
     struct TuiGroupRowData 
@@ -81,6 +147,19 @@ public:
         TuiDataBuffer    dataBuf[2]{};
         std::atomic<int> dataWriteIdx{0};
         bool             defined{false};  // true once any group/row is configured
+        uint8_t          plotRef[TUI_MAX_GROUPS][TUI_MAX_ROWS_PER_GROUP]{};  // plot id + 1, 0 = data row
+        int              plotRows[TUI_MAX_GROUPS]{};                         // rows reserved by plots
+    };
+
+    // Output statistics of Tick() (bytes actually written to the terminal)
+    struct RenderStats
+    {
+        uint64_t frames;          // Tick() calls that rendered a frame
+        uint64_t bytes;           // total bytes written
+        uint64_t cells;           // cells emitted by incremental rendering
+        uint64_t fullRepaints;    // frames redrawn from a cleared screen (resize, layout switch, write error)
+        uint64_t skipped;         // frames skipped because the terminal had not drained the previous one
+        size_t   lastFrameBytes;  // bytes of the most recent frame
     };
 
     // Per-column format+value pair for set_row_cols().
@@ -106,7 +185,12 @@ public:
     ~RtTui();
 
     // ── init / stop (called from NRT context) ──────────────
-    bool Init();   // enter terminal raw mode
+    // enter terminal raw mode, allocate the log queue (capacity x msgLen slots) and the
+    // Area 2 history (history.bytes of line text, optionally in an mmap'd file).
+    // headless: no terminal; Tick() only drains, updates plots and publishes snapshots.
+    bool Init(size_t queueCapacity = QUEUE_CAPACITY, size_t queueMsgLen = QUEUE_MSG_LEN,
+              const dt::Utils::RtMemOptions &memOpt = dt::Utils::RtMemOptions{},
+              const TuiHistoryConfig &history = TuiHistoryConfig{}, bool headless = false);
     void Stop();   // restore terminal
     void Tick();   // drain queue, handle keys, render (called from RtLog drain thread)
 
@@ -146,6 +230,49 @@ public:
     template<typename... Cols>
     void SetRowCols(int layoutIdx, int groupIdx, int rowIdx, const char *label, Cols &&...cols);
 
+    // Raw-value rows: no snprintf on the calling (RT) thread. Values are copied into the
+    // double buffer as-is and formatted only for the visible layout when a frame is drawn.
+    //
+    // Example:
+    //   SetRowVals(0, grp, row, "R1",
+    //       TUI_VAL("0x%04X", statusWord),
+    //       TUI_VAL("%+8.1f", desPos),
+    //       TUI_VAL("%+8d",   tgtTPU));
+    template<typename... Vals>
+    void SetRowVals(int layoutIdx, int groupIdx, int rowIdx, const char *label, const Vals &...vals) noexcept;
+
+    // Same format for every column (raw counterpart of SetRowFmt)
+    template<typename... Args>
+    void SetRowRaw(int layoutIdx, int groupIdx, int rowIdx, const char *label, uint16_t fmtId, Args... args) noexcept;
+
+    void SetRowValData(int layoutIdx, int groupIdx, int rowIdx, const char *label, const TuiVal vals[], int ncols) noexcept;
+
+    // Registers a single-conversion printf spec (e.g. "%+8.1f", "0x%04X", "%6.2f ms") and
+    // returns its id (1..TUI_MAX_FORMATS), or 0 if the spec is invalid, longer than
+    // TUI_DATA_COL_LEN - 1 characters or the table is full.
+    // Length modifiers are normalized, so "%d" and "%ld" both accept any integer value.
+    // Lock-free; TUI_VAL caches the id in a function-local static.
+    static uint16_t InternFormat(const char *fmt) noexcept;
+
+    // ── Area 1 numeric-channel widget ─────────────────────
+    // AddPlot (setup, NRT) reserves a row for a sparkline with rolling min/max/mean/p99 and
+    // returns the channel id (-1 on failure). PushPlot is RT-safe; one producer thread per
+    // channel. Samples are consumed and the statistics updated on Tick().
+    int AddPlot(int layoutIdx, int groupIdx, int rowIdx, const char *label, const TuiPlotConfig &cfg = TuiPlotConfig{});
+
+    void PushPlot(int plotId, double value) noexcept
+    {
+        if (plotId < 0 || plotId >= (int)TUI_MAX_PLOTS)
+        {
+            return;
+        }
+        TuiPlot *plot = m_plots[plotId].load(std::memory_order_acquire);
+        if (plot)
+        {
+            plot->Push(value);
+        }
+    }
+
     // Full-width text row: displays label + pre-formatted string (ignores column layout)
     void SetTextRow(int layoutIdx, int groupIdx, int rowIdx, const char *label, const char *text) noexcept;
 
@@ -160,6 +287,9 @@ public:
     // ── Area 2 log API (RT-safe) ─────────────────
     void Log(spdlog::level::level_enum level, const char *fmt, ...);
     void LogV(spdlog::level::level_enum level, const char *fmt, va_list args);
+    // Pre-formatted line from a named logger (TuiSinkT); loggerName feeds the "logger:" filter
+    void LogText(spdlog::level::level_enum level, const char *loggerName, size_t loggerLen,
+                 const char *text, size_t len) noexcept;
 
     char PopPendingKey() 
     {
@@ -172,25 +302,84 @@ public:
         return m_currentLayout.load(std::memory_order_relaxed);
     }
 
+    // Incremental rendering (default): only cells that changed since the last frame are
+    // written. Disable to repaint the whole screen every Tick() (e.g. for terminals that
+    // render box-drawing or wide glyphs with unexpected widths).
+    void SetIncrementalRender(bool enable) noexcept
+    {
+        m_incrementalReq.store(enable, std::memory_order_relaxed);
+    }
+
+    RenderStats GetRenderStats() const noexcept;
+
+    // ── Shared-memory snapshot (dtRtTuiShm.hpp) ───────────
+    // Publisher: every Tick() copies all defined layouts (rows formatted, plots as sparkline +
+    // statistics) and the newest log lines into the POSIX shm segment 'shmName' ("/name")
+    // under a seqlock. Call after Init(); the segment is removed by Stop().
+    bool OpenSnapshot(const char *shmName);
+
+    // Viewer (dttui-attach): Tick() renders the snapshot of another process instead of this
+    // process' own data; re-attaches when the publisher restarts. Call after Init().
+    bool AttachSnapshot(const char *shmName);
+
+    bool IsHeadless() const noexcept { return m_headless; }
+
+    // Let the calling thread receive SIGWINCH. Init() blocks SIGWINCH in the calling thread
+    // (and therefore in threads created afterwards, e.g. RT tasks, whose clock_nanosleep()
+    // must not be interrupted), so the thread calling Tick() has to opt in.
+    static void AcceptResizeSignal() noexcept;
+
 private:
     // ── member variables ─────────────────────────────────
     TuiLogQueue         m_logQueue;
 
     // Area 1: per-layout state (name + group headers + double-buffered data)
     TuiLayoutData       m_layouts[MAX_LAYOUTS]{};
+
+    // Numeric-channel widgets (owned by m_plotStore, published through m_plots)
+    std::unique_ptr<TuiPlot> m_plotStore[TUI_MAX_PLOTS];
+    std::atomic<TuiPlot *>   m_plots[TUI_MAX_PLOTS]{};
+    std::atomic<int>         m_plotCount{0};
+    dt::Utils::RtMemOptions  m_memOpt{};
     std::atomic<int>    m_currentLayout{0};     // 0-based; key '1' → layout 0
     std::atomic<bool>   m_layoutChanged{false}; // triggers screen clear on next tick
 
-    // Area 2: log history (NRT only, no lock needed) — circular buffer
-    TuiLogEntry         m_logHistory[LOG_KEEP]{};
-    size_t              m_logCount{0};
-    size_t              m_logHead{0};
+    // Area 2: log history (NRT only, no lock needed); offsets index its filtered view
+    TuiLogHistory       m_history;
     size_t              m_scrollOffset{0};  // 0 = bottom (newest)
     bool                m_autoScroll{true};
+
+    // Area 2 prompt ('/'): incremental search, or a "level:" / "logger:" filter on Enter
+    char                m_prompt[PROMPT_LEN]{};
+    size_t              m_promptLen{0};
+    bool                m_promptActive{false};
+    size_t              m_anchorOffset{0};      // scroll position when the prompt was opened
+    bool                m_anchorAutoScroll{true};
+    bool                m_followMatch{false};   // scroll the match into view on next render
+    char                m_promptMsg[PROMPT_LEN + 16]{};  // result of the last filter command
     std::atomic<char>   m_lastKey{0};  // TUI→main key relay
 
     std::atomic<bool>   m_running{false};
     std::atomic<bool>   m_termActive{false};
+    bool                m_headless{false};
+
+    // Shared-memory snapshot: publisher side
+    TuiShmSegment      *m_shm{nullptr};
+    char                m_shmName[64]{};
+    uint64_t            m_shmLogSeq{0};         // log lines appended so far
+    uint64_t            m_shmLogPublished{0};   // lines already copied to the segment
+
+    // Shared-memory snapshot: viewer side
+    const TuiShmSegment *m_attached{nullptr};
+    std::unique_ptr<TuiShmSegment> m_attachCopy;
+    char                m_attachName[64]{};
+    int32_t             m_attachPid{0};
+    uint64_t            m_attachInstance{0};    // TuiShmSegment::instance of the mapped segment
+    uint64_t            m_attachLogSeq{0};
+    uint64_t            m_attachFrame{0};
+    int64_t             m_attachFrame_ns{0};    // monotonic time the frame counter last advanced
+    int64_t             m_attachRetry_ns{0};
+    char                m_attachStatus[160]{};
 
     // Terminal state
     std::unique_ptr<struct termios> m_oldTermios;
@@ -204,17 +393,71 @@ private:
     char                m_outBuf[OUT_BUF_SIZE];
     size_t              m_outPos{0};
 
+    // Damage tracking: Render*() output is parsed into m_screen (what the terminal should
+    // show) instead of being written; ScreenDiff() then emits only the cells that differ
+    // from m_front (what the terminal shows now). Drain thread only.
+    struct TuiCell
+    {
+        char     glyph[4]{' ', 0, 0, 0};  // UTF-8 bytes
+        uint8_t  len{1};                  // glyph bytes, 0 = right half of a wide glyph
+        uint8_t  attr{0};                 // ATTR_* bits
+        uint16_t fg{0};                   // 0 = default, else palette index + 1
+        uint16_t bg{0};
+    };
+
+    struct TuiParser
+    {
+        enum State : uint8_t { GROUND, ESC, CSI } state{GROUND};
+        char     csi[32]{};
+        size_t   csiLen{0};
+        char     utf8[4]{};
+        uint8_t  utf8Len{0};
+        uint8_t  utf8Need{0};
+        uint32_t codePoint{0};
+        int      row{0};                  // cursor (0-based)
+        int      col{0};
+        TuiCell  pen{};                   // current SGR state (glyph unused)
+    };
+
+    std::vector<TuiCell> m_screen;
+    std::vector<TuiCell> m_front;
+    int                 m_screenRows{0};
+    int                 m_screenCols{0};
+    bool                m_clearPending{true};   // emit clear screen, m_front is blank
+    bool                m_composing{false};     // AppendData() feeds m_screen instead of writing
+    bool                m_incremental{true};
+    std::atomic<bool>   m_incrementalReq{true};
+    TuiParser           m_parser;
+    int64_t             m_lastSizeCheck_ns{0};
+
+    std::atomic<uint64_t> m_statFrames{0};
+    std::atomic<uint64_t> m_statBytes{0};
+    std::atomic<uint64_t> m_statCells{0};
+    std::atomic<uint64_t> m_statRepaints{0};
+    std::atomic<uint64_t> m_statSkipped{0};
+    std::atomic<size_t>   m_statLastFrame{0};
+
 private:
     // Helper for formatting individual columns
     template<typename T>
     void FormatColumn(char *buf, size_t buf_size, const char *format, T value);
 
+    // Formats a raw column value with its interned spec (render time)
+    static void FormatVal(char *buf, size_t bufSize, const TuiVal &val) noexcept;
+
     // Helper for setting row data (layout- and group-index based)
     void SetRowData(int layoutIdx, int groupIdx, int rowIdx, const char *label, const char *cols[], int ncols);
 
     // Compute content-driven Area 1 height using the current layout
     int CalcArea1Height() const noexcept;
 
+    // Front (read) half of a layout's double buffer, swapped in if the writer marked it dirty
+    const TuiDataBuffer &FrontBuffer(TuiLayoutData &layout) noexcept;
+
+    // Shared-memory snapshot
+    void PublishSnapshot() noexcept;
+    void ImportSnapshot() noexcept;
+
     // Recursive variadic helpers for format-based columns
     template<typename T, typename... Args>
     void FormatColumnsRecursive(int colIdx, char cols[][TUI_DATA_COL_LEN], const char *format, T value, Args... rest);
@@ -229,12 +472,42 @@ private:
     // Rendering
     void RenderArea1(int startRow, int height, int width);
     void RenderArea2(int startRow, int height, int width);
+    // plot: live channel; nullptr → pre-rendered spark (snapshot viewer)
+    void RenderPlotRow(int row, int width, const char *label, const TuiPlotStats &st,
+                       const TuiPlot *plot, const char *spark);
+    void RenderLogLine(const TuiLogHistory::Line &line, int maxCols, bool highlight);
     void RenderScrollbar(int startRow, int height, int col, size_t total, size_t visible, size_t offset);
     void RenderCmdLine(int row, int width);
 
     // Key input handler (buf: byte array read, len: byte count)
     void HandleKey(const char *buf, ssize_t len);
+    void HandlePromptKey(const char *buf, ssize_t len);
+    void ClosePrompt(bool cancel);
+    void AcceptPrompt();
+    void UpdateSearch();
+    void StepMatch(bool older);
+    bool PromptIsFilter() const noexcept
+    {
+        return strncmp(m_prompt, "level:", 6) == 0 || strncmp(m_prompt, "logger:", 7) == 0 ||
+               strcmp(m_prompt, "clear") == 0;
+    }
  
+    // Damage tracking (shadow screen)
+    void ScreenReset(int rows, int cols);
+    void ScreenFeed(const char *s, size_t len);
+    void ScreenFeedPending();   // parse m_outBuf into m_screen and empty it (composing only)
+    void ScreenCsi(char final);
+    void ScreenSgr(const int *params, int nparams);
+    void ScreenPut(const char *glyph, uint8_t len, int width);
+    void ScreenErase(int row, int from, int to);
+    void ScreenDiff();
+    void AppendSgr(const TuiCell &cell);
+    static int GlyphWidth(uint32_t cp) noexcept;
+    static bool SameCell(const TuiCell &a, const TuiCell &b) noexcept
+    {
+        return memcmp(&a, &b, sizeof(TuiCell)) == 0;
+    }
+
     // Output buffer (single write() syscall per frame)
     void FlushOutput();
     void AppendData(const char *s, size_t len);
@@ -259,6 +532,11 @@ private:
     template<typename... Args>
     inline void SafeSnprintf(const char *fmt, Args... args) 
     {
+        if (m_composing && OUT_BUF_SIZE - m_outPos < 1024)
+        {
+            ScreenFeedPending();
+        }
+
         if (m_outPos >= OUT_BUF_SIZE)
         {
             return;
@@ -360,6 +638,21 @@ void dt::Log::RtTui::SetRowCols(int layoutIdx, int groupIdx, int rowIdx, const c
     SetRowData(layoutIdx, groupIdx, rowIdx, label, ptrs, ncols);
 }
 
+template<typename... Vals>
+void dt::Log::RtTui::SetRowVals(int layoutIdx, int groupIdx, int rowIdx, const char *label, const Vals &...vals) noexcept
+{
+    static_assert((std::is_same_v<Vals, TuiVal> && ...), "SetRowVals: columns must be TUI_VAL(fmt, value)");
+    const TuiVal arr[sizeof...(Vals) > 0 ? sizeof...(Vals) : 1] = {vals...};
+    SetRowValData(layoutIdx, groupIdx, rowIdx, label, arr, (int)sizeof...(Vals));
+}
+
+template<typename... Args>
+void dt::Log::RtTui::SetRowRaw(int layoutIdx, int groupIdx, int rowIdx, const char *label, uint16_t fmtId, Args... args) noexcept
+{
+    const TuiVal arr[sizeof...(Args) > 0 ? sizeof...(Args) : 1] = {TuiVal(fmtId, args)...};
+    SetRowValData(layoutIdx, groupIdx, rowIdx, label, arr, (int)sizeof...(Args));
+}
+
 template<typename T, typename... Args>
 void dt::Log::RtTui::FormatColumnsRecursive(int colIdx, char cols[][TUI_DATA_COL_LEN], const char *format, T value, Args... rest) 
 {
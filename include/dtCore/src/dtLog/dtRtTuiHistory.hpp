@@ -0,0 +1,186 @@
+/*!
+ \file      dtRtTuiHistory.hpp
+ \brief     Compact, filterable and searchable log history for RtTui Area 2
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTTUI_HISTORY_H_
+#define _DT_RTTUI_HISTORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../dtUtils/dtRtMem.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+struct TuiHistoryConfig
+{
+    size_t      bytes{8u << 20};  // text arena (≈100k lines of ~80 chars)
+    const char *file{nullptr};    // back the arena with this file (mmap, MAP_SHARED) instead of anonymous memory
+};
+
+// Variable-length line store for the TUI log view.
+//
+//  - Lines are kept in a byte ring (record header + text without ANSI codes); the oldest
+//    lines are evicted when the arena or the line index is full.
+//  - A per-level index (sorted line sequence numbers) lets a level filter be rebuilt by
+//    merging only the selected levels, so toggling filters does not scan the whole history.
+//  - Search (substring, case-insensitive, or regex) runs over the filtered view in bounded
+//    steps so a long scan never stalls the drain thread.
+//
+// Drain thread only (not thread-safe).
+class TuiLogHistory
+{
+public:
+    static constexpr int    LEVELS       = 6;     // spdlog trace .. critical
+    static constexpr size_t MAX_LOGGERS  = 64;
+    static constexpr size_t LOGGER_LEN   = 32;
+    static constexpr size_t MAX_LINE     = 4096;  // longer lines are truncated
+    static constexpr size_t MIN_LINE_AVG = 24;    // line index capacity = bytes / MIN_LINE_AVG, rounded down to 2^n
+    static constexpr size_t REGEX_COST   = 16;    // StepSearch budget divisor for regex queries
+
+    struct Line
+    {
+        const char *text;
+        uint32_t    len;
+        uint16_t    colorStart;   // [colorStart, colorEnd) = prefix drawn in the level colour
+        uint16_t    colorEnd;
+        uint8_t     level;
+        uint8_t     logger;
+    };
+
+    enum class SearchState : uint8_t { idle, running, found, notFound, badPattern };
+
+    TuiLogHistory();
+    ~TuiLogHistory();
+    TuiLogHistory(const TuiLogHistory &) = delete;
+    TuiLogHistory &operator=(const TuiLogHistory &) = delete;
+
+    bool Init(const TuiHistoryConfig &cfg, const dt::Utils::RtMemOptions &memOpt) noexcept;
+    void Release() noexcept;
+    bool IsFileBacked() const noexcept;
+    size_t Capacity() const noexcept { return m_cap; }
+
+    // Stores a line (ANSI escapes are stripped, the first coloured span is remembered).
+    // Returns true if the line is visible in the current filter.
+    bool Append(int level, const char *logger, const char *msg, size_t len) noexcept;
+    // Same for text that is already stripped (e.g. a line received from another process)
+    bool AppendStripped(int level, const char *logger, const char *text, size_t len,
+                        uint16_t colorStart, uint16_t colorEnd) noexcept;
+
+    // ── view / filters ──
+    size_t Size() const noexcept;          // lines in the filtered view
+    size_t Total() const noexcept;         // lines stored
+    size_t LevelCount(int level) const noexcept;
+    bool   GetLine(size_t viewIdx, Line &out) const noexcept;   // 0 = oldest
+    bool   GetRecent(size_t back, Line &out) const noexcept;    // unfiltered, 0 = newest
+    const char *LoggerName(uint8_t id) const noexcept;
+
+    // Filter commands: "level:w+" (warn and above), "level:d,e", "logger:motion,ctrl", "clear".
+    // An empty value clears that filter; a logger that has not logged yet matches nothing.
+    // Returns false on a syntax error.
+    bool ApplyFilter(const char *cmd) noexcept;
+    void ClearFilters() noexcept;
+    bool Filtered() const noexcept { return !m_viewAll; }
+    void DescribeFilter(char *buf, size_t size) const noexcept;
+
+    // ── search over the view ──
+    // query: plain text (case-insensitive substring) or "re:<ECMAScript regex>"
+    void        StartSearch(const char *query, size_t fromIdx, bool backward) noexcept;
+    SearchState StepSearch(size_t budget) noexcept;   // scans up to 'budget' lines (regex: budget / REGEX_COST)
+    SearchState GetSearchState() const noexcept { return m_search; }
+    size_t      SearchMatch() const noexcept { return m_searchPos; }
+    void        CancelSearch() noexcept;
+
+private:
+    struct RecHdr
+    {
+        uint32_t len;
+        uint16_t colorStart;
+        uint16_t colorEnd;
+        uint8_t  level;
+        uint8_t  logger;
+        uint16_t reserved;
+    };
+
+    // sorted list of line sequence numbers with lazy front trimming
+    struct SeqList
+    {
+        std::vector<uint32_t> seqs;
+        size_t                head{0};
+
+        size_t   Size() const noexcept { return seqs.size() - head; }
+        uint32_t At(size_t i) const noexcept { return seqs[head + i]; }
+        void     Clear() noexcept { seqs.clear(); head = 0; }
+        void     Push(uint32_t seq) noexcept;
+        template<typename Pred>
+        void     Trim(Pred &&alive) noexcept;
+    };
+
+    bool     Store(int level, uint8_t logger, const char *text, size_t n,
+                   uint16_t colorStart, uint16_t colorEnd) noexcept;
+    bool     Alive(uint32_t seq) const noexcept { return (uint32_t)(seq - m_first) < (uint32_t)(m_next - m_first); }
+    void     EvictOldest() noexcept;
+    void     ViewFrontRemoved(size_t n) noexcept;
+    uint8_t  InternLogger(const char *name) noexcept;
+    int      FindLogger(const char *name) const noexcept;   // -1: not interned
+    void     RebuildView() noexcept;
+    bool     InView(uint8_t level, uint8_t logger) const noexcept
+    {
+        return (m_levelMask & (1u << level)) && (m_loggerMask & (1ull << logger));
+    }
+    const RecHdr *Record(uint32_t seq) const noexcept
+    {
+        return reinterpret_cast<const RecHdr *>(m_arena + m_lineOff[seq & (m_maxLines - 1)]);
+    }
+    bool     Matches(const Line &line) const noexcept;
+
+    // arena
+    char                 *m_arena{nullptr};
+    size_t                m_cap{0};
+    size_t                m_write{0};
+    dt::Utils::RtMemBlock m_mem{};
+    int                   m_fileFd{-1};
+    void                 *m_fileMap{nullptr};
+
+    // line index: offset of each live line, indexed by seq & (m_maxLines - 1)
+    std::vector<uint32_t> m_lineOff;
+    uint32_t              m_maxLines{0};  // power of two
+    uint32_t              m_first{0};   // oldest live seq
+    uint32_t              m_next{0};    // next seq
+
+    SeqList               m_levelIdx[LEVELS];
+    char                  m_loggers[MAX_LOGGERS][LOGGER_LEN]{};
+    size_t                m_loggerCount{0};
+
+    // filtered view (m_viewAll: every line, no list)
+    uint32_t              m_levelMask{(1u << LEVELS) - 1};
+    uint64_t              m_loggerMask{~0ull};
+    bool                  m_viewAll{true};
+    SeqList               m_view;
+
+    // search (std::regex kept out of the header)
+    struct SearchRegex;
+    SearchState                  m_search{SearchState::idle};
+    std::string                  m_query;       // lower-cased substring query
+    std::unique_ptr<SearchRegex> m_regex;
+    size_t                       m_searchPos{0};
+    bool                         m_searchBack{true};
+    size_t                       m_searchLeft{0};
+};
+
+}  // namespace Log
+}  // namespace dt
+
+#endif  // _DT_RTTUI_HISTORY_H_
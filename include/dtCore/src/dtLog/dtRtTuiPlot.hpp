@@ -0,0 +1,146 @@
+/*!
+ \file      dtRtTuiPlot.hpp
+ \brief     Numeric-channel widget for RtTui Area 1 (sparkline + rolling min/max/mean/p99)
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTTUI_PLOT_H_
+#define _DT_RTTUI_PLOT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../dtUtils/dtRtMem.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+struct TuiPlotConfig
+{
+    size_t   window{1000};          // samples in the rolling min/max/mean/p99 window
+    uint32_t decimation{10};        // samples per sparkline column
+    double   lo{0.0};               // p99 histogram range; lo >= hi → calibrated from the samples (re-ranged on drift)
+    double   hi{0.0};
+    size_t   queueCapacity{4096};   // RT → drain ring (rounded up to a power of 2)
+};
+
+struct TuiPlotStats
+{
+    double   last;
+    double   min;
+    double   max;
+    double   mean;
+    double   p99;
+    uint64_t samples;    // total samples consumed
+    uint64_t dropped;    // samples lost because the ring was full
+    size_t   window;     // samples currently in the rolling window
+};
+
+// One plotted channel.
+//  - Push()   : single producer (RT thread), wait-free SPSC ring
+//  - Update() : drain thread; every statistic is maintained incrementally, so the cost per
+//               sample is O(1) (amortized) regardless of the window length:
+//               min/max via monotonic deques, mean via running sum, p99 via a fixed-bin
+//               histogram with eviction, sparkline columns via per-bucket aggregates.
+class TuiPlot
+{
+public:
+    static constexpr size_t LABEL_LEN   = 24;
+    static constexpr size_t HIST_BINS   = 128;
+    static constexpr size_t MAX_COLUMNS = 256;   // sparkline history (columns)
+    static constexpr size_t MAX_WINDOW  = 1u << 20;
+    static constexpr size_t CALIB_SAMPLES = 64;  // auto histogram range
+    static constexpr size_t RERANGE_DIV   = 256; // auto range: rebuild once > window/256 samples (< the 1% tail) sit in the edge bins
+
+    TuiPlot() = default;
+    ~TuiPlot();
+    TuiPlot(const TuiPlot &) = delete;
+    TuiPlot &operator=(const TuiPlot &) = delete;
+
+    bool Init(const char *label, const TuiPlotConfig &cfg, const dt::Utils::RtMemOptions &memOpt) noexcept;
+
+    // RT-safe, one producer per channel
+    void Push(double value) noexcept
+    {
+        const uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tailCache >= m_ringCap)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache >= m_ringCap)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        m_ring[head & (m_ringCap - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // Drain thread: consume queued samples, returns the count
+    size_t Update() noexcept;
+
+    TuiPlotStats GetStats() const noexcept;
+
+    // UTF-8 sparkline (▁..█) of the last 'columns' columns into out, returns bytes written
+    size_t RenderSpark(char *out, size_t outSize, int columns) const noexcept;
+
+    const char *Label() const noexcept { return m_label; }
+
+private:
+    struct Column
+    {
+        double min;
+        double max;
+    };
+
+    void    AddSample(double x) noexcept;
+    int     BinOf(double x) const noexcept;
+    void    Calibrate() noexcept;
+    double  Percentile(double q) const noexcept;
+
+    char m_label[LABEL_LEN]{};
+
+    // SPSC ring (producer: m_head, m_tailCache / consumer: m_tail)
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    uint64_t                          m_tailCache{0};
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    std::atomic<uint64_t>             m_dropped{0};
+    double                           *m_ring{nullptr};
+    size_t                            m_ringCap{0};
+    dt::Utils::RtMemBlock             m_mem{};
+
+    // rolling window (drain thread only)
+    TuiPlotConfig         m_cfg{};
+    std::vector<double>   m_win;        // ring of the last m_cfg.window samples
+    std::vector<uint8_t>  m_winBin;     // histogram bin of each window sample
+    std::vector<uint64_t> m_minQ;       // monotonic deques of sample sequence numbers
+    std::vector<uint64_t> m_maxQ;
+    size_t   m_minHead{0}, m_minTail{0};
+    size_t   m_maxHead{0}, m_maxTail{0};
+    uint64_t m_seq{0};                  // samples consumed
+    double   m_sum{0.0};
+    double   m_last{0.0};
+    uint32_t m_hist[HIST_BINS]{};
+    double   m_lo{0.0}, m_hi{0.0};
+    bool     m_calibrated{false};
+    bool     m_autoRange{true};         // range from the samples (not TuiPlotConfig lo/hi)
+
+    // sparkline columns
+    Column   m_cols[MAX_COLUMNS]{};
+    size_t   m_colCount{0};             // completed columns
+    Column   m_cur{};                   // column being accumulated
+    uint32_t m_curN{0};
+};
+
+}  // namespace Log
+}  // namespace dt
+
+#endif  // _DT_RTTUI_PLOT_H_
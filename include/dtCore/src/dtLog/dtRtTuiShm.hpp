@@ -0,0 +1,123 @@
+/*!
+ \file      dtRtTuiShm.hpp
+ \brief     RtTui snapshot in POSIX shared memory (headless publisher / dttui-attach viewer)
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTTUI_SHM_H_
+#define _DT_RTTUI_SHM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dtRtTui.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+// Segment layout shared by the publishing process (RtTui::OpenSnapshot) and any number of
+// viewers (RtTui::AttachSnapshot). The publisher is the only writer; viewers map the segment
+// read-only and copy it under the seqlock, so attaching/detaching never touches the
+// publisher. Bump TUI_SHM_VERSION whenever a struct below changes.
+inline constexpr uint32_t TUI_SHM_MAGIC     = 0x49555444;  // "DTUI"
+inline constexpr uint16_t TUI_SHM_VERSION   = 2;
+inline constexpr size_t   TUI_SHM_LOG_LINES = 64;          // log tail carried by each snapshot
+inline constexpr size_t   TUI_SHM_LOG_LEN   = 232;
+inline constexpr int      TUI_SHM_SPARK_COLS = 64;         // sparkline columns of plot rows
+
+struct TuiShmRow
+{
+    enum Kind : uint8_t { EMPTY, DATA, TEXT, PLOT };
+
+    uint8_t  kind;
+    uint8_t  ncols;
+    uint8_t  reserved[6];
+    char     label[RtTui::TUI_DATA_COL_LEN];
+    char     col[RtTui::TUI_MAX_COLS][RtTui::TUI_DATA_COL_LEN];  // DATA (formatted)
+    char     text[RtTui::TUI_TEXT_ROW_LEN];                    // TEXT, PLOT: UTF-8 sparkline
+    double   stats[5];                                          // PLOT: last, min, max, mean, p99
+    uint64_t samples;                                           // PLOT
+};
+
+struct TuiShmGroupHeader
+{
+    char    label[RtTui::TUI_DATA_COL_LEN];
+    char    cols[RtTui::TUI_MAX_COLS][RtTui::TUI_DATA_COL_LEN];
+    uint8_t ncols;
+    uint8_t active;
+    uint8_t hideHeader;
+    uint8_t reserved[5];
+};
+
+struct TuiShmLayout
+{
+    char              name[32];
+    uint8_t           defined;
+    uint8_t           reserved[3];
+    int32_t           nrows[RtTui::TUI_MAX_GROUPS];
+    TuiShmGroupHeader headers[RtTui::TUI_MAX_GROUPS];
+    TuiShmRow         rows[RtTui::TUI_MAX_GROUPS][RtTui::TUI_MAX_ROWS_PER_GROUP];
+};
+
+struct TuiShmLogLine
+{
+    uint64_t seq;
+    uint8_t  level;
+    uint8_t  reserved;
+    uint16_t len;
+    uint16_t colorStart;   // level-coloured prefix span
+    uint16_t colorEnd;
+    char     logger[32];
+    char     text[TUI_SHM_LOG_LEN];   // ANSI codes stripped
+};
+
+struct TuiShmSegment
+{
+    // fixed once the segment is created
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved0;
+    uint32_t size;         // sizeof(TuiShmSegment) of the publisher
+    int32_t  pid;          // publishing process
+    uint64_t instance;     // unique per CreateTuiShm(): tells a re-created segment of the same pid apart
+
+    // seqlock: odd while the publisher is writing the payload
+    alignas(64) std::atomic<uint64_t> seq;
+
+    // payload
+    alignas(64) int64_t publishWall_ns;   // CLOCK_REALTIME of the last publish
+    uint64_t      frame;                  // publish count
+    uint64_t      logSeqEnd;              // seq of the newest log line + 1 (line s is log[s % N])
+    uint32_t      logCount;               // valid lines: [logSeqEnd - logCount, logSeqEnd)
+    uint32_t      reserved1;
+    TuiShmLogLine log[TUI_SHM_LOG_LINES];
+    TuiShmLayout  layouts[RtTui::MAX_LAYOUTS];
+};
+
+static_assert(std::is_standard_layout_v<TuiShmSegment>, "TuiShmSegment is shared between processes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock counter must be address-free");
+
+// Publisher: creates (replacing a stale one) and maps the segment, nullptr on failure
+TuiShmSegment *CreateTuiShm(const char *name) noexcept;
+void           DestroyTuiShm(TuiShmSegment *seg, const char *name) noexcept;
+
+// Viewer: maps an existing segment read-only, nullptr if missing or of another version
+const TuiShmSegment *OpenTuiShm(const char *name) noexcept;
+void                 CloseTuiShm(const TuiShmSegment *seg) noexcept;
+
+// Consistent copy of the segment (seqlock read; retries while the publisher is writing).
+// Returns false if no consistent copy was obtained within 'retries' attempts.
+bool ReadTuiShm(const TuiShmSegment *seg, TuiShmSegment &out, int retries = 100) noexcept;
+
+}  // namespace Log
+}  // namespace dt
+
+#endif  // _DT_RTTUI_SHM_H_
@@ -0,0 +1,463 @@
+/*!
+ \file      coScheduler.h
+ \brief     Cooperative scheduler of stackless tasks (timers, awaitable semaphores / futures) for small non-RT jobs
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_COSCHEDULER_H__
+#define __DT_THREAD_COSCHEDULER_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "threadImp.h"
+#include "threadPool.h"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+class CoScheduler;
+class CoWaitable;
+struct CoTask;
+template <typename T>
+class CoFuture;
+
+/**
+ * What a task step asks the scheduler to do next.
+ */
+enum class CoStatus : uint8_t
+{
+    Yield, //!< run again after the other ready tasks
+    Sleep, //!< run again at CoContext's wake-up time (CoContext::SleepFor/SleepUntil)
+    Wait,  //!< run again when the awaited object is signaled or the timeout passes (CoContext::Await)
+    Done,  //!< finished: the task is freed
+};
+
+/**
+ * Resume state of a task, passed to every step. A task is a stackless state machine: its step
+ * function returns at each suspension point and is called again from the top, so state that
+ * must survive a suspension lives in the functor (lambda captures, members), not in locals.
+ * The DT_CO_* macros keep the resume point in 'line' (switch on __LINE__):
+ *  - no locals with initializers across a DT_CO_* point, one DT_CO_* per source line.
+ */
+struct CoContext
+{
+    int      line = 0;          //!< resume point (DT_CO_* macros)
+    int64_t  now_ns = 0;        //!< CLOCK_MONOTONIC when the step was resumed
+    bool     timedOut = false;  //!< the last DT_CO_AWAIT_FOR ended by its timeout
+
+    CoStatus SleepFor(int64_t duration_ns) noexcept { return SleepUntil(now_ns + duration_ns); }
+    CoStatus SleepUntil(int64_t wake_ns) noexcept
+    {
+        m_wake_ns = wake_ns;
+        return CoStatus::Sleep;
+    }
+
+    // DT_CO_AWAIT / DT_CO_AWAIT_FOR
+    void BeginAwait(int64_t timeout_ns) noexcept
+    {
+        m_deadline_ns = (timeout_ns >= 0) ? now_ns + timeout_ns : -1;
+        timedOut = false;
+    }
+    bool Await(CoWaitable &w);  //!< true: acquired (or timed out), false: suspend with CoStatus::Wait
+    template <typename T>
+    bool Await(const CoFuture<T> &f);
+
+private:
+    friend class CoScheduler;
+    CoTask *m_task = nullptr;
+    int64_t m_wake_ns = 0;
+    int64_t m_deadline_ns = -1;
+    CoWaitable *m_waitOn = nullptr;
+};
+
+using CoTaskFunc = std::function<CoStatus(CoContext &co)>;
+
+#define DT_CO_BEGIN(co) \
+    switch ((co).line)  \
+    {                   \
+    case 0:
+#define DT_CO_END(co) \
+    }                 \
+    (co).line = -1;   \
+    return dt::Thread::CoStatus::Done
+#define DT_CO_YIELD(co)                     \
+    do                                      \
+    {                                       \
+        (co).line = __LINE__;               \
+        return dt::Thread::CoStatus::Yield; \
+    case __LINE__:;                         \
+    } while (0)
+#define DT_CO_SLEEP(co, duration_ns)       \
+    do                                     \
+    {                                      \
+        (co).line = __LINE__;              \
+        return (co).SleepFor(duration_ns); \
+    case __LINE__:;                        \
+    } while (0)
+#define DT_CO_SLEEP_UNTIL(co, wake_ns)     \
+    do                                     \
+    {                                      \
+        (co).line = __LINE__;              \
+        return (co).SleepUntil(wake_ns);   \
+    case __LINE__:;                        \
+    } while (0)
+#define DT_CO_AWAIT_FOR(co, awaitable, timeout_ns)  \
+    do                                              \
+    {                                               \
+        (co).line = __LINE__;                       \
+        (co).BeginAwait(timeout_ns);                \
+        [[fallthrough]];                            \
+    case __LINE__:                                  \
+        if (!(co).Await(awaitable))                 \
+            return dt::Thread::CoStatus::Wait;      \
+    } while (0)
+#define DT_CO_AWAIT(co, awaitable) DT_CO_AWAIT_FOR(co, awaitable, -1)
+
+/**
+ * Base of the objects a task can wait on. Signaling (Notify) is thread-safe: any non-RT thread
+ * may post a semaphore or fulfill a promise. A waitable must outlive the tasks waiting on it.
+ */
+class CoWaitable
+{
+public:
+    CoWaitable() = default;
+    virtual ~CoWaitable() = default;
+    CoWaitable(const CoWaitable &) = delete;
+    CoWaitable &operator=(const CoWaitable &) = delete;
+
+protected:
+    // called with m_mtx held: true if the waiter may continue (and takes what it waited for)
+    virtual bool TryConsume() = 0;
+    // call with m_mtx held after a state change: every waiting task retries
+    void Notify();
+
+    std::mutex m_mtx;
+
+private:
+    friend struct CoContext;
+    friend class CoScheduler;
+    struct Waiter
+    {
+        CoTask *task;
+        uint32_t seq;
+    };
+    bool TryOrWait(CoTask *task, uint32_t seq);
+    void RemoveWaiter(CoTask *task);
+
+    std::vector<Waiter> m_waiters;
+};
+
+/**
+ * Counting semaphore for tasks. Post() from any non-RT thread.
+ */
+class CoSemaphore : public CoWaitable
+{
+public:
+    explicit CoSemaphore(int initial = 0) : m_count(initial) {}
+
+    void Post(int n = 1)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_count += n;
+        Notify();
+    }
+    bool TryWait()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return TryConsume();
+    }
+    int Count()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return m_count;
+    }
+
+protected:
+    bool TryConsume() override
+    {
+        if (m_count <= 0) return false;
+        --m_count;
+        return true;
+    }
+
+private:
+    int m_count;
+};
+
+/**
+ * Shared state of CoPromise / CoFuture.
+ */
+template <typename T>
+class CoFutureState : public CoWaitable
+{
+public:
+    using Storage = std::conditional_t<std::is_void_v<T>, char, T>;
+
+    template <typename... Args>
+    void SetValue(Args &&...args)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_ready) return;
+        m_value.emplace(std::forward<Args>(args)...);
+        m_ready = true;
+        Notify();
+    }
+    void SetException(std::exception_ptr e)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_ready) return;
+        m_error = e;
+        m_ready = true;
+        Notify();
+    }
+    bool Ready()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return m_ready;
+    }
+    // after the future became ready (DT_CO_AWAIT): rethrows the exception of the producer
+    Storage &Value()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_error) std::rethrow_exception(m_error);
+        return *m_value;
+    }
+
+protected:
+    bool TryConsume() override { return m_ready; } // a ready future stays ready
+
+private:
+    bool m_ready = false;
+    std::optional<Storage> m_value;
+    std::exception_ptr m_error;
+};
+
+/**
+ * Result of an operation that completes later (on another thread, e.g. CoSubmit()), awaited by a
+ * task with DT_CO_AWAIT(co, future).
+ */
+template <typename T>
+class CoFuture
+{
+public:
+    CoFuture() = default;
+    explicit CoFuture(std::shared_ptr<CoFutureState<T>> state) : m_state(std::move(state)) {}
+
+    bool Valid() const { return (bool)m_state; }
+    bool Ready() const { return m_state && m_state->Ready(); }
+    // value once ready (T = void: only rethrows)
+    decltype(auto) Get() const
+    {
+        if constexpr (std::is_void_v<T>)
+            m_state->Value();
+        else
+            return (m_state->Value());
+    }
+    CoWaitable &Waitable() const { return *m_state; }
+
+private:
+    std::shared_ptr<CoFutureState<T>> m_state;
+};
+
+template <typename T>
+class CoPromise
+{
+public:
+    CoPromise() : m_state(std::make_shared<CoFutureState<T>>()) {}
+
+    CoFuture<T> GetFuture() const { return CoFuture<T>(m_state); }
+    template <typename... Args>
+    void SetValue(Args &&...args) const { m_state->SetValue(std::forward<Args>(args)...); }
+    void SetException(std::exception_ptr e) const { m_state->SetException(e); }
+
+private:
+    std::shared_ptr<CoFutureState<T>> m_state;
+};
+
+/**
+ * Options of CoScheduler.
+ */
+struct CoSchedulerConfig
+{
+    const char *name = "co";     //!< thread name
+    int cpuIdx = CPU_AUTO;       //!< CPU_AUTO: a housekeeping CPU away from the RT threads
+    size_t stackSz = 0;          //!< 0: default stack size
+};
+
+/**
+ * Counters of a scheduler (relaxed, for monitoring).
+ */
+struct CoSchedulerStats
+{
+    uint64_t tasks = 0;          //!< live tasks
+    uint64_t spawned = 0;
+    uint64_t resumes = 0;        //!< task steps run
+    uint64_t timerWakes = 0;     //!< sleeps / await timeouts expired
+    uint64_t signalWakes = 0;    //!< waits ended by a semaphore / future
+    uint64_t idleSleeps = 0;     //!< times the scheduler thread blocked with nothing ready
+};
+
+/**
+ * Runs many small non-RT tasks (watchdogs, status publishers, config polls) on one thread.
+ *  - a task costs sizeof(CoTask) (144 bytes on x86_64, see TaskSize()) plus its functor instead
+ *    of a thread stack.
+ *  - tasks switch by returning from their step, not by a kernel context switch; the thread
+ *    sleeps only when no task is ready until the next timer or signal.
+ *  - a task must not block (no Sleep, mutex waits on long critical sections, blocking I/O): use
+ *    DT_CO_SLEEP / DT_CO_AWAIT, or move the blocking part to a ThreadPool with CoSubmit().
+ *  - Spawn(), Every(), After() may be called from any non-RT thread, before or after Start().
+ *  - for a few threads, run one scheduler per thread.
+ */
+class CoScheduler
+{
+public:
+    explicit CoScheduler(const CoSchedulerConfig &config = CoSchedulerConfig());
+    ~CoScheduler();
+    CoScheduler(const CoScheduler &) = delete;
+    CoScheduler &operator=(const CoScheduler &) = delete;
+
+    /**
+     * Run the scheduler on its own non-RT thread.
+     * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+     */
+    int Start();
+
+    /**
+     * Join the scheduler thread and free every remaining task. Called by the destructor.
+     */
+    void Stop();
+
+    /**
+     * Run ready tasks and expired timers on the calling thread instead of Start(), e.g. from an
+     * existing non-RT loop. Waits up to maxWait_ns when nothing is ready.
+     * @return It returns the number of task steps run.
+     */
+    int RunOnce(int64_t maxWait_ns = 0);
+
+    /**
+     * Add a task. 'step' is called until it returns CoStatus::Done.
+     * @return It returns false if the task could not be allocated.
+     */
+    bool Spawn(const char *name, CoTaskFunc step);
+
+    /**
+     * Call 'job' every period (drift-free, missed periods are skipped) until it returns false.
+     */
+    bool Every(const char *name, int64_t period_ns, std::function<bool()> job, int64_t firstDelay_ns = 0);
+
+    /**
+     * Call 'job' once after delay_ns.
+     */
+    bool After(const char *name, int64_t delay_ns, std::function<void()> job);
+
+    void GetStats(CoSchedulerStats &stats) const;
+    static size_t TaskSize();    //!< bytes per task without the functor's own allocations
+
+private:
+    friend class CoWaitable;
+    struct Inbox
+    {
+        CoTask *task;
+        uint32_t seq;
+        bool spawn;
+    };
+
+    static void *SchedulerProc(void *arg);
+    void Wake(CoTask *task, uint32_t seq);
+    void DrainInbox();
+    void MakeReady(CoTask *task);
+    void Resume(CoTask *task);
+    void Free(CoTask *task);
+    void ExpireTimers(int64_t now_ns);
+    void TimerPush(CoTask *task, int64_t wake_ns);
+    void TimerRemove(CoTask *task);
+    void TimerSiftUp(size_t idx);
+    void TimerSiftDown(size_t idx);
+
+    CoSchedulerConfig m_config;
+    ThreadInfo m_thread;
+    std::atomic<bool> m_running{false};
+
+    // scheduler thread only
+    CoTask *m_readyHead = nullptr;
+    CoTask *m_readyTail = nullptr;
+    size_t  m_readyCount = 0;
+    std::vector<CoTask *> m_timers;      // min-heap on the task's wake-up time (one timer per task)
+    std::vector<CoTask *> m_tasks;       // every live task
+    std::vector<CoTask *> m_graveyard;   // finished, freed after the next inbox drain
+    std::vector<Inbox> m_drained;
+
+    // any thread
+    std::mutex m_inboxMtx;
+    std::condition_variable m_inboxCv;
+    std::vector<Inbox> m_inbox;
+
+    std::atomic<uint64_t> m_spawned{0};
+    std::atomic<uint64_t> m_live{0};
+    std::atomic<uint64_t> m_resumes{0};
+    std::atomic<uint64_t> m_timerWakes{0};
+    std::atomic<uint64_t> m_signalWakes{0};
+    std::atomic<uint64_t> m_idleSleeps{0};
+};
+
+//* Template Functions -------------------------------------------------------*/
+template <typename T>
+bool CoContext::Await(const CoFuture<T> &f)
+{
+    return Await(f.Waitable());
+}
+
+/**
+ * Run 'func' on a ThreadPool worker; the returned future can be awaited by a task.
+ */
+template <typename F>
+auto CoSubmit(ThreadPool &pool, F &&func) -> CoFuture<std::invoke_result_t<std::decay_t<F>>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    CoPromise<R> promise;
+    CoFuture<R> result = promise.GetFuture();
+    pool.Post([promise, f = std::forward<F>(func)]() mutable {
+        try
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                f();
+                promise.SetValue();
+            }
+            else
+            {
+                promise.SetValue(f());
+            }
+        }
+        catch (...)
+        {
+            promise.SetException(std::current_exception());
+        }
+    });
+    return result;
+}
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_COSCHEDULER_H__
@@ -0,0 +1,131 @@
+/*!
+ \file      cpuTopology.h
+ \brief     CPU topology / isolation discovery (sysfs) and thread placement helpers
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_CPUTOPOLOGY_H__
+#define __DT_THREAD_CPUTOPOLOGY_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <string>
+#include <vector>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+/**
+ * Topology of one logical CPU. Ids that the kernel does not report are -1.
+ */
+typedef struct _cpuTopoInfo
+{
+    int cpu = -1;
+    bool online = false;
+    bool allowed = false;        // in the process affinity (cpuset)
+    bool isolated = false;       // isolcpus=
+    bool nohzFull = false;       // nohz_full=
+    int core = -1;               // topology/core_id (unique only within a package)
+    int package = -1;            // topology/physical_package_id
+    int node = -1;               // NUMA node
+    int l2 = -1;                 // L2 group: lowest CPU sharing this CPU's L2
+    int l3 = -1;                 // L3 group: lowest CPU sharing this CPU's L3
+    std::vector<int> siblings;   // SMT siblings, including this CPU
+} CpuTopoInfo;
+
+/**
+ * Topology of the machine as seen by this process.
+ */
+typedef struct _cpuTopology
+{
+    std::vector<CpuTopoInfo> cpus; // indexed by CPU number (possible CPUs)
+    std::vector<int> online;
+    std::vector<int> isolated;
+    std::vector<int> nohzFull;
+    std::vector<int> allowed;      // sched_getaffinity() of the process
+    std::vector<int> cgroupCpus;   // cpuset.cpus.effective of the cgroup (empty if unknown)
+    int numNodes = 0;
+    int numPackages = 0;
+    int numCores = 0;              // physical cores (SMT groups)
+
+    const CpuTopoInfo *Get(int cpu) const { return (cpu >= 0 && cpu < (int)cpus.size()) ? &cpus[cpu] : nullptr; }
+    bool SameCore(int a, int b) const;
+    bool SharesL2(int a, int b) const;
+    bool SharesL3(int a, int b) const;
+    bool SameNode(int a, int b) const;
+    /** online, allowed, and neither isolated nor nohz_full */
+    bool IsHousekeeping(int cpu) const;
+} CpuTopology;
+
+//* Public(Exported) Functions -----------------------------------------------*/
+/**
+ * Read the CPU topology from sysfs.
+ * @param[out] topo Topology read.
+ * @param[in] sysfsRoot Root of sysfs. A copied tree of another machine can be given for offline planning.
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int ReadCpuTopology(CpuTopology &topo, const char *sysfsRoot = "/sys");
+
+/**
+ * Topology of this machine, read once on the first call.
+ */
+const CpuTopology &GetCpuTopology();
+
+/**
+ * Parse a kernel CPU list ("0-3,8,10-11").
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int ParseCpuList(const char *str, std::vector<int> &cpus);
+
+/**
+ * Format CPUs as a kernel CPU list ("0-3,8").
+ */
+std::string FormatCpuList(const std::vector<int> &cpus);
+
+/**
+ * Housekeeping CPUs (see CpuTopology::IsHousekeeping) that share neither a physical core nor an
+ * L2 cache with any of 'rtCpus'. If that leaves nothing, the L2 rule and then the core rule are dropped.
+ * @param[in] topo Topology.
+ * @param[in] rtCpus CPUs used by RT threads.
+ * @return Housekeeping CPUs in ascending order (empty if the process has none).
+ */
+std::vector<int> GetHousekeepingCpus(const CpuTopology &topo, const std::vector<int> &rtCpus);
+
+/**
+ * Pick a housekeeping CPU for a non-RT thread, e.g. the partner of RT core N:
+ * PickHousekeepingCpu(topo, {N}, N) avoids N's core and L2 and prefers N's L3 / NUMA node.
+ * @param[in] topo Topology.
+ * @param[in] rtCpus CPUs used by RT threads.
+ * @param[in] nearCpu CPU to stay close to (same L3, then same node), or -1.
+ * @param[in] busyCpus CPUs already used by other threads (may repeat); less used CPUs are preferred.
+ * @return CPU index, or -1 if there is no housekeeping CPU.
+ */
+int PickHousekeepingCpu(const CpuTopology &topo, const std::vector<int> &rtCpus, int nearCpu = -1,
+                        const std::vector<int> &busyCpus = std::vector<int>());
+
+/**
+ * Pick a CPU for a new RT thread: allowed CPUs not used by 'rtCpus' (nor their SMT siblings),
+ * preferring isolated + nohz_full, then isolated, then the highest-numbered CPU.
+ * @param[in] topo Topology.
+ * @param[in] rtCpus CPUs already used by RT threads.
+ * @return CPU index, or -1 if every allowed CPU is taken.
+ */
+int PickRtCpu(const CpuTopology &topo, const std::vector<int> &rtCpus);
+
+/**
+ * Log the topology table (LOG info).
+ */
+void PrintCpuTopology(const CpuTopology &topo);
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_CPUTOPOLOGY_H__
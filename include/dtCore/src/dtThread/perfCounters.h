@@ -0,0 +1,186 @@
+/*!
+ \file      perfCounters.h
+ \brief     Per-thread hardware/software performance counters (perf_event_open) for RT cycles
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_PERFCOUNTERS_H__
+#define __DT_THREAD_PERFCOUNTERS_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "threadImp.h"
+#include "../dtUtils/dtRing.hpp"
+#include "../dtUtils/dtSeqLock.hpp"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+/**
+ * Counted events. Index of PerfSample::value / PerfTotals arrays.
+ */
+enum class PerfEvent : uint8_t
+{
+    Cycles,          //!< CPU cycles (task-clock ns when only software counters are available)
+    Instructions,    //!< retired instructions
+    CacheMisses,     //!< last level cache misses
+    ContextSwitches,
+    PageFaults,      //!< minor + major
+    Migrations,      //!< CPU migrations
+};
+constexpr int PERF_EVENT_COUNT = 6;
+
+/**
+ * Where the value of an event comes from.
+ */
+enum class PerfSource : uint8_t
+{
+    None,     //!< not available (e.g. no PMU in a VM, perf_event_paranoid)
+    Hardware, //!< PMU counter (rdpmc in the cycle when the kernel allows it, group read() otherwise)
+    Software, //!< kernel software counter (perf_event_open)
+    Emulated, //!< without perf_event_open: getrusage(RUSAGE_THREAD), CLOCK_THREAD_CPUTIME_ID, sched_getcpu()
+};
+
+/**
+ * Options of PerfCounters::Open().
+ */
+struct PerfConfig
+{
+    size_t ringSize = 1024;     //!< per-cycle samples kept for the reader (rounded up to a power of 2, 0: no ring)
+    bool   hardware = true;     //!< try the PMU events (cycles, instructions, cache-misses)
+    bool   userOnly = false;    //!< count user space only (always the case with perf_event_paranoid >= 2)
+    bool   useRdpmc = true;     //!< x86: read the PMU with rdpmc instead of read() when the kernel allows it
+};
+
+/**
+ * Counter deltas of one cycle (between BeginCycle() and EndCycle()).
+ */
+struct PerfSample
+{
+    uint64_t cycle = 0;
+    int64_t  time_ns = 0;                   //!< CLOCK_MONOTONIC at EndCycle()
+    uint64_t value[PERF_EVENT_COUNT] = {};
+};
+
+/**
+ * Running totals, published every cycle.
+ */
+struct PerfTotals
+{
+    uint64_t cycles = 0;                    //!< number of EndCycle() calls
+    uint64_t dropped = 0;                   //!< samples lost because the ring was full
+    uint64_t last[PERF_EVENT_COUNT] = {};   //!< delta of the last cycle
+    uint64_t sum[PERF_EVENT_COUNT] = {};
+    uint64_t max[PERF_EVENT_COUNT] = {};    //!< largest per-cycle delta
+};
+
+/**
+ * perf_event_open counters of one thread, read around each control cycle.
+ *  - Open() on the measured thread groups the PMU events (cycles, instructions, cache-misses) and
+ *    the software events (context-switches, page-faults, migrations) so that each group is
+ *    scheduled and read together. Events the kernel refuses fall back as PerfSource tells.
+ *  - BeginCycle()/EndCycle() run in the cycle: rdpmc for the PMU group when possible, otherwise
+ *    one read() per group. No allocation, no lock.
+ *  - the deltas go to an SPSC ring (PopSample(), one consumer such as a RtLog/TUI drain thread)
+ *    and to totals that any thread can read (ReadTotals()).
+ */
+class PerfCounters
+{
+public:
+    PerfCounters() noexcept = default;
+    ~PerfCounters() { Close(); }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     * Open the counters.
+     * @param[in] config Options.
+     * @param[in] tid Thread to measure, 0 for the calling thread. BeginCycle()/EndCycle() must be
+     *            called on that thread; the getrusage fallback and rdpmc only work with tid 0.
+     * @return It returns true if at least one event is available.
+     */
+    bool Open(const PerfConfig &config = PerfConfig{}, int tid = 0);
+    void Close();
+    bool IsOpen() const noexcept { return m_ready.load(std::memory_order_acquire); }
+
+    PerfSource Source(PerfEvent ev) const noexcept { return m_src[(int)ev]; }
+    bool UsesRdpmc() const noexcept { return m_rdpmc; }
+    bool CyclesAreNs() const noexcept { return m_cyclesNs; } //!< Cycles is CPU time in ns (no PMU)
+
+    // measured thread
+    void BeginCycle() noexcept;
+    void EndCycle(uint64_t cycle) noexcept;
+    // counter values since Open() (raw, not per cycle)
+    void ReadNow(uint64_t (&value)[PERF_EVENT_COUNT]) noexcept;
+
+    // readers
+    bool PopSample(PerfSample &out) noexcept;            //!< single consumer
+    bool ReadTotals(PerfTotals &out) const noexcept;     //!< any thread
+    void ResetTotals() noexcept { m_resetReq.store(true, std::memory_order_relaxed); }
+
+private:
+    struct Group
+    {
+        int fd[PERF_EVENT_COUNT] = {-1, -1, -1, -1, -1, -1}; // fd[0]: leader
+        int ev[PERF_EVENT_COUNT] = {};                          // PerfEvent of each member
+        int n = 0;
+    };
+
+    bool OpenGroup(Group &g, const int *evs, int count, bool hardware, int tid);
+    void CloseGroup(Group &g);
+    bool ReadGroup(const Group &g, uint64_t (&value)[PERF_EVENT_COUNT]) noexcept;
+    bool ReadRdpmc(uint64_t (&value)[PERF_EVENT_COUNT]) noexcept;
+
+    PerfConfig m_config;
+    PerfSource m_src[PERF_EVENT_COUNT] = {};
+    Group m_hw;
+    Group m_sw;
+    void *m_mmap[PERF_EVENT_COUNT] = {};   // perf_event_mmap_page of each PMU member (rdpmc)
+    bool m_rdpmc = false;
+    bool m_cyclesNs = false;               // Cycles counts task-clock / thread CPU time (ns)
+    bool m_emulated = false;               // some events come from getrusage() & co.
+    int  m_tid = 0;
+
+    // writer state (measured thread)
+    uint64_t m_raw[PERF_EVENT_COUNT] = {}; // last values read (kept when a read fails)
+    uint64_t m_begin[PERF_EVENT_COUNT] = {};
+    int      m_lastCpu = -1;
+    PerfTotals m_cur{};
+
+    std::atomic<bool> m_ready{false};
+    std::atomic<bool> m_resetReq{false};
+    dt::Utils::SpscRing<PerfSample> m_ring;
+    dt::Utils::SeqLock<PerfTotals> m_totals;
+};
+
+//* Public(Exported) Functions -----------------------------------------------*/
+/**
+ * Name of an event / a source, e.g. "cache-misses", "hw".
+ */
+const char *PerfEventName(PerfEvent ev);
+const char *PerfSourceName(PerfSource src);
+
+/**
+ * Counters of a periodic thread created with PeriodicConfig::perfCounters.
+ * @param[in] thread Periodic thread.
+ * @return It returns nullptr if the thread has no counters (or has not opened them yet).
+ */
+PerfCounters *GetPerfCounters(const ThreadInfo &thread);
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_PERFCOUNTERS_H__
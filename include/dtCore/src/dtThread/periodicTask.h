@@ -0,0 +1,206 @@
+/*!
+ \file      periodicTask.h
+ \brief     Periodic thread (absolute-deadline clock_nanosleep loop) with lock-free timing statistics
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_PERIODICTASK_H__
+#define __DT_THREAD_PERIODICTASK_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "threadImp.h"
+#include "preciseWait.h"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+/**
+ * What the loop does when a cycle ends after the next deadline.
+ */
+enum class OverrunPolicy : uint8_t
+{
+    CatchUp, //!< run the missed cycles back-to-back (at most maxCatchUp), then skip the rest
+    Skip,    //!< drop the missed cycles, wake at the next deadline of the original grid
+    Resync,  //!< restart the grid one period after the late cycle ended
+};
+
+/**
+ * Callback of a periodic thread. Called once per cycle with the cycle index (0, 1, ...).
+ * Return false to leave the loop.
+ */
+using PeriodicCallback = std::function<bool(uint64_t cycle)>;
+
+/**
+ * Options of CreatePeriodicThread().
+ */
+struct PeriodicConfig
+{
+    int64_t       period_ns = 1000000;
+    OverrunPolicy overrunPolicy = OverrunPolicy::Skip;
+    uint32_t      maxCatchUp = 3;     //!< OverrunPolicy::CatchUp only
+    bool          realtime = true;    //!< SCHED_FIFO (CreateRtThread) or SCHED_OTHER
+    bool          rtAllocCheck = true; //!< realtime only: heap allocations in the loop are trapped (DT_RT_ALLOC_TRAP builds, dtRtAlloc.h)
+    bool          perfCounters = false; //!< per-cycle perf_event_open counters of the thread (GetPerfCounters(), perfCounters.h)
+    bool          preciseWake = false; //!< sleep to deadline - margin, then spin (PreciseWaiter): less jitter for more CPU
+    PreciseWaitConfig preciseWait;     //!< preciseWake only
+};
+
+/**
+ * Snapshot of the timing statistics of a periodic thread.
+ *  - latency: wake-up time minus deadline (scheduling jitter)
+ *  - period : time between two consecutive wake-ups
+ *  - compute: time spent in the callback
+ *  - cpu    : CPU time the thread consumed in the cycle (CLOCK_THREAD_CPUTIME_ID), compared with
+ *             the SCHED_DEADLINE runtime budget of the thread (ThreadInfo::dlRuntime_ns)
+ */
+struct PeriodicStatsData
+{
+    int64_t  targetPeriod_ns = 0;
+    uint64_t cycles = 0;
+    uint64_t overruns = 0;      //!< cycles that ended after the next deadline
+    uint64_t skipped = 0;       //!< deadlines dropped by the overrun policy
+    int64_t  period_ns = 0;     //!< last
+    int64_t  periodMin_ns = 0;
+    int64_t  periodMax_ns = 0;
+    int64_t  latency_ns = 0;    //!< last
+    int64_t  latencyAvg_ns = 0;
+    int64_t  latencyMax_ns = 0;
+    int64_t  compute_ns = 0;    //!< last
+    int64_t  computeAvg_ns = 0;
+    int64_t  computeMax_ns = 0;
+    int64_t  budget_ns = 0;     //!< SCHED_DEADLINE runtime per period (0: no budget)
+    int64_t  cpu_ns = 0;        //!< last
+    int64_t  cpuAvg_ns = 0;
+    int64_t  cpuMax_ns = 0;
+    uint64_t budgetOverruns = 0; //!< cycles that used more CPU time than budget_ns (throttled by the kernel)
+};
+
+/**
+ * Per-thread timing statistics. Updated by the periodic thread only (single writer, seqlock of
+ * relaxed atomics): Update() never blocks or allocates and Read() from any thread (TUI, RtLog,
+ * monitor) never blocks the writer.
+ */
+class PeriodicStats
+{
+public:
+    void Reset(int64_t targetPeriod_ns, int64_t budget_ns = 0) noexcept;
+
+    // writer (periodic thread)
+    void Update(int64_t wake_ns, int64_t deadline_ns, int64_t end_ns, int64_t cpu_ns, bool overrun, uint64_t skipped) noexcept;
+
+    // readers: consistent snapshot, false if the writer kept updating during 'retries' attempts
+    bool Read(PeriodicStatsData &out, int retries = 16) const noexcept;
+    // min/max/avg restart on the writer's next Update() (e.g. after start-up transients)
+    void RequestResetMinMax() const noexcept { m_resetReq.store(true, std::memory_order_relaxed); }
+
+private:
+    void Publish() noexcept;
+
+    alignas(64) std::atomic<uint32_t> m_seq{0};
+    std::atomic<int64_t>  m_targetPeriod_ns{0};
+    std::atomic<uint64_t> m_cycles{0};
+    std::atomic<uint64_t> m_overruns{0};
+    std::atomic<uint64_t> m_skipped{0};
+    std::atomic<int64_t>  m_period_ns{0};
+    std::atomic<int64_t>  m_periodMin_ns{0};
+    std::atomic<int64_t>  m_periodMax_ns{0};
+    std::atomic<int64_t>  m_latency_ns{0};
+    std::atomic<int64_t>  m_latencyAvg_ns{0};
+    std::atomic<int64_t>  m_latencyMax_ns{0};
+    std::atomic<int64_t>  m_compute_ns{0};
+    std::atomic<int64_t>  m_computeAvg_ns{0};
+    std::atomic<int64_t>  m_computeMax_ns{0};
+    std::atomic<int64_t>  m_budget_ns{0};
+    std::atomic<int64_t>  m_cpu_ns{0};
+    std::atomic<int64_t>  m_cpuAvg_ns{0};
+    std::atomic<int64_t>  m_cpuMax_ns{0};
+    std::atomic<uint64_t> m_budgetOverruns{0};
+    mutable std::atomic<bool> m_resetReq{false}; // set by readers
+
+    // writer-local accumulators
+    alignas(64) PeriodicStatsData m_cur{};
+    int64_t  m_prevWake_ns = 0;
+    int64_t  m_latencySum_ns = 0;
+    int64_t  m_computeSum_ns = 0;
+    int64_t  m_cpuSum_ns = 0;
+    uint64_t m_avgCount = 0;
+};
+
+//* Public(Exported) Functions -----------------------------------------------*/
+/**
+ * Create a thread that calls 'callback' every period. Deadlines are absolute (CLOCK_MONOTONIC,
+ * TIMER_ABSTIME) so the period does not drift with the callback's run time. Wake-up latency,
+ * period and compute time of each cycle are recorded into the thread's PeriodicStats.
+ * @param[in, out] thread Thread attributes (name, cpuIdx, priority, stackSz). procFunc/procFuncArg are set by this function.
+ * @param[in] config Period and overrun policy.
+ * @param[in] callback Cycle body. Return false to stop.
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int CreatePeriodicThread(ThreadInfo &thread, const PeriodicConfig &config, PeriodicCallback callback);
+
+/**
+ * Create a periodic RT thread with the default overrun policy (Skip).
+ * @param[in, out] thread Thread attributes to create.
+ * @param[in] period_ns Period in nanoseconds.
+ * @param[in] callback Cycle body. Return false to stop.
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int CreatePeriodicThread(ThreadInfo &thread, int64_t period_ns, PeriodicCallback callback);
+
+/**
+ * Ask a periodic thread to leave its loop after the current cycle (does not join).
+ * DeleteThread() stops and joins a periodic thread.
+ * @param[in] thread Periodic thread.
+ */
+void StopPeriodicThread(ThreadInfo &thread);
+
+/**
+ * Ask every periodic thread to stop (used by DeleteAllThread()).
+ */
+void StopAllPeriodicThreads();
+
+/**
+ * Free the loop state of a stopped and joined periodic thread (used by DeleteThread()).
+ * @param[in, out] thread Periodic thread. thread.periodic is cleared.
+ */
+void ReleasePeriodicTask(ThreadInfo &thread);
+
+/**
+ * Timing statistics of a periodic thread.
+ * @param[in] thread Periodic thread.
+ * @return It returns nullptr if the thread was not created by CreatePeriodicThread().
+ */
+const PeriodicStats *GetPeriodicStats(const ThreadInfo &thread);
+
+/**
+ * Sleep-then-spin waiter of a periodic thread created with PeriodicConfig::preciseWake.
+ * @param[in] thread Periodic thread.
+ * @return It returns nullptr if the thread does not use it. Only ReadStats() may be called.
+ */
+const PreciseWaiter *GetPreciseWaiter(const ThreadInfo &thread);
+
+/**
+ * Fill ThreadTimeInfo (milliseconds) from the statistics of a periodic thread.
+ * @param[in] thread Periodic thread.
+ * @param[out] timeInfo period/algo times of the last cycle, average and max compute time, overrun count.
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int GetThreadTimeInfo(const ThreadInfo &thread, ThreadTimeInfo &timeInfo);
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_PERIODICTASK_H__
@@ -0,0 +1,104 @@
+/*!
+ \file      preciseWait.h
+ \brief     Hybrid sleep-then-spin wait to an absolute deadline with a self-calibrating margin
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_PRECISEWAIT_H__
+#define __DT_THREAD_PRECISEWAIT_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <cstdint>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "../dtUtils/dtSeqLock.hpp"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+/**
+ * Options of PreciseWaiter. The margin is how long before the deadline the thread asks to be
+ * woken up; the rest is spun. It tracks the 'quantile' of the observed wake-up latency plus
+ * guard_ns (streaming quantile estimate: +step*q on a late wake-up, -step*(1-q) otherwise), so a
+ * rare multi-ms outlier does not turn the thread into a busy loop. Higher quantile / guard_ns
+ * spend more CPU for less jitter.
+ */
+struct PreciseWaitConfig
+{
+    int64_t margin_ns = 50000;        //!< initial margin
+    int64_t minMargin_ns = 5000;
+    int64_t maxMargin_ns = 300000;    //!< upper bound of the spin time per wait
+    int64_t guard_ns = 5000;          //!< added to the latency estimate
+    double  quantile = 0.99;          //!< wake-up latency quantile the margin covers
+    int64_t step_ns = 2000;           //!< adaptation step (0: fixed margin)
+};
+
+/**
+ * Statistics of a PreciseWaiter.
+ */
+struct PreciseWaitStats
+{
+    uint64_t waits = 0;
+    uint64_t misses = 0;             //!< woke up from the sleep after the deadline (margin too small)
+    int64_t  margin_ns = 0;          //!< current margin
+    int64_t  sleepLatency_ns = 0;    //!< last: wake-up time minus requested sleep end
+    int64_t  sleepLatencyMax_ns = 0;
+    int64_t  spin_ns = 0;            //!< last: time spun until the deadline
+    int64_t  spinAvg_ns = 0;
+    int64_t  lateMax_ns = 0;         //!< largest return time after the deadline
+};
+
+/**
+ * Waits until an absolute CLOCK_MONOTONIC deadline: clock_nanosleep() to deadline - margin, then
+ * spin on the clock (vDSO, no syscall) to the deadline.
+ * One thread waits (single writer); ReadStats() can be called from any thread.
+ */
+class PreciseWaiter
+{
+public:
+    explicit PreciseWaiter(const PreciseWaitConfig &config = PreciseWaitConfig{}) noexcept;
+
+    void Configure(const PreciseWaitConfig &config) noexcept;
+
+    /**
+     * Wait until deadline_ns (CLOCK_MONOTONIC). Returns immediately if it has passed.
+     * @return It returns the wake-up time (CLOCK_MONOTONIC ns).
+     */
+    int64_t WaitUntil(int64_t deadline_ns) noexcept;
+    int64_t WaitFor(int64_t duration_ns) noexcept;
+
+    int64_t Margin() const noexcept { return m_margin_ns; }
+
+    bool ReadStats(PreciseWaitStats &out) const noexcept { return m_stats.TryLoad(out); }
+    void ResetStats() noexcept;
+
+private:
+    void Adapt(int64_t latency_ns) noexcept;
+
+    PreciseWaitConfig m_config;
+    int64_t  m_margin_ns = 0;
+    int64_t  m_stepUp_ns = 0;
+    int64_t  m_stepDown_ns = 0;
+    int64_t  m_spinSum_ns = 0;
+    PreciseWaitStats m_cur{};
+    dt::Utils::SeqLock<PreciseWaitStats> m_stats;
+};
+
+//* Public(Exported) Functions -----------------------------------------------*/
+/**
+ * CLOCK_MONOTONIC in nanoseconds (the time base of PreciseWaiter and the periodic threads).
+ */
+int64_t GetMonotonicNs();
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_PRECISEWAIT_H__
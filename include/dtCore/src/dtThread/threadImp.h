@@ -35,6 +35,9 @@ extern "C"
 #endif
 }
 
+#include <cstdint>
+#include <vector>
+
 //* Other Lib Headers --------------------------------------------------------*/
 //* Project Headers ----------------------------------------------------------*/
 //* System-Specific Headers --------------------------------------------------*/
@@ -72,21 +75,69 @@ typedef struct _threadTimeInfo
         int overrun = 0;
 } ThreadTimeInfo;
 
+class PeriodicTask; // periodicTask.h
+
+/**
+ * ThreadInfo::cpuIdx value to let CreateThread() place the thread (cpuTopology.h):
+ * RT threads get a free, preferably isolated core; non-RT threads a housekeeping core away from RT cores.
+ */
+constexpr int CPU_AUTO = -1;
+
+/**
+ * What CreateThread() does when the kernel refuses SCHED_DEADLINE for a thread
+ * (admission control: total bandwidth exceeded, missing CAP_SYS_NICE, kernel without SCHED_DEADLINE).
+ */
+enum class DeadlineFallback
+{
+    None, // fail: CreateThread() returns an error and the thread function is not run
+    Fifo, // SCHED_FIFO with ThreadInfo::priority, pinned to cpuIdx (default)
+    Other // SCHED_OTHER, pinned to cpuIdx
+};
+
 /**
  * Data structure to hold information of a thread created by dt::Thread.
+ * A realtime thread with dlRuntime_ns > 0 runs under SCHED_DEADLINE (Linux, EDF bandwidth
+ * reservation of dlRuntime_ns every dlPeriod_ns) instead of SCHED_FIFO. The kernel requires the
+ * affinity of a deadline thread to span its whole root domain, so cpuIdx only applies after a fallback.
  */
 typedef struct _threadInfo
 {
     const char *name = nullptr;
     void *(*procFunc)(void *arg) = nullptr;
     void *procFuncArg = nullptr;
-    int cpuIdx = 0;
+    int cpuIdx = 0;                   // CPU to pin, or CPU_AUTO
     int priority = 0;
     size_t stackSz = 0;
     dt_thread_t id = 0;
     int listIdx = 0;
+    PeriodicTask *periodic = nullptr; // set by CreatePeriodicThread()
+    int64_t dlRuntime_ns = 0;         // SCHED_DEADLINE CPU budget per period (0: SCHED_FIFO)
+    int64_t dlDeadline_ns = 0;        // relative deadline (0: dlPeriod_ns)
+    int64_t dlPeriod_ns = 0;          // reservation period (0: dlDeadline_ns; CreatePeriodicThread(): the task period)
+    DeadlineFallback dlFallback = DeadlineFallback::Fifo;
+    int policy = -1;                  // scheduling policy actually applied (set by CreateThread())
 } ThreadInfo;
 
+/**
+ * Runtime status of a registered thread, read from /proc/self/task/<tid> (Linux).
+ */
+typedef struct _threadStatus
+{
+    const char *name = nullptr;
+    ThreadInfo *info = nullptr;
+    int tid = 0;                 // kernel thread id (0 until the thread has started)
+    bool realtime = false;       // created as RT thread
+    int cpuIdx = 0;              // requested CPU
+    int lastCpu = -1;            // CPU the thread last ran on
+    int policy = 0;              // SCHED_OTHER(0), SCHED_FIFO(1), ... SCHED_DEADLINE(6)
+    int priority = 0;            // RT priority
+    double userTime_ms = 0;
+    double sysTime_ms = 0;
+    long volCtxSwitches = 0;     // voluntary (blocking, sleeping)
+    long involCtxSwitches = 0;   // preempted
+    char cpusAllowed[64] = {};   // affinity list, e.g. "2" or "0-3,6"
+} ThreadStatus;
+
 /**
  * Information of semaphore created.
  */
@@ -104,6 +155,7 @@ typedef struct _mtxInfo
 {
     dt_mutex_t mutex;
     int listIdx = 0;
+    bool prioInherit = false; // created with PTHREAD_PRIO_INHERIT
 } MtxInfo;
 
 //* Public(Exported) Variables -----------------------------------------------*/
@@ -116,6 +168,9 @@ int GetCpuCount();
 
 /**
  * Create a RT or a non-RT thread.
+ * RT threads run under SCHED_FIFO, or SCHED_DEADLINE if thread.dlRuntime_ns > 0. A refused
+ * SCHED_DEADLINE request is logged with the reason and handled as thread.dlFallback says;
+ * thread.policy tells which policy the thread got.
  * @param[in, out] thread Thread attributes to create.
  * @param realtime RT or non-RT
  * @param addList Add thread id to internal list or not
@@ -138,7 +193,7 @@ int CreateRtThread(ThreadInfo &thread);
 int CreateNonRtThread(ThreadInfo &thread);
 
 /**
- * Joint a thread and remove it from thread list.
+ * Joint a thread and remove it from thread list. A periodic thread is stopped first.
  * @param[in] thread Thread to delete.
  * @return It returns 0 if successful. Otherwise it returns non-zero error code.
  */
@@ -150,6 +205,34 @@ int DeleteThread(ThreadInfo &thread);
  */
 int DeleteAllThread();
 
+/**
+ * Count threads registered.
+ * @return It returns number of threads in the thread list.
+ */
+int GetThreadCount();
+
+/**
+ * Find a registered thread by name.
+ * @param[in] name Thread name given at creation.
+ * @return It returns the ThreadInfo passed to CreateThread(), or nullptr if not found.
+ */
+ThreadInfo *FindThread(const char *name);
+
+/**
+ * Read runtime status (CPU time, context switches, affinity) of a registered thread.
+ * @param[in] thread Registered thread.
+ * @param[out] status Status of the thread.
+ * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+ */
+int GetThreadStatus(const ThreadInfo &thread, ThreadStatus &status);
+
+/**
+ * Read runtime status of all registered threads.
+ * @param[out] list Status of each thread, in creation order.
+ * @return It returns number of threads.
+ */
+int GetAllThreadStatus(std::vector<ThreadStatus> &list);
+
 /**
  * Create a semaphore.
  * @param[out] semInfo Data structure that holds information of semaphore created.
@@ -211,9 +294,11 @@ int DeleteAllSemaphore();
 /**
  * Create a mutex with given information.
  * @param[out] mtxInfo Data structure to hold information about a new mutex to be created.
+ * @param[in] prioInherit Use PTHREAD_PRIO_INHERIT: a lower priority holder is boosted to the priority
+ *            of the highest RT thread waiting for the mutex (no unbounded priority inversion).
  * @return It returns 0 if successful. Otherwise it returns non-zero error code.
  */
-int CreateMutex(MtxInfo &mtxInfo);
+int CreateMutex(MtxInfo &mtxInfo, bool prioInherit = false);
 
 /**
  * Lock the given mutex.
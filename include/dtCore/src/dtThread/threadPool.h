@@ -0,0 +1,223 @@
+/*!
+ \file      threadPool.h
+ \brief     Work-stealing thread pool for non-RT work, restricted to a CPU set
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef __DT_THREAD_THREADPOOL_H__
+#define __DT_THREAD_THREADPOOL_H__
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "threadImp.h"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Public(Exported) Types ---------------------------------------------------*/
+/**
+ * Options of ThreadPool.
+ */
+struct ThreadPoolConfig
+{
+    const char *name = "pool";   //!< worker names: "<name>/<idx>"
+    std::vector<int> cpus;       //!< CPUs of the workers. Empty: GetHousekeepingCpus() away from registered RT threads
+    int numThreads = 0;          //!< 0: one worker per CPU in 'cpus'
+    bool pinEach = false;        //!< true: worker i runs only on cpus[i % n], false: any CPU in 'cpus'
+    size_t stackSz = 0;          //!< 0: default stack size
+};
+
+/**
+ * Counters of one worker (relaxed, for monitoring and benchmarks).
+ */
+struct ThreadPoolWorkerStats
+{
+    uint64_t executed = 0;       //!< tasks run by this worker
+    uint64_t stolen = 0;         //!< of which taken from another worker's deque
+    uint64_t sleeps = 0;         //!< times the worker found no work and slept
+};
+
+/**
+ * Thread pool for non-RT work (serialization, planners, service callbacks).
+ *
+ * - Workers are CreateNonRtThread() threads pinned to 'cpus', so keeping the RT cores out of
+ *   the set keeps pool work off them.
+ * - Each worker owns a deque: tasks submitted from a worker go to its own deque (LIFO for the
+ *   owner, cache-warm); idle workers steal the oldest task from the others (FIFO).
+ *   Tasks submitted from other threads are distributed round-robin.
+ * - Tasks may allocate and block; do not submit from RT threads.
+ * - Workers are registered threads: Stop() the pool before DeleteAllThread().
+ * - Before Start() (or after Stop()) Post() runs the task on the calling thread.
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(const ThreadPoolConfig &config = ThreadPoolConfig());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Create the worker threads.
+     * @return It returns 0 if successful. Otherwise it returns non-zero error code.
+     */
+    int Start();
+
+    /**
+     * Finish queued tasks and join the workers. Called by the destructor.
+     */
+    void Stop();
+
+    int GetThreadCount() const { return (int)m_workers.size(); }
+
+    /**
+     * Run a task without a result.
+     */
+    void Post(std::function<void()> task);
+
+    /**
+     * Run a task and get its result (or exception) through a future.
+     */
+    template <typename F>
+    auto Submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    /**
+     * Run 'func', then 'cont' with its result (cont(void) for void tasks) as another pool task.
+     * @return future of the continuation's result.
+     */
+    template <typename F, typename C>
+    auto SubmitThen(F &&func, C &&cont);
+
+    /**
+     * Split [begin, end) into chunks of 'grain' indices and run body(chunkBegin, chunkEnd) on the
+     * pool. The caller takes part in the work and returns when every chunk is done (also safe
+     * to call from inside a pool task).
+     */
+    void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+    /**
+     * Run queued tasks on the calling thread until 'done' returns true (used to wait inside tasks
+     * without blocking a worker).
+     */
+    void HelpUntil(const std::function<bool()> &done);
+
+    void GetStats(std::vector<ThreadPoolWorkerStats> &stats) const;
+
+private:
+    struct Worker
+    {
+        ThreadInfo info;
+        char name[32] = {};
+        ThreadPool *pool = nullptr;
+        int index = 0;
+        std::mutex dequeMtx;
+        std::deque<std::function<void()>> tasks;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> sleeps{0};
+    };
+
+    static void *WorkerProc(void *arg);
+    template <typename P, typename F, typename... Args>
+    static void Fulfill(P &promise, F &func, Args &&...args);
+    void Push(std::function<void()> task);
+    bool PopLocal(Worker &w, std::function<void()> &task);
+    bool Steal(int thief, std::function<void()> &task);
+    bool RunOne(int self);
+    int CurrentWorker() const;
+
+    ThreadPoolConfig m_config;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running{false};
+    std::atomic<int64_t> m_pending{0};   // queued, not yet started
+    std::atomic<uint32_t> m_nextWorker{0};
+    std::mutex m_sleepMtx;
+    std::condition_variable m_sleepCv;
+    std::atomic<int> m_sleepers{0};
+};
+
+//* Template Member Functions ------------------------------------------------*/
+template <typename F>
+auto ThreadPool::Submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+    std::future<R> result = task->get_future();
+    Post([task]() { (*task)(); });
+    return result;
+}
+
+template <typename P, typename F, typename... Args>
+void ThreadPool::Fulfill(P &promise, F &func, Args &&...args)
+{
+    try
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>)
+        {
+            func(std::forward<Args>(args)...);
+            promise.set_value();
+        }
+        else
+        {
+            promise.set_value(func(std::forward<Args>(args)...));
+        }
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+template <typename F, typename C>
+auto ThreadPool::SubmitThen(F &&func, C &&cont)
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    using R2 = typename std::conditional_t<std::is_void_v<R>, std::invoke_result<std::decay_t<C>>,
+                                           std::invoke_result<std::decay_t<C>, R>>::type;
+    auto promise = std::make_shared<std::promise<R2>>();
+    std::future<R2> result = promise->get_future();
+    Post([this, f = std::forward<F>(func), c = std::forward<C>(cont), promise]() mutable {
+        // the continuation is posted as its own task, so a long chain does not pin one worker
+        try
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                f();
+                Post([c = std::move(c), promise]() mutable { Fulfill(*promise, c); });
+            }
+            else
+            {
+                auto value = std::make_shared<R>(f());
+                Post([c = std::move(c), value, promise]() mutable { Fulfill(*promise, c, std::move(*value)); });
+            }
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
+
+} // namespace Thread
+} // namespace dt
+
+#endif // __DT_THREAD_THREADPOOL_H__
@@ -8,6 +8,17 @@
 #define __DT_UTILS_LOCK_H__
 
 #include <atomic>
+#include <cstdint>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 /** \defgroup dtUtils
  *
@@ -16,18 +27,193 @@ namespace dt
 {
 namespace Utils
 {
+/**
+ * Hint to the CPU that the caller is spinning (x86 pause / arm yield).
+ * Frees pipeline resources for the SMT sibling and avoids the memory-order flush on loop exit.
+ */
+inline void CpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Test-and-test-and-set spinlock with bounded exponential backoff.
+ * - waiters spin on a plain load (the line stays shared in their caches) and only try the
+ *   exchange when the lock looks free; after a failed attempt the pause count doubles up to
+ *   MAX_BACKOFF so that N waiters do not hammer the line together.
+ * - for very short critical sections between threads on different CPUs. Two SCHED_FIFO
+ *   threads on the same CPU must not share it (the waiter never lets the holder run):
+ *   use AdaptiveMutex or a PI mutex (CreateMutex(info, true)) there.
+ * - satisfies Lockable: std::lock_guard / std::unique_lock work.
+ */
+class SpinLock
+{
+public:
+    static constexpr uint32_t MAX_BACKOFF = 1024; // pause instructions
+
+    void lock() noexcept
+    {
+        uint32_t backoff = 1;
+        for (;;)
+        {
+            if (!m_locked.exchange(true, std::memory_order_acquire))
+            {
+                return;
+            }
+            do
+            {
+                for (uint32_t i = 0; i < backoff; ++i) CpuRelax();
+                backoff = (backoff < MAX_BACKOFF) ? backoff << 1 : MAX_BACKOFF;
+            } while (m_locked.load(std::memory_order_relaxed));
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { m_locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> m_locked{false};
+};
+
+/**
+ * FIFO ticket lock: waiters are served in arrival order, so no thread starves under
+ * contention (SpinLock favours whoever happens to see the line free first).
+ * Waiters back off in proportion to their distance from the head of the line.
+ * Same CPU / scheduling caveats as SpinLock; a preempted waiter also blocks everyone behind it.
+ */
+class TicketLock
+{
+public:
+    void lock() noexcept
+    {
+        const uint32_t ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+        for (;;)
+        {
+            const uint32_t serving = m_serving.load(std::memory_order_acquire);
+            if (serving == ticket)
+            {
+                return;
+            }
+            const uint32_t ahead = ticket - serving;
+            for (uint32_t i = 0; i < ahead * 32; ++i) CpuRelax();
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        uint32_t serving = m_serving.load(std::memory_order_acquire);
+        uint32_t expected = serving;
+        return m_next.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        // only the holder writes m_serving
+        m_serving.store(m_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> m_next{0};
+    alignas(64) std::atomic<uint32_t> m_serving{0};
+};
+
+/**
+ * Adaptive mutex: spins for a short while, then sleeps in the kernel (futex, Linux).
+ * State 0: free, 1: locked, 2: locked with (possible) sleepers — unlock() enters the kernel only
+ * in state 2 ("Futexes Are Tricky", U. Drepper, mutex #3).
+ * Cheaper than pthread_mutex when uncontended and safe between threads on one CPU, but it has
+ * no priority inheritance: for RT threads sharing a lock with lower priority ones use
+ * dt::Thread::CreateMutex(info, true).
+ */
+class AdaptiveMutex
+{
+public:
+    static constexpr int SPIN_COUNT = 100; // tries before sleeping
+
+    void lock() noexcept
+    {
+        int c = 0;
+        for (int i = 0; i < SPIN_COUNT; ++i)
+        {
+            c = 0;
+            if (m_state.compare_exchange_weak(c, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return;
+            }
+            if (c == 2) break; // others are already sleeping: join them
+            CpuRelax();
+        }
+        if (c != 2)
+        {
+            c = m_state.exchange(2, std::memory_order_acquire);
+        }
+        while (c != 0)
+        {
+            Wait(2);
+            c = m_state.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        int c = 0;
+        return m_state.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        if (m_state.fetch_sub(1, std::memory_order_release) != 1)
+        {
+            m_state.store(0, std::memory_order_release);
+            Wake();
+        }
+    }
+
+private:
+    void Wait(int expected) noexcept
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int *>(&m_state), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+        (void)expected;
+        std::this_thread::yield();
+#endif
+    }
+
+    void Wake() noexcept
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int *>(&m_state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex needs a plain 32 bit word");
+    std::atomic<int> m_state{0};
+};
+
 /**
  * Lock implementation.
+ * Legacy try-lock: lock() makes one attempt and returns false if the lock is held.
+ * Kept for existing code (while (!lock.lock());); new code should use SpinLock, TicketLock
+ * or AdaptiveMutex with std::lock_guard.
  */
 class Lock
 {
 public:
     bool lock() {
         bool expected = false;
-        return _lock.compare_exchange_strong(expected, true);
+        return _lock.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
     }
     void unlock() {
-        _lock.store(false);
+        _lock.store(false, std::memory_order_release);
     }
 private:
     std::atomic_bool _lock{false};
@@ -36,4 +222,4 @@ private:
 } // namespace Utils
 } // namespace dt
 
-#endif // __DT_UTILS_LOCK_H__
\ No newline at end of file
+#endif // __DT_UTILS_LOCK_H__
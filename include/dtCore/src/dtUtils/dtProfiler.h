@@ -0,0 +1,178 @@
+/*!
+ \file      dtProfiler.h
+ \brief     Named scoped profiler: TSC timestamps, per-thread lock-free count / total / min / max / log2 histogram
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_PROFILER_H_
+#define _DT_PROFILER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "dtTimeUtil.hpp"
+
+namespace dt
+{
+namespace Utils
+{
+
+// Zone profiler for code sections that TimeCheck is too heavy or too manual for.
+//   void Control() {
+//       DT_PROFILE_FUNCTION();
+//       { DT_PROFILE_SCOPE("ik"); SolveIk(); }   // nested: the parent also gets its self time
+//   }
+// - each DT_PROFILE_SCOPE site is one static ProfileZone, registered the first time it runs
+//   (a mutex once; call ProfilerRegisterThread() in the non-RT init of an RT thread so the
+//   first cycle does not allocate the thread's counters either).
+// - timestamps are TSC ticks (cntvct_el0 on aarch64, CLOCK_MONOTONIC without an invariant TSC);
+//   entering and leaving a zone costs two timestamps and a few stores to the thread's own
+//   counters: no lock, no atomic RMW, no allocation.
+// - ProfileSnapshot() / ProfileReport() merge all threads on a non-RT thread (e.g. a
+//   CoScheduler::Every() job) and convert ticks to ns.
+// - disabled: a zone switched off at run time costs one relaxed load. Building with
+//   DT_PROFILE_DISABLE (cmake -DBUILD_dtCore_PROFILER=OFF) removes the zones entirely.
+constexpr int PROFILE_MAX_ZONES = 128;
+constexpr int PROFILE_HIST_BUCKETS = 40; // bucket b: [2^b, 2^(b+1)) ticks, the last one is open
+
+class ProfileClock
+{
+public:
+    static inline uint64_t Now() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if (s_tsc.load(std::memory_order_relaxed))
+        {
+            return __rdtsc();
+        }
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#endif
+        return (uint64_t)MonotonicNs();
+    }
+    // ns per tick, measured against CLOCK_MONOTONIC since the first zone was registered
+    static double NsPerTick();
+    static const char *Source() noexcept; // "tsc", "cntvct" or "monotonic"
+
+private:
+    static std::atomic<bool> s_tsc; // invariant TSC found at start-up
+};
+
+struct ProfileZone
+{
+    ProfileZone(const char *zoneName, const char *srcFile, int srcLine) noexcept;
+
+    const char *name;
+    const char *file;
+    int line;
+    int id;                        // -1: more than PROFILE_MAX_ZONES zones, not measured
+    std::atomic<bool> active;      // enabled and the profiler is enabled
+    bool enabled;                  // ProfileSetZoneEnabled()
+    ProfileZone *next;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone &zone) noexcept
+    {
+        if (!zone.active.load(std::memory_order_relaxed))
+        {
+            m_zone = nullptr;
+            return;
+        }
+        m_zone = &zone;
+        Enter();
+        m_start = ProfileClock::Now();
+    }
+    ~ProfileScope()
+    {
+        if (m_zone)
+        {
+            Leave(ProfileClock::Now());
+        }
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    void Enter() noexcept;
+    void Leave(uint64_t end) noexcept;
+
+    ProfileZone *m_zone;
+    ProfileScope *m_parent = nullptr;
+    uint64_t m_start = 0;
+    uint64_t m_child = 0; // ticks spent in nested zones
+};
+
+struct ProfileZoneStats
+{
+    std::string name;
+    std::string file;
+    int      line = 0;
+    int      threads = 0;    // threads that ran the zone (exited threads included)
+    uint64_t count = 0;
+    double   total_ns = 0;
+    double   self_ns = 0;    // total minus nested zones
+    double   min_ns = 0;
+    double   max_ns = 0;
+    double   mean_ns = 0;
+    double   p50_ns = 0;     // upper bound of the histogram bucket
+    double   p99_ns = 0;
+    uint64_t hist[PROFILE_HIST_BUCKETS] = {};
+};
+
+struct ProfileReportConfig
+{
+    size_t      maxZones = 20;    // by total time
+    bool        log = true;       // RtLog, LOG(info)
+    int         tuiLayout = -1;   // >= 0: TUI group (no-op if the TUI is disabled)
+    int         tuiGroup = 0;
+    std::string jsonFile;         // not empty: every zone, written to a temporary and renamed
+    bool        reset = false;    // start a new interval after the report
+};
+
+bool ProfilerRegisterThread() noexcept;
+void ProfilerSetEnabled(bool enable);
+bool ProfilerIsEnabled();
+// every zone with this name, returns false if there is none (yet)
+bool ProfileSetZoneEnabled(const char *name, bool enable);
+// Zero all counters. Threads drop their counters at their next zone, so a snapshot racing a
+// reset may mix both intervals.
+void ProfilerReset();
+
+// Merge all threads, sorted by total time. Returns the number of zones.
+size_t ProfileSnapshot(std::vector<ProfileZoneStats> &zones);
+double ProfileBucketNs(int bucket); // lower bound of a histogram bucket
+bool ProfileWriteJson(const std::string &path, const std::vector<ProfileZoneStats> &zones);
+void ProfileReport(const ProfileReportConfig &config = ProfileReportConfig());
+
+} // namespace Utils
+} // namespace dt
+
+#define DT_PROFILE_CONCAT_(a, b) a##b
+#define DT_PROFILE_NAME_(a, b) DT_PROFILE_CONCAT_(a, b)
+
+#if defined(DT_PROFILE_DISABLE)
+#define DT_PROFILE_SCOPE(name) do {} while (0)
+#else
+// DT_PROFILE_SCOPE("name"): measure the rest of the enclosing block. 'name' must outlive the program (a literal).
+#define DT_PROFILE_SCOPE(name)                                                                                 \
+    static dt::Utils::ProfileZone DT_PROFILE_NAME_(_dtProfZone_, __LINE__){name, __FILE__, __LINE__};          \
+    dt::Utils::ProfileScope DT_PROFILE_NAME_(_dtProfScope_, __LINE__){DT_PROFILE_NAME_(_dtProfZone_, __LINE__)}
+#endif
+#define DT_PROFILE_FUNCTION() DT_PROFILE_SCOPE(__func__)
+
+#endif // _DT_PROFILER_H_
@@ -0,0 +1,177 @@
+/*!
+ \file      dtRcu.h
+ \brief     Epoch-based RCU: wait-free RT read sections, atomic publish, deferred free on non-RT threads
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RCU_H_
+#define _DT_RCU_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dt
+{
+namespace Utils
+{
+
+// Epoch-based read-copy-update.
+// - readers (RT) bracket every access with RcuReadGuard: a thread-local counter and one store
+//   of the global epoch into the thread's slot. Wait-free, no allocation, no lock. Sections nest.
+// - writers (non-RT) build the new version, publish it with one atomic store (RcuPtr::Publish,
+//   RcuList::Append/Remove) and retire the old one.
+// - retired versions are deleted by RcuReclaim() once every reader that might still see them
+//   has left its section. It runs on the writer (RcuPtr / RcuList call it after each publish) or
+//   on any non-RT housekeeping thread; a reader never frees anything.
+// - a pointer read in a section is valid until the end of that section only.
+//
+// A thread takes one of RCU_MAX_READERS reader slots on its first section (lock-free, no
+// allocation) and returns it when it exits. Call RcuRegisterThread() in the non-RT init of an RT
+// thread to see a failure there; readers beyond the limit still work but hold back every
+// reclamation while they are inside a section.
+constexpr int RCU_MAX_READERS = 256;
+
+struct RcuStats
+{
+    uint64_t epoch = 0;
+    uint64_t retired = 0;       // objects retired so far
+    uint64_t reclaimed = 0;     // of which deleted
+    uint64_t pending = 0;       // retired, waiting for readers
+    int      readers = 0;       // threads holding a reader slot
+    int      activeReaders = 0; // of which inside a section now
+};
+
+// reader side -------------------------------------------------------------------
+bool RcuRegisterThread() noexcept;
+void RcuReadLock() noexcept;
+void RcuReadUnlock() noexcept;
+bool RcuInReadSection() noexcept;
+
+class RcuReadGuard
+{
+public:
+    RcuReadGuard() noexcept { RcuReadLock(); }
+    ~RcuReadGuard() { RcuReadUnlock(); }
+    RcuReadGuard(const RcuReadGuard &) = delete;
+    RcuReadGuard &operator=(const RcuReadGuard &) = delete;
+};
+
+// writer / reclaimer side (non-RT) --------------------------------------------
+// Hand 'ptr' over for deletion by deleter(ptr) once no reader can reference it.
+void RcuRetire(void *ptr, void (*deleter)(void *));
+template <typename T>
+inline void RcuRetire(T *ptr)
+{
+    if (ptr) RcuRetire(const_cast<void *>(static_cast<const void *>(ptr)), [](void *p) { delete static_cast<T *>(p); });
+}
+// Delete the retired objects no reader can see. Never blocks. Returns the number deleted.
+size_t RcuReclaim();
+// Wait until every read section that started before the call has ended (not from a read
+// section), then reclaim. Use before destroying something readers may still use.
+void RcuSynchronize();
+void GetRcuStats(RcuStats &stats);
+
+// Single shared object (configuration, trajectory, calibration table).
+//   reader: RcuReadGuard g; const Config *c = cfg.Read(); ... (valid until g ends)
+//   writer: cfg.Update([](Config &next) { next.gain = 2.0; });  // copy, modify, publish
+template <typename T>
+class RcuPtr
+{
+public:
+    explicit RcuPtr(T *init = nullptr) noexcept : m_ptr(init) {}
+    ~RcuPtr()
+    {
+        // no reader may be left at destruction
+        delete m_ptr.load(std::memory_order_relaxed);
+    }
+    RcuPtr(const RcuPtr &) = delete;
+    RcuPtr &operator=(const RcuPtr &) = delete;
+
+    // reader: inside a read section
+    const T *Read() const noexcept { return m_ptr.load(std::memory_order_acquire); }
+
+    // writers (serialized internally)
+    void Publish(T *next)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMtx);
+        PublishLocked(next);
+    }
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        Publish(new T(std::forward<Args>(args)...));
+    }
+    // copy the current version (default-constructed if none), modify it and publish the copy
+    template <typename F>
+    void Update(F &&modify)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMtx);
+        const T *cur = m_ptr.load(std::memory_order_relaxed);
+        T *next = cur ? new T(*cur) : new T();
+        modify(*next);
+        PublishLocked(next);
+    }
+
+private:
+    void PublishLocked(T *next)
+    {
+        T *prev = m_ptr.exchange(next, std::memory_order_acq_rel);
+        RcuRetire(prev);
+        RcuReclaim();
+    }
+
+    std::atomic<T *> m_ptr;
+    std::mutex m_writeMtx;
+};
+
+// Copy-on-write list for the RT side to iterate (data sinks, observers, callbacks).
+//   reader: RcuReadGuard g; for (const auto &s : list.Read()) s->Publish(msg);
+//   writer: list.Append(sink); list.Remove(sink);
+// Elements leave with the old version, i.e. on the reclaiming non-RT thread.
+template <typename T>
+class RcuList
+{
+public:
+    using Container = std::vector<T>;
+
+    RcuList() : m_items(new Container()) {}
+
+    // reader: inside a read section
+    const Container &Read() const noexcept { return *m_items.Read(); }
+
+    // writers
+    void Append(const T &item)
+    {
+        m_items.Update([&item](Container &next) { next.push_back(item); });
+    }
+    // removes every element equal to 'item'
+    void Remove(const T &item)
+    {
+        m_items.Update([&item](Container &next) { next.erase(std::remove(next.begin(), next.end(), item), next.end()); });
+    }
+    template <typename Pred>
+    void RemoveIf(Pred pred)
+    {
+        m_items.Update([&pred](Container &next) { next.erase(std::remove_if(next.begin(), next.end(), pred), next.end()); });
+    }
+    void Clear()
+    {
+        m_items.Publish(new Container());
+    }
+
+private:
+    RcuPtr<Container> m_items;
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_RCU_H_
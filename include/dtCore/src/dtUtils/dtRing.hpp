@@ -0,0 +1,277 @@
+/*!
+ \file      dtRing.hpp
+ \brief     Bounded lock-free SPSC / MPMC rings for arbitrary T
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RING_H_
+#define _DT_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "dtRtMem.hpp"
+
+namespace dt
+{
+namespace Utils
+{
+
+// Common rules of SpscRing / MpmcRing
+// - slot storage is mapped by Allocate() (nonRT, before use) with RtMemOptions, like LogQueue:
+//   capacity is rounded up to a power of 2, no allocation on push/pop.
+// - T is constructed in place on push and destroyed on pop; T's own copy/move must not
+//   allocate if the ring is used from an RT thread.
+// - TryPush()/TryPop() never block: they return false when full / empty (or unallocated).
+// - Release() (nonRT, after producers/consumers stopped) destroys what is left in the ring.
+
+// Single producer / single consumer ring.
+// head and tail live on their own cache lines, and each side caches the other side's index,
+// so a push/pop touches the shared line only when the cached index says full/empty.
+template <typename T>
+class SpscRing
+{
+public:
+    SpscRing() noexcept = default;
+    ~SpscRing() { Release(); }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    bool Allocate(size_t capacity, const RtMemOptions &opt = RtMemOptions{}) noexcept
+    {
+        Release();
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        if (!AllocRtMem(cap * sizeof(Storage), opt, m_mem))
+        {
+            return false;
+        }
+        m_slots = static_cast<Storage *>(m_mem.ptr);
+        m_mask = cap - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_headCache = 0;
+        m_tailCache = 0;
+        return true;
+    }
+
+    void Release() noexcept
+    {
+        if (m_slots)
+        {
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            for (size_t pos = m_head.load(std::memory_order_relaxed); pos != tail; ++pos)
+            {
+                std::launder(reinterpret_cast<T *>(&m_slots[pos & m_mask]))->~T();
+            }
+        }
+        FreeRtMem(m_mem);
+        m_slots = nullptr;
+        m_mask = 0;
+    }
+
+    // producer ---------------------------------------------------------------
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        if (!m_slots) return false;
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache > m_mask)
+        {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache > m_mask) return false; // full
+        }
+        new (&m_slots[tail & m_mask]) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    bool TryPush(const T &value) { return TryEmplace(value); }
+    bool TryPush(T &&value) { return TryEmplace(std::move(value)); }
+
+    // consumer ---------------------------------------------------------------
+    bool TryPop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        if (!m_slots) return false;
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) return false; // empty
+        }
+        T *slot = std::launder(reinterpret_cast<T *>(&m_slots[head & m_mask]));
+        out = std::move(*slot);
+        slot->~T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // approximate when called while the other side is running
+    size_t Size() const noexcept { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+    bool Empty() const noexcept { return Size() == 0; }
+    size_t Capacity() const noexcept { return m_slots ? m_mask + 1 : 0; }
+
+private:
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    RtMemBlock m_mem;
+    Storage *m_slots{nullptr};
+    size_t m_mask{0};
+
+    alignas(64) std::atomic<size_t> m_head{0}; // written by the consumer
+    size_t m_tailCache{0};                     // consumer's copy of m_tail
+    alignas(64) std::atomic<size_t> m_tail{0}; // written by the producer
+    size_t m_headCache{0};                     // producer's copy of m_head
+};
+
+// Multi producer / multi consumer ring (bounded, D. Vyukov's sequence-per-slot algorithm,
+// the same scheme as LogQueue). Each slot is padded to a cache line.
+// Lock-free, not wait-free: a producer/consumer preempted between claiming a slot and
+// publishing it delays the ones behind it on that slot, so keep RT and nonRT sides on
+// separate rings where possible (SPSC per direction).
+// T's constructor must not throw here: a claimed slot cannot be given back.
+template <typename T>
+class MpmcRing
+{
+public:
+    MpmcRing() noexcept = default;
+    ~MpmcRing() { Release(); }
+
+    MpmcRing(const MpmcRing &) = delete;
+    MpmcRing &operator=(const MpmcRing &) = delete;
+
+    bool Allocate(size_t capacity, const RtMemOptions &opt = RtMemOptions{}) noexcept
+    {
+        Release();
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        if (!AllocRtMem(cap * sizeof(Slot), opt, m_mem))
+        {
+            return false;
+        }
+        m_slots = static_cast<Slot *>(m_mem.ptr);
+        for (size_t i = 0; i < cap; ++i)
+        {
+            Slot *slot = new (&m_slots[i]) Slot();
+            slot->seq.store(i, std::memory_order_relaxed);
+        }
+        m_mask = cap - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Release() noexcept
+    {
+        if (m_slots)
+        {
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            for (size_t pos = m_head.load(std::memory_order_relaxed); pos != tail; ++pos)
+            {
+                std::launder(reinterpret_cast<T *>(&m_slots[pos & m_mask].storage))->~T();
+            }
+            for (size_t i = 0; i <= m_mask; ++i) m_slots[i].~Slot();
+        }
+        FreeRtMem(m_mem);
+        m_slots = nullptr;
+        m_mask = 0;
+    }
+
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        if (!m_slots) return false;
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot &slot = m_slots[pos & m_mask];
+            const size_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (&slot.storage) T(std::forward<Args>(args)...);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    bool TryPush(const T &value) { return TryEmplace(value); }
+    bool TryPush(T &&value) { return TryEmplace(std::move(value)); }
+
+    bool TryPop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        if (!m_slots) return false;
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot &slot = m_slots[pos & m_mask];
+            const size_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    T *value = std::launder(reinterpret_cast<T *>(&slot.storage));
+                    out = std::move(*value);
+                    value->~T();
+                    slot.seq.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t Size() const noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return (tail > head) ? tail - head : 0;
+    }
+    bool Empty() const noexcept { return Size() == 0; }
+    size_t Capacity() const noexcept { return m_slots ? m_mask + 1 : 0; }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<size_t> seq{0};
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    RtMemBlock m_mem;
+    Slot *m_slots{nullptr};
+    size_t m_mask{0};
+
+    alignas(64) std::atomic<size_t> m_tail{0}; // producers
+    alignas(64) std::atomic<size_t> m_head{0}; // consumers
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_RING_H_
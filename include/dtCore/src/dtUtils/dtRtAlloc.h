@@ -0,0 +1,367 @@
+/*!
+ \file      dtRtAlloc.h
+ \brief     RT-safe block pools, per-cycle arena, std allocator adapters and a heap allocation trap
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTALLOC_H_
+#define _DT_RTALLOC_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "dtLock.hpp"
+#include "dtRtMem.hpp"
+
+namespace dt
+{
+namespace Utils
+{
+
+// RT 경로에서는 malloc / new를 호출하지 않는다. (glibc arena lock, brk / mmap system call,
+// 첫 접근 page fault) 필요한 메모리는 초기화 시점(nonRT)에 AllocRtMem()으로 prefault /
+// mlock 된 영역을 잡아두고 아래 allocator로 나누어 쓴다.
+//
+//   RtBlockPool   fixed size blocks, O(1) Alloc / Free from any thread, per-thread cache
+//   RtPoolSet     several RtBlockPools as size classes (e.g. 32 B .. 4 KB) for variable sizes
+//   RtArena       per-cycle bump allocator of one thread: Alloc() only, Reset() every cycle
+//   RtPoolAllocator<T> / RtArenaAllocator<T>   std allocator adapters of the above
+//
+// DT_RT_ALLOC_TRAP builds (cmake -DBUILD_dtCore_RT_ALLOC_TRAP=ON) replace the global
+// operator new / delete and report every heap allocation made by a thread marked with
+// SetRtThread(true) or inside an RtSection (periodic thread callbacks are marked).
+
+/**
+ * Fixed size block pool.
+ * - Allocate() / Release() in nonRT context (before / after use), like SpscRing.
+ * - Alloc() returns nullptr when the pool is exhausted; it never falls back to the heap.
+ * - each thread keeps a small cache of free blocks per pool (up to RTPOOL_CACHE_POOLS pools per
+ *   thread), so Alloc() / Free() usually touch only thread local data. The shared free list is
+ *   refilled / drained in batches of RTPOOL_CACHE_BATCH under an AdaptiveMutex (no spinning
+ *   forever when an RT thread and a nonRT holder share a CPU).
+ * - the first Alloc() / Free() of a thread registers its cache (thread exit returns the cached
+ *   blocks): call WarmUp() once in the thread's init code, outside the cycle.
+ * - a block may be freed by another thread than the one that allocated it.
+ */
+class RtBlockPool
+{
+public:
+    static constexpr size_t   MIN_ALIGN = 16;           // block alignment (and minimum size)
+    static constexpr uint32_t RTPOOL_CACHE_BATCH = 16;  // blocks moved between cache and pool at once
+    static constexpr int      RTPOOL_CACHE_POOLS = 8;   // pools cached per thread
+
+    RtBlockPool() noexcept = default;
+    ~RtBlockPool() { Release(); }
+
+    RtBlockPool(const RtBlockPool &) = delete;
+    RtBlockPool &operator=(const RtBlockPool &) = delete;
+
+    /**
+     * Map blockCount blocks of blockSize bytes (rounded up to MIN_ALIGN).
+     * @return false if the region could not be mapped.
+     */
+    bool Allocate(size_t blockSize, size_t blockCount, const RtMemOptions &opt = RtMemOptions{});
+
+    /**
+     * Unmap the pool. Every thread must have stopped using it; blocks still cached by other
+     * threads are dropped.
+     */
+    void Release();
+
+    void *Alloc() noexcept;
+    void Free(void *p) noexcept;
+
+    /** Register the calling thread's cache and fill it (call outside the RT cycle). */
+    void WarmUp() noexcept;
+
+    bool Owns(const void *p) const noexcept
+    {
+        const uintptr_t a = reinterpret_cast<uintptr_t>(p);
+        const uintptr_t b = reinterpret_cast<uintptr_t>(m_begin);
+        return m_begin && a >= b && a < b + m_blockSize * m_blockCount;
+    }
+
+    size_t BlockSize() const noexcept { return m_blockSize; }
+    size_t Capacity() const noexcept { return m_blockCount; }
+    bool IsLocked() const noexcept { return m_mem.locked; }
+    size_t CentralFree() const noexcept;                     // free blocks not held by thread caches
+    uint64_t Failures() const noexcept { return m_failures.load(std::memory_order_relaxed); }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    // shared free list
+    uint32_t Take(FreeBlock *&head, uint32_t n) noexcept;
+    void Give(FreeBlock *head, FreeBlock *tail, uint32_t n) noexcept;
+    static void OnThreadExit(void *caches);
+
+    RtMemBlock m_mem;
+    char *m_begin{nullptr};
+    size_t m_blockSize{0};
+    size_t m_blockCount{0};
+    uint64_t m_id{0};                      // unique per Allocate(): invalidates stale thread caches
+
+    mutable AdaptiveMutex m_lock;
+    FreeBlock *m_free{nullptr};
+    size_t m_freeCount{0};
+    std::atomic<uint64_t> m_failures{0};
+};
+
+// size class of RtPoolSet
+struct RtPoolClass
+{
+    size_t blockSize;
+    size_t blockCount;
+};
+
+/**
+ * Set of block pools used as size classes.
+ * Alloc(size) takes a block from the smallest class that fits and moves on to larger classes
+ * when that one is exhausted.
+ */
+class RtPoolSet
+{
+public:
+    static constexpr int MAX_CLASSES = 16;
+
+    RtPoolSet() noexcept = default;
+    ~RtPoolSet() { Release(); }
+
+    RtPoolSet(const RtPoolSet &) = delete;
+    RtPoolSet &operator=(const RtPoolSet &) = delete;
+
+    /**
+     * @param classes block size / count per class, in any order (at most MAX_CLASSES).
+     * @return false if a class could not be mapped (nothing is kept allocated then).
+     */
+    bool Allocate(const std::vector<RtPoolClass> &classes, const RtMemOptions &opt = RtMemOptions{});
+
+    /** Default classes: 32, 64, ... 4096 bytes, blocksPerClass blocks each. */
+    bool Allocate(size_t blocksPerClass, const RtMemOptions &opt = RtMemOptions{});
+
+    void Release();
+
+    void *Alloc(size_t size) noexcept;
+    void Free(void *p) noexcept;
+    void WarmUp() noexcept;
+
+    bool Owns(const void *p) const noexcept;
+    size_t MaxSize() const noexcept { return m_count ? m_pools[m_count - 1].BlockSize() : 0; }
+    int ClassCount() const noexcept { return m_count; }
+    const RtBlockPool &Class(int i) const noexcept { return m_pools[i]; }
+
+private:
+    RtBlockPool m_pools[MAX_CLASSES]; // sorted by block size
+    int m_count{0};
+};
+
+/**
+ * Per-cycle bump arena of one thread (not thread safe).
+ * Alloc() moves a pointer; memory is given back all at once by Reset() (e.g. at the start of
+ * every cycle) or down to a Mark(). Destructors of objects placed in the arena are not called.
+ */
+class RtArena
+{
+public:
+    RtArena() noexcept = default;
+    ~RtArena() { Release(); }
+
+    RtArena(const RtArena &) = delete;
+    RtArena &operator=(const RtArena &) = delete;
+
+    bool Allocate(size_t bytes, const RtMemOptions &opt = RtMemOptions{}) noexcept
+    {
+        Release();
+        if (!AllocRtMem(bytes, opt, m_mem))
+        {
+            return false;
+        }
+        m_begin = static_cast<char *>(m_mem.ptr);
+        m_size = m_mem.size;
+        return true;
+    }
+
+    void Release() noexcept
+    {
+        FreeRtMem(m_mem);
+        m_begin = nullptr;
+        m_size = m_used = m_highWater = 0;
+    }
+
+    // @return nullptr (and counts a failure) if the arena is full
+    void *Alloc(size_t size, size_t align = alignof(std::max_align_t)) noexcept
+    {
+        const size_t off = (m_used + align - 1) & ~(align - 1);
+        if (!m_begin || off + size > m_size)
+        {
+            m_failures++;
+            return nullptr;
+        }
+        m_used = off + size;
+        if (m_used > m_highWater) m_highWater = m_used;
+        return m_begin + off;
+    }
+
+    template <typename T, typename... Args>
+    T *New(Args &&...args)
+    {
+        void *p = Alloc(sizeof(T), alignof(T));
+        return p ? new (p) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    size_t Mark() const noexcept { return m_used; }
+    void Rewind(size_t mark) noexcept { m_used = (mark < m_used) ? mark : m_used; }
+    void Reset() noexcept { m_used = 0; }
+
+    size_t Used() const noexcept { return m_used; }
+    size_t HighWater() const noexcept { return m_highWater; } // size the arena from this
+    size_t Capacity() const noexcept { return m_size; }
+    uint64_t Failures() const noexcept { return m_failures; }
+
+private:
+    RtMemBlock m_mem;
+    char *m_begin{nullptr};
+    size_t m_size{0};
+    size_t m_used{0};
+    size_t m_highWater{0};
+    uint64_t m_failures{0};
+};
+
+// std allocator adapters -------------------------------------------------------------
+// allocate() throws std::bad_alloc when the pool / arena is exhausted, as std containers
+// expect; size the pools so that it never happens on the RT path.
+
+template <typename T>
+class RtPoolAllocator
+{
+public:
+    using value_type = T;
+
+    explicit RtPoolAllocator(RtPoolSet &pools) noexcept : m_pools(&pools) {}
+    template <typename U>
+    RtPoolAllocator(const RtPoolAllocator<U> &other) noexcept : m_pools(other.m_pools) {}
+
+    T *allocate(size_t n)
+    {
+        void *p = (n <= m_pools->MaxSize() / sizeof(T)) ? m_pools->Alloc(n * sizeof(T)) : nullptr;
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+    void deallocate(T *p, size_t) noexcept { m_pools->Free(p); }
+
+    template <typename U>
+    bool operator==(const RtPoolAllocator<U> &other) const noexcept { return m_pools == other.m_pools; }
+    template <typename U>
+    bool operator!=(const RtPoolAllocator<U> &other) const noexcept { return m_pools != other.m_pools; }
+
+private:
+    template <typename U>
+    friend class RtPoolAllocator;
+    RtPoolSet *m_pools;
+};
+
+template <typename T>
+class RtArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit RtArenaAllocator(RtArena &arena) noexcept : m_arena(&arena) {}
+    template <typename U>
+    RtArenaAllocator(const RtArenaAllocator<U> &other) noexcept : m_arena(other.m_arena) {}
+
+    T *allocate(size_t n)
+    {
+        void *p = (n <= m_arena->Capacity() / sizeof(T)) ? m_arena->Alloc(n * sizeof(T), alignof(T)) : nullptr;
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+    void deallocate(T *, size_t) noexcept {} // freed by RtArena::Reset()
+
+    template <typename U>
+    bool operator==(const RtArenaAllocator<U> &other) const noexcept { return m_arena == other.m_arena; }
+    template <typename U>
+    bool operator!=(const RtArenaAllocator<U> &other) const noexcept { return m_arena != other.m_arena; }
+
+private:
+    template <typename U>
+    friend class RtArenaAllocator;
+    RtArena *m_arena;
+};
+
+// heap allocation trap ---------------------------------------------------------------
+enum class RtAllocTrapAction
+{
+    Count,  // count only (GetRtAllocTrapStats)
+    Report, // count and print size + backtrace to stderr (default)
+    Abort   // report, then abort() (stops in the debugger at the offending call)
+};
+
+struct RtAllocTrapStats
+{
+    uint64_t allocs = 0;       // operator new calls on RT threads
+    uint64_t frees = 0;        // operator delete calls on RT threads
+    uint64_t bytes = 0;
+    size_t   lastSize = 0;
+    void    *lastCaller = nullptr;
+};
+
+/** @return true if the library was built with DT_RT_ALLOC_TRAP (otherwise nothing is trapped) */
+bool RtAllocTrapCompiled() noexcept;
+
+void SetRtAllocTrapAction(RtAllocTrapAction action) noexcept;
+void GetRtAllocTrapStats(RtAllocTrapStats &stats) noexcept;
+void ResetRtAllocTrapStats() noexcept;
+
+/** Mark the calling thread as RT (its heap allocations are trapped) or not. */
+void SetRtThread(bool rt) noexcept;
+bool IsRtThread() noexcept;
+
+/** Marks the calling thread as RT for the lifetime of the object (e.g. one control cycle). */
+class RtSection
+{
+public:
+    explicit RtSection(bool enable = true) noexcept : m_prev(IsRtThread()) { SetRtThread(m_prev || enable); }
+    ~RtSection() { SetRtThread(m_prev); }
+
+    RtSection(const RtSection &) = delete;
+    RtSection &operator=(const RtSection &) = delete;
+
+private:
+    bool m_prev;
+};
+
+/** Allows heap allocations inside an RT section (known, accepted allocations only). */
+class RtAllocAllowed
+{
+public:
+    RtAllocAllowed() noexcept : m_prev(IsRtThread()) { SetRtThread(false); }
+    ~RtAllocAllowed() { SetRtThread(m_prev); }
+
+    RtAllocAllowed(const RtAllocAllowed &) = delete;
+    RtAllocAllowed &operator=(const RtAllocAllowed &) = delete;
+
+private:
+    bool m_prev;
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_RTALLOC_H_
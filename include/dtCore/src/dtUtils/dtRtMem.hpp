@@ -0,0 +1,135 @@
+/*!
+ \file      dtRtMem.hpp
+ \brief     Pre-faulted, locked memory regions for RT data structures
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_RTMEM_H_
+#define _DT_RTMEM_H_
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dt
+{
+namespace Utils
+{
+
+// Allocation options for RT memory regions.
+//
+// RT 경로에서 사용하는 큐/버퍼는 첫 접근 시 page fault가 발생하면 수십 μs의 지연이
+// 생길 수 있으므로, 초기화 시점(nonRT)에 미리 page를 매핑(prefault)하고 mlock()으로
+// swap-out을 막아둔다.
+struct RtMemOptions
+{
+    bool hugePages{false};   // try MAP_HUGETLB, then transparent huge pages (madvise)
+    bool lockMemory{false};  // mlock() the region (needs RLIMIT_MEMLOCK / CAP_IPC_LOCK)
+    bool prefault{true};     // touch every page once so no fault happens on the RT path
+};
+
+// Result of AllocRtMem(). Keep it to release the region with FreeRtMem().
+struct RtMemBlock
+{
+    void  *ptr{nullptr};
+    size_t size{0};          // mapped size (rounded up to page / huge page size)
+    bool   hugePages{false}; // true if backed by MAP_HUGETLB pages
+    bool   locked{false};    // true if mlock() succeeded
+};
+
+inline constexpr size_t RTMEM_HUGE_PAGE_SIZE = 2 * 1024 * 1024;  // 2 MB (x86_64 / aarch64 default)
+
+/**
+ * @brief Map an anonymous memory region for RT use (nonRT context only).
+ *
+ * hugePages: MAP_HUGETLB 실패 시(hugetlbfs page 미할당 등) 일반 page로 매핑 후
+ *            madvise(MADV_HUGEPAGE)로 THP를 요청한다.
+ * lockMemory: mlock() 실패는 치명적이지 않으므로 block.locked = false로 두고 계속 진행.
+ *
+ * @return false if the region could not be mapped at all.
+ */
+inline bool AllocRtMem(size_t bytes, const RtMemOptions &opt, RtMemBlock &block) noexcept
+{
+    block = RtMemBlock{};
+    if (bytes == 0)
+    {
+        return false;
+    }
+
+    const long   pg       = sysconf(_SC_PAGESIZE);
+    const size_t pageSize = (pg > 0) ? static_cast<size_t>(pg) : 4096;
+    void        *p        = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (opt.hugePages)
+    {
+        size_t sz = (bytes + RTMEM_HUGE_PAGE_SIZE - 1) & ~(RTMEM_HUGE_PAGE_SIZE - 1);
+        p = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+        {
+            block.size      = sz;
+            block.hugePages = true;
+        }
+    }
+#endif
+
+    if (p == MAP_FAILED)
+    {
+        size_t sz = (bytes + pageSize - 1) & ~(pageSize - 1);
+        p = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            return false;
+        }
+        block.size = sz;
+#ifdef MADV_HUGEPAGE
+        if (opt.hugePages)
+        {
+            (void)madvise(p, sz, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    block.ptr = p;
+
+    if (opt.prefault)
+    {
+        // Write (not read) each page: a read fault on anonymous memory only maps the shared zero page.
+        const size_t step = block.hugePages ? RTMEM_HUGE_PAGE_SIZE : pageSize;
+        volatile char *c  = static_cast<volatile char *>(p);
+        for (size_t off = 0; off < block.size; off += step)
+        {
+            c[off] = 0;
+        }
+    }
+
+    if (opt.lockMemory)
+    {
+        block.locked = (mlock(p, block.size) == 0);
+    }
+
+    return true;
+}
+
+inline void FreeRtMem(RtMemBlock &block) noexcept
+{
+    if (block.ptr)
+    {
+        if (block.locked)
+        {
+            (void)munlock(block.ptr, block.size);
+        }
+        (void)munmap(block.ptr, block.size);
+    }
+    block = RtMemBlock{};
+}
+
+} // namespace Utils
+} // namespace dt
+
+#endif  // _DT_RTMEM_H_
@@ -0,0 +1,109 @@
+/*!
+ \file      dtSeqLock.hpp
+ \brief     Sequence lock for POD snapshots (single writer, many readers)
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_SEQLOCK_H_
+#define _DT_SEQLOCK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace dt
+{
+namespace Utils
+{
+
+// Single writer / any number of readers, for trivially copyable T.
+// - Store() never waits: readers cannot delay the (RT) writer.
+// - Load() retries while a Store() is in progress; TryLoad() gives up after N attempts.
+// - the payload is copied as relaxed atomic words, so a torn read is detected by the
+//   sequence check instead of being a data race.
+// Compared to TripleBuffer: any number of readers and no consumer-side state, but readers
+// spin while the writer is storing, so keep T small (a few cache lines).
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock<T> requires a trivially copyable T");
+
+public:
+    SeqLock() noexcept
+    {
+        const T init{};
+        Store(init);
+    }
+    explicit SeqLock(const T &init) noexcept { Store(init); }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    // writer (single thread) ---------------------------------------------------
+    void Store(const T &value) noexcept
+    {
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i)
+        {
+            m_data[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // readers -----------------------------------------------------------------
+    // @return false if every attempt overlapped a Store(); 'out' is then unchanged
+    bool TryLoad(T &out, int retries = 64) const noexcept
+    {
+        uint64_t words[WORDS];
+        for (int i = 0; i < retries; ++i)
+        {
+            const uint32_t s0 = m_seq.load(std::memory_order_acquire);
+            if (s0 & 1)
+            {
+                continue;
+            }
+            for (size_t w = 0; w < WORDS; ++w)
+            {
+                words[w] = m_data[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == s0)
+            {
+                std::memcpy(&out, words, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    T Load() const noexcept
+    {
+        T out;
+        while (!TryLoad(out)) {}
+        return out;
+    }
+
+    // number of completed Store() calls, including the initial one
+    uint32_t Sequence() const noexcept { return m_seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint32_t> m_seq{0};
+    std::atomic<uint64_t> m_data[WORDS];
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_SEQLOCK_H_
@@ -20,6 +20,9 @@
  *
  */
 
+#include <time.h>
+
+#include <cstdint>
 #include <ctime>
 #include <stdexcept>
 #include <string>
@@ -29,6 +32,17 @@ namespace dt
 namespace Utils
 {
 
+/**
+ * get CLOCK_MONOTONIC time in ns (RT-safe, no allocation).
+ * CLOCK_MONOTONIC is served by the Xenomai POSIX skin in primary mode, unlike CLOCK_MONOTONIC_RAW.
+ */
+inline int64_t MonotonicNs() noexcept
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
 /**
  * get current epoch time.
  */
@@ -0,0 +1,104 @@
+/*!
+ \file      dtTripleBuffer.hpp
+ \brief     Wait-free triple buffer for handing the latest state between two threads
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_TRIPLEBUFFER_H_
+#define _DT_TRIPLEBUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace dt
+{
+namespace Utils
+{
+
+// Single producer / single consumer "latest value" exchange.
+// - producer: fill WriteBuffer() (or Write()), then Publish(). Never blocks, never fails.
+// - consumer: Update() swaps in the newest published buffer, Read() returns it.
+//   Intermediate values published between two Update() calls are dropped (state, not a queue).
+// - both sides are wait-free (one atomic exchange each), no allocation after construction.
+//
+// e.g. RT loop → gRPC / MCAP thread: robot state each cycle, the reader always sees a complete
+// and the most recent snapshot, and a slow reader never delays the RT loop.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T &init)
+    {
+        for (Slot &s : m_slot) s.value = init;
+    }
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // producer ---------------------------------------------------------------
+    // buffer owned by the producer until Publish(). Holds the value last written by the producer
+    // two publishes ago, not the latest one: overwrite what you need.
+    T &WriteBuffer() noexcept { return m_slot[m_back].value; }
+
+    void Publish() noexcept
+    {
+        const uint8_t prev = m_state.exchange(static_cast<uint8_t>(m_back | DIRTY), std::memory_order_acq_rel);
+        m_back = prev & INDEX_MASK;
+    }
+
+    void Write(const T &value)
+    {
+        WriteBuffer() = value;
+        Publish();
+    }
+
+    // consumer ---------------------------------------------------------------
+    // take the newest published value. @return true if it is new since the last Update()
+    bool Update() noexcept
+    {
+        if (!(m_state.load(std::memory_order_relaxed) & DIRTY))
+        {
+            return false;
+        }
+        const uint8_t prev = m_state.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & INDEX_MASK;
+        return true;
+    }
+
+    const T &Read() const noexcept { return m_slot[m_front].value; }
+
+    // Update() + copy. @return true if the value is new
+    bool Read(T &out)
+    {
+        const bool fresh = Update();
+        out = Read();
+        return fresh;
+    }
+
+    bool HasUpdate() const noexcept { return (m_state.load(std::memory_order_relaxed) & DIRTY) != 0; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t DIRTY = 0x4;
+
+    // each buffer on its own cache line: producer and consumer never write the same line
+    struct alignas(64) Slot
+    {
+        T value{};
+    };
+
+    Slot m_slot[3];
+    alignas(64) std::atomic<uint8_t> m_state{1}; // middle buffer index | DIRTY
+    alignas(64) uint8_t m_back{0};                // producer only
+    alignas(64) uint8_t m_front{2};               // consumer only
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_TRIPLEBUFFER_H_
@@ -0,0 +1,146 @@
+/*!
+ \file      dtWatchdogBank.h
+ \brief     Multi-channel watchdog: per-channel heartbeat deadlines, one vectorized monitor scan
+ \author    myungjin.kim@hyundai.com
+ \date      2026. 4. 24
+ \version   0.0.1
+ \copyright RoboticsLab ART All rights reserved.
+*/
+
+#ifndef _DT_WATCHDOG_BANK_H_
+#define _DT_WATCHDOG_BANK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dtRtMem.hpp"
+#include "dtTimeUtil.hpp"
+
+namespace dt
+{
+namespace Utils
+{
+
+// Deadline monitor for many heartbeat sources (sensor streams, tasks), replacing arrays of
+// Watchdog<N> ticked by hand.
+// - producers call Feed(ch) on every message / cycle from any thread: one relaxed store of
+//   (now + timeout) into the channel's deadline, no lock, RT-safe.
+// - one monitor thread calls Check() (e.g. every cycle of a 1 kHz periodic thread): deadlines
+//   are kept as a structure of arrays, compared 4 (AVX2) / 2 (SSE4.2, NEON) at a time into one
+//   expired bit per channel, and only channels whose bit changed raise an event.
+// - events (expired / recovered) go to the callback and, with logEvents, to RtLog. Both run on
+//   the monitor thread.
+// Channels are added on a non-RT thread up to the capacity given to Allocate(); Check() may
+// run meanwhile.
+struct WatchdogEvent
+{
+    int         channel;
+    const char *name;
+    bool        expired;    // false: recovered (a heartbeat arrived after the expiry)
+    int64_t     age_ns;     // since the last heartbeat (or since the channel was added)
+    int64_t     now_ns;
+    uint32_t    expiries;   // of this channel so far
+};
+
+using WatchdogCallback = std::function<void(const WatchdogEvent &event)>;
+
+struct WatchdogBankStats
+{
+    int      channels = 0;
+    int      expired = 0;     // now
+    uint64_t expiries = 0;    // all channels, since Allocate()
+    uint64_t recoveries = 0;
+    uint64_t checks = 0;
+    int64_t  lastScan_ns = 0; // cost of the last Check()
+    int64_t  maxScan_ns = 0;
+};
+
+class WatchdogBank
+{
+public:
+    WatchdogBank() noexcept = default;
+    ~WatchdogBank() { Release(); }
+
+    WatchdogBank(const WatchdogBank &) = delete;
+    WatchdogBank &operator=(const WatchdogBank &) = delete;
+
+    // nonRT, before use: room for 'capacity' channels, prefaulted / locked with opt
+    bool Allocate(int capacity, const RtMemOptions &opt = RtMemOptions{}) noexcept;
+    void Release() noexcept;
+
+    void SetCallback(WatchdogCallback callback); // before the monitor starts
+    void SetLogEvents(bool enable) { m_logEvents.store(enable, std::memory_order_relaxed); }
+
+    /**
+     * Add a channel (nonRT).
+     * @param[in] name Channel name for events and logs.
+     * @param[in] timeout_ns Longest allowed gap between two heartbeats.
+     * @param[in] grace_ns Time allowed for the first heartbeat (0: timeout_ns).
+     * @return channel id, or -1 if the bank is full.
+     */
+    int AddChannel(const std::string &name, int64_t timeout_ns, int64_t grace_ns = 0);
+    int FindChannel(const std::string &name) const;
+    // a disabled channel never expires; enabling it re-arms it with its timeout
+    void SetEnabled(int ch, bool enable);
+    void SetTimeout(int ch, int64_t timeout_ns);
+
+    // producers -------------------------------------------------------------------
+    inline void Feed(int ch, int64_t now_ns) noexcept
+    {
+        if ((unsigned)ch < (unsigned)m_capacity)
+        {
+            m_deadline[ch].store(now_ns + m_timeout[ch].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+    inline void Feed(int ch) noexcept { Feed(ch, MonotonicNs()); }
+
+    // monitor (one thread) ------------------------------------------------------------
+    // Scan every channel against now_ns (0: current time) and raise the events.
+    // Returns the number of channels that expired in this pass.
+    int Check(int64_t now_ns = 0);
+
+    // queries (any thread) -------------------------------------------------------------
+    bool IsExpired(int ch) const noexcept;     // as of the last Check()
+    int64_t Age_ns(int ch, int64_t now_ns = 0) const noexcept; // -1: no such / disabled channel
+    int ChannelCount() const noexcept { return m_count.load(std::memory_order_acquire); }
+    const char *ChannelName(int ch) const noexcept;
+    void GetExpired(std::vector<int> &channels) const;
+    void GetStats(WatchdogBankStats &stats) const;
+    static const char *ScanKernel() noexcept;  // "avx2", "sse4.2", "neon" or "scalar"
+
+private:
+    void Raise(int ch, bool expired, int64_t now);
+
+    RtMemBlock m_mem;
+    int m_capacity = 0;
+    int m_words = 0;                          // 64 channels per word
+    std::atomic<int> m_count{0};
+    // structure of arrays, one RtMem block; padding channels never expire
+    std::atomic<int64_t> *m_deadline = nullptr; // feed time + timeout
+    std::atomic<int64_t> *m_timeout = nullptr;  // effective (huge when disabled)
+    int64_t *m_setTimeout = nullptr;            // configured
+    std::atomic<uint64_t> *m_expired = nullptr; // bit per channel, written by Check()
+    uint32_t *m_expiries = nullptr;
+
+    std::vector<std::string> m_names;           // reserved at Allocate(): never reallocated
+    mutable std::mutex m_mtx;                   // channel configuration
+    WatchdogCallback m_callback;
+    std::atomic<bool> m_logEvents{true};
+
+    std::atomic<int> m_expiredNow{0};
+    std::atomic<uint64_t> m_totalExpiries{0};
+    std::atomic<uint64_t> m_recoveries{0};
+    std::atomic<uint64_t> m_checks{0};
+    std::atomic<int64_t> m_lastScan_ns{0};
+    std::atomic<int64_t> m_maxScan_ns{0};
+};
+
+} // namespace Utils
+} // namespace dt
+
+#endif // _DT_WATCHDOG_BANK_H_
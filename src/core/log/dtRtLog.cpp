@@ -2,6 +2,7 @@
 #include <spdlog/details/os.h>
 #include <dtCore/dtThread>
 #include "dtCore/src/dtLog/dtRtLog.hpp"
+#include "dtCore/src/dtLog/dtRtLogNetSink.hpp"
 
 namespace dt {
 
@@ -41,7 +42,8 @@ void RtLog::Initialize(
     int threadPriority,
     size_t threadStack,
     bool annotDatetime,
-    bool truncate)
+    bool truncate,
+    const RtLogQueueConfig &queueConfig)
 {
     auto &m_instance = Instance();
     if (m_instance.m_initialized.load(std::memory_order_acquire))   // check initialize state
@@ -50,21 +52,58 @@ void RtLog::Initialize(
         return;
     }
 
-    // Auto-disable TUI when output cannot be rendered in a terminal
-    if (enableTui)
+    // Auto-disable TUI when output cannot be rendered in a terminal. With a snapshot
+    // segment configured it keeps running headless so dttui-attach can still show it.
+    const bool tuiShm      = queueConfig.tuiShmName && queueConfig.tuiShmName[0];
+    bool       tuiHeadless = enableTui && queueConfig.tuiHeadless;
+    if (enableTui && !tuiHeadless)
     {
+        const char *reason = nullptr;
         if (fileBasename == "_SYSLOG_")
         {
-            enableTui = false;
-            LogRaw(LogLevel::warn, "[RtLog] syslog output requested: TUI auto-disabled");
+            reason = "syslog output requested";
         }
         else if (!isatty(STDOUT_FILENO))
+        {
+            reason = "stdout is not a terminal (daemon/redirected)";
+        }
+
+        if (reason && tuiShm)
+        {
+            tuiHeadless = true;
+            LogRaw(LogLevel::info, "[RtLog] %s: TUI runs headless (shm %s)", reason, queueConfig.tuiShmName);
+        }
+        else if (reason)
         {
             enableTui = false;
-            LogRaw(LogLevel::warn, "[RtLog] stdout is not a terminal (daemon/redirected): TUI auto-disabled");
+            LogRaw(LogLevel::warn, "[RtLog] %s: TUI auto-disabled", reason);
         }
     }
 
+    // allocate queue storage (nonRT) — size and memory policy from queueConfig
+    Utils::RtMemOptions memOpt;
+    memOpt.hugePages  = queueConfig.hugePages;
+    memOpt.lockMemory = queueConfig.lockMemory;
+    memOpt.prefault   = queueConfig.prefault;
+    if (!m_instance.m_queue.Allocate(queueConfig.capacity, queueConfig.msgLen, memOpt))
+    {
+        LogRaw(LogLevel::err, "[RtLog] Cannot allocate log queue (%zu x %zu B): %s",
+               queueConfig.capacity, queueConfig.msgLen, strerror(errno));
+        return;
+    }
+    m_instance.ReportQueueMemory("log queue", m_instance.m_queue.Memory(), memOpt);
+
+    // LOG_DATA() sample queue — failure only disables telemetry channels
+    if (!m_instance.m_data.Open(queueConfig.dataCapacity, queueConfig.dataSlotBytes, memOpt))
+    {
+        LogRaw(LogLevel::warn, "[RtLog] Cannot allocate data queue (%zu x %zu B): %s. LOG_DATA() disabled",
+               queueConfig.dataCapacity, queueConfig.dataSlotBytes, strerror(errno));
+    }
+    else if (queueConfig.dataCapacity > 0)
+    {
+        m_instance.ReportQueueMemory("data queue", m_instance.m_data.Queue().Memory(), memOpt);
+    }
+
     // create spdlog logger with appropriate sinks
     m_instance.m_logger = std::make_shared<spdlog::logger>(logName);
     m_instance.m_logger->sinks().clear();
@@ -73,11 +112,28 @@ void RtLog::Initialize(
     if (enableTui)
     {
         m_instance.m_tui = std::make_shared<RtTui>();
-        if (m_instance.m_tui->Init())
+        TuiHistoryConfig history;
+        history.bytes = queueConfig.tuiHistoryBytes;
+        history.file  = queueConfig.tuiHistoryFile;
+        if (m_instance.m_tui->Init(queueConfig.tuiCapacity, queueConfig.tuiMsgLen, memOpt, history, tuiHeadless))
         {
             auto tui_sink = std::make_shared<TuiSink>(m_instance.m_tui);
             tui_sink->set_pattern("%^[%L][%H:%M:%S.%f]%$ %v");
             m_instance.m_logger->sinks().push_back(tui_sink);
+
+            if (tuiShm && !m_instance.m_tui->OpenSnapshot(queueConfig.tuiShmName))
+            {
+                LogRaw(LogLevel::warn, "[RtLog] Cannot create TUI snapshot shm '%s': %s",
+                       queueConfig.tuiShmName, strerror(errno));
+            }
+
+            // headless: the log lines still go to stdout (journal, redirected file)
+            if (tuiHeadless)
+            {
+                auto console_sink = std::make_shared<ColorStdoutSinkMt>();
+                console_sink->set_pattern("%^[%L][%H:%M:%S.%f]%$ %v");
+                m_instance.m_logger->sinks().push_back(console_sink);
+            }
         }
         else
         {
@@ -104,6 +160,15 @@ void RtLog::Initialize(
         syslog_sink->set_pattern("[%L][%H:%M:%S.%f] %v");
         m_instance.m_logger->sinks().push_back(syslog_sink);
     }
+    // network streaming sink ("_NET_:tcp:<host>:<port>" / "_NET_:unix:<path>")
+    else if (NetLogEndpoint::IsSelector(fileBasename))
+    {
+        auto net_sink = m_instance.CreateNetSink(fileBasename, "");
+        if (net_sink)
+        {
+            m_instance.m_logger->sinks().push_back(net_sink);
+        }
+    }
     // basic file sink
     else if (!fileBasename.empty() && (fileBasename != "_STDOUT_"))
     {
@@ -161,8 +226,30 @@ void RtLog::Initialize(
     }
     else
     {
+        const int err = errno;
         m_instance.m_logThreadRun.store(false, std::memory_order_release);
-        m_instance.m_logger->log(spdlog::level::err, "Cannot create log thread: {}", strerror(errno));
+
+        // Nothing was published to producers (m_initialized stays false, no data channel can
+        // exist yet), so the queues are released right away instead of on the next Initialize().
+        // The TUI (and its queue) goes with its sink; stdout takes its place.
+        if (m_instance.m_tui)
+        {
+            m_instance.m_tui->Stop();
+            m_instance.m_tui.reset();
+            auto &sinks = m_instance.m_logger->sinks();
+            sinks.erase(std::remove_if(sinks.begin(), sinks.end(),
+                                       [](const auto &sink) { return dynamic_cast<TuiSink *>(sink.get()) != nullptr; }),
+                        sinks.end());
+            if (!tuiHeadless)   // headless already has its stdout sink
+            {
+                auto console_sink = std::make_shared<ColorStdoutSinkMt>();
+                console_sink->set_pattern("%^[%L][%H:%M:%S.%f]%$ %v");
+                sinks.insert(sinks.begin(), console_sink);
+            }
+        }
+        m_instance.m_data.Release();
+        m_instance.m_queue.Release();
+        m_instance.m_logger->log(spdlog::level::err, "Cannot create log thread: {}", strerror(err));
     }
 }
 
@@ -190,6 +277,14 @@ void RtLog::Create(
         syslog_sink->set_pattern("[%L][%H:%M:%S.%f] %v");
         logger->sinks().push_back(syslog_sink);
     }
+    else if (NetLogEndpoint::IsSelector(fileBasename))
+    {
+        auto net_sink = inst.CreateNetSink(fileBasename, logName.c_str());
+        if (net_sink)
+        {
+            logger->sinks().push_back(net_sink);
+        }
+    }
     else
     {
         spdlog::filename_t filename = fileBasename;
@@ -250,6 +345,22 @@ void RtLog::Terminate()
         m_instance.m_logThreadInfo->threadInfo.id = {};
         m_instance.DrainAll();
         m_instance.FlushContLines(true);  // flush any pending LOG_CONT output
+        m_instance.m_data.Drain(m_instance.m_timebase.wall_ns - m_instance.m_timebase.monotonic_ns);
+        m_instance.m_data.Flush(m_instance.MonoNow_ns(), true);
+    }
+
+    // Report LOG_DATA() samples that did not reach their file
+    m_instance.m_data.ForEachChannel([&m_instance](const char *name, const DataChannelStats &stats) {
+        if (stats.dropped > 0 || stats.rejected > 0)
+        {
+            m_instance.m_logger->log(spdlog::level::warn, "CloseLogger: data channel '{}' wrote {} samples, dropped {} (queue full / schema pending), rejected {} (schema mismatch)",
+                                     name, stats.samples, stats.dropped, stats.rejected);
+        }
+    });
+    if (m_instance.m_data.UnknownChannelCount() > 0)
+    {
+        m_instance.m_logger->log(spdlog::level::warn, "CloseLogger: {} LOG_DATA samples for unknown channels (CreateDataChannel() missing)",
+                                 m_instance.m_data.UnknownChannelCount());
     }
 
     // Stop TUI if enabled
@@ -259,7 +370,14 @@ void RtLog::Terminate()
         m_instance.m_tui.reset();
     }
 
+    // The queue storage stays mapped: a producer that passed the m_initialized check in LogRt()
+    // just before this store may still push into it. It is remapped by the next Initialize()
+    // (Allocate()) or released by the LogQueue destructor.
     m_instance.m_initialized.store(false, std::memory_order_release);
+    if (result == 0)
+    {
+        m_instance.m_data.Close();
+    }
 
     // Flush all sinks and destroy the default logger before returning.
     //
@@ -278,6 +396,14 @@ void RtLog::Terminate()
     spdlog::apply_all([](std::shared_ptr<spdlog::logger> l) { l->flush(); });
     spdlog::shutdown();
     m_instance.m_logger.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_instance.m_netSinkMtx);
+        const int n = m_instance.m_netSlotCount.exchange(0, std::memory_order_acq_rel);
+        for (int i = 0; i < n; ++i)
+        {
+            m_instance.m_netSlots[i].sink.reset();
+        }
+    }
 }
 
 void RtLog::FlushOn(LogLevel lvl)
@@ -398,6 +524,11 @@ void RtLog::TuiSetTextRow(int layoutIdx, int groupIdx, int rowIdx, const char *l
     }
 }
 
+int RtLog::TuiAddPlot(int layoutIdx, int groupIdx, int rowIdx, const char *label, const TuiPlotConfig &cfg) noexcept
+{
+    return m_tui ? m_tui->AddPlot(layoutIdx, groupIdx, rowIdx, label, cfg) : -1;
+}
+
 void RtLog::TuiSetTextRowFmt(int layoutIdx, int groupIdx, int rowIdx, const char *label, const char *fmt, ...) noexcept
 {
     if (!m_tui)
@@ -430,6 +561,11 @@ void *RtLog::PollLogQueue(void *pArg) noexcept
 {
     auto &m_instance = Instance();
 
+    if (m_instance.m_tui)
+    {
+        RtTui::AcceptResizeSignal();    // Tick() runs here: let SIGWINCH reach this thread
+    }
+
     while (m_instance.m_logThreadRun.load(std::memory_order_acquire))
     {
         Instance().Poll();
@@ -481,6 +617,125 @@ void RtLog::Sync() noexcept
     spdlog::apply_all([](std::shared_ptr<spdlog::logger> l) { l->flush(); });
 }
 
+bool RtLog::AddTap(RtLogTap *tap) noexcept
+{
+    auto &inst = Instance();
+    if (!tap)
+    {
+        return false;
+    }
+
+    for (auto &slot : inst.m_taps)
+    {
+        RtLogTap *expected = nullptr;
+        if (slot.compare_exchange_strong(expected, tap, std::memory_order_acq_rel))
+        {
+            inst.m_tapCount.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RtLog::RemoveTap(RtLogTap *tap) noexcept
+{
+    auto &inst = Instance();
+    if (!tap)
+    {
+        return;
+    }
+
+    bool removed = false;
+    for (auto &slot : inst.m_taps)
+    {
+        RtLogTap *expected = tap;
+        if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+        {
+            inst.m_tapCount.fetch_sub(1, std::memory_order_release);
+            removed = true;
+        }
+    }
+
+    // The drain thread may still be inside OnLogLine() of this tap. Sync() is acknowledged
+    // only after a DrainAll() pass that ends after the slot was cleared, so the tap is
+    // no longer referenced once it returns.
+    if (removed)
+    {
+        Sync();
+    }
+}
+
+void RtLog::NotifyTaps(LogLevel lvl, int64_t wall_ns, const char *loggerName, const char *msg, size_t msgLen) noexcept
+{
+    for (auto &slot : m_taps)
+    {
+        RtLogTap *tap = slot.load(std::memory_order_acquire);
+        if (tap)
+        {
+            tap->OnLogLine(lvl, wall_ns, loggerName, msg, msgLen);
+        }
+    }
+}
+
+bool RtLog::CreateDataChannel(
+    const std::string &channel,
+    const std::string &fileBasename,
+    const std::vector<std::string> &columns,
+    DataFormat format,
+    bool annotDatetime)
+{
+    auto &inst = Instance();
+    if (!inst.m_initialized.load(std::memory_order_acquire))
+    {
+        LogRaw(LogLevel::err, "[RtLog] CreateDataChannel(%s): Initialize() is not called", channel.c_str());
+        return false;
+    }
+
+    std::string filename = fileBasename;
+    if (annotDatetime)
+    {
+        filename = inst.AnnotateFilenameDatetime(fileBasename);
+    }
+    auto [dname, fname] = inst.SplitByDirectory(filename);
+    std::error_code ec;
+    if (!inst.EnsureDirectoryExistes(dname, ec))
+    {
+        inst.m_logger->log(spdlog::level::err, "Cannot create directory '{}': {}", dname, ec.message());
+    }
+
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        inst.m_logger->log(spdlog::level::err, "CreateDataChannel({}): cannot open '{}': {}", channel, filename, strerror(errno));
+        return false;
+    }
+
+    if (!inst.m_data.CreateChannel(channel, fd, columns, format))
+    {
+        ::close(fd);
+        (void)remove(filename.c_str());
+        inst.m_logger->log(spdlog::level::err, "CreateDataChannel({}): duplicated name, too many channels/columns or LOG_DATA disabled", channel);
+        return false;
+    }
+
+    if (annotDatetime)
+    {
+        (void)remove(fileBasename.c_str());
+        if (symlink(fname.c_str(), fileBasename.c_str()) < 0)
+        {
+            inst.m_logger->log(spdlog::level::warn,
+                "Cannot create symlink '{}' -> '{}': {}", fileBasename, fname, strerror(errno));
+        }
+    }
+    return true;
+}
+
+bool RtLog::GetDataStats(const std::string &channel, DataChannelStats &stats) noexcept
+{
+    return Instance().m_data.GetStats(channel.c_str(), stats);
+}
+
 void RtLog::LogRaw(LogLevel lvl, const char *fmt, ...) noexcept
 {
     char buf[512];
@@ -612,20 +867,39 @@ size_t RtLog::QueueSize() const noexcept
 size_t RtLog::QueueUtilization() const noexcept
 {
     size_t size = m_queue.ApproxSize();
-    return ((size * 100) / QueueType::Capacity());
+    size_t cap  = m_queue.Capacity();
+    return (cap > 0) ? ((size * 100) / cap) : 0;
 }
 
 RtLog::QueueStats RtLog::GetQueueStats() const noexcept
 {
     size_t size = m_queue.ApproxSize();
+    size_t cap  = m_queue.Capacity();
+    const Utils::RtMemBlock &mem = m_queue.Memory();
     return QueueStats{
         .current_size = size,
-        .capacity = QueueType::Capacity(),
-        .utilization_pct = (size * 100) / QueueType::Capacity(),
+        .capacity = cap,
+        .msg_len = m_queue.SlotMsgLen(),
+        .memory_bytes = mem.size,
+        .huge_pages = mem.hugePages,
+        .locked = mem.locked,
+        .utilization_pct = (cap > 0) ? (size * 100) / cap : 0,
         .total_drops = m_dropCount.load(std::memory_order_relaxed)
     };
 }
 
+void RtLog::ReportQueueMemory(const char *what, const Utils::RtMemBlock &mem, const Utils::RtMemOptions &opt) noexcept
+{
+    if (opt.hugePages && !mem.hugePages)
+    {
+        LogRaw(LogLevel::warn, "[RtLog] %s: huge pages unavailable, using regular pages (%zu KB)", what, mem.size / 1024);
+    }
+    if (opt.lockMemory && !mem.locked)
+    {
+        LogRaw(LogLevel::warn, "[RtLog] %s: mlock() failed (check RLIMIT_MEMLOCK / CAP_IPC_LOCK)", what);
+    }
+}
+
 void RtLog::Poll() noexcept
 {
     // Sleep in the non-RT log thread, then drain all queued entries.
@@ -637,6 +911,9 @@ void RtLog::Poll() noexcept
     // Drain all queued entries (TuiSinkT pushes to TUI queue here)
     size_t count = DrainAll();
 
+    // LOG_DATA() samples: copied into per-channel blocks, full blocks are written here
+    size_t dataCount = m_data.Drain(m_timebase.wall_ns - m_timebase.monotonic_ns);
+
     // Acknowledge any pending Sync() requests.
     // Sync()는 이 store를 감지할 때까지 대기하며, 이 시점에 DrainAll()이 완료된 것이 보장됨.
     {
@@ -657,6 +934,7 @@ void RtLog::Poll() noexcept
         spdlog::apply_all([](std::shared_ptr<spdlog::logger> l) { l->flush(); });
         m_lastFlush_ns = now_ns;
     }
+    m_data.Flush(now_ns, false);  // partial data blocks every RtLogDataConstant::FLUSH_INTERVAL_NS
 
     // TUI tick: (TUI_FLUSH_INTERVAL_NS ms) rate-limiter — drains queue, handles keys, renders
     if (m_tui)
@@ -674,7 +952,8 @@ void RtLog::Poll() noexcept
     // Adaptive polling: adjust interval based on queue pressure
     long interval_ns;
 
-    if (queueSizeAfter > QueueType::Capacity() / 2)
+    if (queueSizeAfter > m_queue.Capacity() / 2 ||
+        m_data.Queue().ApproxSize() > m_data.Queue().Capacity() / 2)
     {
         interval_ns = 100'000L;   // 100 μs: queue >50% — drain as fast as possible
     }
@@ -682,7 +961,7 @@ void RtLog::Poll() noexcept
     {
         interval_ns = 100'000L;  // 100 μs: queue not shrinking after drain (falling behind)
     }
-    else if (count > 0)
+    else if (count > 0 || dataCount > 0)
     {
         interval_ns = 500'000L;  // 500 μs: draining normally
     }
@@ -705,6 +984,7 @@ void RtLog::FlushEntry(const Entry &entry) noexcept
         std::memcpy(m_contBuf + m_contBufLen, entry.msg, copy);
         m_contBufLen += copy;
         m_contLevel   = entry.level;
+        m_contTime_ns = entry.timeStamp_ns;
         FlushContLines(false);
         return;
     }
@@ -741,12 +1021,18 @@ void RtLog::FlushEntry(const Entry &entry) noexcept
         auto duration = std::chrono::nanoseconds(wall_ns);
         auto tp = spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(duration));
 
+        ReportNetDrops();
         target->log(
             tp,
             spdlog::source_loc{},
             entry.level,
             spdlog::string_view_t(entry.msg, entry.msgLen)
         );
+
+        if (m_tapCount.load(std::memory_order_relaxed) > 0)
+        {
+            NotifyTaps(entry.level, wall_ns, entry.loggerName, entry.msg, entry.msgLen);
+        }
     }
     catch (...)
     {
@@ -756,6 +1042,45 @@ void RtLog::FlushEntry(const Entry &entry) noexcept
     }
 }
 
+void RtLog::CountNetDrop(const char *loggerName) noexcept
+{
+    // RT path: at most MAX_NET_SINKS short compares, no lock
+    const int   n    = m_netSlotCount.load(std::memory_order_acquire);
+    const char *name = (loggerName[0] == CONT_ENTRY_MARKER) ? "" : loggerName;
+    int         dflt = -1;
+    for (int i = 0; i < n; ++i)
+    {
+        if (std::strcmp(m_netSlots[i].logger, name) == 0)
+        {
+            m_netSlots[i].drops.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_netSlots[i].logger[0] == '\0')
+        {
+            dflt = i;
+        }
+    }
+    if (dflt >= 0)
+    {
+        m_netSlots[dflt].drops.fetch_add(1, std::memory_order_relaxed);  // routed to the default logger
+    }
+}
+
+void RtLog::ReportNetDrops() noexcept
+{
+    const int n = m_netSlotCount.load(std::memory_order_acquire);
+    for (int i = 0; i < n; ++i)
+    {
+        NetDropSlot &slot  = m_netSlots[i];
+        const uint64_t drops = slot.drops.load(std::memory_order_relaxed);
+        if (drops != slot.reported)
+        {
+            static_cast<NetSinkMt *>(slot.sink.get())->NoteDropped(static_cast<uint32_t>(drops - slot.reported));
+            slot.reported = drops;
+        }
+    }
+}
+
 void RtLog::LogRtCont(LogLevel lvl, const char *msg, size_t msgLen) noexcept
 {
     if (!m_initialized.load(std::memory_order_acquire)) return;
@@ -812,6 +1137,11 @@ void RtLog::FlushContLines(bool force) noexcept
             m_logger->set_pattern("%v");
             m_logger->log(m_contLevel, spdlog::string_view_t(ibuf, ilen));
             m_logger->set_pattern(m_patternStr);
+
+            if (m_tapCount.load(std::memory_order_relaxed) > 0)
+            {
+                NotifyTaps(m_contLevel, m_timebase.ToWall_ns(m_contTime_ns), "", ibuf + IND, copy);
+            }
         }
         catch (...)
         {
@@ -843,6 +1173,7 @@ void RtLog::Enqueue(const Entry &entry) noexcept
         // Only increment the drop counter; pushing into a full queue is pointless.
         // Monitor via drop_count() or display with TUI_SET_ROW_V.
         m_dropCount.fetch_add(1, std::memory_order_relaxed);
+        CountNetDrop(entry.loggerName);
     }
 }
 
@@ -851,6 +1182,37 @@ bool RtLog::IsActiveLevel(LogLevel lvl) const noexcept
     return (static_cast<int>(lvl) >= m_level.load(std::memory_order_relaxed));
 }
 
+std::shared_ptr<spdlog::sinks::sink> RtLog::CreateNetSink(const std::string &fileBasename, const char *loggerName)
+{
+    NetLogEndpoint endpoint;
+    if (!NetLogEndpoint::Parse(fileBasename, endpoint))
+    {
+        LogRaw(LogLevel::err, "[RtLog] invalid network log target '%s' (use _NET_:tcp:<host>:<port> or _NET_:unix:<path>)",
+               fileBasename.c_str());
+        return nullptr;
+    }
+
+    auto net_sink = std::make_shared<NetSinkMt>(endpoint);
+    // level and timestamp travel in the record header; the collector formats them
+    net_sink->set_pattern("%v");
+
+    std::lock_guard<std::mutex> lock(m_netSinkMtx);
+    const int n = m_netSlotCount.load(std::memory_order_relaxed);
+    if (n >= static_cast<int>(RtLogConstant::MAX_NET_SINKS))
+    {
+        LogRaw(LogLevel::warn, "[RtLog] more than %zu network sinks: queue drops of '%s' are not reported to the collector",
+               RtLogConstant::MAX_NET_SINKS, loggerName);
+        return net_sink;
+    }
+    NetDropSlot &slot = m_netSlots[n];
+    snprintf(slot.logger, sizeof(slot.logger), "%s", loggerName);
+    slot.drops.store(0, std::memory_order_relaxed);
+    slot.reported = 0;
+    slot.sink     = net_sink;
+    m_netSlotCount.store(n + 1, std::memory_order_release);
+    return net_sink;
+}
+
 std::string RtLog::AnnotateFilenameDatetime(const std::string &fileBasename)
 {
     spdlog::filename_t filename;
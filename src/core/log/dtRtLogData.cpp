@@ -0,0 +1,523 @@
+#include <spdlog/fmt/fmt.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <new>
+#include "dtCore/src/dtLog/dtRtLogData.hpp"
+
+namespace dt {
+
+namespace Log {
+// ─── DataQueue ──────────────────────────────────────────────────────────────
+
+bool DataQueue::Allocate(size_t capacity, size_t slotBytes, const dt::Utils::RtMemOptions &opt) noexcept
+{
+    Release();
+
+    size_t cap = 2;
+    while (cap < capacity && cap < (size_t{1} << 20))
+    {
+        cap <<= 1;
+    }
+    slotBytes = std::min(std::max(slotBytes, static_cast<size_t>(8)), RtLogDataConstant::MAX_SLOT_BYTES);
+    slotBytes = (slotBytes + 7) & ~static_cast<size_t>(7);
+
+    const size_t stride = (sizeof(SlotHeader) + slotBytes + 63) & ~static_cast<size_t>(63);
+    if (!dt::Utils::AllocRtMem(cap * stride, opt, m_mem))
+    {
+        return false;
+    }
+
+    m_base      = static_cast<char *>(m_mem.ptr);
+    m_stride    = stride;
+    m_mask      = cap - 1;
+    m_slotCap   = cap;
+    m_slotBytes = slotBytes;
+
+    for (size_t i = 0; i < cap; ++i)
+    {
+        SlotHeader *hdr = new (m_base + i * stride) SlotHeader{};
+        hdr->seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void DataQueue::Release() noexcept
+{
+    dt::Utils::FreeRtMem(m_mem);
+    m_base      = nullptr;
+    m_stride    = 0;
+    m_mask      = 0;
+    m_slotCap   = 0;
+    m_slotBytes = 0;
+}
+
+// ─── RtLogData ──────────────────────────────────────────────────────────────
+
+RtLogData::~RtLogData()
+{
+    Close();
+}
+
+bool RtLogData::Open(size_t capacity, size_t slotBytes, const dt::Utils::RtMemOptions &opt) noexcept
+{
+    Close();
+    if (capacity == 0)
+    {
+        return true;
+    }
+    if (!m_queue.Allocate(capacity, slotBytes, opt))
+    {
+        return false;
+    }
+    m_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void RtLogData::Close() noexcept
+{
+    m_enabled.store(false, std::memory_order_release);
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+
+    std::lock_guard<std::mutex> lock(m_createMutex);
+    for (auto &ch : m_channels)
+    {
+        if (ch.fd >= 0)
+        {
+            ::close(ch.fd);
+        }
+        ch.fd            = -1;
+        ch.schema.store(SCHEMA_NONE, std::memory_order_relaxed);
+        ch.name[0]       = '\0';
+        ch.namedColumns  = 0;
+        ch.columns       = 0;
+        ch.rowBytes      = 0;
+        ch.dropped.store(0, std::memory_order_relaxed);
+        ch.rejected.store(0, std::memory_order_relaxed);
+        ch.samples.store(0, std::memory_order_relaxed);
+        ch.columnNames.clear();
+        ch.offsets.clear();
+        std::vector<char>().swap(ch.block);
+        ch.rows          = 0;
+        ch.headerWritten = false;
+        ch.failed        = false;
+        ch.used.store(false, std::memory_order_release);
+    }
+    m_unknown.store(0, std::memory_order_relaxed);
+    // The queue storage stays mapped: a LOG_DATA() producer that passed the m_enabled check
+    // just before the store above may still reserve a slot in it. It is remapped by the next
+    // Open() (Allocate()) or released by the DataQueue destructor.
+}
+
+void RtLogData::Release() noexcept
+{
+    Close();
+    m_queue.Release();
+}
+
+bool RtLogData::CreateChannel(const std::string &name, int fd, const std::vector<std::string> &columns, DataFormat format)
+{
+    if (!m_enabled.load(std::memory_order_acquire) ||
+        name.empty() || name.size() >= RtLogDataConstant::NAME_LEN || columns.size() > RtLogDataConstant::MAX_COLUMNS)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_createMutex);
+    Channel *slot = nullptr;
+    for (auto &ch : m_channels)
+    {
+        if (ch.used.load(std::memory_order_relaxed))
+        {
+            if (name == ch.name)
+            {
+                return false;
+            }
+        }
+        else if (!slot)
+        {
+            slot = &ch;
+        }
+    }
+    if (!slot)
+    {
+        return false;
+    }
+
+    std::memset(slot->name, 0, sizeof(slot->name));
+    std::memcpy(slot->name, name.data(), name.size());
+    slot->namedColumns = static_cast<uint16_t>(columns.size());
+    slot->columnNames  = columns;
+    slot->fd           = fd;
+    slot->format       = format;
+    slot->lastFlush_ns = dt::Utils::MonotonicNs();
+    slot->used.store(true, std::memory_order_release);  // publish to producers
+    return true;
+}
+
+uint64_t RtLogData::Resolve(Site &site, const DataType *types, DataType uniform, uint16_t count, size_t bytes, uint32_t gen) noexcept
+{
+    const uint64_t base = (static_cast<uint64_t>(gen) << 32) | (static_cast<uint64_t>(count) << 8);
+
+    size_t idx = 0;
+    for (; idx < m_channels.size(); ++idx)
+    {
+        const Channel &ch = m_channels[idx];
+        if (ch.used.load(std::memory_order_acquire) && std::strncmp(ch.name, site.name, RtLogDataConstant::NAME_LEN) == 0)
+        {
+            break;
+        }
+    }
+    if (idx == m_channels.size())
+    {
+        // unknown channel: CreateDataChannel() not called (yet). Not cached, so a channel
+        // created later is picked up.
+        return base | (uint64_t{0xFF} << 24) | VERDICT_REJECT;
+    }
+
+    Channel &ch = m_channels[idx];
+    const uint64_t chBits = static_cast<uint64_t>(idx) << 24;
+    if (count > RtLogDataConstant::MAX_COLUMNS)
+    {
+        return base | chBits | VERDICT_REJECT;  // WriteArray() with too many values, not cached
+    }
+
+    auto type_at = [&](size_t i) { return types ? types[i] : uniform; };
+
+    // first sample of this channel registers the schema
+    uint8_t state = ch.schema.load(std::memory_order_acquire);
+    if (state == SCHEMA_NONE)
+    {
+        bool fits = (bytes <= m_queue.SlotBytes()) && (ch.namedColumns == 0 || ch.namedColumns == count);
+        if (fits && ch.schema.compare_exchange_strong(state, SCHEMA_WRITING, std::memory_order_acq_rel))
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                ch.types[i] = type_at(i);
+            }
+            ch.columns  = count;
+            ch.rowBytes = static_cast<uint32_t>(bytes);
+            ch.schema.store(SCHEMA_READY, std::memory_order_release);
+            state = SCHEMA_READY;
+        }
+        else if (!fits)
+        {
+            uint64_t result = base | chBits | VERDICT_REJECT;
+            site.cache.store(result, std::memory_order_release);
+            return result;
+        }
+        else
+        {
+            state = ch.schema.load(std::memory_order_acquire);
+        }
+    }
+    if (state != SCHEMA_READY)
+    {
+        return base | chBits | VERDICT_NONE;  // another producer is registering the schema
+    }
+
+    bool match = (ch.columns == count) && (ch.rowBytes == bytes) && (bytes <= m_queue.SlotBytes());
+    for (size_t i = 0; match && i < count; ++i)
+    {
+        match = (ch.types[i] == type_at(i));
+    }
+
+    uint64_t result = base | chBits | (match ? VERDICT_OK : VERDICT_REJECT);
+    site.cache.store(result, std::memory_order_release);
+    return result;
+}
+
+void RtLogData::Reject(uint64_t cache) noexcept
+{
+    const size_t idx = static_cast<size_t>((cache >> 24) & 0xFF);
+    if (static_cast<uint8_t>(cache) == VERDICT_NONE)
+    {
+        // schema being registered by another producer: the sample is lost, not mismatched
+        if (idx < m_channels.size())
+        {
+            m_channels[idx].dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    if (idx < m_channels.size())
+    {
+        m_channels[idx].rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_unknown.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+size_t RtLogData::Drain(int64_t wallOffset_ns) noexcept
+{
+    size_t count = 0;
+    const DataQueue::SlotHeader *slot;
+    while ((slot = m_queue.Front()) != nullptr)
+    {
+        if (slot->channel < m_channels.size())
+        {
+            Channel &ch = m_channels[slot->channel];
+            if (ch.schema.load(std::memory_order_acquire) == SCHEMA_READY && slot->bytes == ch.rowBytes)
+            {
+                Append(ch, slot->timeStamp_ns + wallOffset_ns, DataQueue::Payload(slot));
+            }
+        }
+        m_queue.Pop();
+        ++count;
+    }
+    return count;
+}
+
+void RtLogData::Flush(int64_t now_ns, bool force) noexcept
+{
+    for (auto &ch : m_channels)
+    {
+        if (!ch.used.load(std::memory_order_acquire) || ch.rows == 0)
+        {
+            continue;
+        }
+        if (force || now_ns - ch.lastFlush_ns >= RtLogDataConstant::FLUSH_INTERVAL_NS)
+        {
+            WriteBlock(ch);
+            ch.lastFlush_ns = now_ns;
+        }
+    }
+}
+
+bool RtLogData::GetStats(const char *channelName, DataChannelStats &stats) const noexcept
+{
+    for (const auto &ch : m_channels)
+    {
+        if (ch.used.load(std::memory_order_acquire) && std::strncmp(ch.name, channelName, RtLogDataConstant::NAME_LEN) == 0)
+        {
+            bool ready = ch.schema.load(std::memory_order_acquire) == SCHEMA_READY;
+            stats = DataChannelStats{
+                .samples     = ch.samples.load(std::memory_order_relaxed),
+                .dropped     = ch.dropped.load(std::memory_order_relaxed),
+                .rejected    = ch.rejected.load(std::memory_order_relaxed),
+                .columns     = ready ? ch.columns : static_cast<uint16_t>(0),
+                .schemaReady = ready
+            };
+            return true;
+        }
+    }
+    return false;
+}
+
+// drain thread: the schema is READY here, so columns / types / rowBytes are stable
+void RtLogData::Append(Channel &ch, int64_t wall_ns, const char *payload) noexcept
+{
+    if (ch.failed)
+    {
+        return;
+    }
+
+    try
+    {
+        if (!ch.headerWritten)
+        {
+            // first sample: fix value offsets, column names and the block buffer (nonRT allocation)
+            ch.offsets.resize(ch.columns);
+            uint32_t off = 0;
+            for (size_t i = 0; i < ch.columns; ++i)
+            {
+                ch.offsets[i] = off;
+                off += static_cast<uint32_t>(DataTypeSize(ch.types[i]));
+            }
+            if (ch.columnNames.size() != ch.columns)
+            {
+                ch.columnNames.clear();
+                for (size_t i = 0; i < ch.columns; ++i)
+                {
+                    ch.columnNames.push_back("c" + std::to_string(i));
+                }
+            }
+            if (ch.format == DataFormat::binary)
+            {
+                ch.block.resize(RtLogDataConstant::BLOCK_ROWS * (sizeof(int64_t) + ch.rowBytes));
+            }
+            else
+            {
+                ch.block.reserve(64 * 1024);
+            }
+            WriteHeader(ch);
+            ch.headerWritten = true;
+        }
+
+        if (ch.format == DataFormat::binary)
+        {
+            // column-major: [ts x BLOCK_ROWS][col0 x BLOCK_ROWS][col1 x BLOCK_ROWS]...
+            char *base = ch.block.data();
+            std::memcpy(base + ch.rows * sizeof(int64_t), &wall_ns, sizeof(int64_t));
+            size_t colBase = RtLogDataConstant::BLOCK_ROWS * sizeof(int64_t);
+            for (size_t i = 0; i < ch.columns; ++i)
+            {
+                const size_t sz = DataTypeSize(ch.types[i]);
+                std::memcpy(base + colBase + ch.rows * sz, payload + ch.offsets[i], sz);
+                colBase += RtLogDataConstant::BLOCK_ROWS * sz;
+            }
+            if (++ch.rows == RtLogDataConstant::BLOCK_ROWS)
+            {
+                WriteBlock(ch);
+            }
+        }
+        else
+        {
+            auto out = std::back_inserter(ch.block);
+            fmt::format_to(out, "{}.{:09d}", wall_ns / 1'000'000'000LL, wall_ns % 1'000'000'000LL);
+            for (size_t i = 0; i < ch.columns; ++i)
+            {
+                const char *p = payload + ch.offsets[i];
+                switch (ch.types[i])
+                {
+                    case DataType::i8:      { int8_t v;   std::memcpy(&v, p, 1); fmt::format_to(out, ",{}", static_cast<int>(v)); break; }
+                    case DataType::u8:      { uint8_t v;  std::memcpy(&v, p, 1); fmt::format_to(out, ",{}", static_cast<unsigned>(v)); break; }
+                    case DataType::boolean: { uint8_t v;  std::memcpy(&v, p, 1); fmt::format_to(out, ",{}", v ? 1 : 0); break; }
+                    case DataType::i16:     { int16_t v;  std::memcpy(&v, p, 2); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::u16:     { uint16_t v; std::memcpy(&v, p, 2); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::i32:     { int32_t v;  std::memcpy(&v, p, 4); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::u32:     { uint32_t v; std::memcpy(&v, p, 4); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::i64:     { int64_t v;  std::memcpy(&v, p, 8); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::u64:     { uint64_t v; std::memcpy(&v, p, 8); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::f32:     { float v;    std::memcpy(&v, p, 4); fmt::format_to(out, ",{}", v); break; }
+                    case DataType::f64:     { double v;   std::memcpy(&v, p, 8); fmt::format_to(out, ",{}", v); break; }
+                    default: break;
+                }
+            }
+            ch.block.push_back('\n');
+            ++ch.rows;
+            if (ch.block.size() >= 60 * 1024)
+            {
+                WriteBlock(ch);
+            }
+        }
+        ch.samples.fetch_add(1, std::memory_order_relaxed);
+    }
+    catch (...)
+    {
+        ch.failed = true;  // out of memory on the drain thread: stop this channel only
+    }
+}
+
+void RtLogData::WriteHeader(Channel &ch) noexcept
+{
+    if (ch.format == DataFormat::csv)
+    {
+        std::string line = "timestamp";
+        for (const auto &col : ch.columnNames)
+        {
+            line += ',';
+            line += col;
+        }
+        line += '\n';
+        WriteAll(ch, line.data(), line.size());
+        return;
+    }
+
+    struct timespec tw{};
+    clock_gettime(CLOCK_REALTIME, &tw);
+
+    DataFileHeader hdr{};
+    hdr.magic      = RtLogDataConstant::FILE_MAGIC;
+    hdr.version    = RtLogDataConstant::FILE_VERSION;
+    hdr.columns    = ch.columns;
+    hdr.created_ns = static_cast<int64_t>(tw.tv_sec) * 1'000'000'000LL + tw.tv_nsec;
+    std::memcpy(hdr.channel, ch.name, sizeof(hdr.channel));
+    WriteAll(ch, &hdr, sizeof(hdr));
+
+    for (size_t i = 0; i < ch.columns; ++i)
+    {
+        DataColumnDesc desc{};
+        desc.type = static_cast<uint8_t>(ch.types[i]);
+        std::strncpy(desc.name, ch.columnNames[i].c_str(), sizeof(desc.name) - 1);
+        WriteAll(ch, &desc, sizeof(desc));
+    }
+}
+
+void RtLogData::WriteBlock(Channel &ch) noexcept
+{
+    if (ch.rows == 0)
+    {
+        return;
+    }
+
+    if (ch.format == DataFormat::csv)
+    {
+        WriteAll(ch, ch.block.data(), ch.block.size());
+        ch.block.clear();
+        ch.rows = 0;
+        return;
+    }
+
+    // header + timestamp column + one iovec per value column (only the filled rows)
+    DataBlockHeader hdr{RtLogDataConstant::BLOCK_MAGIC, ch.rows};
+    std::array<struct iovec, RtLogDataConstant::MAX_COLUMNS + 2> iov;
+    size_t n = 0;
+    iov[n++] = {&hdr, sizeof(hdr)};
+    iov[n++] = {ch.block.data(), ch.rows * sizeof(int64_t)};
+    size_t colBase = RtLogDataConstant::BLOCK_ROWS * sizeof(int64_t);
+    for (size_t i = 0; i < ch.columns; ++i)
+    {
+        const size_t sz = DataTypeSize(ch.types[i]);
+        iov[n++] = {ch.block.data() + colBase, ch.rows * sz};
+        colBase += RtLogDataConstant::BLOCK_ROWS * sz;
+    }
+
+    size_t idx = 0;
+    while (idx < n && ch.fd >= 0)
+    {
+        ssize_t written = ::writev(ch.fd, &iov[idx], static_cast<int>(n - idx));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ch.failed = true;
+            break;
+        }
+        // advance over fully written iovecs, trim the partially written one
+        size_t left = static_cast<size_t>(written);
+        while (idx < n && left >= iov[idx].iov_len)
+        {
+            left -= iov[idx].iov_len;
+            ++idx;
+        }
+        if (idx < n)
+        {
+            iov[idx].iov_base = static_cast<char *>(iov[idx].iov_base) + left;
+            iov[idx].iov_len -= left;
+        }
+    }
+    ch.rows = 0;
+}
+
+void RtLogData::WriteAll(Channel &ch, const void *data, size_t len) noexcept
+{
+    const char *p = static_cast<const char *>(data);
+    while (len > 0 && ch.fd >= 0)
+    {
+        ssize_t written = ::write(ch.fd, p, len);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ch.failed = true;
+            return;
+        }
+        p   += written;
+        len -= static_cast<size_t>(written);
+    }
+}
+
+}   // namespace Log
+
+}   // namespace dt
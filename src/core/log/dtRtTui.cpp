@@ -3,13 +3,21 @@
 #include <termios.h>
 #include <sys/ioctl.h>
 #include <poll.h>
+#include <signal.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
+#include <errno.h>
 #include <atomic>
 #include <algorithm>
+#include <cmath>
+#include <new>
 
 #include "dtCore/src/dtLog/dtRtTui.hpp"
+#include "dtCore/src/dtLog/dtRtTuiShm.hpp"
 #include "dtCore/src/dtLog/dtRtLog.hpp"
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
 
 namespace dt 
 {
@@ -35,6 +43,82 @@ namespace ansi
     static constexpr const char* SHOW_CURSOR  = "\x1b[?25h";
 }
 
+// ═══════════════════════════════════════════════
+// SIGWINCH: terminal size is re-queried only when the flag is raised
+// ═══════════════════════════════════════════════
+namespace
+{
+    std::atomic<bool> g_resizePending{true};
+    struct sigaction  g_oldWinch{};
+    bool              g_winchInstalled = false;
+
+    void OnWinch(int sig)
+    {
+        g_resizePending.store(true, std::memory_order_relaxed);
+        // chain to a handler installed by the application
+        if (!(g_oldWinch.sa_flags & SA_SIGINFO) && g_oldWinch.sa_handler != SIG_DFL && g_oldWinch.sa_handler != SIG_IGN)
+        {
+            g_oldWinch.sa_handler(sig);
+        }
+    }
+
+    int64_t RealtimeNs()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return (int64_t)ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+    }
+
+    void CopyStr(char *dst, const char *src, size_t size)
+    {
+        const size_t n = strnlen(src, size - 1);
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+
+    // Interned TUI_VAL format specs: slots are claimed with fetch_add and published with
+    // 'ready', so lookups never block. Duplicate entries from a concurrent first use are harmless.
+    struct TuiFormatSpec
+    {
+        std::atomic<bool> ready{false};
+        char              conv{0};                          // 'd' signed, 'u' unsigned, 'f' floating
+        char              src[RtTui::TUI_DATA_COL_LEN]{};   // spec as given
+        char              fmt[RtTui::TUI_DATA_COL_LEN]{};   // normalized (ll for integers)
+    };
+    TuiFormatSpec         g_formats[RtTui::TUI_MAX_FORMATS];
+    std::atomic<uint32_t> g_formatCount{0};
+
+    // float → integer for a %d / %u spec: out-of-range values saturate instead of the UB cast
+    // (callers handle NaN / inf)
+    long long SaturateLL(double d)
+    {
+        if (d >= 9223372036854775807.0)   // 2^63
+        {
+            return INT64_MAX;
+        }
+        if (d <= -9223372036854775808.0)
+        {
+            return INT64_MIN;
+        }
+        return (long long)d;
+    }
+
+    unsigned long long SaturateULL(double d)
+    {
+        if (d >= 18446744073709551615.0)  // 2^64
+        {
+            return UINT64_MAX;
+        }
+        return (d >= 0.0) ? (unsigned long long)d : (unsigned long long)SaturateLL(d);
+    }
+
+    constexpr uint8_t ATTR_BOLD      = 0x01;
+    constexpr uint8_t ATTR_DIM       = 0x02;
+    constexpr uint8_t ATTR_ITALIC    = 0x04;
+    constexpr uint8_t ATTR_UNDERLINE = 0x08;
+    constexpr uint8_t ATTR_REVERSE   = 0x10;
+}
+
 // ═══════════════════════════════════════════════
 // RtTui implementation
 // ═══════════════════════════════════════════════
@@ -58,13 +142,30 @@ RtTui::~RtTui()
 // ───────────────────────────────────────────────
 // Init / shutdown
 // ───────────────────────────────────────────────
-bool RtTui::Init() 
+bool RtTui::Init(size_t queueCapacity, size_t queueMsgLen, const dt::Utils::RtMemOptions &memOpt,
+                 const TuiHistoryConfig &history, bool headless) 
 {
     // already initialized
-    if (m_termActive.load(std::memory_order_acquire))
+    if (m_termActive.load(std::memory_order_acquire) || m_running.load(std::memory_order_acquire))
         return true;
 
-    TermInit();
+    if (!m_logQueue.Allocate(queueCapacity, queueMsgLen, memOpt))
+        return false;
+
+    // a file that cannot be mapped falls back to anonymous memory inside Init()
+    if (!m_history.Init(history, memOpt))
+    {
+        m_logQueue.Release();
+        return false;
+    }
+
+    m_memOpt   = memOpt;   // plot rings added later use the same memory policy
+    m_headless = headless;
+
+    if (!m_headless)
+    {
+        TermInit();
+    }
     m_running.store(true, std::memory_order_release);
     return true;
 }
@@ -73,6 +174,17 @@ void RtTui::Stop()
 {
     m_running.store(false, std::memory_order_release);
     TermRestore();  // m_termActive guards against double-call
+
+    if (m_shm)
+    {
+        DestroyTuiShm(m_shm, m_shmName);
+        m_shm = nullptr;
+    }
+    if (m_attached)
+    {
+        CloseTuiShm(m_attached);
+        m_attached = nullptr;
+    }
 }
 
 // ───────────────────────────────────────────────
@@ -109,11 +221,34 @@ void RtTui::TermInit()
         }
     }
 
+    // Resize notification. SIGWINCH is blocked in this thread first: RT threads created
+    // afterwards inherit the mask, so a window resize never cuts their sleeps short (EINTR).
+    // The drain thread unblocks it via AcceptResizeSignal().
+    sigset_t winch;
+    sigemptyset(&winch);
+    sigaddset(&winch, SIGWINCH);
+    pthread_sigmask(SIG_BLOCK, &winch, nullptr);
+
+    struct sigaction sa{};
+    sa.sa_handler = OnWinch;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    g_winchInstalled = (sigaction(SIGWINCH, &sa, &g_oldWinch) == 0);
+    g_resizePending.store(true, std::memory_order_relaxed);
+
     AppendData_str(ansi::HIDE_CURSOR);
     AppendData_str(ansi::CLEAR_SCREEN);
     FlushOutput();
 }
 
+void RtTui::AcceptResizeSignal() noexcept
+{
+    sigset_t winch;
+    sigemptyset(&winch);
+    sigaddset(&winch, SIGWINCH);
+    pthread_sigmask(SIG_UNBLOCK, &winch, nullptr);
+}
+
 void RtTui::TermRestore() 
 {
     if (!m_termActive.exchange(false, std::memory_order_acq_rel))
@@ -152,6 +287,12 @@ void RtTui::TermRestore()
     }
 
     tcsetattr(STDIN_FILENO, TCSAFLUSH, m_oldTermios.get());
+
+    if (g_winchInstalled)
+    {
+        sigaction(SIGWINCH, &g_oldWinch, nullptr);
+        g_winchInstalled = false;
+    }
 }
 
 void RtTui::TermGetSize(int& rows, int& cols) 
@@ -280,8 +421,10 @@ void RtTui::SetRowData(int layoutIdx, int groupIdx, int row_idx, const char *lab
     strncpy(row.label, label, TUI_DATA_COL_LEN - 1);
     row.label[TUI_DATA_COL_LEN - 1] = '\0';
 
-    row.ncols     = ncols;
+    row.ncols    = ncols;
     row.textMode = false;
+    row.rawMode  = false;
+    row.plotMode = false;
     for (int i = 0; i < ncols; ++i) 
     {
         if (cols[i]) 
@@ -332,6 +475,8 @@ void RtTui::SetTextRow(int layoutIdx, int groupIdx, int row_idx, const char *lab
     row.label[TUI_DATA_COL_LEN - 1] = '\0';
 
     row.textMode = true;
+    row.rawMode  = false;
+    row.plotMode = false;
     strncpy(row.text, text, TUI_TEXT_ROW_LEN - 1);
     row.text[TUI_TEXT_ROW_LEN - 1] = '\0';
     row.ncols = 0;
@@ -351,6 +496,265 @@ void RtTui::SetTextRowFmt(int layoutIdx, int groupIdx, int row_idx, const char*
     SetTextRow(layoutIdx, groupIdx, row_idx, label, buf);
 }
 
+void RtTui::SetRowValData(int layoutIdx, int groupIdx, int row_idx, const char *label, const TuiVal vals[], int ncols) noexcept
+{
+    if (layoutIdx < 0 || layoutIdx >= MAX_LAYOUTS)
+    {
+        return;
+    }
+
+    if (groupIdx < 0 || groupIdx >= (int)TUI_MAX_GROUPS)
+    {
+        return;
+    }
+
+    if (row_idx < 0 || row_idx >= (int)TUI_MAX_ROWS_PER_GROUP)
+    {
+        return;
+    }
+
+    if (ncols > TUI_MAX_COLS)
+    {
+        ncols = TUI_MAX_COLS;
+    }
+
+    TuiLayoutData   &layout = m_layouts[layoutIdx];
+    int             widx    = layout.dataWriteIdx.load(std::memory_order_relaxed);
+    TuiDataBuffer   &dbuf   = layout.dataBuf[widx];
+    TuiGroupRowData &gdata  = dbuf.groups[groupIdx];
+    TuiDataRow      &row    = gdata.rows[row_idx];
+
+    strncpy(row.label, label, TUI_DATA_COL_LEN - 1);
+    row.label[TUI_DATA_COL_LEN - 1] = '\0';
+
+    row.ncols    = ncols;
+    row.textMode = false;
+    row.rawMode  = true;
+    row.plotMode = false;
+    memcpy(row.vals, vals, sizeof(TuiVal) * (size_t)ncols);
+
+    gdata.nrows = std::max(gdata.nrows, row_idx + 1);
+    dbuf.dirty.store(true, std::memory_order_release);
+    layout.defined = true;
+}
+
+uint16_t RtTui::InternFormat(const char *fmt) noexcept
+{
+    if (!fmt)
+    {
+        return 0;
+    }
+
+    // the whole spec is kept for the lookup below: a longer one is rejected, not truncated
+    // (a truncated key never matches again and would take a new slot on every call)
+    const size_t srcLen = strnlen(fmt, sizeof(TuiFormatSpec::src));
+    if (srcLen >= sizeof(TuiFormatSpec::src))
+    {
+        return 0;
+    }
+
+    // normalize: one conversion (d i u o x X f F e E g G a A), length modifiers replaced
+    // by "ll" for integer conversions, literal text and %% allowed around it
+    char   norm[TUI_DATA_COL_LEN];
+    size_t n    = 0;
+    char   conv = 0;
+    auto put = [&](char c) {
+        if (n + 1 >= sizeof(norm))
+        {
+            return false;
+        }
+        norm[n++] = c;
+        return true;
+    };
+
+    for (const char *p = fmt; *p; ++p)
+    {
+        if (*p != '%')
+        {
+            if (!put(*p)) return 0;
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            if (!put('%') || !put('%')) return 0;
+            ++p;
+            continue;
+        }
+        if (conv)
+        {
+            return 0;   // second conversion
+        }
+
+        if (!put(*p++)) return 0;
+        while (*p && strchr("-+ #0", *p))
+        {
+            if (!put(*p++)) return 0;
+        }
+        while ((*p >= '0' && *p <= '9') || *p == '.')
+        {
+            if (!put(*p++)) return 0;
+        }
+        while (*p && strchr("hljztL", *p))
+        {
+            ++p;
+        }
+
+        if (*p && strchr("di", *p))
+        {
+            conv = 'd';
+        }
+        else if (*p && strchr("ouxX", *p))
+        {
+            conv = 'u';
+        }
+        else if (*p && strchr("fFeEgGaA", *p))
+        {
+            conv = 'f';
+        }
+        else
+        {
+            return 0;   // %s, %c, %n, %p, '*' width, ...
+        }
+        if (conv != 'f' && (!put('l') || !put('l')))
+        {
+            return 0;
+        }
+        if (!put(*p)) return 0;
+    }
+    if (!conv)
+    {
+        return 0;
+    }
+    norm[n] = '\0';
+
+    uint32_t count = std::min<uint32_t>(g_formatCount.load(std::memory_order_acquire), TUI_MAX_FORMATS);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (g_formats[i].ready.load(std::memory_order_acquire) && strcmp(g_formats[i].src, fmt) == 0)
+        {
+            return (uint16_t)(i + 1);
+        }
+    }
+
+    uint32_t slot = g_formatCount.fetch_add(1, std::memory_order_acq_rel);
+    if (slot >= TUI_MAX_FORMATS)
+    {
+        return 0;
+    }
+
+    TuiFormatSpec &spec = g_formats[slot];
+    memcpy(spec.src, fmt, srcLen + 1);
+    memcpy(spec.fmt, norm, n + 1);
+    spec.conv = conv;
+    spec.ready.store(true, std::memory_order_release);
+    return (uint16_t)(slot + 1);
+}
+
+void RtTui::FormatVal(char *buf, size_t bufSize, const TuiVal &val) noexcept
+{
+    if (val.fmtId == 0 || val.fmtId > TUI_MAX_FORMATS ||
+        !g_formats[val.fmtId - 1].ready.load(std::memory_order_acquire))
+    {
+        snprintf(buf, bufSize, "?");
+        return;
+    }
+
+    const TuiFormatSpec &spec = g_formats[val.fmtId - 1];
+    if (spec.conv != 'f' && val.kind == TuiVal::FLOAT && !std::isfinite(val.d))
+    {
+        snprintf(buf, bufSize, "%g", val.d);   // "nan" / "inf" / "-inf"
+        return;
+    }
+
+    switch (spec.conv)
+    {
+    case 'd':
+    {
+        long long v = (val.kind == TuiVal::FLOAT)    ? SaturateLL(val.d)
+                    : (val.kind == TuiVal::UNSIGNED) ? (long long)val.u : (long long)val.i;
+        snprintf(buf, bufSize, spec.fmt, v);
+        break;
+    }
+    case 'u':
+    {
+        unsigned long long v = (val.kind == TuiVal::FLOAT)  ? SaturateULL(val.d)
+                             : (val.kind == TuiVal::SIGNED) ? (unsigned long long)val.i : (unsigned long long)val.u;
+        if (val.kind == TuiVal::SIGNED && val.bytes < 8)
+        {
+            v &= (1ULL << (val.bytes * 8)) - 1;
+        }
+        snprintf(buf, bufSize, spec.fmt, v);
+        break;
+    }
+    default:
+    {
+        double v = (val.kind == TuiVal::FLOAT)  ? val.d
+                 : (val.kind == TuiVal::SIGNED) ? (double)val.i : (double)val.u;
+        snprintf(buf, bufSize, spec.fmt, v);
+        break;
+    }
+    }
+}
+
+int RtTui::AddPlot(int layoutIdx, int groupIdx, int rowIdx, const char *label, const TuiPlotConfig &cfg)
+{
+    if (layoutIdx < 0 || layoutIdx >= MAX_LAYOUTS)
+    {
+        return -1;
+    }
+
+    if (groupIdx < 0 || groupIdx >= (int)TUI_MAX_GROUPS)
+    {
+        return -1;
+    }
+
+    if (rowIdx < 0 || rowIdx >= (int)TUI_MAX_ROWS_PER_GROUP)
+    {
+        return -1;
+    }
+
+    // the id is claimed only once the ring exists, so a failed Init() does not use up a slot
+    std::unique_ptr<TuiPlot> plot(new (std::nothrow) TuiPlot());
+    if (!plot || !plot->Init(label, cfg, m_memOpt))
+    {
+        LOG(err).printf("[TUI] AddPlot(%s): ring allocation failed", label ? label : "");
+        return -1;
+    }
+
+    int id = m_plotCount.fetch_add(1, std::memory_order_acq_rel);
+    if (id >= (int)TUI_MAX_PLOTS)
+    {
+        m_plotCount.store((int)TUI_MAX_PLOTS, std::memory_order_relaxed);
+        LOG(warn).printf("[TUI] AddPlot(%s): max %zu plots", label ? label : "", TUI_MAX_PLOTS);
+        return -1;
+    }
+
+    TuiLayoutData &layout = m_layouts[layoutIdx];
+    layout.plotRef[groupIdx][rowIdx] = (uint8_t)(id + 1);
+    layout.plotRows[groupIdx]        = std::max(layout.plotRows[groupIdx], rowIdx + 1);
+    layout.defined                   = true;
+
+    m_plots[id].store(plot.get(), std::memory_order_release);
+    m_plotStore[id] = std::move(plot);
+    return id;
+}
+
+const RtTui::TuiDataBuffer &RtTui::FrontBuffer(TuiLayoutData &layout) noexcept
+{
+    // Swap double buffer if dirty
+    int widx = layout.dataWriteIdx.load(std::memory_order_acquire);
+    int ridx = 1 - widx;
+
+    if (layout.dataBuf[widx].dirty.load(std::memory_order_acquire)) 
+    {
+        layout.dataWriteIdx.store(1 - widx, std::memory_order_release);
+        layout.dataBuf[widx].dirty.store(false, std::memory_order_release);
+        ridx = widx;
+    }
+
+    return layout.dataBuf[ridx];
+}
+
 int RtTui::CalcArea1Height() const noexcept 
 {
     int layoutIdx = m_currentLayout.load(std::memory_order_relaxed);
@@ -381,7 +785,7 @@ int RtTui::CalcArea1Height() const noexcept
             content += 2;  // header row + underline separator
         }
 
-        content += buf.groups[g].nrows;
+        content += std::max(buf.groups[g].nrows, layout.plotRows[g]);
     }
 
     return (2 + content);  // +2 for top and bottom border
@@ -404,6 +808,21 @@ void RtTui::LogV(spdlog::level::level_enum level, const char *fmt, va_list args)
     m_logQueue.TryPush(entry);
 }
 
+void RtTui::LogText(spdlog::level::level_enum level, const char *loggerName, size_t loggerLen,
+                    const char *text, size_t len) noexcept
+{
+    TuiLogEntry entry;
+    entry.Set(level, 0, "%.*s", (int)std::min(len, QUEUE_MSG_LEN - 1), text);
+
+    const size_t n = std::min(loggerLen, sizeof(entry.loggerName) - 1);
+    if (loggerName && n)
+    {
+        memcpy(entry.loggerName, loggerName, n);
+    }
+    entry.loggerName[loggerName ? n : 0] = '\0';
+    m_logQueue.TryPush(entry);
+}
+
 // ───────────────────────────────────────────────
 // tick(): called at 25 Hz by the RtLog drain thread
 // ───────────────────────────────────────────────
@@ -414,19 +833,15 @@ void RtTui::Tick()
         return;
     }
 
-    // 1) drain log queue into circular history
+    // 1) drain log queue into the history; a paused view keeps its position as long as
+    //    the new line is part of the filtered view
     TuiLogEntry entry;
     while (m_logQueue.TryPop(entry)) 
     {
-        if (m_logCount < LOG_KEEP) 
-        {
-            m_logHistory[(m_logHead + m_logCount) % LOG_KEEP] = entry;
-            m_logCount++;
-        }
-        else 
+        m_shmLogSeq++;
+        if (!m_history.Append(entry.level, entry.loggerName, entry.msg, entry.msgLen))
         {
-            m_logHistory[m_logHead] = entry;
-            m_logHead = (m_logHead + 1) % LOG_KEEP;
+            continue;
         }
 
         if (m_autoScroll) 
@@ -437,6 +852,37 @@ void RtTui::Tick()
         {
             m_scrollOffset++;
         }
+        m_anchorOffset++;
+    }
+
+    // 1a) advance a pending search by a bounded number of lines
+    if (m_history.GetSearchState() == TuiLogHistory::SearchState::running &&
+        m_history.StepSearch(SEARCH_STEP_LINES) == TuiLogHistory::SearchState::found)
+    {
+        m_followMatch = true;
+    }
+
+    // 1b) consume plot samples (all layouts, so rings never fill while hidden)
+    for (size_t i = 0; i < TUI_MAX_PLOTS; ++i)
+    {
+        if (TuiPlot *plot = m_plots[i].load(std::memory_order_acquire))
+        {
+            plot->Update();
+        }
+    }
+
+    // 1c) shared-memory snapshot: viewers read it without involving this thread
+    if (m_shm)
+    {
+        PublishSnapshot();
+    }
+    if (m_attachName[0])
+    {
+        ImportSnapshot();
+    }
+    if (m_headless)
+    {
+        return;
     }
 
     // 2) process key input
@@ -467,59 +913,416 @@ void RtTui::Tick()
         }
     }
 
-    // 3) update terminal size and compute layout
-    TermGetSize(m_termRows, m_termCols);
+    // 3) update terminal size (on SIGWINCH, or periodically if the signal cannot be
+    //    delivered to this thread) and compute layout
+    int64_t now_ns = dt::Utils::MonotonicNs();
+    if (g_resizePending.exchange(false, std::memory_order_relaxed) ||
+        now_ns - m_lastSizeCheck_ns >= SIZE_CHECK_INTERVAL_NS)
+    {
+        TermGetSize(m_termRows, m_termCols);
+        m_lastSizeCheck_ns = now_ns;
+    }
     int rows    = m_termRows;
     int cols    = m_termCols;
     int needed  = CalcArea1Height();
     int area1_h = std::max(4, std::min(needed, rows - 1 - AREA2_MIN_ROWS));
     int area2_h = rows - area1_h - 1;
 
-    // 4) clear screen on terminal resize or layout switch
+    // 4) push bytes the terminal did not accept last frame; if it is still busy,
+    //    skip this frame rather than dropping output (the shadow screen must match)
+    FlushOutput();
+    if (m_outPos > 0)
+    {
+        m_statSkipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    uint64_t bytes_before = m_statBytes.load(std::memory_order_relaxed);
+
+    // 5) clear screen on terminal resize, layout switch or render mode change
     bool force_clear = m_layoutChanged.exchange(false, std::memory_order_relaxed);
+    bool incremental = m_incrementalReq.load(std::memory_order_relaxed);
+    if (incremental != m_incremental)
+    {
+        m_incremental = incremental;
+        force_clear   = true;
+    }
     if (rows != m_prevTermRows || cols != m_prevTermCols || force_clear) 
     {
-        AppendData_str(ansi::CLEAR_SCREEN);
-        FlushOutput();
+        if (m_incremental)
+        {
+            ScreenReset(rows, cols);   // clear is emitted by ScreenDiff()
+        }
+        else
+        {
+            AppendData_str(ansi::CLEAR_SCREEN);
+        }
+        m_statRepaints.fetch_add(1, std::memory_order_relaxed);
         m_prevTermRows = rows;
         m_prevTermCols = cols;
     }
 
-    // 5) render: pack Area1 + Area2 + cmd_line into one buffer → single write()
-    FlushOutput();
-    m_outPos = 0;
+    // 6) render Area1 + Area2 + cmd_line. In incremental mode the escape stream is
+    //    parsed into the shadow screen and only the changed cells are written.
+    m_composing = m_incremental;
     RenderArea1(1, area1_h, cols);
     RenderArea2(area1_h + 1, area2_h, cols);
     RenderCmdLine(rows, cols);
+    if (m_composing)
+    {
+        ScreenFeedPending();
+        m_composing = false;
+        ScreenDiff();
+    }
 
     FlushOutput();
+
+    uint64_t frame_bytes = m_statBytes.load(std::memory_order_relaxed) - bytes_before + m_outPos;
+    m_statLastFrame.store(frame_bytes, std::memory_order_relaxed);
+    m_statFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+RtTui::RenderStats RtTui::GetRenderStats() const noexcept
+{
+    RenderStats st;
+    st.frames         = m_statFrames.load(std::memory_order_relaxed);
+    st.bytes          = m_statBytes.load(std::memory_order_relaxed);
+    st.cells          = m_statCells.load(std::memory_order_relaxed);
+    st.fullRepaints   = m_statRepaints.load(std::memory_order_relaxed);
+    st.skipped        = m_statSkipped.load(std::memory_order_relaxed);
+    st.lastFrameBytes = m_statLastFrame.load(std::memory_order_relaxed);
+    return st;
 }
 
 // ───────────────────────────────────────────────
-// Area 1: multi-group data monitor
+// Shared-memory snapshot: publisher
 // ───────────────────────────────────────────────
-void RtTui::RenderArea1(int startRow, int height, int width) 
+bool RtTui::OpenSnapshot(const char *shmName)
 {
-    if (height < 4)
+    if (m_shm)
     {
-        return;
+        return true;
+    }
+    if (!shmName || strlen(shmName) >= sizeof(m_shmName))
+    {
+        return false;
     }
 
-    int layoutIdx = m_currentLayout.load(std::memory_order_relaxed);
-    TuiLayoutData& layout = m_layouts[layoutIdx];
-
-    // Swap double buffer if dirty
-    int widx = layout.dataWriteIdx.load(std::memory_order_acquire);
-    int ridx = 1 - widx;
+    m_shm = CreateTuiShm(shmName);
+    if (!m_shm)
+    {
+        return false;
+    }
+    CopyStr(m_shmName, shmName, sizeof(m_shmName));
+    return true;
+}
 
-    if (layout.dataBuf[widx].dirty.load(std::memory_order_acquire)) 
+// Rewrites the payload under the seqlock (odd count while writing). Only defined layouts
+// and used rows are touched; raw values are formatted here, plots are sent as a sparkline
+// of TUI_SHM_SPARK_COLS columns plus their statistics.
+void RtTui::PublishSnapshot() noexcept
+{
+    TuiShmSegment &seg = *m_shm;
+    const uint64_t seq = seg.seq.load(std::memory_order_relaxed);
+    seg.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    seg.publishWall_ns = RealtimeNs();
+    seg.frame++;
+
+    // ── log tail: copy only lines not published yet ──
+    const uint64_t avail = std::min<uint64_t>({m_shmLogSeq, (uint64_t)m_history.Total(), (uint64_t)TUI_SHM_LOG_LINES});
+    for (uint64_t s = std::max(m_shmLogPublished, m_shmLogSeq - avail); s < m_shmLogSeq; ++s)
     {
-        layout.dataWriteIdx.store(1 - widx, std::memory_order_release);
-        layout.dataBuf[widx].dirty.store(false, std::memory_order_release);
-        ridx = widx;
+        TuiLogHistory::Line line;
+        if (!m_history.GetRecent((size_t)(m_shmLogSeq - 1 - s), line))
+        {
+            continue;
+        }
+        TuiShmLogLine &dst = seg.log[s % TUI_SHM_LOG_LINES];
+        const size_t   n   = std::min<size_t>(line.len, TUI_SHM_LOG_LEN - 1);
+        dst.seq        = s;
+        dst.level      = line.level;
+        dst.len        = (uint16_t)n;
+        dst.colorStart = (uint16_t)std::min<size_t>(line.colorStart, n);
+        dst.colorEnd   = (uint16_t)std::min<size_t>(line.colorEnd, n);
+        memcpy(dst.text, line.text, n);
+        dst.text[n] = '\0';
+        CopyStr(dst.logger, m_history.LoggerName(line.logger), sizeof(dst.logger));
     }
+    m_shmLogPublished = m_shmLogSeq;
+    seg.logSeqEnd     = m_shmLogSeq;
+    seg.logCount      = (uint32_t)avail;
 
-    const TuiDataBuffer& buf = layout.dataBuf[ridx];
+    // ── Area 1 layouts ──
+    for (int L = 0; L < MAX_LAYOUTS; ++L)
+    {
+        TuiLayoutData &layout = m_layouts[L];
+        TuiShmLayout  &sl     = seg.layouts[L];
+        sl.defined = layout.defined;
+        if (!layout.defined)
+        {
+            continue;
+        }
+        CopyStr(sl.name, layout.name, sizeof(sl.name));
+
+        const TuiDataBuffer &buf = FrontBuffer(layout);
+        for (int g = 0; g < (int)TUI_MAX_GROUPS; ++g)
+        {
+            const TuiGroupHeader &gh = layout.groupHeaders[g];
+            TuiShmGroupHeader    &sh = sl.headers[g];
+            sh.active     = gh.active;
+            sh.hideHeader = gh.hideHeader;
+            sh.ncols      = (uint8_t)std::min(std::max(gh.ncols, 0), TUI_MAX_COLS);
+            CopyStr(sh.label, gh.label, sizeof(sh.label));
+            for (int c = 0; c < sh.ncols; ++c)
+            {
+                CopyStr(sh.cols[c], gh.cols[c], sizeof(sh.cols[c]));
+            }
+            if (!gh.active)
+            {
+                sl.nrows[g] = 0;
+                continue;
+            }
+
+            const TuiGroupRowData &gd = buf.groups[g];
+            const int nrows = std::min(std::max(gd.nrows, layout.plotRows[g]), (int)TUI_MAX_ROWS_PER_GROUP);
+            sl.nrows[g] = nrows;
+            for (int r = 0; r < nrows; ++r)
+            {
+                TuiShmRow &dst = sl.rows[g][r];
+
+                const TuiPlot *plot = layout.plotRef[g][r] ? m_plots[layout.plotRef[g][r] - 1].load(std::memory_order_acquire) : nullptr;
+                const TuiDataRow &dr = gd.rows[r];
+                if (plot || dr.plotMode)
+                {
+                    const TuiPlotStats st = plot ? plot->GetStats() : dr.plot;
+                    dst.kind     = TuiShmRow::PLOT;
+                    dst.stats[0] = st.last;
+                    dst.stats[1] = st.min;
+                    dst.stats[2] = st.max;
+                    dst.stats[3] = st.mean;
+                    dst.stats[4] = st.p99;
+                    dst.samples  = st.samples;
+                    CopyStr(dst.label, plot ? plot->Label() : dr.label, sizeof(dst.label));
+                    if (plot)
+                    {
+                        plot->RenderSpark(dst.text, sizeof(dst.text), TUI_SHM_SPARK_COLS);
+                    }
+                    else
+                    {
+                        CopyStr(dst.text, dr.text, sizeof(dst.text));
+                    }
+                    continue;
+                }
+
+                CopyStr(dst.label, dr.label, sizeof(dst.label));
+                if (dr.textMode)
+                {
+                    dst.kind = TuiShmRow::TEXT;
+                    CopyStr(dst.text, dr.text, sizeof(dst.text));
+                    continue;
+                }
+
+                dst.kind  = (dr.ncols > 0 || dr.label[0]) ? TuiShmRow::DATA : TuiShmRow::EMPTY;
+                dst.ncols = (uint8_t)std::min(std::max(dr.ncols, 0), TUI_MAX_COLS);
+                for (int c = 0; c < dst.ncols; ++c)
+                {
+                    if (dr.rawMode)
+                    {
+                        FormatVal(dst.col[c], sizeof(dst.col[c]), dr.vals[c]);
+                    }
+                    else
+                    {
+                        CopyStr(dst.col[c], dr.col[c], sizeof(dst.col[c]));
+                    }
+                }
+            }
+        }
+    }
+
+    seg.seq.store(seq + 2, std::memory_order_release);
+}
+
+// ───────────────────────────────────────────────
+// Shared-memory snapshot: viewer
+// ───────────────────────────────────────────────
+bool RtTui::AttachSnapshot(const char *shmName)
+{
+    if (!shmName || shmName[0] != '/' || strlen(shmName) >= sizeof(m_attachName))
+    {
+        return false;
+    }
+    if (!m_attachCopy)
+    {
+        m_attachCopy.reset(new (std::nothrow) TuiShmSegment());
+        if (!m_attachCopy)
+        {
+            return false;
+        }
+    }
+
+    CopyStr(m_attachName, shmName, sizeof(m_attachName));
+    m_attached = OpenTuiShm(shmName);   // missing publisher: retried by Tick()
+    return true;
+}
+
+void RtTui::ImportSnapshot() noexcept
+{
+    const int64_t now_ns = dt::Utils::MonotonicNs();
+    const bool    stale  = (now_ns - m_attachFrame_ns) > ATTACH_STALE_NS;
+
+    // (re)attach: publisher not started yet, restarted (new segment) or gone
+    if ((!m_attached || stale) && now_ns - m_attachRetry_ns >= ATTACH_STALE_NS)
+    {
+        m_attachRetry_ns = now_ns;
+        const TuiShmSegment *seg = OpenTuiShm(m_attachName);
+        if (seg && (!m_attached || seg->pid != m_attachPid || seg->instance != m_attachInstance))
+        {
+            CloseTuiShm(m_attached);
+            m_attached       = seg;
+            m_attachPid      = seg->pid;
+            m_attachInstance = seg->instance;
+            m_attachLogSeq = 0;
+            m_attachFrame  = 0;
+        }
+        else
+        {
+            CloseTuiShm(seg);
+        }
+    }
+
+    if (!m_attached)
+    {
+        snprintf(m_attachStatus, sizeof(m_attachStatus), "[%s: waiting for publisher]", m_attachName);
+        return;
+    }
+
+    TuiShmSegment &snap = *m_attachCopy;
+    if (!ReadTuiShm(m_attached, snap))
+    {
+        return;   // publisher busy writing: next Tick
+    }
+    m_attachPid = snap.pid;
+    if (snap.frame != m_attachFrame)
+    {
+        m_attachFrame    = snap.frame;
+        m_attachFrame_ns = now_ns;
+    }
+
+    if (stale)
+    {
+        const bool alive = (kill(snap.pid, 0) == 0 || errno != ESRCH);
+        snprintf(m_attachStatus, sizeof(m_attachStatus), "[%s pid %d: %s, last update %.0f s ago]",
+                 m_attachName, (int)snap.pid, alive ? "not publishing" : "exited",
+                 (double)(RealtimeNs() - snap.publishWall_ns) / 1e9);
+    }
+    else
+    {
+        snprintf(m_attachStatus, sizeof(m_attachStatus), "[%s pid %d]", m_attachName, (int)snap.pid);
+    }
+
+    // ── Area 1: rewrite every row of the write half (swapped in by RenderArea1) ──
+    for (int L = 0; L < MAX_LAYOUTS; ++L)
+    {
+        const TuiShmLayout &sl     = snap.layouts[L];
+        TuiLayoutData      &layout = m_layouts[L];
+        layout.defined = sl.defined;
+        if (!sl.defined)
+        {
+            continue;
+        }
+        CopyStr(layout.name, sl.name, sizeof(layout.name));
+
+        TuiDataBuffer &dbuf = layout.dataBuf[layout.dataWriteIdx.load(std::memory_order_relaxed)];
+        for (int g = 0; g < (int)TUI_MAX_GROUPS; ++g)
+        {
+            const TuiShmGroupHeader &sh = sl.headers[g];
+            TuiGroupHeader          &gh = layout.groupHeaders[g];
+            gh.active     = sh.active;
+            gh.hideHeader = sh.hideHeader;
+            gh.ncols      = std::min((int)sh.ncols, TUI_MAX_COLS);
+            CopyStr(gh.label, sh.label, sizeof(gh.label));
+            for (int c = 0; c < gh.ncols; ++c)
+            {
+                CopyStr(gh.cols[c], sh.cols[c], sizeof(gh.cols[c]));
+            }
+
+            TuiGroupRowData &gd = dbuf.groups[g];
+            gd.nrows = std::min(std::max(sl.nrows[g], 0), (int)TUI_MAX_ROWS_PER_GROUP);
+            for (int r = 0; r < gd.nrows; ++r)
+            {
+                const TuiShmRow &src = sl.rows[g][r];
+                TuiDataRow      &dr  = gd.rows[r];
+                CopyStr(dr.label, src.label, sizeof(dr.label));
+                dr.textMode = (src.kind == TuiShmRow::TEXT);
+                dr.plotMode = (src.kind == TuiShmRow::PLOT);
+                dr.rawMode  = false;
+                dr.ncols    = (src.kind == TuiShmRow::DATA) ? std::min((int)src.ncols, TUI_MAX_COLS) : 0;
+                for (int c = 0; c < dr.ncols; ++c)
+                {
+                    CopyStr(dr.col[c], src.col[c], sizeof(dr.col[c]));
+                }
+                if (dr.textMode || dr.plotMode)
+                {
+                    CopyStr(dr.text, src.text, sizeof(dr.text));
+                }
+                if (dr.plotMode)
+                {
+                    dr.plot.last    = src.stats[0];
+                    dr.plot.min     = src.stats[1];
+                    dr.plot.max     = src.stats[2];
+                    dr.plot.mean    = src.stats[3];
+                    dr.plot.p99     = src.stats[4];
+                    dr.plot.samples = src.samples;
+                }
+            }
+        }
+        dbuf.dirty.store(true, std::memory_order_release);
+    }
+
+    // ── Area 2: append log lines not seen yet ──
+    if (m_attachLogSeq > snap.logSeqEnd)
+    {
+        m_attachLogSeq = 0;
+    }
+    for (uint64_t s = std::max(m_attachLogSeq, snap.logSeqEnd - snap.logCount); s < snap.logSeqEnd; ++s)
+    {
+        const TuiShmLogLine &ln = snap.log[s % TUI_SHM_LOG_LINES];
+        if (ln.seq != s)
+        {
+            continue;
+        }
+        if (!m_history.AppendStripped(ln.level, ln.logger, ln.text, std::min<size_t>(ln.len, TUI_SHM_LOG_LEN - 1),
+                                      ln.colorStart, ln.colorEnd))
+        {
+            continue;
+        }
+        if (m_autoScroll)
+        {
+            m_scrollOffset = 0;
+        }
+        else
+        {
+            m_scrollOffset++;
+        }
+        m_anchorOffset++;
+    }
+    m_attachLogSeq = snap.logSeqEnd;
+}
+
+// ───────────────────────────────────────────────
+// Area 1: multi-group data monitor
+// ───────────────────────────────────────────────
+void RtTui::RenderArea1(int startRow, int height, int width) 
+{
+    if (height < 4)
+    {
+        return;
+    }
+
+    int layoutIdx = m_currentLayout.load(std::memory_order_relaxed);
+    TuiLayoutData& layout = m_layouts[layoutIdx];
+    const TuiDataBuffer& buf = FrontBuffer(layout);
 
     // Column width: label 21 chars + 2 border + 12 per data column
     int maxColsFit = (width - 23) / 12;
@@ -607,9 +1410,25 @@ void RtTui::RenderArea1(int startRow, int height, int width)
 
         // ── data rows ──
         const TuiGroupRowData& gdata = buf.groups[g];
-        for (int r = 0; r < gdata.nrows && cur < bot; ++r) 
+        const int nrows = std::max(gdata.nrows, layout.plotRows[g]);
+        for (int r = 0; r < nrows && cur < bot; ++r) 
         {
+            if (layout.plotRef[g][r])
+            {
+                TuiPlot *plot = m_plots[layout.plotRef[g][r] - 1].load(std::memory_order_acquire);
+                if (plot)
+                {
+                    RenderPlotRow(cur++, width, plot->Label(), plot->GetStats(), plot, nullptr);
+                    continue;
+                }
+            }
+
             const TuiDataRow& dr = gdata.rows[r];
+            if (dr.plotMode)
+            {
+                RenderPlotRow(cur++, width, dr.label, dr.plot, nullptr, dr.text);
+                continue;
+            }
             SafeSnprintf("\x1b[%d;1H%s│%s", cur, ansi::FG_CYAN, ansi::RESET);
             SafeSnprintf(" %s%-20s%s", ansi::FG_WHITE, dr.label, ansi::RESET);
             AppendData_str("\x1b[K");  // erase from end-of-label to EOL before writing content
@@ -624,11 +1443,18 @@ void RtTui::RenderArea1(int startRow, int height, int width)
             }
             else
             {
+                char rawBuf[TUI_DATA_COL_LEN];
                 for (int ci = 0; ci < maxColsFit; ++ci)
                 {
                     if (ci < dr.ncols)
                     {
-                        SafeSnprintf(" %s%11s%s", ansi::FG_WHITE, dr.col[ci], ansi::RESET);
+                        const char *cell = dr.col[ci];
+                        if (dr.rawMode)
+                        {
+                            FormatVal(rawBuf, sizeof(rawBuf), dr.vals[ci]);   // deferred from SetRowVals()
+                            cell = rawBuf;
+                        }
+                        SafeSnprintf(" %s%11s%s", ansi::FG_WHITE, cell, ansi::RESET);
                     }
                     else
                     {
@@ -658,6 +1484,75 @@ void RtTui::RenderArea1(int startRow, int height, int width)
     AppendData_str(ansi::RESET);
 }
 
+// ───────────────────────────────────────────────
+// Area 1: numeric-channel row  │ label  ▁▂▅█▃  min … max … avg … p99 … │
+// ───────────────────────────────────────────────
+void RtTui::RenderPlotRow(int row, int width, const char *label, const TuiPlotStats &st,
+                          const TuiPlot *plot, const char *spark)
+{
+    SafeSnprintf("\x1b[%d;1H%s│%s", row, ansi::FG_CYAN, ansi::RESET);
+    SafeSnprintf(" %s%-20s%s", ansi::FG_WHITE, label, ansi::RESET);
+    AppendData_str("\x1b[K");
+
+    char stats[160];
+    int statsLen;   // visible width (ASCII)
+    if (st.samples == 0)
+    {
+        statsLen = snprintf(stats, sizeof(stats), " (no data)");
+    }
+    else
+    {
+        statsLen = snprintf(stats, sizeof(stats), " %9.4g  min %9.4g  max %9.4g  avg %9.4g  p99 %9.4g",
+                            st.last, st.min, st.max, st.mean, st.p99);
+    }
+
+    int avail    = width - 24;   // between the label and the right border
+    int sparkLen = avail - statsLen - 1;
+    if (sparkLen < 8)
+    {
+        // narrow terminal: sparkline + last value only
+        statsLen = (st.samples == 0) ? statsLen : snprintf(stats, sizeof(stats), " %9.4g", st.last);
+        sparkLen = avail - statsLen - 1;
+    }
+
+    if (sparkLen > 0)
+    {
+        AppendData_str(" ");
+        AppendData_str(ansi::FG_GREEN);
+        if (plot)
+        {
+            char buf[TuiPlot::MAX_COLUMNS * 3 + 1];
+            size_t n = plot->RenderSpark(buf, sizeof(buf), sparkLen);
+            AppendData(buf, n);
+        }
+        else if (spark)
+        {
+            // pre-rendered (one code point per column): keep the newest sparkLen columns
+            int columns = Utf8CodePointCount(spark);
+            for (int i = columns; i < sparkLen; ++i)
+            {
+                AppendData_str(" ");
+            }
+            const char *p = spark;
+            for (int skip = columns - sparkLen; skip > 0 && *p; --skip)
+            {
+                do
+                {
+                    ++p;
+                } while ((*p & 0xC0) == 0x80);
+            }
+            AppendData_str(p);
+        }
+        AppendData_str(ansi::RESET);
+    }
+    if (statsLen > 0 && statsLen < avail)
+    {
+        SafeSnprintf("%s%s%s", ansi::FG_WHITE, stats, ansi::RESET);
+    }
+
+    SafeSnprintf("\x1b[%d;%dH%s│%s", row, width, ansi::FG_CYAN, ansi::RESET);
+}
+
 // ───────────────────────────────────────────────
 // Area 2: log scroll view
 // ───────────────────────────────────────────────
@@ -669,7 +1564,18 @@ void RtTui::RenderArea2(int startRow, int height, int width)
     }
 
     size_t visibleH = (size_t)(height - 2);
-    size_t total     = m_logCount;
+    size_t total     = m_history.Size();
+
+    // a search hit: pause and center the matching line
+    const bool hasMatch = m_history.GetSearchState() == TuiLogHistory::SearchState::found;
+    const size_t match  = m_history.SearchMatch();
+    if (m_followMatch && hasMatch && match < total)
+    {
+        size_t fromBottom = total - 1 - match;
+        m_scrollOffset = (fromBottom > visibleH / 2) ? fromBottom - visibleH / 2 : 0;
+        m_autoScroll   = false;
+    }
+    m_followMatch = false;
 
     // Maximum valid offset: oldest available message sits at the top of the viewport.
     // Setting offset beyond this would make endIdx go to 0 and show nothing.
@@ -682,7 +1588,19 @@ void RtTui::RenderArea2(int startRow, int height, int width)
 
     // ── top border ──
     const char* titleColor = m_autoScroll ? ansi::FG_CYAN : ansi::FG_YELLOW;
-    const char* titleText  = m_autoScroll ? "─[ LOG : AUTO SCROLL ]─" : "─[ LOG : PAUSED      ]─";
+    char titleText[160];
+    if (m_history.Filtered())
+    {
+        char filter[96];
+        m_history.DescribeFilter(filter, sizeof(filter));
+        snprintf(titleText, sizeof(titleText), "─[ LOG : %s | %s  %zu/%zu ]─",
+                 m_autoScroll ? "AUTO SCROLL" : "PAUSED     ", filter, total, m_history.Total());
+    }
+    else
+    {
+        snprintf(titleText, sizeof(titleText), "%s",
+                 m_autoScroll ? "─[ LOG : AUTO SCROLL ]─" : "─[ LOG : PAUSED      ]─");
+    }
 
     SafeSnprintf("\x1b[%d;1H%s%s┌%s%s%s",
                   startRow, ansi::BOLD, ansi::FG_CYAN,
@@ -700,11 +1618,10 @@ void RtTui::RenderArea2(int startRow, int height, int width)
         SafeSnprintf("\x1b[%d;1H%s│%s", screen_row, ansi::FG_CYAN, ansi::RESET);
         AppendData_str("\x1b[K");  // erase from col 2 to EOL before writing message
 
-        if (r < linesToShow)
+        TuiLogHistory::Line line;
+        if (r < linesToShow && m_history.GetLine(startIdx + r, line))
         {
-            const TuiLogEntry& e = m_logHistory[(m_logHead + startIdx + r) % LOG_KEEP];
-            int maxMsg = width - 4;
-            SafeSnprintf(" %.*s", maxMsg, e.msg);
+            RenderLogLine(line, width - 4, hasMatch && startIdx + r == match);
         }
 
         AppendData_str(ansi::RESET);
@@ -718,13 +1635,49 @@ void RtTui::RenderArea2(int startRow, int height, int width)
     SafeSnprintf("\x1b[%d;1H%s└", startRow + height - 1, ansi::FG_CYAN);
     AppendData_hbar(width - 2);
 
-    const char* hint = " ↑↓:Line  PgUp/PgDn:Page ";
+    const char* hint = " ↑↓:Line  PgUp/PgDn:Page  /:Search ";
     int hint_cols = Utf8CodePointCount(hint);
     int hint_col = std::max(2, width - 1 - hint_cols);
     SafeSnprintf("\x1b[%d;%dH%s%s", startRow + height - 1, hint_col, ansi::FG_GRAY, hint);
     SafeSnprintf("\x1b[%d;%dH%s─┘%s", startRow + height - 1, width - 1, ansi::FG_CYAN, ansi::RESET);
 }
 
+// One history line: the prefix span keeps its level colour, the search hit is reversed
+void RtTui::RenderLogLine(const TuiLogHistory::Line &line, int maxCols, bool highlight)
+{
+    // clip to maxCols code points
+    size_t cut  = 0;
+    int    cols = 0;
+    while (cut < line.len)
+    {
+        if ((line.text[cut] & 0xC0) != 0x80)
+        {
+            if (cols == maxCols)
+            {
+                break;
+            }
+            ++cols;
+        }
+        ++cut;
+    }
+
+    if (highlight)
+    {
+        SafeSnprintf(" \x1b[7m%.*s", (int)cut, line.text);
+        return;
+    }
+
+    const size_t cs = std::min<size_t>(line.colorStart, cut);
+    const size_t ce = std::min<size_t>(line.colorEnd, cut);
+    SafeSnprintf(" %.*s", (int)cs, line.text);
+    if (ce > cs)
+    {
+        SafeSnprintf("%s%.*s%s", SinkColorFor((spdlog::level::level_enum)line.level),
+                     (int)(ce - cs), line.text + cs, ansi::RESET);
+    }
+    SafeSnprintf("%.*s", (int)(cut - ce), line.text + ce);
+}
+
 // ───────────────────────────────────────────────
 // Scrollbar rendering
 // ───────────────────────────────────────────────
@@ -763,6 +1716,12 @@ void RtTui::HandleKey(const char* buf, ssize_t len)
         page = 1;
     }
 
+    if (m_promptActive)
+    {
+        HandlePromptKey(buf, len);
+        return;
+    }
+
     char c = buf[0];
 
     // ESC sequence
@@ -814,25 +1773,39 @@ void RtTui::HandleKey(const char* buf, ssize_t len)
             }
             break;
 
-        case 'F':  // End
+        case 'F':  // End (also drops the search highlight)
             m_scrollOffset = 0;
             m_autoScroll   = true;
+            m_history.CancelSearch();
             break;
 
         case 'H':  // Home
-            m_scrollOffset = m_logCount;
+            m_scrollOffset = m_history.Size();
             m_autoScroll   = false;
             break;
         }
 
         // Coarse upper-bound clamp (fine clamp against visible height is done in render_area2)
-        if (m_scrollOffset > m_logCount)
+        if (m_scrollOffset > m_history.Size())
         {
-            m_scrollOffset = m_logCount;
+            m_scrollOffset = m_history.Size();
         }
         return;
     }
 
+    // '/': search / filter prompt on the command line
+    if (c == '/')
+    {
+        m_promptActive     = true;
+        m_promptLen        = 0;
+        m_prompt[0]        = '\0';
+        m_promptMsg[0]     = '\0';
+        m_anchorOffset     = m_scrollOffset;
+        m_anchorAutoScroll = m_autoScroll;
+        m_history.CancelSearch();
+        return;
+    }
+
     // Layout switching: keys '[', ']'
     int curr_layout = m_currentLayout.load(std::memory_order_relaxed);
     int new_layout  = curr_layout;
@@ -873,6 +1846,149 @@ void RtTui::HandleKey(const char* buf, ssize_t len)
     }
 }
 
+// ───────────────────────────────────────────────
+// Area 2 prompt: search as you type, Enter accepts / applies a filter, ESC cancels
+// ───────────────────────────────────────────────
+void RtTui::HandlePromptKey(const char* buf, ssize_t len)
+{
+    char c = buf[0];
+
+    if (c == '\x1b')
+    {
+        if (len >= 3 && buf[1] == '[')
+        {
+            if (buf[2] == 'A')       // ↑: older match
+            {
+                StepMatch(true);
+            }
+            else if (buf[2] == 'B')  // ↓: newer match
+            {
+                StepMatch(false);
+            }
+            return;
+        }
+        ClosePrompt(true);
+        return;
+    }
+
+    if (c == '\r' || c == '\n')
+    {
+        AcceptPrompt();
+        return;
+    }
+
+    if (c == 0x7f || c == 0x08)  // Backspace (drops a whole UTF-8 sequence)
+    {
+        if (m_promptLen == 0)
+        {
+            ClosePrompt(true);
+            return;
+        }
+        do
+        {
+            --m_promptLen;
+        } while (m_promptLen > 0 && (m_prompt[m_promptLen] & 0xC0) == 0x80);
+        m_prompt[m_promptLen] = '\0';
+        UpdateSearch();
+        return;
+    }
+
+    if (c == 0x15)  // Ctrl-U
+    {
+        m_promptLen = 0;
+        m_prompt[0] = '\0';
+        UpdateSearch();
+        return;
+    }
+
+    if ((unsigned char)c >= 0x20 && m_promptLen < PROMPT_LEN - 1)
+    {
+        m_prompt[m_promptLen++] = c;
+        m_prompt[m_promptLen]   = '\0';
+        UpdateSearch();
+    }
+}
+
+void RtTui::ClosePrompt(bool cancel)
+{
+    m_promptActive = false;
+    if (cancel)
+    {
+        m_history.CancelSearch();
+        m_scrollOffset = m_anchorOffset;
+        m_autoScroll   = m_anchorAutoScroll;
+    }
+}
+
+void RtTui::AcceptPrompt()
+{
+    if (PromptIsFilter())
+    {
+        bool ok = m_history.ApplyFilter(m_prompt);
+        const char *status = !ok ? "bad filter: " : (m_history.Size() == 0) ? "no match: " : "";
+        snprintf(m_promptMsg, sizeof(m_promptMsg), "%s%s", status, m_prompt);
+        m_promptActive = false;
+        m_scrollOffset = 0;
+        m_autoScroll   = true;
+        return;
+    }
+
+    // keep the match (paused on it); nothing found → back to where the search started
+    auto state = m_history.GetSearchState();
+    ClosePrompt(m_promptLen == 0 || state == TuiLogHistory::SearchState::notFound ||
+                state == TuiLogHistory::SearchState::badPattern);
+}
+
+// Restart the search from the anchor (the bottom line when the prompt was opened),
+// scanning towards older lines
+void RtTui::UpdateSearch()
+{
+    m_scrollOffset = m_anchorOffset;
+    m_autoScroll   = m_anchorAutoScroll;
+
+    size_t total = m_history.Size();
+    if (m_promptLen == 0 || PromptIsFilter() || total == 0)
+    {
+        m_history.CancelSearch();
+        return;
+    }
+
+    size_t anchor = (m_anchorOffset < total) ? total - 1 - m_anchorOffset : 0;
+    m_history.StartSearch(m_prompt, anchor, true);
+    if (m_history.StepSearch(SEARCH_STEP_LINES) == TuiLogHistory::SearchState::found)
+    {
+        m_followMatch = true;
+    }
+}
+
+void RtTui::StepMatch(bool older)
+{
+    if (m_promptLen == 0 || PromptIsFilter() ||
+        m_history.GetSearchState() != TuiLogHistory::SearchState::found)
+    {
+        return;
+    }
+
+    size_t match = m_history.SearchMatch();
+    if (older ? match == 0 : match + 1 >= m_history.Size())
+    {
+        return;
+    }
+
+    m_history.StartSearch(m_prompt, older ? match - 1 : match + 1, older);
+    auto state = m_history.StepSearch(SEARCH_STEP_LINES);
+    if (state == TuiLogHistory::SearchState::found)
+    {
+        m_followMatch = true;
+    }
+    else if (state == TuiLogHistory::SearchState::notFound)
+    {
+        // no further hit in that direction: stay on the current one
+        m_history.StartSearch(m_prompt, match, older);
+        m_history.StepSearch(1);
+    }
+}
+
 // ───────────────────────────────────────────────
 // Command status line (bottom row)
 // ───────────────────────────────────────────────
@@ -906,6 +2022,37 @@ void RtTui::RenderCmdLine(int row, int width)
         }
     }
 
+    if (m_promptActive)
+    {
+        const char *status = "";
+        char found[48] = "";
+        switch (m_history.GetSearchState())
+        {
+        case TuiLogHistory::SearchState::running:    status = "searching..."; break;
+        case TuiLogHistory::SearchState::notFound:   status = "not found";    break;
+        case TuiLogHistory::SearchState::badPattern: status = "bad regex";    break;
+        case TuiLogHistory::SearchState::found:
+            snprintf(found, sizeof(found), "line %zu/%zu  ↑↓:prev/next", m_history.SearchMatch() + 1, m_history.Size());
+            status = found;
+            break;
+        default:
+            if (PromptIsFilter())
+            {
+                status = "Enter:apply filter";
+            }
+            else if (m_promptLen == 0)
+            {
+                status = "text | re:<regex> | level:w+ | logger:a,b | clear";
+            }
+            break;
+        }
+
+        SafeSnprintf("\x1b[%d;1H%s /%s%s\x1b[7m \x1b[0m  %s%s%s\x1b[K",
+                      row, ansi::FG_YELLOW, ansi::RESET, m_prompt,
+                      ansi::FG_GRAY, status, ansi::RESET);
+        return;
+    }
+
     // Last key display
     char keyStr[16];
     char lastKey = m_lastKey.load(std::memory_order_relaxed);
@@ -923,11 +2070,469 @@ void RtTui::RenderCmdLine(int row, int width)
         snprintf(keyStr, sizeof(keyStr), "0x%02X", (unsigned char)lastKey);
     }
 
-    SafeSnprintf("\x1b[%d;1H%s LAYOUTS: %s%s%s  CMD: %s%-10s%s\x1b[K",
+    SafeSnprintf("\x1b[%d;1H%s LAYOUTS: %s%s%s  CMD: %s%-10s%s  %s%s%s\x1b[K",
                   row,
                   ansi::FG_GRAY,
                   ansi::FG_MAGENTA, switcher, ansi::RESET,
-                  ansi::FG_WHITE, keyStr, ansi::RESET);
+                  ansi::FG_WHITE, keyStr, ansi::RESET,
+                  ansi::FG_GRAY, m_attachName[0] ? m_attachStatus : m_promptMsg, ansi::RESET);
+}
+
+// ───────────────────────────────────────────────
+// Shadow screen (damage tracking)
+// ───────────────────────────────────────────────
+void RtTui::ScreenReset(int rows, int cols)
+{
+    m_screenRows = std::max(rows, 1);
+    m_screenCols = std::max(cols, 1);
+    m_screen.assign((size_t)m_screenRows * m_screenCols, TuiCell{});
+    m_front.assign((size_t)m_screenRows * m_screenCols, TuiCell{});
+    m_parser = TuiParser{};
+    m_clearPending = true;
+}
+
+void RtTui::ScreenFeedPending()
+{
+    ScreenFeed(m_outBuf, m_outPos);
+    m_outPos = 0;
+}
+
+// Width of a code point in terminal cells (East Asian wide / emoji ranges → 2).
+// wcwidth() is not used: it depends on the process locale, which is often "C".
+int RtTui::GlyphWidth(uint32_t cp) noexcept
+{
+    // zero-width first: combining marks (U+0300..) lie below the narrow fast path
+    if ((cp >= 0x0300 && cp <= 0x036F) || (cp >= 0x200B && cp <= 0x200F) || (cp >= 0xFE00 && cp <= 0xFE0F))
+    {
+        return 0;
+    }
+    if (cp < 0x1100)
+    {
+        return 1;
+    }
+    if ((cp <= 0x115F) ||
+        (cp >= 0x2E80 && cp <= 0x303E) || (cp >= 0x3041 && cp <= 0x33FF) ||
+        (cp >= 0x3400 && cp <= 0x4DBF) || (cp >= 0x4E00 && cp <= 0x9FFF) ||
+        (cp >= 0xA000 && cp <= 0xA4CF) || (cp >= 0xAC00 && cp <= 0xD7A3) ||
+        (cp >= 0xF900 && cp <= 0xFAFF) || (cp >= 0xFE30 && cp <= 0xFE4F) ||
+        (cp >= 0xFF00 && cp <= 0xFF60) || (cp >= 0xFFE0 && cp <= 0xFFE6) ||
+        (cp >= 0x1F300 && cp <= 0x1F64F) || (cp >= 0x1F900 && cp <= 0x1F9FF) ||
+        (cp >= 0x20000 && cp <= 0x3FFFD))
+    {
+        return 2;
+    }
+    return 1;
+}
+
+// Interprets the subset of VT100 that Render*() emits: printable UTF-8, TAB,
+// CUP (ESC[r;cH), EL (ESC[K), ED (ESC[2J) and SGR (ESC[...m). Other sequences
+// and C0 controls are ignored. Parser state survives across calls.
+void RtTui::ScreenFeed(const char *s, size_t len)
+{
+    TuiParser &p = m_parser;
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned char ch = (unsigned char)s[i];
+        switch (p.state)
+        {
+        case TuiParser::GROUND:
+            if (ch == 0x1b)
+            {
+                p.state = TuiParser::ESC;
+                p.utf8Need = 0;
+            }
+            else if (ch == '\t')
+            {
+                int next = std::min((p.col / 8 + 1) * 8, m_screenCols);
+                while (p.col < next)
+                {
+                    ScreenPut(" ", 1, 1);
+                }
+            }
+            else if (ch < 0x20 || ch == 0x7f)
+            {
+                // C0 controls (CR/LF from log messages, ...) would move the real cursor
+                // off the layout; they are dropped.
+            }
+            else if (ch < 0x80)
+            {
+                p.utf8Need = 0;
+                ScreenPut(reinterpret_cast<const char *>(&s[i]), 1, 1);
+            }
+            else if ((ch & 0xC0) == 0x80)
+            {
+                if (p.utf8Need == 0)
+                {
+                    break;  // stray continuation byte
+                }
+                p.utf8[p.utf8Len++] = (char)ch;
+                p.codePoint = (p.codePoint << 6) | (ch & 0x3F);
+                if (--p.utf8Need == 0)
+                {
+                    int w = GlyphWidth(p.codePoint);
+                    if (w > 0)
+                    {
+                        ScreenPut(p.utf8, p.utf8Len, w);
+                    }
+                }
+            }
+            else
+            {
+                p.utf8Need  = (ch >= 0xF0) ? 3 : (ch >= 0xE0) ? 2 : 1;
+                p.codePoint = ch & ((ch >= 0xF0) ? 0x07 : (ch >= 0xE0) ? 0x0F : 0x1F);
+                p.utf8[0]   = (char)ch;
+                p.utf8Len   = 1;
+            }
+            break;
+
+        case TuiParser::ESC:
+            if (ch == '[')
+            {
+                p.state  = TuiParser::CSI;
+                p.csiLen = 0;
+            }
+            else
+            {
+                p.state = TuiParser::GROUND;
+            }
+            break;
+
+        case TuiParser::CSI:
+            if (ch >= 0x40 && ch <= 0x7E)
+            {
+                p.csi[p.csiLen] = '\0';
+                ScreenCsi((char)ch);
+                p.state = TuiParser::GROUND;
+            }
+            else if (p.csiLen < sizeof(p.csi) - 1)
+            {
+                p.csi[p.csiLen++] = (char)ch;
+            }
+            break;
+        }
+    }
+}
+
+void RtTui::ScreenCsi(char final)
+{
+    TuiParser &p = m_parser;
+    if (p.csi[0] == '?' || p.csi[0] == '>' || p.csi[0] == '=')
+    {
+        return;  // private modes (cursor visibility, ...)
+    }
+
+    int params[16];
+    int nparams = 0;
+    int value   = -1;
+    for (size_t i = 0; i <= p.csiLen; ++i)
+    {
+        char c = p.csi[i];
+        if (c >= '0' && c <= '9')
+        {
+            value = (value < 0 ? 0 : value * 10) + (c - '0');
+        }
+        else if (c == ';' || c == ':' || c == '\0')
+        {
+            if (nparams < 16)
+            {
+                params[nparams++] = value;
+            }
+            value = -1;
+        }
+    }
+    auto param = [&](int idx, int def) { return (idx < nparams && params[idx] > 0) ? params[idx] : def; };
+
+    switch (final)
+    {
+    case 'H':
+    case 'f':
+        p.row = std::min(param(0, 1), m_screenRows) - 1;
+        p.col = std::min(param(1, 1), m_screenCols) - 1;
+        break;
+    case 'A': p.row = std::max(p.row - param(0, 1), 0); break;
+    case 'B': p.row = std::min(p.row + param(0, 1), m_screenRows - 1); break;
+    case 'C': p.col = std::min(p.col + param(0, 1), m_screenCols - 1); break;
+    case 'D': p.col = std::max(std::min(p.col, m_screenCols - 1) - param(0, 1), 0); break;
+    case 'K':
+    {
+        int mode = (nparams > 0 && params[0] > 0) ? params[0] : 0;
+        int col  = std::min(p.col, m_screenCols - 1);
+        if (mode == 0)      ScreenErase(p.row, col, m_screenCols);
+        else if (mode == 1) ScreenErase(p.row, 0, col + 1);
+        else                ScreenErase(p.row, 0, m_screenCols);
+        break;
+    }
+    case 'J':
+        if (nparams > 0 && params[0] >= 2)
+        {
+            for (int r = 0; r < m_screenRows; ++r)
+            {
+                ScreenErase(r, 0, m_screenCols);
+            }
+        }
+        break;
+    case 'm':
+        ScreenSgr(params, nparams);
+        break;
+    default:
+        break;
+    }
+}
+
+void RtTui::ScreenSgr(const int *params, int nparams)
+{
+    TuiCell &pen = m_parser.pen;
+    for (int i = 0; i < nparams; ++i)
+    {
+        int v = params[i] < 0 ? 0 : params[i];
+        if (v == 0)                   { pen.attr = 0; pen.fg = 0; pen.bg = 0; }
+        else if (v == 1)              pen.attr |= ATTR_BOLD;
+        else if (v == 2)              pen.attr |= ATTR_DIM;
+        else if (v == 3)              pen.attr |= ATTR_ITALIC;
+        else if (v == 4)              pen.attr |= ATTR_UNDERLINE;
+        else if (v == 7)              pen.attr |= ATTR_REVERSE;
+        else if (v == 22)             pen.attr &= ~(ATTR_BOLD | ATTR_DIM);
+        else if (v == 23)             pen.attr &= ~ATTR_ITALIC;
+        else if (v == 24)             pen.attr &= ~ATTR_UNDERLINE;
+        else if (v == 27)             pen.attr &= ~ATTR_REVERSE;
+        else if (v >= 30 && v <= 37)  pen.fg = (uint16_t)(v - 30 + 1);
+        else if (v >= 90 && v <= 97)  pen.fg = (uint16_t)(v - 90 + 8 + 1);
+        else if (v == 39)             pen.fg = 0;
+        else if (v >= 40 && v <= 47)  pen.bg = (uint16_t)(v - 40 + 1);
+        else if (v >= 100 && v <= 107) pen.bg = (uint16_t)(v - 100 + 8 + 1);
+        else if (v == 49)             pen.bg = 0;
+        else if (v == 38 || v == 48)
+        {
+            // 256-colour (38;5;n) is kept; true colour (38;2;r;g;b) falls back to default
+            uint16_t &target = (v == 38) ? pen.fg : pen.bg;
+            if (i + 2 < nparams && params[i + 1] == 5)
+            {
+                target = (uint16_t)((params[i + 2] & 0xFF) + 1);
+                i += 2;
+            }
+            else if (i + 1 < nparams && params[i + 1] == 2)
+            {
+                target = 0;
+                i += 4;
+            }
+        }
+    }
+}
+
+void RtTui::ScreenPut(const char *glyph, uint8_t len, int width)
+{
+    TuiParser &p = m_parser;
+    if (p.row < 0 || p.row >= m_screenRows || p.col >= m_screenCols)
+    {
+        return;  // no autowrap: the layout never relies on it
+    }
+
+    TuiCell *row = &m_screen[(size_t)p.row * m_screenCols];
+    if (width == 2 && p.col == m_screenCols - 1)
+    {
+        glyph = " ";
+        len   = 1;
+        width = 1;
+    }
+
+    // overwriting one half of a wide glyph blanks the other half
+    if (row[p.col].len == 0 && p.col > 0)
+    {
+        row[p.col - 1].glyph[0] = ' ';
+        row[p.col - 1].len      = 1;
+    }
+    int last = p.col + width - 1;
+    if (last + 1 < m_screenCols && row[last + 1].len == 0)
+    {
+        row[last + 1].glyph[0] = ' ';
+        row[last + 1].len      = 1;
+    }
+
+    TuiCell &cell = row[p.col];
+    cell = p.pen;
+    memset(cell.glyph, 0, sizeof(cell.glyph));
+    memcpy(cell.glyph, glyph, len);
+    cell.len = len;
+    if (width == 2)
+    {
+        row[p.col + 1] = p.pen;
+        memset(row[p.col + 1].glyph, 0, sizeof(row[p.col + 1].glyph));
+        row[p.col + 1].len = 0;
+    }
+    p.col += width;
+}
+
+void RtTui::ScreenErase(int row, int from, int to)
+{
+    if (row < 0 || row >= m_screenRows)
+    {
+        return;
+    }
+    TuiCell blank{};
+    blank.bg = m_parser.pen.bg;  // erase uses the current background (bce)
+    TuiCell *cells = &m_screen[(size_t)row * m_screenCols];
+    if (from > 0 && cells[from].len == 0)
+    {
+        cells[from - 1] = blank;
+    }
+    if (to < m_screenCols && cells[to].len == 0)
+    {
+        cells[to] = blank;
+    }
+    std::fill(cells + from, cells + to, blank);
+}
+
+void RtTui::AppendSgr(const TuiCell &cell)
+{
+    char buf[64];
+    size_t n = 0;
+    auto put = [&](const char *str) { while (*str) buf[n++] = *str++; };
+    auto color = [&](uint16_t c, int base, int brightBase, const char *ext) {
+        char tmp[16];
+        int idx = c - 1;
+        if (idx < 8)       snprintf(tmp, sizeof(tmp), ";%d", base + idx);
+        else if (idx < 16) snprintf(tmp, sizeof(tmp), ";%d", brightBase + idx - 8);
+        else               snprintf(tmp, sizeof(tmp), ";%s;5;%d", ext, idx);
+        put(tmp);
+    };
+
+    put("\x1b[0");
+    if (cell.attr & ATTR_BOLD)      put(";1");
+    if (cell.attr & ATTR_DIM)       put(";2");
+    if (cell.attr & ATTR_ITALIC)    put(";3");
+    if (cell.attr & ATTR_UNDERLINE) put(";4");
+    if (cell.attr & ATTR_REVERSE)   put(";7");
+    if (cell.fg) color(cell.fg, 30, 90, "38");
+    if (cell.bg) color(cell.bg, 40, 100, "48");
+    put("m");
+    AppendData(buf, n);
+}
+
+// Emits the difference between m_screen and m_front, then m_front := m_screen.
+// Unchanged rows are skipped with one memcmp; inside a changed row, runs of changed
+// cells are written after a single cursor move, short unchanged gaps (DIFF_MAX_GAP)
+// are re-sent instead of a new cursor move, and a blank tail becomes ESC[K.
+void RtTui::ScreenDiff()
+{
+    const int rows = m_screenRows;
+    const int cols = m_screenCols;
+    const TuiCell blank{};
+    uint64_t cellsOut = 0;
+
+    if (m_clearPending)
+    {
+        AppendData_str(ansi::RESET);
+        AppendData_str(ansi::CLEAR_SCREEN);
+        std::fill(m_front.begin(), m_front.end(), blank);
+        m_clearPending = false;
+    }
+
+    int curRow = -1, curCol = -1;   // terminal cursor, -1 = unknown
+    bool penKnown = false;
+    TuiCell pen{};
+
+    auto setPen = [&](const TuiCell &c) {
+        if (!penKnown || c.attr != pen.attr || c.fg != pen.fg || c.bg != pen.bg)
+        {
+            AppendSgr(c);
+            pen = c;
+            penKnown = true;
+        }
+    };
+
+    for (int r = 0; r < rows; ++r)
+    {
+        TuiCell *back  = &m_screen[(size_t)r * cols];
+        TuiCell *front = &m_front[(size_t)r * cols];
+        if (memcmp(back, front, sizeof(TuiCell) * cols) == 0)
+        {
+            continue;
+        }
+
+        // cells from blankFrom to the end of the row are default blanks
+        int blankFrom = cols;
+        while (blankFrom > 0 && SameCell(back[blankFrom - 1], blank))
+        {
+            --blankFrom;
+        }
+
+        int c = 0;
+        while (c < cols)
+        {
+            if (SameCell(back[c], front[c]))
+            {
+                ++c;
+                continue;
+            }
+
+            // run [start, end]: changed cells joined across gaps of <= DIFF_MAX_GAP
+            int start = c;
+            while (start > 0 && back[start].len == 0)
+            {
+                --start;    // right half of a wide glyph: start at its left half
+            }
+            int end = c, gap = 0;
+            for (int k = c + 1; k < cols && gap <= DIFF_MAX_GAP; ++k)
+            {
+                if (SameCell(back[k], front[k]))
+                {
+                    ++gap;
+                }
+                else
+                {
+                    end = k;
+                    gap = 0;
+                }
+            }
+
+            if (curRow != r || curCol != start)
+            {
+                char cup[24];
+                int n = snprintf(cup, sizeof(cup), "\x1b[%d;%dH", r + 1, start + 1);
+                AppendData(cup, (size_t)n);
+            }
+
+            int k = start;
+            for (; k <= end; ++k)
+            {
+                if (k >= blankFrom && cols - k > 3)
+                {
+                    setPen(blank);
+                    AppendData("\x1b[K", 3);
+                    break;
+                }
+                const TuiCell &cell = back[k];
+                if (cell.len == 0)
+                {
+                    continue;   // covered by the wide glyph on its left
+                }
+                setPen(cell);
+                AppendData(cell.glyph, cell.len);
+                ++cellsOut;
+            }
+
+            if (k <= end)
+            {
+                curCol = -1;    // ESC[K: rest of the row done
+                break;
+            }
+            curRow = r;
+            curCol = end + 1;
+            if (end + 1 < cols && back[end + 1].len == 0)
+            {
+                curCol = -1;    // a wide glyph ending the run moved the cursor one further
+            }
+            c = end + 1;
+        }
+
+        memcpy(front, back, sizeof(TuiCell) * cols);
+    }
+
+    if (penKnown && (pen.attr || pen.fg || pen.bg))
+    {
+        AppendData_str(ansi::RESET);
+    }
+    m_statCells.fetch_add(cellsOut, std::memory_order_relaxed);
 }
 
 // ───────────────────────────────────────────────
@@ -937,7 +2542,14 @@ void RtTui::AppendData(const char* s, size_t len)
 {
     if (m_outPos + len >= OUT_BUF_SIZE)
     {
-        FlushOutput();
+        if (m_composing)
+        {
+            ScreenFeedPending();
+        }
+        else
+        {
+            FlushOutput();
+        }
     }
 
     size_t n = std::min(len, (OUT_BUF_SIZE - m_outPos));
@@ -1002,7 +2614,9 @@ void RtTui::FlushOutput()
                 const char* errstr = strerror_r(errno, errbuf, sizeof(errbuf));
                 LOG(err).printf("[TUI] write failed (%s): dropped %zu bytes", errstr, m_outPos - written);
             }
-            m_outPos = written;
+            // The terminal state is unknown now: repaint from a cleared screen.
+            m_outPos = 0;
+            m_clearPending = true;
 
             return;
         }
@@ -1014,6 +2628,7 @@ void RtTui::FlushOutput()
 
         written += (size_t)n;
     }
+    m_statBytes.fetch_add(written, std::memory_order_relaxed);
 
     size_t remaining = m_outPos - written;
     if (remaining > 0 && written > 0)
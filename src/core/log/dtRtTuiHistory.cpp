@@ -0,0 +1,809 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <regex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "dtCore/src/dtLog/dtRtTuiHistory.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+struct TuiLogHistory::SearchRegex
+{
+    std::regex re;
+};
+
+// ─── SeqList ────────────────────────────────────────────────────────────────
+
+void TuiLogHistory::SeqList::Push(uint32_t seq) noexcept
+{
+    try
+    {
+        seqs.push_back(seq);
+    }
+    catch (...)
+    {
+        // out of memory: the line stays in the arena but is not indexed
+    }
+}
+
+template<typename Pred>
+void TuiLogHistory::SeqList::Trim(Pred &&alive) noexcept
+{
+    while (head < seqs.size() && !alive(seqs[head]))
+    {
+        ++head;
+    }
+    // compact once the dead prefix dominates (amortized O(1) per line)
+    if (head >= 1024 && head * 2 >= seqs.size())
+    {
+        seqs.erase(seqs.begin(), seqs.begin() + static_cast<std::ptrdiff_t>(head));
+        head = 0;
+    }
+}
+
+// ─── TuiLogHistory ──────────────────────────────────────────────────────────
+
+TuiLogHistory::TuiLogHistory() = default;
+
+TuiLogHistory::~TuiLogHistory()
+{
+    Release();
+}
+
+bool TuiLogHistory::Init(const TuiHistoryConfig &cfg, const dt::Utils::RtMemOptions &memOpt) noexcept
+{
+    Release();
+
+    // record offsets are 32-bit
+    const size_t cap = std::min(std::max(cfg.bytes, static_cast<size_t>(64u << 10)), static_cast<size_t>(0xFFFFFFF0u));
+
+    if (cfg.file && cfg.file[0])
+    {
+        const int fd = open(cfg.file, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0)
+        {
+            void *p = MAP_FAILED;
+            if (ftruncate(fd, static_cast<off_t>(cap)) == 0)
+            {
+                p = mmap(nullptr, cap, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            if (p != MAP_FAILED)
+            {
+                m_fileFd  = fd;
+                m_fileMap = p;
+                m_arena   = static_cast<char *>(p);
+            }
+            else
+            {
+                close(fd);
+            }
+        }
+        // fall back to anonymous memory below
+    }
+
+    if (!m_arena)
+    {
+        if (!dt::Utils::AllocRtMem(cap, memOpt, m_mem))
+        {
+            return false;
+        }
+        m_arena = static_cast<char *>(m_mem.ptr);
+    }
+    m_cap      = cap;
+    // power of two so that seq & (m_maxLines - 1) stays continuous across the uint32 seq wrap
+    const size_t lines = std::min<size_t>(cap / MIN_LINE_AVG, size_t{1} << 31);
+    m_maxLines = 1;
+    while (m_maxLines * 2 <= lines)
+    {
+        m_maxLines *= 2;
+    }
+
+    try
+    {
+        m_lineOff.assign(m_maxLines, 0);
+        for (SeqList &l : m_levelIdx)
+        {
+            l.seqs.reserve(4096);
+        }
+    }
+    catch (...)
+    {
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void TuiLogHistory::Release() noexcept
+{
+    if (m_fileMap)
+    {
+        (void)munmap(m_fileMap, m_cap);
+        m_fileMap = nullptr;
+    }
+    if (m_fileFd >= 0)
+    {
+        close(m_fileFd);
+        m_fileFd = -1;
+    }
+    dt::Utils::FreeRtMem(m_mem);
+
+    m_arena = nullptr;
+    m_cap   = 0;
+    m_write = 0;
+    m_lineOff.clear();
+    m_maxLines = 0;
+    m_first    = 0;
+    m_next     = 0;
+    for (SeqList &l : m_levelIdx)
+    {
+        l.Clear();
+    }
+    m_view.Clear();
+    CancelSearch();
+}
+
+bool TuiLogHistory::IsFileBacked() const noexcept
+{
+    return m_fileMap != nullptr;
+}
+
+uint8_t TuiLogHistory::InternLogger(const char *name) noexcept
+{
+    if (!name)
+    {
+        name = "";
+    }
+    const int found = FindLogger(name);
+    if (found >= 0)
+    {
+        return static_cast<uint8_t>(found);
+    }
+    if (m_loggerCount >= MAX_LOGGERS - 1)
+    {
+        // table full: the last id collects every further logger
+        if (m_loggerCount == MAX_LOGGERS - 1)
+        {
+            snprintf(m_loggers[m_loggerCount++], LOGGER_LEN, "(other)");
+        }
+        return static_cast<uint8_t>(MAX_LOGGERS - 1);
+    }
+    strncpy(m_loggers[m_loggerCount], name, LOGGER_LEN - 1);
+    m_loggers[m_loggerCount][LOGGER_LEN - 1] = '\0';
+    return static_cast<uint8_t>(m_loggerCount++);
+}
+
+int TuiLogHistory::FindLogger(const char *name) const noexcept
+{
+    for (size_t i = 0; i < m_loggerCount; ++i)
+    {
+        if (strncmp(m_loggers[i], name, LOGGER_LEN - 1) == 0)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+const char *TuiLogHistory::LoggerName(uint8_t id) const noexcept
+{
+    return (id < m_loggerCount) ? m_loggers[id] : "";
+}
+
+void TuiLogHistory::EvictOldest() noexcept
+{
+    const uint8_t level = Record(m_first)->level;
+    const uint8_t lg    = Record(m_first)->logger;
+    m_first++;
+    if (m_first == m_next)
+    {
+        m_write = 0;
+    }
+
+    auto alive = [this](uint32_t seq) { return Alive(seq); };
+    m_levelIdx[level].Trim(alive);
+
+    if (m_viewAll)
+    {
+        ViewFrontRemoved(1);
+    }
+    else if (InView(level, lg))
+    {
+        const size_t before = m_view.Size();
+        m_view.Trim(alive);
+        ViewFrontRemoved(before - m_view.Size());
+    }
+}
+
+void TuiLogHistory::ViewFrontRemoved(size_t n) noexcept
+{
+    if (n == 0 || m_search == SearchState::idle || m_search == SearchState::badPattern)
+    {
+        return;
+    }
+    if (m_searchPos >= n)
+    {
+        m_searchPos -= n;
+    }
+    else
+    {
+        // the match / scan position scrolled out of the history
+        m_searchPos = 0;
+        if (m_search == SearchState::found)
+        {
+            m_search = SearchState::notFound;
+        }
+        else if (m_searchBack)
+        {
+            m_searchLeft = 0;
+        }
+    }
+}
+
+bool TuiLogHistory::Append(int level, const char *logger, const char *msg, size_t len) noexcept
+{
+    if (!m_arena || !msg)
+    {
+        return false;
+    }
+    level = std::min(std::max(level, 0), LEVELS - 1);
+
+    // strip ANSI escapes, remember the first coloured span
+    char     text[MAX_LINE];
+    size_t   n          = 0;
+    uint16_t colorStart = 0, colorEnd = 0;
+    bool     inColor    = false;
+    for (size_t i = 0; i < len && n < MAX_LINE; ++i)
+    {
+        const char c = msg[i];
+        if (c == '\x1b' && i + 1 < len && msg[i + 1] == '[')
+        {
+            size_t j = i + 2;
+            while (j < len && !(msg[j] >= 0x40 && msg[j] <= 0x7e))
+            {
+                ++j;
+            }
+            if (j < len && msg[j] == 'm')
+            {
+                const bool reset = (j == i + 2) || (j == i + 3 && msg[i + 2] == '0');
+                if (!reset && !inColor && colorEnd == 0)
+                {
+                    colorStart = static_cast<uint16_t>(n);
+                    inColor    = true;
+                }
+                else if (reset && inColor)
+                {
+                    colorEnd = static_cast<uint16_t>(n);
+                    inColor  = false;
+                }
+            }
+            i = j;
+            continue;
+        }
+        if (c == '\n' || c == '\r')
+        {
+            continue;
+        }
+        text[n++] = (c == '\t') ? ' ' : c;
+    }
+    if (inColor)
+    {
+        colorEnd = static_cast<uint16_t>(n);
+    }
+    return Store(level, InternLogger(logger), text, n, colorStart, colorEnd);
+}
+
+bool TuiLogHistory::AppendStripped(int level, const char *logger, const char *text, size_t len,
+                                   uint16_t colorStart, uint16_t colorEnd) noexcept
+{
+    if (!m_arena || !text)
+    {
+        return false;
+    }
+    level = std::min(std::max(level, 0), LEVELS - 1);
+    len   = std::min(len, MAX_LINE);
+    return Store(level, InternLogger(logger), text, len, colorStart, colorEnd);
+}
+
+bool TuiLogHistory::Store(int level, uint8_t lg, const char *text, size_t n,
+                          uint16_t colorStart, uint16_t colorEnd) noexcept
+{
+    if (colorEnd <= colorStart || colorEnd > n)
+    {
+        colorStart = colorEnd = 0;
+    }
+
+    const size_t stride = (sizeof(RecHdr) + n + 3) & ~static_cast<size_t>(3);
+
+    // find room: the live region is [tail, m_write) (possibly wrapped)
+    for (;;)
+    {
+        if (m_first == m_next)
+        {
+            m_write = 0;
+            break;
+        }
+        if (m_next - m_first >= m_maxLines)
+        {
+            EvictOldest();
+            continue;
+        }
+        const size_t tail = m_lineOff[m_first & (m_maxLines - 1)];
+        if (m_write >= tail)
+        {
+            if (m_write + stride <= m_cap)
+            {
+                break;
+            }
+            if (stride < tail)
+            {
+                m_write = 0;
+                break;
+            }
+        }
+        else if (m_write + stride < tail)
+        {
+            break;
+        }
+        EvictOldest();
+    }
+
+    RecHdr *hdr     = reinterpret_cast<RecHdr *>(m_arena + m_write);
+    hdr->len        = static_cast<uint32_t>(n);
+    hdr->colorStart = colorStart;
+    hdr->colorEnd   = colorEnd;
+    hdr->level      = static_cast<uint8_t>(level);
+    hdr->logger     = lg;
+    hdr->reserved   = 0;
+    memcpy(hdr + 1, text, n);
+
+    const uint32_t seq          = m_next++;
+    m_lineOff[seq & (m_maxLines - 1)] = static_cast<uint32_t>(m_write);
+    m_write                    += stride;
+
+    m_levelIdx[level].Push(seq);
+    if (!InView(static_cast<uint8_t>(level), lg))
+    {
+        return false;
+    }
+    if (!m_viewAll)
+    {
+        m_view.Push(seq);
+    }
+    return true;
+}
+
+size_t TuiLogHistory::Size() const noexcept
+{
+    return m_viewAll ? static_cast<size_t>(m_next - m_first) : m_view.Size();
+}
+
+size_t TuiLogHistory::Total() const noexcept
+{
+    return static_cast<size_t>(m_next - m_first);
+}
+
+size_t TuiLogHistory::LevelCount(int level) const noexcept
+{
+    return (level >= 0 && level < LEVELS) ? m_levelIdx[level].Size() : 0;
+}
+
+bool TuiLogHistory::GetLine(size_t viewIdx, Line &out) const noexcept
+{
+    if (viewIdx >= Size())
+    {
+        return false;
+    }
+    const uint32_t seq = m_viewAll ? m_first + static_cast<uint32_t>(viewIdx) : m_view.At(viewIdx);
+    const RecHdr  *hdr = Record(seq);
+    out.text       = reinterpret_cast<const char *>(hdr + 1);
+    out.len        = hdr->len;
+    out.colorStart = hdr->colorStart;
+    out.colorEnd   = hdr->colorEnd;
+    out.level      = hdr->level;
+    out.logger     = hdr->logger;
+    return true;
+}
+
+bool TuiLogHistory::GetRecent(size_t back, Line &out) const noexcept
+{
+    if (back >= Total())
+    {
+        return false;
+    }
+    const RecHdr *hdr = Record(m_next - 1 - static_cast<uint32_t>(back));
+    out.text       = reinterpret_cast<const char *>(hdr + 1);
+    out.len        = hdr->len;
+    out.colorStart = hdr->colorStart;
+    out.colorEnd   = hdr->colorEnd;
+    out.level      = hdr->level;
+    out.logger     = hdr->logger;
+    return true;
+}
+
+// ─── filters ────────────────────────────────────────────────────────────────
+
+namespace
+{
+
+int ParseLevelName(const char *s, size_t n) noexcept
+{
+    static const char *const names[][3] = {
+        {"t", "trace", nullptr},  {"d", "debug", nullptr}, {"i", "info", nullptr},
+        {"w", "warn", "warning"}, {"e", "err", "error"},   {"c", "critical", "crit"},
+    };
+    for (int lv = 0; lv < TuiLogHistory::LEVELS; ++lv)
+    {
+        for (const char *name : names[lv])
+        {
+            if (name && strlen(name) == n && strncasecmp(name, s, n) == 0)
+            {
+                return lv;
+            }
+        }
+    }
+    return -1;
+}
+
+const char *SkipSpaces(const char *s) noexcept
+{
+    while (*s == ' ')
+    {
+        ++s;
+    }
+    return s;
+}
+
+}  // namespace
+
+bool TuiLogHistory::ApplyFilter(const char *cmd) noexcept
+{
+    if (!cmd)
+    {
+        return false;
+    }
+    cmd = SkipSpaces(cmd);
+
+    uint32_t levelMask  = m_levelMask;
+    uint64_t loggerMask = m_loggerMask;
+
+    if (*cmd == '\0' || strcmp(cmd, "clear") == 0)
+    {
+        levelMask  = (1u << LEVELS) - 1;
+        loggerMask = ~0ull;
+    }
+    else if (strncmp(cmd, "level:", 6) == 0)
+    {
+        const char *p = SkipSpaces(cmd + 6);
+        levelMask     = (*p == '\0') ? (1u << LEVELS) - 1 : 0;
+        while (*p)
+        {
+            const char *end = p;
+            while (*end && *end != ',' && *end != ' ')
+            {
+                ++end;
+            }
+            size_t     n     = static_cast<size_t>(end - p);
+            const bool above = (n > 0 && p[n - 1] == '+');
+            const int  lv    = ParseLevelName(p, above ? n - 1 : n);
+            if (lv < 0)
+            {
+                return false;
+            }
+            levelMask |= above ? ((1u << LEVELS) - (1u << lv)) : (1u << lv);
+            p = end;
+            while (*p == ',' || *p == ' ')
+            {
+                ++p;
+            }
+        }
+    }
+    else if (strncmp(cmd, "logger:", 7) == 0)
+    {
+        const char *p = SkipSpaces(cmd + 7);
+        loggerMask    = (*p == '\0') ? ~0ull : 0;
+        while (*p)
+        {
+            const char *end = p;
+            while (*end && *end != ',' && *end != ' ')
+            {
+                ++end;
+            }
+            char name[LOGGER_LEN];
+            const size_t n = std::min(static_cast<size_t>(end - p), LOGGER_LEN - 1);
+            memcpy(name, p, n);
+            name[n] = '\0';
+            // look up only: interning typed names would fill the table with loggers that never log
+            const int id = FindLogger(name);
+            if (id >= 0)
+            {
+                loggerMask |= 1ull << id;
+            }
+            p = end;
+            while (*p == ',' || *p == ' ')
+            {
+                ++p;
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    m_levelMask  = levelMask;
+    m_loggerMask = loggerMask;
+    RebuildView();
+    return true;
+}
+
+void TuiLogHistory::ClearFilters() noexcept
+{
+    m_levelMask  = (1u << LEVELS) - 1;
+    m_loggerMask = ~0ull;
+    RebuildView();
+}
+
+// Merge the per-level lists of the selected levels (already in sequence order); only the
+// logger filter needs to look at the records themselves.
+void TuiLogHistory::RebuildView() noexcept
+{
+    CancelSearch();
+    m_view.Clear();
+    m_viewAll = (m_levelMask == (1u << LEVELS) - 1) && (m_loggerMask == ~0ull);
+    if (m_viewAll)
+    {
+        return;
+    }
+
+    auto    alive = [this](uint32_t seq) { return Alive(seq); };
+    size_t  cur[LEVELS]{};
+    size_t  total = 0;
+    for (int lv = 0; lv < LEVELS; ++lv)
+    {
+        if (m_levelMask & (1u << lv))
+        {
+            m_levelIdx[lv].Trim(alive);
+            total += m_levelIdx[lv].Size();
+        }
+    }
+    try
+    {
+        m_view.seqs.reserve(total);
+    }
+    catch (...)
+    {
+    }
+
+    const bool byLogger = (m_loggerMask != ~0ull);
+    for (;;)
+    {
+        int      best    = -1;
+        uint32_t bestAge = 0;
+        for (int lv = 0; lv < LEVELS; ++lv)
+        {
+            if (!(m_levelMask & (1u << lv)) || cur[lv] >= m_levelIdx[lv].Size())
+            {
+                continue;
+            }
+            const uint32_t age = m_levelIdx[lv].At(cur[lv]) - m_first;
+            if (best < 0 || age < bestAge)
+            {
+                best    = lv;
+                bestAge = age;
+            }
+        }
+        if (best < 0)
+        {
+            break;
+        }
+        const uint32_t seq = m_levelIdx[best].At(cur[best]++);
+        if (!byLogger || (m_loggerMask & (1ull << Record(seq)->logger)))
+        {
+            m_view.Push(seq);
+        }
+    }
+}
+
+void TuiLogHistory::DescribeFilter(char *buf, size_t size) const noexcept
+{
+    if (!buf || size == 0)
+    {
+        return;
+    }
+    static const char lvChar[LEVELS] = {'t', 'd', 'i', 'w', 'e', 'c'};
+
+    size_t pos = 0;
+    buf[0]     = '\0';
+    auto put = [&](const char *s) {
+        const int w = snprintf(buf + pos, size - pos, "%s", s);
+        if (w > 0)
+        {
+            pos = std::min(pos + static_cast<size_t>(w), size - 1);
+        }
+    };
+
+    if (m_levelMask != (1u << LEVELS) - 1)
+    {
+        put("lv:");
+        bool first = true;
+        for (int lv = 0; lv < LEVELS; ++lv)
+        {
+            if (m_levelMask & (1u << lv))
+            {
+                const char s[3] = {first ? '\0' : ',', lvChar[lv], '\0'};
+                put(first ? s + 1 : s);
+                first = false;
+            }
+        }
+        if (first)
+        {
+            put("-");
+        }
+    }
+    if (m_loggerMask != ~0ull)
+    {
+        put(pos ? " log:" : "log:");
+        bool first = true;
+        for (size_t i = 0; i < m_loggerCount; ++i)
+        {
+            if (m_loggerMask & (1ull << i))
+            {
+                if (!first)
+                {
+                    put(",");
+                }
+                put(m_loggers[i][0] ? m_loggers[i] : "\"\"");
+                first = false;
+            }
+        }
+        if (first)
+        {
+            put("-");
+        }
+    }
+}
+
+// ─── search ─────────────────────────────────────────────────────────────────
+
+void TuiLogHistory::StartSearch(const char *query, size_t fromIdx, bool backward) noexcept
+{
+    CancelSearch();
+    if (!query || !query[0] || Size() == 0)
+    {
+        return;
+    }
+
+    try
+    {
+        if (strncmp(query, "re:", 3) == 0)
+        {
+            if (!query[3])
+            {
+                return;
+            }
+            m_regex.reset(new SearchRegex{std::regex(query + 3, std::regex::ECMAScript | std::regex::icase)});
+        }
+        else
+        {
+            m_query = query;
+            for (char &c : m_query)
+            {
+                c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+    catch (...)
+    {
+        m_regex.reset();
+        m_query.clear();
+        m_search = SearchState::badPattern;
+        return;
+    }
+
+    m_searchPos  = std::min(fromIdx, Size() - 1);
+    m_searchBack = backward;
+    m_searchLeft = backward ? m_searchPos + 1 : Size() - m_searchPos;
+    m_search     = SearchState::running;
+}
+
+TuiLogHistory::SearchState TuiLogHistory::StepSearch(size_t budget) noexcept
+{
+    // std::regex costs roughly 20x a substring scan per line
+    if (m_regex)
+    {
+        budget = std::max<size_t>(budget / REGEX_COST, 1);
+    }
+    while (m_search == SearchState::running && budget-- > 0)
+    {
+        Line line;
+        if (m_searchLeft == 0 || !GetLine(m_searchPos, line))
+        {
+            m_search = SearchState::notFound;
+            break;
+        }
+        if (Matches(line))
+        {
+            m_search = SearchState::found;
+            break;
+        }
+        --m_searchLeft;
+        if (m_searchBack)
+        {
+            if (m_searchPos == 0)
+            {
+                m_searchLeft = 0;
+            }
+            else
+            {
+                --m_searchPos;
+            }
+        }
+        else
+        {
+            ++m_searchPos;
+        }
+    }
+    return m_search;
+}
+
+void TuiLogHistory::CancelSearch() noexcept
+{
+    m_search = SearchState::idle;
+    m_regex.reset();
+    m_query.clear();
+    m_searchPos  = 0;
+    m_searchLeft = 0;
+}
+
+bool TuiLogHistory::Matches(const Line &line) const noexcept
+{
+    if (m_regex)
+    {
+        try
+        {
+            return std::regex_search(line.text, line.text + line.len, m_regex->re);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    const size_t qn = m_query.size();
+    if (qn == 0 || qn > line.len)
+    {
+        return qn == 0;
+    }
+    const char  *q     = m_query.data();
+    const char   first = q[0];
+    for (size_t i = 0; i + qn <= line.len; ++i)
+    {
+        if (tolower(static_cast<unsigned char>(line.text[i])) != first)
+        {
+            continue;
+        }
+        size_t k = 1;
+        while (k < qn && tolower(static_cast<unsigned char>(line.text[i + k])) == q[k])
+        {
+            ++k;
+        }
+        if (k == qn)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace Log
+}  // namespace dt
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "dtCore/src/dtLog/dtRtTuiPlot.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+// ─── TuiPlot ────────────────────────────────────────────────────────────────
+
+TuiPlot::~TuiPlot()
+{
+    dt::Utils::FreeRtMem(m_mem);
+}
+
+bool TuiPlot::Init(const char *label, const TuiPlotConfig &cfg, const dt::Utils::RtMemOptions &memOpt) noexcept
+{
+    strncpy(m_label, label ? label : "", LABEL_LEN - 1);
+    m_label[LABEL_LEN - 1] = '\0';
+
+    m_cfg            = cfg;
+    m_cfg.window     = std::min(std::max(cfg.window, static_cast<size_t>(1)), MAX_WINDOW);
+    m_cfg.decimation = std::max(cfg.decimation, 1u);
+
+    size_t cap = 2;
+    while (cap < cfg.queueCapacity && cap < (size_t{1} << 20))
+    {
+        cap <<= 1;
+    }
+    if (!dt::Utils::AllocRtMem(cap * sizeof(double), memOpt, m_mem))
+    {
+        return false;
+    }
+    m_ring    = static_cast<double *>(m_mem.ptr);
+    m_ringCap = cap;
+
+    try
+    {
+        m_win.assign(m_cfg.window, 0.0);
+        m_winBin.assign(m_cfg.window, 0);
+        m_minQ.assign(m_cfg.window, 0);
+        m_maxQ.assign(m_cfg.window, 0);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    if (m_cfg.lo < m_cfg.hi)
+    {
+        m_lo         = m_cfg.lo;
+        m_hi         = m_cfg.hi;
+        m_calibrated = true;
+        m_autoRange  = false;
+    }
+    return true;
+}
+
+size_t TuiPlot::Update() noexcept
+{
+    uint64_t       tail = m_tail.load(std::memory_order_relaxed);
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    size_t         n    = 0;
+
+    while (tail != head)
+    {
+        const double x = m_ring[tail & (m_ringCap - 1)];
+        ++tail;
+        ++n;
+        if (std::isfinite(x))
+        {
+            AddSample(x);
+        }
+    }
+
+    m_tail.store(tail, std::memory_order_release);
+    return n;
+}
+
+int TuiPlot::BinOf(double x) const noexcept
+{
+    if (!(x > m_lo))
+    {
+        return 0;
+    }
+    if (x >= m_hi)
+    {
+        return static_cast<int>(HIST_BINS - 1);
+    }
+    const int b = static_cast<int>((x - m_lo) / (m_hi - m_lo) * HIST_BINS);
+    return std::min(b, static_cast<int>(HIST_BINS - 1));
+}
+
+void TuiPlot::AddSample(double x) noexcept
+{
+    const size_t   N    = m_cfg.window;
+    const uint64_t s    = m_seq;
+    const size_t   slot = static_cast<size_t>(s % N);
+
+    // evict the sample leaving the window
+    if (s >= N)
+    {
+        m_sum -= m_win[slot];
+        if (m_calibrated)
+        {
+            m_hist[m_winBin[slot]]--;
+        }
+    }
+
+    m_win[slot] = x;
+    m_sum      += x;
+    m_last      = x;
+    if (m_calibrated)
+    {
+        const int b    = BinOf(x);
+        m_winBin[slot] = static_cast<uint8_t>(b);
+        m_hist[b]++;
+    }
+
+    // monotonic deques: front is the window min / max
+    while (m_minHead != m_minTail && m_minQ[m_minHead % N] + N <= s) ++m_minHead;
+    while (m_maxHead != m_maxTail && m_maxQ[m_maxHead % N] + N <= s) ++m_maxHead;
+    while (m_minHead != m_minTail && m_win[m_minQ[(m_minTail - 1) % N] % N] >= x) --m_minTail;
+    while (m_maxHead != m_maxTail && m_win[m_maxQ[(m_maxTail - 1) % N] % N] <= x) --m_maxTail;
+    m_minQ[m_minTail++ % N] = s;
+    m_maxQ[m_maxTail++ % N] = s;
+
+    m_seq++;
+
+    // re-sum once per window to cancel floating-point drift (O(1) amortized)
+    if (m_seq % N == 0)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            sum += m_win[i];
+        }
+        m_sum = sum;
+    }
+
+    if (!m_calibrated && m_seq == std::min<uint64_t>(CALIB_SAMPLES, N))
+    {
+        Calibrate();
+    }
+    else if (m_calibrated && m_autoRange && m_seq >= CALIB_SAMPLES)
+    {
+        // the signal drifted out of the range: rebuild from the current window. Right after a
+        // rebuild the edge bins are (nearly) empty, so this runs at most once per N/256 samples.
+        const uint64_t edge  = m_hist[0] + m_hist[HIST_BINS - 1];
+        const uint64_t count = std::min<uint64_t>(m_seq, N);
+        if (edge * RERANGE_DIV > count)
+        {
+            Calibrate();
+        }
+    }
+
+    // sparkline column aggregate
+    if (m_curN == 0)
+    {
+        m_cur.min = m_cur.max = x;
+    }
+    else
+    {
+        m_cur.min = std::min(m_cur.min, x);
+        m_cur.max = std::max(m_cur.max, x);
+    }
+    if (++m_curN >= m_cfg.decimation)
+    {
+        m_cols[m_colCount % MAX_COLUMNS] = m_cur;
+        m_colCount++;
+        m_curN = 0;
+    }
+}
+
+// Histogram range from the window samples, padded by half the observed span on each side.
+// Values outside the range fall into the edge bins (p99 then reports the exact max) until
+// AddSample() re-ranges.
+void TuiPlot::Calibrate() noexcept
+{
+    const size_t N   = m_cfg.window;
+    double       lo  = m_win[m_minQ[m_minHead % N] % N];
+    double       hi  = m_win[m_maxQ[m_maxHead % N] % N];
+    const double pad = (hi > lo) ? (hi - lo) * 0.5 : std::max(std::fabs(lo), 1.0) * 0.5;
+    m_lo = lo - pad;
+    m_hi = hi + pad;
+
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(m_seq, N));
+    memset(m_hist, 0, sizeof(m_hist));
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t slot = static_cast<size_t>((m_seq - 1 - i) % N);
+        const int    b    = BinOf(m_win[slot]);
+        m_winBin[slot]    = static_cast<uint8_t>(b);
+        m_hist[b]++;
+    }
+    m_calibrated = true;
+}
+
+double TuiPlot::Percentile(double q) const noexcept
+{
+    const size_t N     = m_cfg.window;
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(m_seq, N));
+    const double vmin  = m_win[m_minQ[m_minHead % N] % N];
+    const double vmax  = m_win[m_maxQ[m_maxHead % N] % N];
+
+    if (!m_calibrated)
+    {
+        // fewer than CALIB_SAMPLES samples: exact
+        double tmp[CALIB_SAMPLES];
+        for (size_t i = 0; i < count; ++i)
+        {
+            tmp[i] = m_win[i];
+        }
+        const size_t k = std::min(count - 1, static_cast<size_t>(std::ceil(q * count)) - 1);
+        std::nth_element(tmp, tmp + k, tmp + count);
+        return tmp[k];
+    }
+
+    const uint64_t target = static_cast<uint64_t>(std::ceil(q * count));
+    uint64_t       cum    = 0;
+    size_t         b      = 0;
+    for (; b < HIST_BINS; ++b)
+    {
+        cum += m_hist[b];
+        if (cum >= target)
+        {
+            break;
+        }
+    }
+    if (b >= HIST_BINS - 1)
+    {
+        return vmax;
+    }
+    const double upper = m_lo + (m_hi - m_lo) * static_cast<double>(b + 1) / HIST_BINS;
+    return std::min(std::max(upper, vmin), vmax);
+}
+
+TuiPlotStats TuiPlot::GetStats() const noexcept
+{
+    TuiPlotStats st{};
+    st.samples = m_seq;
+    st.dropped = m_dropped.load(std::memory_order_relaxed);
+    if (m_seq == 0)
+    {
+        return st;
+    }
+
+    const size_t N = m_cfg.window;
+    st.window = static_cast<size_t>(std::min<uint64_t>(m_seq, N));
+    st.last   = m_last;
+    st.min    = m_win[m_minQ[m_minHead % N] % N];
+    st.max    = m_win[m_maxQ[m_maxHead % N] % N];
+    st.mean   = m_sum / static_cast<double>(st.window);
+    st.p99    = Percentile(0.99);
+    return st;
+}
+
+size_t TuiPlot::RenderSpark(char *out, size_t outSize, int columns) const noexcept
+{
+    if (!out || outSize == 0 || columns <= 0)
+    {
+        return 0;
+    }
+
+    columns = std::min(columns, static_cast<int>(MAX_COLUMNS));
+    const size_t stored    = static_cast<size_t>(std::min<uint64_t>(m_colCount, MAX_COLUMNS - 1));
+    const size_t available = stored + (m_curN > 0 ? 1 : 0);
+    const size_t n         = std::min(available, static_cast<size_t>(columns));
+
+    // column i (0 = oldest shown); the partially filled column is the newest
+    auto columnAt = [&](size_t i) -> Column {
+        size_t fromNewest = n - 1 - i;
+        if (m_curN > 0)
+        {
+            if (fromNewest == 0)
+            {
+                return m_cur;
+            }
+            --fromNewest;
+        }
+        return m_cols[(m_colCount - 1 - fromNewest) % MAX_COLUMNS];
+    };
+
+    double lo = 0.0, hi = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Column c = columnAt(i);
+        lo = (i == 0) ? c.min : std::min(lo, c.min);
+        hi = (i == 0) ? c.max : std::max(hi, c.max);
+    }
+    const TuiPlotStats st   = GetStats();
+    const double       span = hi - lo;
+
+    size_t pos = 0;
+    for (size_t i = n; i < static_cast<size_t>(columns) && pos + 1 < outSize; ++i)
+    {
+        out[pos++] = ' ';
+    }
+    for (size_t i = 0; i < n && pos + 3 < outSize; ++i)
+    {
+        // draw the extreme farther from the window mean so spikes survive decimation
+        const Column c = columnAt(i);
+        const double v = (std::fabs(c.max - st.mean) >= std::fabs(c.min - st.mean)) ? c.max : c.min;
+        int level = 3;
+        if (span > 0.0)
+        {
+            level = static_cast<int>((v - lo) / span * 7.0 + 0.5);
+            level = std::min(std::max(level, 0), 7);
+        }
+        out[pos++] = '\xe2';                            // U+2581 ▁ .. U+2588 █
+        out[pos++] = '\x96';
+        out[pos++] = static_cast<char>(0x81 + level);
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+}  // namespace Log
+}  // namespace dt
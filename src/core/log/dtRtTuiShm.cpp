@@ -0,0 +1,148 @@
+#include <cstring>
+#include <sched.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dtCore/src/dtLog/dtRtTuiShm.hpp"
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
+
+namespace dt
+{
+
+namespace Log
+{
+
+TuiShmSegment *CreateTuiShm(const char *name) noexcept
+{
+    if (!name || name[0] != '/')
+    {
+        return nullptr;
+    }
+
+    // a new inode per publisher: viewers still mapping a previous run see it go stale
+    // (dead pid) and re-open, instead of reading a segment being re-initialized
+    (void)shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    void *p = MAP_FAILED;
+    if (ftruncate(fd, sizeof(TuiShmSegment)) == 0)
+    {
+        p = mmap(nullptr, sizeof(TuiShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        (void)shm_unlink(name);
+        return nullptr;
+    }
+
+    // the mapping is zero-filled; publish the header last
+    auto *seg    = static_cast<TuiShmSegment *>(p);
+    seg->size    = sizeof(TuiShmSegment);
+    seg->pid      = static_cast<int32_t>(getpid());
+    seg->instance = static_cast<uint64_t>(dt::Utils::MonotonicNs());
+    seg->version  = TUI_SHM_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    seg->magic = TUI_SHM_MAGIC;
+    return seg;
+}
+
+void DestroyTuiShm(TuiShmSegment *seg, const char *name) noexcept
+{
+    if (seg)
+    {
+        (void)munmap(seg, sizeof(TuiShmSegment));
+    }
+    if (name)
+    {
+        (void)shm_unlink(name);
+    }
+}
+
+const TuiShmSegment *OpenTuiShm(const char *name) noexcept
+{
+    if (!name)
+    {
+        return nullptr;
+    }
+
+    const int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat st{};
+    void *p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == sizeof(TuiShmSegment))
+    {
+        p = mmap(nullptr, sizeof(TuiShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    auto *seg = static_cast<const TuiShmSegment *>(p);
+    bool valid = (seg->magic == TUI_SHM_MAGIC);
+    std::atomic_thread_fence(std::memory_order_acquire);  // pairs with the release in CreateTuiShm()
+    valid = valid && seg->version == TUI_SHM_VERSION && seg->size == sizeof(TuiShmSegment);
+    if (!valid)
+    {
+        (void)munmap(p, sizeof(TuiShmSegment));
+        return nullptr;
+    }
+    return seg;
+}
+
+void CloseTuiShm(const TuiShmSegment *seg) noexcept
+{
+    if (seg)
+    {
+        (void)munmap(const_cast<TuiShmSegment *>(seg), sizeof(TuiShmSegment));
+    }
+}
+
+bool ReadTuiShm(const TuiShmSegment *seg, TuiShmSegment &out, int retries) noexcept
+{
+    if (!seg)
+    {
+        return false;
+    }
+
+    constexpr size_t PAYLOAD = offsetof(TuiShmSegment, publishWall_ns);
+    for (int i = 0; i < retries; ++i)
+    {
+        const uint64_t s0 = seg->seq.load(std::memory_order_acquire);
+        if (s0 & 1)
+        {
+            sched_yield();
+            continue;
+        }
+        memcpy(reinterpret_cast<char *>(&out) + PAYLOAD, reinterpret_cast<const char *>(seg) + PAYLOAD,
+               sizeof(TuiShmSegment) - PAYLOAD);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seg->seq.load(std::memory_order_relaxed) == s0)
+        {
+            out.magic    = seg->magic;
+            out.version  = seg->version;
+            out.size     = seg->size;
+            out.pid      = seg->pid;
+            out.instance = seg->instance;
+            out.seq.store(s0, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace Log
+}  // namespace dt
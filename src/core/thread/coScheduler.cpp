@@ -0,0 +1,531 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/coScheduler.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include <dtCore/dtLog>
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Types ------------------------------------------------------------*/
+enum class CoTaskState : uint8_t
+{
+    Ready,
+    Sleeping,
+    Waiting,
+    Done,
+};
+
+struct CoTask
+{
+    CoTaskFunc step;
+    CoContext ctx;
+    CoScheduler *sched = nullptr;
+    const char *name = nullptr;
+    CoTask *next = nullptr;           // ready list
+    int64_t timer_ns = 0;             // wake-up time while in the timer heap
+    size_t heapIdx = SIZE_MAX;        // SIZE_MAX: no timer
+    size_t taskIdx = 0;               // in CoScheduler::m_tasks
+    uint32_t seq = 0;                 // bumped at every Await: older signals are ignored
+    CoTaskState state = CoTaskState::Ready;
+};
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+// CoContext / CoWaitable ------------------------------------------------------
+bool CoContext::Await(CoWaitable &w)
+{
+    if (timedOut)
+    {
+        return true; // resumed by the timeout of DT_CO_AWAIT_FOR
+    }
+    if (w.TryOrWait(m_task, ++m_task->seq))
+    {
+        m_waitOn = nullptr;
+        return true;
+    }
+    m_waitOn = &w;
+    return false;
+}
+
+void CoWaitable::Notify()
+{
+    for (const Waiter &w : m_waiters)
+    {
+        w.task->sched->Wake(w.task, w.seq);
+    }
+    m_waiters.clear();
+}
+
+bool CoWaitable::TryOrWait(CoTask *task, uint32_t seq)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (TryConsume())
+    {
+        return true;
+    }
+    m_waiters.push_back(Waiter{task, seq});
+    return false;
+}
+
+void CoWaitable::RemoveWaiter(CoTask *task)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_waiters.erase(std::remove_if(m_waiters.begin(), m_waiters.end(), [task](const Waiter &w) { return w.task == task; }),
+                    m_waiters.end());
+}
+
+// CoScheduler -----------------------------------------------------------------
+CoScheduler::CoScheduler(const CoSchedulerConfig &config)
+    : m_config(config)
+{
+}
+
+CoScheduler::~CoScheduler()
+{
+    Stop();
+}
+
+size_t CoScheduler::TaskSize()
+{
+    return sizeof(CoTask);
+}
+
+int CoScheduler::Start()
+{
+    if (m_running.exchange(true))
+    {
+        LOG(err).printf("!Error! CoScheduler::Start() : %s is already started", m_config.name);
+        return -1;
+    }
+    m_thread = ThreadInfo{};
+    m_thread.name = m_config.name;
+    m_thread.procFunc = SchedulerProc;
+    m_thread.procFuncArg = this;
+    m_thread.cpuIdx = m_config.cpuIdx;
+    m_thread.stackSz = m_config.stackSz;
+    if (CreateNonRtThread(m_thread))
+    {
+        m_running.store(false);
+        return -1;
+    }
+    return 0;
+}
+
+void CoScheduler::Stop()
+{
+    if (m_running.exchange(false))
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_inboxMtx);
+            m_inboxCv.notify_all();
+        }
+        DeleteThread(m_thread);
+    }
+
+    // free every task, including the ones spawned but never run
+    DrainInbox();
+    for (CoTask *task : m_tasks)
+    {
+        if (task->ctx.m_waitOn)
+        {
+            task->ctx.m_waitOn->RemoveWaiter(task);
+        }
+    }
+    {
+        // no waitable refers to the tasks any more: drop the signals still queued
+        std::lock_guard<std::mutex> lock(m_inboxMtx);
+        for (const Inbox &in : m_inbox)
+        {
+            if (in.spawn)
+            {
+                delete in.task;
+            }
+        }
+        m_inbox.clear();
+    }
+    for (CoTask *task : m_tasks)
+    {
+        delete task;
+    }
+    for (CoTask *task : m_graveyard)
+    {
+        delete task;
+    }
+    m_tasks.clear();
+    m_graveyard.clear();
+    m_timers.clear();
+    m_readyHead = m_readyTail = nullptr;
+    m_readyCount = 0;
+    m_live.store(0, std::memory_order_relaxed);
+}
+
+void *CoScheduler::SchedulerProc(void *arg)
+{
+    CoScheduler *self = static_cast<CoScheduler *>(arg);
+    while (self->m_running.load(std::memory_order_relaxed))
+    {
+        self->RunOnce(100000000); // wakes earlier for timers, signals and Stop()
+    }
+    return nullptr;
+}
+
+bool CoScheduler::Spawn(const char *name, CoTaskFunc step)
+{
+    if (!step)
+    {
+        return false;
+    }
+    CoTask *task = new (std::nothrow) CoTask();
+    if (!task)
+    {
+        LOG(err).printf("!Error! CoScheduler::Spawn() : cannot allocate task %s", name ? name : "-");
+        return false;
+    }
+    task->step = std::move(step);
+    task->sched = this;
+    task->name = name;
+    task->ctx.m_task = task;
+    m_spawned.fetch_add(1, std::memory_order_relaxed);
+    m_live.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_inboxMtx);
+    m_inbox.push_back(Inbox{task, 0, true});
+    m_inboxCv.notify_one();
+    return true;
+}
+
+bool CoScheduler::Every(const char *name, int64_t period_ns, std::function<bool()> job, int64_t firstDelay_ns)
+{
+    if (period_ns <= 0 || !job)
+    {
+        return false;
+    }
+    return Spawn(name, [period_ns, firstDelay_ns, job = std::move(job), next = (int64_t)-1](CoContext &co) mutable {
+        if (next < 0)
+        {
+            next = co.now_ns + firstDelay_ns;
+            if (firstDelay_ns > 0)
+            {
+                return co.SleepUntil(next);
+            }
+        }
+        if (!job())
+        {
+            return CoStatus::Done;
+        }
+        next += period_ns;
+        if (next <= co.now_ns)
+        {
+            next += ((co.now_ns - next) / period_ns + 1) * period_ns; // skip the missed periods
+        }
+        return co.SleepUntil(next);
+    });
+}
+
+bool CoScheduler::After(const char *name, int64_t delay_ns, std::function<void()> job)
+{
+    if (!job)
+    {
+        return false;
+    }
+    return Spawn(name, [delay_ns, job = std::move(job), started = false](CoContext &co) mutable {
+        if (!started)
+        {
+            started = true;
+            return co.SleepFor(delay_ns);
+        }
+        job();
+        return CoStatus::Done;
+    });
+}
+
+void CoScheduler::GetStats(CoSchedulerStats &stats) const
+{
+    stats.tasks = m_live.load(std::memory_order_relaxed);
+    stats.spawned = m_spawned.load(std::memory_order_relaxed);
+    stats.resumes = m_resumes.load(std::memory_order_relaxed);
+    stats.timerWakes = m_timerWakes.load(std::memory_order_relaxed);
+    stats.signalWakes = m_signalWakes.load(std::memory_order_relaxed);
+    stats.idleSleeps = m_idleSleeps.load(std::memory_order_relaxed);
+}
+
+void CoScheduler::Wake(CoTask *task, uint32_t seq)
+{
+    // called by CoWaitable::Notify() with the waitable's lock held (lock order: waitable -> inbox)
+    std::lock_guard<std::mutex> lock(m_inboxMtx);
+    m_inbox.push_back(Inbox{task, seq, false});
+    m_inboxCv.notify_one();
+}
+
+void CoScheduler::DrainInbox()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_inboxMtx);
+        m_drained.swap(m_inbox);
+    }
+    for (const Inbox &in : m_drained)
+    {
+        CoTask *task = in.task;
+        if (in.spawn)
+        {
+            task->taskIdx = m_tasks.size();
+            m_tasks.push_back(task);
+            MakeReady(task);
+        }
+        else if (task->state == CoTaskState::Waiting && task->seq == in.seq)
+        {
+            TimerRemove(task);
+            task->ctx.m_waitOn = nullptr;
+            MakeReady(task);
+            m_signalWakes.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    m_drained.clear();
+
+    // every signal sent before these tasks finished has been seen above
+    for (CoTask *task : m_graveyard)
+    {
+        delete task;
+    }
+    m_graveyard.clear();
+}
+
+void CoScheduler::MakeReady(CoTask *task)
+{
+    task->state = CoTaskState::Ready;
+    task->next = nullptr;
+    if (m_readyTail)
+    {
+        m_readyTail->next = task;
+    }
+    else
+    {
+        m_readyHead = task;
+    }
+    m_readyTail = task;
+    m_readyCount++;
+}
+
+void CoScheduler::ExpireTimers(int64_t now_ns)
+{
+    while (!m_timers.empty() && m_timers[0]->timer_ns <= now_ns)
+    {
+        CoTask *task = m_timers[0];
+        TimerRemove(task);
+        if (task->state == CoTaskState::Waiting)
+        {
+            if (task->ctx.m_waitOn)
+            {
+                task->ctx.m_waitOn->RemoveWaiter(task);
+                task->ctx.m_waitOn = nullptr;
+            }
+            task->seq++; // a signal already queued for this wait is stale
+            task->ctx.timedOut = true;
+        }
+        MakeReady(task);
+        m_timerWakes.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void CoScheduler::Resume(CoTask *task)
+{
+    CoContext &co = task->ctx;
+    co.now_ns = dt::Utils::MonotonicNs();
+    m_resumes.fetch_add(1, std::memory_order_relaxed);
+
+    CoStatus status;
+    try
+    {
+        status = task->step(co);
+    }
+    catch (const std::exception &e)
+    {
+        LOG(err).printf("!Error! CoScheduler : task %s threw: %s", task->name ? task->name : "-", e.what());
+        status = CoStatus::Done;
+    }
+    catch (...)
+    {
+        LOG(err).printf("!Error! CoScheduler : task %s threw an exception", task->name ? task->name : "-");
+        status = CoStatus::Done;
+    }
+
+    switch (status)
+    {
+    case CoStatus::Yield:
+        MakeReady(task);
+        break;
+    case CoStatus::Sleep:
+        task->state = CoTaskState::Sleeping;
+        TimerPush(task, co.m_wake_ns);
+        break;
+    case CoStatus::Wait:
+        if (!co.m_waitOn)
+        {
+            MakeReady(task); // Wait without a pending Await(): same as Yield
+            break;
+        }
+        task->state = CoTaskState::Waiting;
+        if (co.m_deadline_ns >= 0)
+        {
+            TimerPush(task, co.m_deadline_ns);
+        }
+        break;
+    case CoStatus::Done:
+        Free(task);
+        break;
+    }
+}
+
+void CoScheduler::Free(CoTask *task)
+{
+    if (task->ctx.m_waitOn)
+    {
+        task->ctx.m_waitOn->RemoveWaiter(task);
+        task->ctx.m_waitOn = nullptr;
+    }
+    TimerRemove(task);
+    task->state = CoTaskState::Done;
+    task->step = nullptr; // release the captures now
+
+    CoTask *last = m_tasks.back();
+    m_tasks[task->taskIdx] = last;
+    last->taskIdx = task->taskIdx;
+    m_tasks.pop_back();
+    m_graveyard.push_back(task);
+    m_live.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int CoScheduler::RunOnce(int64_t maxWait_ns)
+{
+    DrainInbox();
+    int64_t now = dt::Utils::MonotonicNs();
+    ExpireTimers(now);
+
+    if (!m_readyHead && maxWait_ns > 0)
+    {
+        int64_t wait = maxWait_ns;
+        if (!m_timers.empty())
+        {
+            wait = std::min(wait, m_timers[0]->timer_ns - now);
+        }
+        if (wait > 0)
+        {
+            std::unique_lock<std::mutex> lock(m_inboxMtx);
+            if (m_inbox.empty() && (m_running.load(std::memory_order_relaxed) || m_thread.id == 0))
+            {
+                m_idleSleeps.fetch_add(1, std::memory_order_relaxed);
+                m_inboxCv.wait_for(lock, std::chrono::nanoseconds(wait));
+            }
+        }
+        DrainInbox();
+        now = dt::Utils::MonotonicNs();
+        ExpireTimers(now);
+    }
+
+    // the tasks ready now; the ones they make ready run in the next round
+    int steps = 0;
+    for (size_t n = m_readyCount; n > 0 && m_readyHead; --n)
+    {
+        CoTask *task = m_readyHead;
+        m_readyHead = task->next;
+        if (!m_readyHead)
+        {
+            m_readyTail = nullptr;
+        }
+        m_readyCount--;
+        Resume(task);
+        steps++;
+    }
+    return steps;
+}
+
+// timer heap (indexed: a task can leave it when a signal ends its wait) ------
+void CoScheduler::TimerPush(CoTask *task, int64_t wake_ns)
+{
+    task->timer_ns = wake_ns;
+    task->heapIdx = m_timers.size();
+    m_timers.push_back(task);
+    TimerSiftUp(task->heapIdx);
+}
+
+void CoScheduler::TimerRemove(CoTask *task)
+{
+    const size_t idx = task->heapIdx;
+    if (idx == SIZE_MAX)
+    {
+        return;
+    }
+    task->heapIdx = SIZE_MAX;
+    CoTask *last = m_timers.back();
+    m_timers.pop_back();
+    if (last == task)
+    {
+        return;
+    }
+    m_timers[idx] = last;
+    last->heapIdx = idx;
+    TimerSiftUp(idx);
+    TimerSiftDown(last->heapIdx);
+}
+
+void CoScheduler::TimerSiftUp(size_t idx)
+{
+    CoTask *task = m_timers[idx];
+    while (idx > 0)
+    {
+        const size_t parent = (idx - 1) / 2;
+        if (m_timers[parent]->timer_ns <= task->timer_ns)
+        {
+            break;
+        }
+        m_timers[idx] = m_timers[parent];
+        m_timers[idx]->heapIdx = idx;
+        idx = parent;
+    }
+    m_timers[idx] = task;
+    task->heapIdx = idx;
+}
+
+void CoScheduler::TimerSiftDown(size_t idx)
+{
+    const size_t n = m_timers.size();
+    CoTask *task = m_timers[idx];
+    for (;;)
+    {
+        size_t child = 2 * idx + 1;
+        if (child >= n)
+        {
+            break;
+        }
+        if (child + 1 < n && m_timers[child + 1]->timer_ns < m_timers[child]->timer_ns)
+        {
+            child++;
+        }
+        if (task->timer_ns <= m_timers[child]->timer_ns)
+        {
+            break;
+        }
+        m_timers[idx] = m_timers[child];
+        m_timers[idx]->heapIdx = idx;
+        idx = child;
+    }
+    m_timers[idx] = task;
+    task->heapIdx = idx;
+}
+#endif
+
+} // namespace Thread
+} // namespace dt
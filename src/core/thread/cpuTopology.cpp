@@ -0,0 +1,411 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/cpuTopology.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <dirent.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <utility>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include <dtCore/dtLog>
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Functions Definition ---------------------------------------------*/
+static bool ReadLine(const std::string &path, char *buf, size_t len)
+{
+    FILE *fp = fopen(path.c_str(), "r");
+    if (!fp) return false;
+    const bool ok = (fgets(buf, (int)len, fp) != nullptr);
+    fclose(fp);
+    if (!ok) return false;
+    buf[strcspn(buf, "\n")] = '\0';
+    return true;
+}
+
+static int ReadInt(const std::string &path, int def)
+{
+    char buf[64];
+    if (!ReadLine(path, buf, sizeof(buf))) return def;
+    char *end = nullptr;
+    long v = strtol(buf, &end, 10);
+    return (end == buf) ? def : (int)v;
+}
+
+static bool ReadCpuListFile(const std::string &path, std::vector<int> &cpus)
+{
+    char buf[4096];
+    cpus.clear();
+    if (!ReadLine(path, buf, sizeof(buf))) return false;
+    return ParseCpuList(buf, cpus) == 0;
+}
+
+static bool Contains(const std::vector<int> &list, int v)
+{
+    return std::find(list.begin(), list.end(), v) != list.end();
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+static void ReadAffinity(std::vector<int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+        {
+            if (CPU_ISSET(i, &set)) cpus.push_back(i);
+        }
+    }
+}
+
+static void ReadCgroupCpus(const std::string &sysfsRoot, std::vector<int> &cpus)
+{
+    FILE *fp = fopen("/proc/self/cgroup", "r");
+    if (!fp) return;
+    char line[1024];
+    std::string v2, v1;
+    while (fgets(line, sizeof(line), fp))
+    {
+        line[strcspn(line, "\n")] = '\0';
+        if (strncmp(line, "0::", 3) == 0)
+        {
+            v2 = line + 3;
+            continue;
+        }
+        // cgroup v1: "<id>:<controllers>:<path>"
+        char *ctrl = strchr(line, ':');
+        char *path = ctrl ? strchr(ctrl + 1, ':') : nullptr;
+        if (path)
+        {
+            *path = '\0';
+            if (strstr(ctrl + 1, "cpuset")) v1 = path + 1;
+        }
+    }
+    fclose(fp);
+
+    if (!v1.empty() && ReadCpuListFile(sysfsRoot + "/fs/cgroup/cpuset" + v1 + "/cpuset.effective_cpus", cpus)) return;
+    if (!v2.empty()) ReadCpuListFile(sysfsRoot + "/fs/cgroup" + v2 + "/cpuset.cpus.effective", cpus);
+}
+#endif
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+bool CpuTopology::SameCore(int a, int b) const
+{
+    const CpuTopoInfo *ia = Get(a);
+    return ia && (a == b || Contains(ia->siblings, b));
+}
+
+bool CpuTopology::SharesL2(int a, int b) const
+{
+    const CpuTopoInfo *ia = Get(a), *ib = Get(b);
+    if (!ia || !ib) return false;
+    // without cache info, an SMT core still shares its L2
+    return (ia->l2 >= 0) ? (ia->l2 == ib->l2) : SameCore(a, b);
+}
+
+bool CpuTopology::SharesL3(int a, int b) const
+{
+    const CpuTopoInfo *ia = Get(a), *ib = Get(b);
+    return ia && ib && ia->l3 >= 0 && ia->l3 == ib->l3;
+}
+
+bool CpuTopology::SameNode(int a, int b) const
+{
+    const CpuTopoInfo *ia = Get(a), *ib = Get(b);
+    return ia && ib && ia->node == ib->node;
+}
+
+bool CpuTopology::IsHousekeeping(int cpu) const
+{
+    const CpuTopoInfo *i = Get(cpu);
+    return i && i->online && i->allowed && !i->isolated && !i->nohzFull;
+}
+
+int ParseCpuList(const char *str, std::vector<int> &cpus)
+{
+    cpus.clear();
+    const char *s = str;
+    while (*s == ' ') ++s;
+    while (*s)
+    {
+        char *end = nullptr;
+        long a = strtol(s, &end, 10);
+        if (end == s || a < 0) return -1;
+        long b = a, stride = 1;
+        if (*end == '-')
+        {
+            s = end + 1;
+            b = strtol(s, &end, 10);
+            if (end == s || b < a) return -1;
+            if (*end == ':') // isolcpus style "0-7:2"
+            {
+                s = end + 1;
+                stride = strtol(s, &end, 10);
+                if (end == s || stride <= 0) return -1;
+            }
+        }
+        for (long c = a; c <= b; c += stride)
+        {
+            cpus.push_back((int)c);
+        }
+        if (*end == ',') ++end;
+        else if (*end && *end != ' ') return -1;
+        s = end;
+        while (*s == ' ') ++s;
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return 0;
+}
+
+std::string FormatCpuList(const std::vector<int> &list)
+{
+    std::vector<int> cpus(list);
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+    std::string out;
+    char buf[32];
+    for (size_t i = 0; i < cpus.size();)
+    {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (j > i) snprintf(buf, sizeof(buf), "%s%d-%d", out.empty() ? "" : ",", cpus[i], cpus[j]);
+        else snprintf(buf, sizeof(buf), "%s%d", out.empty() ? "" : ",", cpus[i]);
+        out += buf;
+        i = j + 1;
+    }
+    return out;
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+int ReadCpuTopology(CpuTopology &topo, const char *sysfsRoot)
+{
+    topo = CpuTopology();
+    const std::string root = sysfsRoot ? sysfsRoot : "/sys";
+    const std::string base = root + "/devices/system/cpu";
+    const bool live = (root == "/sys");
+
+    std::vector<int> possible;
+    if (!ReadCpuListFile(base + "/possible", possible) || possible.empty())
+    {
+        if (!live)
+        {
+            LOG(err).printf("!Error! ReadCpuTopology() : cannot read %s/possible", base.c_str());
+            return -1;
+        }
+        for (long i = 0, n = sysconf(_SC_NPROCESSORS_CONF); i < n; ++i) possible.push_back((int)i);
+    }
+    if (!ReadCpuListFile(base + "/online", topo.online)) topo.online = possible;
+    ReadCpuListFile(base + "/isolated", topo.isolated);
+    ReadCpuListFile(base + "/nohz_full", topo.nohzFull);
+    if (live)
+    {
+        ReadAffinity(topo.allowed);
+        ReadCgroupCpus(root, topo.cgroupCpus);
+    }
+    else
+    {
+        topo.allowed = topo.online;
+    }
+
+    topo.cpus.resize(possible.back() + 1);
+    for (int cpu = 0; cpu < (int)topo.cpus.size(); ++cpu)
+    {
+        CpuTopoInfo &info = topo.cpus[cpu];
+        info.cpu = cpu;
+        info.online = Contains(topo.online, cpu);
+        info.allowed = Contains(topo.allowed, cpu);
+        info.isolated = Contains(topo.isolated, cpu);
+        info.nohzFull = Contains(topo.nohzFull, cpu);
+        if (!info.online) continue;
+
+        const std::string dir = base + "/cpu" + std::to_string(cpu);
+        info.core = ReadInt(dir + "/topology/core_id", -1);
+        info.package = ReadInt(dir + "/topology/physical_package_id", -1);
+        if (!ReadCpuListFile(dir + "/topology/thread_siblings_list", info.siblings) || info.siblings.empty())
+        {
+            info.siblings.assign(1, cpu);
+        }
+
+        for (int idx = 0; idx < 16; ++idx)
+        {
+            const std::string cache = dir + "/cache/index" + std::to_string(idx);
+            const int level = ReadInt(cache + "/level", -1);
+            if (level < 0) break;
+            char type[32];
+            if (ReadLine(cache + "/type", type, sizeof(type)) && strcmp(type, "Instruction") == 0) continue;
+            std::vector<int> shared;
+            if (!ReadCpuListFile(cache + "/shared_cpu_list", shared) || shared.empty()) continue;
+            if (level == 2) info.l2 = shared.front();
+            else if (level == 3) info.l3 = shared.front();
+        }
+    }
+
+    // NUMA nodes
+    const std::string nodeBase = root + "/devices/system/node";
+    if (DIR *dir = opendir(nodeBase.c_str()))
+    {
+        while (struct dirent *ent = readdir(dir))
+        {
+            int node;
+            if (sscanf(ent->d_name, "node%d", &node) != 1) continue;
+            std::vector<int> cpus;
+            if (!ReadCpuListFile(nodeBase + "/" + ent->d_name + "/cpulist", cpus) || cpus.empty()) continue;
+            topo.numNodes++;
+            for (int cpu : cpus)
+            {
+                if (cpu < (int)topo.cpus.size()) topo.cpus[cpu].node = node;
+            }
+        }
+        closedir(dir);
+    }
+    if (topo.numNodes == 0)
+    {
+        topo.numNodes = 1;
+        for (CpuTopoInfo &info : topo.cpus) info.node = 0;
+    }
+
+    std::set<int> packages;
+    std::set<std::pair<int, int>> cores;
+    for (const CpuTopoInfo &info : topo.cpus)
+    {
+        if (!info.online) continue;
+        packages.insert(info.package);
+        cores.insert(std::make_pair(info.package, info.siblings.front()));
+    }
+    topo.numPackages = (int)packages.size();
+    topo.numCores = (int)cores.size();
+    return 0;
+}
+
+const CpuTopology &GetCpuTopology()
+{
+    static CpuTopology topo;
+    static std::once_flag once;
+    std::call_once(once, []() { ReadCpuTopology(topo); });
+    return topo;
+}
+#endif
+
+std::vector<int> GetHousekeepingCpus(const CpuTopology &topo, const std::vector<int> &rtCpus)
+{
+    std::vector<int> all, noCore, noL2;
+    for (const CpuTopoInfo &info : topo.cpus)
+    {
+        if (!topo.IsHousekeeping(info.cpu)) continue;
+        bool core = false, l2 = false;
+        for (int rt : rtCpus)
+        {
+            core |= topo.SameCore(info.cpu, rt);
+            l2 |= topo.SharesL2(info.cpu, rt);
+        }
+        all.push_back(info.cpu);
+        if (!core) noCore.push_back(info.cpu);
+        if (!core && !l2) noL2.push_back(info.cpu);
+    }
+    return !noL2.empty() ? noL2 : (!noCore.empty() ? noCore : all);
+}
+
+int PickHousekeepingCpu(const CpuTopology &topo, const std::vector<int> &rtCpus, int nearCpu, const std::vector<int> &busyCpus)
+{
+    int best = -1;
+    long bestScore = 0;
+    for (int cpu : GetHousekeepingCpus(topo, rtCpus))
+    {
+        // locality first, then load; ties go to the lower CPU
+        long score = 0;
+        if (nearCpu >= 0)
+        {
+            score += topo.SharesL3(cpu, nearCpu) ? 2000000 : 0;
+            score += topo.SameNode(cpu, nearCpu) ? 1000000 : 0;
+        }
+        score -= (long)std::count(busyCpus.begin(), busyCpus.end(), cpu) * 1000;
+        score -= (cpu == 0) ? 1 : 0; // CPU 0 takes most IRQs and timers by default
+        if (best < 0 || score > bestScore)
+        {
+            best = cpu;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+int PickRtCpu(const CpuTopology &topo, const std::vector<int> &rtCpus)
+{
+    const bool cgroupKnown = !topo.cgroupCpus.empty();
+    int best = -1;
+    long bestScore = 0;
+    for (int pass = 0; pass < 2 && best < 0; ++pass)
+    {
+        for (const CpuTopoInfo &info : topo.cpus)
+        {
+            // isolcpus= drops the CPU from the default affinity, but a thread may still be pinned there
+            if (!info.online || !(info.allowed || info.isolated)) continue;
+            if (cgroupKnown && !Contains(topo.cgroupCpus, info.cpu)) continue;
+            if (Contains(rtCpus, info.cpu)) continue;
+            bool core = false, l2 = false;
+            for (int rt : rtCpus)
+            {
+                core |= topo.SameCore(info.cpu, rt);
+                l2 |= topo.SharesL2(info.cpu, rt);
+            }
+            if (core && pass == 0) continue; // second pass: SMT siblings of busy RT cores as last resort
+
+            long score = info.cpu;
+            score += (info.isolated && info.nohzFull) ? 30000 : 0;
+            score += (info.isolated || info.nohzFull) ? 20000 : 0;
+            score += l2 ? 0 : 10000;
+            score -= (info.cpu == 0) ? 5000 : 0;
+            if (best < 0 || score > bestScore)
+            {
+                best = info.cpu;
+                bestScore = score;
+            }
+        }
+    }
+    return best;
+}
+
+void PrintCpuTopology(const CpuTopology &topo)
+{
+    LOG(info).printf("========= CPU Topology =========");
+    LOG_CONT(info).printf("packages %d, cores %d, cpus %zu, NUMA nodes %d\n", topo.numPackages, topo.numCores,
+                          topo.online.size(), topo.numNodes);
+    LOG_CONT(info).printf("online   : %s\n", FormatCpuList(topo.online).c_str());
+    LOG_CONT(info).printf("allowed  : %s\n", FormatCpuList(topo.allowed).c_str());
+    LOG_CONT(info).printf("cgroup   : %s\n", topo.cgroupCpus.empty() ? "-" : FormatCpuList(topo.cgroupCpus).c_str());
+    LOG_CONT(info).printf("isolated : %s\n", topo.isolated.empty() ? "-" : FormatCpuList(topo.isolated).c_str());
+    LOG_CONT(info).printf("nohz_full: %s\n", topo.nohzFull.empty() ? "-" : FormatCpuList(topo.nohzFull).c_str());
+    LOG_CONT(info).printf(" cpu  pkg core node   L2   L3  siblings  flags\n");
+    for (const CpuTopoInfo &i : topo.cpus)
+    {
+        if (!i.online)
+        {
+            LOG_CONT(info).printf("%4d  offline\n", i.cpu);
+            continue;
+        }
+        LOG_CONT(info).printf("%4d %4d %4d %4d %4d %4d  %-8s  %s%s%s\n", i.cpu, i.package, i.core, i.node, i.l2, i.l3,
+                              FormatCpuList(i.siblings).c_str(), i.allowed ? "allowed " : "",
+                              i.isolated ? "isolated " : "", i.nohzFull ? "nohz_full" : "");
+    }
+    LOG_CONT(info).printf("------------------------------------");
+}
+
+} // namespace Thread
+} // namespace dt
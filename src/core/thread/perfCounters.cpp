@@ -0,0 +1,458 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/perfCounters.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
+#include <dtCore/dtLog>
+
+//* System-Specific Headers --------------------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Variables --------------------------------------------------------*/
+static const char *const perfEventNames[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "cache-misses", "context-switches", "page-faults", "migrations"};
+
+//* Private Functions Definition ---------------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+static inline uint64_t ThreadCpuNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int PerfEventOpen(struct perf_event_attr *attr, int tid, int groupFd)
+{
+    return (int)syscall(SYS_perf_event_open, attr, tid, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+static bool PerfEventAttr(struct perf_event_attr &attr, int ev, bool hardware)
+{
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = hardware ? PERF_TYPE_HARDWARE : PERF_TYPE_SOFTWARE;
+    switch ((PerfEvent)ev)
+    {
+    case PerfEvent::Cycles:
+        attr.config = hardware ? (uint64_t)PERF_COUNT_HW_CPU_CYCLES : (uint64_t)PERF_COUNT_SW_TASK_CLOCK;
+        return true;
+    case PerfEvent::Instructions:
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        return hardware;
+    case PerfEvent::CacheMisses:
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        return hardware;
+    case PerfEvent::ContextSwitches:
+        attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+        return !hardware;
+    case PerfEvent::PageFaults:
+        attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+        return !hardware;
+    case PerfEvent::Migrations:
+        attr.config = PERF_COUNT_SW_CPU_MIGRATIONS;
+        return !hardware;
+    }
+    return false;
+}
+
+static const char *PerfErrorHint(int err)
+{
+    switch (err)
+    {
+    case EACCES:
+    case EPERM:
+        return "not permitted (kernel.perf_event_paranoid, CAP_PERFMON)";
+    case ENOENT:
+    case EOPNOTSUPP:
+        return "event not supported (no PMU, e.g. in a VM)";
+    case ENOSYS:
+        return "perf_event_open not available in this kernel";
+    case EMFILE:
+        return "too many open files";
+    default:
+        return strerror(err);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64_t Rdpmc(uint32_t counter)
+{
+    uint32_t lo, hi;
+    __asm__ volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(counter));
+    return (uint64_t)lo | ((uint64_t)hi << 32);
+}
+#endif
+#endif
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+const char *PerfEventName(PerfEvent ev)
+{
+    const int i = (int)ev;
+    return (i >= 0 && i < PERF_EVENT_COUNT) ? perfEventNames[i] : "?";
+}
+
+const char *PerfSourceName(PerfSource src)
+{
+    switch (src)
+    {
+    case PerfSource::Hardware: return "hw";
+    case PerfSource::Software: return "sw";
+    case PerfSource::Emulated: return "emul";
+    default: return "n/a";
+    }
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+bool PerfCounters::OpenGroup(Group &g, const int *evs, int count, bool hardware, int tid)
+{
+    int lastErr = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        struct perf_event_attr attr;
+        if (!PerfEventAttr(attr, evs[i], hardware))
+        {
+            continue;
+        }
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = (g.n == 0) ? 1 : 0; // the leader starts the whole group
+        attr.exclude_hv = 1;
+        attr.exclude_kernel = m_config.userOnly ? 1 : 0;
+
+        int fd = PerfEventOpen(&attr, tid, (g.n == 0) ? -1 : g.fd[0]);
+        if (fd < 0 && (errno == EACCES || errno == EPERM) && !attr.exclude_kernel)
+        {
+            m_config.userOnly = true; // perf_event_paranoid >= 2: user space only
+            attr.exclude_kernel = 1;
+            fd = PerfEventOpen(&attr, tid, (g.n == 0) ? -1 : g.fd[0]);
+        }
+        if (fd < 0)
+        {
+            lastErr = errno;
+            continue;
+        }
+        g.fd[g.n] = fd;
+        g.ev[g.n] = evs[i];
+        g.n++;
+        m_src[evs[i]] = hardware ? PerfSource::Hardware : PerfSource::Software;
+    }
+    if (g.n == 0)
+    {
+        if (lastErr)
+        {
+            LOG(warn).printf("PerfCounters : %s events unavailable, %s", hardware ? "hardware" : "software",
+                             PerfErrorHint(lastErr));
+        }
+        return false;
+    }
+    ioctl(g.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(g.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerfCounters::CloseGroup(Group &g)
+{
+    // members first, then the leader
+    for (int i = g.n - 1; i >= 0; --i)
+    {
+        if (g.fd[i] >= 0)
+        {
+            close(g.fd[i]);
+        }
+        g.fd[i] = -1;
+    }
+    g.n = 0;
+}
+
+bool PerfCounters::ReadGroup(const Group &g, uint64_t (&value)[PERF_EVENT_COUNT]) noexcept
+{
+    // PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING: nr, enabled, running, value[nr]
+    uint64_t buf[3 + PERF_EVENT_COUNT];
+    const ssize_t len = read(g.fd[0], buf, sizeof(buf));
+    if (len < (ssize_t)(3 * sizeof(uint64_t)) || buf[0] != (uint64_t)g.n || buf[2] == 0)
+    {
+        return false; // group not scheduled yet
+    }
+    const uint64_t enabled = buf[1];
+    const uint64_t running = buf[2];
+    for (int i = 0; i < g.n; ++i)
+    {
+        uint64_t v = buf[3 + i];
+        if (running < enabled)
+        {
+            v = (uint64_t)((double)v * (double)enabled / (double)running); // multiplexed with other users of the PMU
+        }
+        value[g.ev[i]] = v;
+    }
+    return true;
+}
+
+bool PerfCounters::ReadRdpmc(uint64_t (&value)[PERF_EVENT_COUNT]) noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    for (int i = 0; i < m_hw.n; ++i)
+    {
+        volatile struct perf_event_mmap_page *pc = static_cast<volatile struct perf_event_mmap_page *>(m_mmap[i]);
+        uint32_t seq;
+        int64_t count;
+        do
+        {
+            seq = pc->lock;
+            __asm__ volatile("" ::: "memory");
+            const uint32_t idx = pc->index;
+            if (!pc->cap_user_rdpmc || idx == 0)
+            {
+                return false; // counter not on the PMU right now: read() gives the saved value
+            }
+            count = pc->offset;
+            const uint16_t width = pc->pmc_width;
+            int64_t pmc = (int64_t)Rdpmc(idx - 1);
+            pmc = (int64_t)((uint64_t)pmc << (64 - width)) >> (64 - width); // sign-extend
+            count += pmc;
+            __asm__ volatile("" ::: "memory");
+        } while (pc->lock != seq);
+        value[m_hw.ev[i]] = (uint64_t)count;
+    }
+    return true;
+#else
+    (void)value;
+    return false;
+#endif
+}
+
+bool PerfCounters::Open(const PerfConfig &config, int tid)
+{
+    Close();
+    m_config = config;
+    m_tid = tid;
+
+    static const int hwEvents[] = {(int)PerfEvent::Cycles, (int)PerfEvent::Instructions, (int)PerfEvent::CacheMisses};
+    if (config.hardware)
+    {
+        OpenGroup(m_hw, hwEvents, 3, true, tid);
+    }
+    // without a PMU cycles becomes task-clock (ns) in the software group
+    int swEvents[4];
+    int nsw = 0;
+    if (m_src[(int)PerfEvent::Cycles] == PerfSource::None)
+    {
+        swEvents[nsw++] = (int)PerfEvent::Cycles;
+    }
+    swEvents[nsw++] = (int)PerfEvent::ContextSwitches;
+    swEvents[nsw++] = (int)PerfEvent::PageFaults;
+    swEvents[nsw++] = (int)PerfEvent::Migrations;
+    OpenGroup(m_sw, swEvents, nsw, false, tid);
+
+    // without perf_event_open: what the thread can measure on itself
+    if (tid == 0)
+    {
+        static const PerfEvent emulated[] = {PerfEvent::Cycles, PerfEvent::ContextSwitches, PerfEvent::PageFaults,
+                                             PerfEvent::Migrations};
+        for (PerfEvent ev : emulated)
+        {
+            if (m_src[(int)ev] == PerfSource::None)
+            {
+                m_src[(int)ev] = PerfSource::Emulated;
+                m_emulated = true;
+            }
+        }
+    }
+    m_cyclesNs = (m_src[(int)PerfEvent::Cycles] != PerfSource::Hardware);
+
+    // rdpmc: every PMU member needs its mmap page (index and offset of the counter)
+    if (config.useRdpmc && tid == 0 && m_hw.n > 0)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const long pageSz = sysconf(_SC_PAGESIZE);
+        m_rdpmc = true;
+        for (int i = 0; i < m_hw.n; ++i)
+        {
+            void *p = mmap(nullptr, (size_t)pageSz, PROT_READ, MAP_SHARED, m_hw.fd[i], 0);
+            if (p == MAP_FAILED)
+            {
+                m_rdpmc = false;
+                break;
+            }
+            m_mmap[i] = p;
+            if (!static_cast<struct perf_event_mmap_page *>(p)->cap_user_rdpmc)
+            {
+                m_rdpmc = false; // /sys/bus/event_source/devices/cpu/rdpmc == 0
+            }
+        }
+#endif
+    }
+
+    if (config.ringSize > 0 && !m_ring.Allocate(config.ringSize))
+    {
+        LOG(warn).printf("PerfCounters : cannot allocate the sample ring (%zu)", config.ringSize);
+    }
+
+    bool any = false;
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        any = any || (m_src[i] != PerfSource::None);
+    }
+    if (!any)
+    {
+        Close();
+        return false;
+    }
+    LOG(info).printf("PerfCounters : tid %d, %s(%s) %s(%s) %s(%s) %s(%s) %s(%s) %s(%s)%s", tid ? tid : (int)syscall(SYS_gettid),
+                     perfEventNames[0], PerfSourceName(m_src[0]), perfEventNames[1], PerfSourceName(m_src[1]),
+                     perfEventNames[2], PerfSourceName(m_src[2]), perfEventNames[3], PerfSourceName(m_src[3]),
+                     perfEventNames[4], PerfSourceName(m_src[4]), perfEventNames[5], PerfSourceName(m_src[5]),
+                     m_rdpmc ? ", rdpmc" : "");
+
+    m_lastCpu = (tid == 0) ? sched_getcpu() : -1;
+    ReadNow(m_begin);
+    m_cur = PerfTotals{};
+    m_totals.Store(m_cur);
+    m_ready.store(true, std::memory_order_release);
+    return true;
+}
+
+void PerfCounters::Close()
+{
+    m_ready.store(false, std::memory_order_release);
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        if (m_mmap[i])
+        {
+            munmap(m_mmap[i], (size_t)sysconf(_SC_PAGESIZE));
+        }
+        m_mmap[i] = nullptr;
+    }
+    CloseGroup(m_hw);
+    CloseGroup(m_sw);
+    m_ring.Release();
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        m_src[i] = PerfSource::None;
+        m_raw[i] = 0;
+    }
+    m_rdpmc = false;
+    m_cyclesNs = false;
+    m_emulated = false;
+}
+
+void PerfCounters::ReadNow(uint64_t (&value)[PERF_EVENT_COUNT]) noexcept
+{
+    if (m_hw.n > 0 && !(m_rdpmc && ReadRdpmc(m_raw)))
+    {
+        ReadGroup(m_hw, m_raw);
+    }
+    if (m_sw.n > 0)
+    {
+        ReadGroup(m_sw, m_raw);
+    }
+    if (m_emulated)
+    {
+        if (m_src[(int)PerfEvent::Cycles] == PerfSource::Emulated)
+        {
+            m_raw[(int)PerfEvent::Cycles] = ThreadCpuNs();
+        }
+        if (m_src[(int)PerfEvent::ContextSwitches] == PerfSource::Emulated ||
+            m_src[(int)PerfEvent::PageFaults] == PerfSource::Emulated)
+        {
+            struct rusage ru;
+            if (getrusage(RUSAGE_THREAD, &ru) == 0)
+            {
+                if (m_src[(int)PerfEvent::ContextSwitches] == PerfSource::Emulated)
+                    m_raw[(int)PerfEvent::ContextSwitches] = (uint64_t)(ru.ru_nvcsw + ru.ru_nivcsw);
+                if (m_src[(int)PerfEvent::PageFaults] == PerfSource::Emulated)
+                    m_raw[(int)PerfEvent::PageFaults] = (uint64_t)(ru.ru_minflt + ru.ru_majflt);
+            }
+        }
+        if (m_src[(int)PerfEvent::Migrations] == PerfSource::Emulated)
+        {
+            // only the migrations seen between two reads are counted
+            const int cpu = sched_getcpu();
+            if (cpu != m_lastCpu)
+            {
+                m_raw[(int)PerfEvent::Migrations] += (m_lastCpu >= 0) ? 1 : 0;
+                m_lastCpu = cpu;
+            }
+        }
+    }
+    memcpy(value, m_raw, sizeof(value));
+}
+
+void PerfCounters::BeginCycle() noexcept
+{
+    if (!m_ready.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    ReadNow(m_begin);
+}
+
+void PerfCounters::EndCycle(uint64_t cycle) noexcept
+{
+    if (!m_ready.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    PerfSample s;
+    uint64_t now[PERF_EVENT_COUNT];
+    ReadNow(now);
+    s.cycle = cycle;
+    s.time_ns = dt::Utils::MonotonicNs();
+
+    PerfTotals &c = m_cur;
+    if (m_resetReq.exchange(false, std::memory_order_relaxed))
+    {
+        c = PerfTotals{};
+    }
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        const uint64_t d = (now[i] >= m_begin[i]) ? now[i] - m_begin[i] : 0; // scaled values may step back
+        s.value[i] = d;
+        c.last[i] = d;
+        c.sum[i] += d;
+        c.max[i] = (d > c.max[i]) ? d : c.max[i];
+    }
+    c.cycles++;
+    if (m_ring.Capacity() > 0 && !m_ring.TryPush(s))
+    {
+        c.dropped++;
+    }
+    m_totals.Store(c);
+}
+
+bool PerfCounters::PopSample(PerfSample &out) noexcept
+{
+    if (!IsOpen() || m_ring.Capacity() == 0)
+    {
+        return false;
+    }
+    return m_ring.TryPop(out);
+}
+
+bool PerfCounters::ReadTotals(PerfTotals &out) const noexcept
+{
+    return IsOpen() && m_totals.TryLoad(out);
+}
+#endif
+
+} // namespace Thread
+} // namespace dt
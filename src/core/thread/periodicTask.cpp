@@ -0,0 +1,384 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/periodicTask.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
+#include <dtCore/dtLog>
+#include "dtCore/src/dtThread/perfCounters.h"
+#include "dtCore/src/dtUtils/dtRtAlloc.h"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Types ------------------------------------------------------------*/
+class PeriodicTask
+{
+public:
+    PeriodicConfig config;
+    PeriodicCallback callback;
+    PeriodicStats stats;
+    PerfCounters perf;
+    PreciseWaiter waiter;
+    std::atomic<bool> stop{false};
+};
+
+//* Private Variables --------------------------------------------------------*/
+static std::mutex periodicMtx;
+static std::vector<PeriodicTask *> periodicList; // live tasks, for StopAllPeriodicThreads()
+
+//* Private Functions Definition ---------------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+static inline int64_t ThreadCpuNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void SleepUntilNs(int64_t deadline_ns)
+{
+    struct timespec ts;
+    ts.tv_sec = deadline_ns / 1000000000LL;
+    ts.tv_nsec = deadline_ns % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+        // absolute deadline: resuming after a signal does not stretch the period
+    }
+}
+
+static void *PeriodicProc(void *arg)
+{
+    PeriodicTask *task = static_cast<PeriodicTask *>(arg);
+    const int64_t period = task->config.period_ns;
+    uint32_t catchUp = 0;
+    uint64_t cycle = 0;
+
+    // counters are opened on the thread itself (per-thread events, rdpmc)
+    if (task->config.perfCounters)
+    {
+        task->perf.Open();
+    }
+
+    // the cycle path must not touch the heap: marked for the RT allocation trap
+    dt::Utils::RtSection rtSection(task->config.realtime && task->config.rtAllocCheck);
+
+    int64_t deadline = dt::Utils::MonotonicNs() + period;
+    while (!task->stop.load(std::memory_order_relaxed))
+    {
+        if (task->config.preciseWake)
+        {
+            task->waiter.WaitUntil(deadline);
+        }
+        else
+        {
+            SleepUntilNs(deadline);
+        }
+        const int64_t wake = dt::Utils::MonotonicNs();
+        const int64_t cpuStart = ThreadCpuNs();
+        task->perf.BeginCycle();
+
+        const bool cont = task->callback(cycle);
+        const int64_t end = dt::Utils::MonotonicNs();
+        const int64_t cpu = ThreadCpuNs() - cpuStart;
+        task->perf.EndCycle(cycle++);
+
+        // next deadline and the overrun policy
+        uint64_t skipped = 0;
+        int64_t next = deadline + period;
+        const bool overrun = (end > next);
+        if (overrun)
+        {
+            switch (task->config.overrunPolicy)
+            {
+            case OverrunPolicy::CatchUp:
+                if (catchUp < task->config.maxCatchUp)
+                {
+                    ++catchUp; // next deadline already passed: run again without sleeping
+                    break;
+                }
+                [[fallthrough]];
+            case OverrunPolicy::Skip:
+                skipped = (uint64_t)((end - next) / period) + 1;
+                next += (int64_t)skipped * period;
+                catchUp = 0;
+                break;
+            case OverrunPolicy::Resync:
+                skipped = (uint64_t)((end - next) / period) + 1;
+                next = end + period;
+                catchUp = 0;
+                break;
+            }
+        }
+        else
+        {
+            catchUp = 0;
+        }
+
+        task->stats.Update(wake, deadline, end, cpu, overrun, skipped);
+        if (!cont)
+        {
+            break;
+        }
+        deadline = next;
+    }
+    return nullptr;
+}
+#endif
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+void PeriodicStats::Reset(int64_t targetPeriod_ns, int64_t budget_ns) noexcept
+{
+    m_cur = PeriodicStatsData{};
+    m_cur.targetPeriod_ns = targetPeriod_ns;
+    m_cur.budget_ns = budget_ns;
+    m_prevWake_ns = 0;
+    m_latencySum_ns = 0;
+    m_computeSum_ns = 0;
+    m_cpuSum_ns = 0;
+    m_avgCount = 0;
+    m_resetReq.store(false, std::memory_order_relaxed);
+    Publish();
+}
+
+void PeriodicStats::Update(int64_t wake_ns, int64_t deadline_ns, int64_t end_ns, int64_t cpu_ns, bool overrun, uint64_t skipped) noexcept
+{
+    PeriodicStatsData &c = m_cur;
+    if (m_resetReq.exchange(false, std::memory_order_relaxed))
+    {
+        c.periodMin_ns = c.periodMax_ns = 0;
+        c.latencyMax_ns = c.computeMax_ns = c.cpuMax_ns = 0;
+        m_latencySum_ns = m_computeSum_ns = m_cpuSum_ns = 0;
+        m_avgCount = 0;
+    }
+
+    c.cycles++;
+    c.overruns += overrun ? 1 : 0;
+    c.skipped += skipped;
+
+    c.latency_ns = wake_ns - deadline_ns;
+    c.compute_ns = end_ns - wake_ns;
+    c.cpu_ns = cpu_ns;
+    c.budgetOverruns += (c.budget_ns > 0 && cpu_ns > c.budget_ns) ? 1 : 0;
+    if (m_prevWake_ns != 0)
+    {
+        c.period_ns = wake_ns - m_prevWake_ns;
+        c.periodMin_ns = (c.periodMin_ns == 0) ? c.period_ns : std::min(c.periodMin_ns, c.period_ns);
+        c.periodMax_ns = std::max(c.periodMax_ns, c.period_ns);
+    }
+    m_prevWake_ns = wake_ns;
+
+    m_avgCount++;
+    m_latencySum_ns += c.latency_ns;
+    m_computeSum_ns += c.compute_ns;
+    m_cpuSum_ns += c.cpu_ns;
+    c.latencyAvg_ns = m_latencySum_ns / (int64_t)m_avgCount;
+    c.computeAvg_ns = m_computeSum_ns / (int64_t)m_avgCount;
+    c.cpuAvg_ns = m_cpuSum_ns / (int64_t)m_avgCount;
+    c.latencyMax_ns = std::max(c.latencyMax_ns, c.latency_ns);
+    c.computeMax_ns = std::max(c.computeMax_ns, c.compute_ns);
+    c.cpuMax_ns = std::max(c.cpuMax_ns, c.cpu_ns);
+
+    Publish();
+}
+
+void PeriodicStats::Publish() noexcept
+{
+    const PeriodicStatsData &c = m_cur;
+    const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_targetPeriod_ns.store(c.targetPeriod_ns, std::memory_order_relaxed);
+    m_cycles.store(c.cycles, std::memory_order_relaxed);
+    m_overruns.store(c.overruns, std::memory_order_relaxed);
+    m_skipped.store(c.skipped, std::memory_order_relaxed);
+    m_period_ns.store(c.period_ns, std::memory_order_relaxed);
+    m_periodMin_ns.store(c.periodMin_ns, std::memory_order_relaxed);
+    m_periodMax_ns.store(c.periodMax_ns, std::memory_order_relaxed);
+    m_latency_ns.store(c.latency_ns, std::memory_order_relaxed);
+    m_latencyAvg_ns.store(c.latencyAvg_ns, std::memory_order_relaxed);
+    m_latencyMax_ns.store(c.latencyMax_ns, std::memory_order_relaxed);
+    m_compute_ns.store(c.compute_ns, std::memory_order_relaxed);
+    m_computeAvg_ns.store(c.computeAvg_ns, std::memory_order_relaxed);
+    m_computeMax_ns.store(c.computeMax_ns, std::memory_order_relaxed);
+    m_budget_ns.store(c.budget_ns, std::memory_order_relaxed);
+    m_cpu_ns.store(c.cpu_ns, std::memory_order_relaxed);
+    m_cpuAvg_ns.store(c.cpuAvg_ns, std::memory_order_relaxed);
+    m_cpuMax_ns.store(c.cpuMax_ns, std::memory_order_relaxed);
+    m_budgetOverruns.store(c.budgetOverruns, std::memory_order_relaxed);
+
+    m_seq.store(seq + 2, std::memory_order_release);
+}
+
+bool PeriodicStats::Read(PeriodicStatsData &out, int retries) const noexcept
+{
+    for (int i = 0; i < retries; ++i)
+    {
+        const uint32_t s0 = m_seq.load(std::memory_order_acquire);
+        if (s0 & 1)
+        {
+            continue;
+        }
+        out.targetPeriod_ns = m_targetPeriod_ns.load(std::memory_order_relaxed);
+        out.cycles = m_cycles.load(std::memory_order_relaxed);
+        out.overruns = m_overruns.load(std::memory_order_relaxed);
+        out.skipped = m_skipped.load(std::memory_order_relaxed);
+        out.period_ns = m_period_ns.load(std::memory_order_relaxed);
+        out.periodMin_ns = m_periodMin_ns.load(std::memory_order_relaxed);
+        out.periodMax_ns = m_periodMax_ns.load(std::memory_order_relaxed);
+        out.latency_ns = m_latency_ns.load(std::memory_order_relaxed);
+        out.latencyAvg_ns = m_latencyAvg_ns.load(std::memory_order_relaxed);
+        out.latencyMax_ns = m_latencyMax_ns.load(std::memory_order_relaxed);
+        out.compute_ns = m_compute_ns.load(std::memory_order_relaxed);
+        out.computeAvg_ns = m_computeAvg_ns.load(std::memory_order_relaxed);
+        out.computeMax_ns = m_computeMax_ns.load(std::memory_order_relaxed);
+        out.budget_ns = m_budget_ns.load(std::memory_order_relaxed);
+        out.cpu_ns = m_cpu_ns.load(std::memory_order_relaxed);
+        out.cpuAvg_ns = m_cpuAvg_ns.load(std::memory_order_relaxed);
+        out.cpuMax_ns = m_cpuMax_ns.load(std::memory_order_relaxed);
+        out.budgetOverruns = m_budgetOverruns.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_seq.load(std::memory_order_relaxed) == s0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+int CreatePeriodicThread(ThreadInfo &thread, const PeriodicConfig &config, PeriodicCallback callback)
+{
+    if (config.period_ns <= 0 || !callback)
+    {
+        LOG(err).printf("!Error! CreatePeriodicThread() : invalid period(%lld ns) or callback", (long long)config.period_ns);
+        return -1;
+    }
+    if (thread.periodic)
+    {
+        LOG(err).printf("!Error! CreatePeriodicThread() : %s is already a periodic thread", thread.name);
+        return -1;
+    }
+
+    PeriodicTask *task = new (std::nothrow) PeriodicTask();
+    if (!task)
+    {
+        return -1;
+    }
+    task->config = config;
+    task->callback = std::move(callback);
+    // SCHED_DEADLINE: the reservation period defaults to the task's period
+    if (config.realtime && thread.dlRuntime_ns > 0 && thread.dlPeriod_ns == 0 && thread.dlDeadline_ns == 0)
+    {
+        thread.dlPeriod_ns = config.period_ns;
+    }
+    task->stats.Reset(config.period_ns, config.realtime ? thread.dlRuntime_ns : 0);
+    if (config.preciseWake)
+    {
+        task->waiter.Configure(config.preciseWait);
+    }
+
+    thread.procFunc = PeriodicProc;
+    thread.procFuncArg = task;
+    thread.periodic = task;
+    {
+        std::lock_guard<std::mutex> lock(periodicMtx);
+        periodicList.push_back(task);
+    }
+
+    if (CreateThread(thread, config.realtime, true))
+    {
+        ReleasePeriodicTask(thread);
+        return -1;
+    }
+    return 0;
+}
+
+int CreatePeriodicThread(ThreadInfo &thread, int64_t period_ns, PeriodicCallback callback)
+{
+    PeriodicConfig config;
+    config.period_ns = period_ns;
+    return CreatePeriodicThread(thread, config, std::move(callback));
+}
+
+void StopPeriodicThread(ThreadInfo &thread)
+{
+    if (thread.periodic)
+    {
+        thread.periodic->stop.store(true, std::memory_order_relaxed);
+    }
+}
+
+void StopAllPeriodicThreads()
+{
+    std::lock_guard<std::mutex> lock(periodicMtx);
+    for (PeriodicTask *task : periodicList)
+    {
+        task->stop.store(true, std::memory_order_relaxed);
+    }
+}
+
+void ReleasePeriodicTask(ThreadInfo &thread)
+{
+    PeriodicTask *task = thread.periodic;
+    if (!task)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(periodicMtx);
+        periodicList.erase(std::remove(periodicList.begin(), periodicList.end(), task), periodicList.end());
+    }
+    thread.periodic = nullptr;
+    thread.procFuncArg = nullptr;
+    delete task;
+}
+
+const PeriodicStats *GetPeriodicStats(const ThreadInfo &thread)
+{
+    return thread.periodic ? &thread.periodic->stats : nullptr;
+}
+
+PerfCounters *GetPerfCounters(const ThreadInfo &thread)
+{
+    return (thread.periodic && thread.periodic->perf.IsOpen()) ? &thread.periodic->perf : nullptr;
+}
+
+const PreciseWaiter *GetPreciseWaiter(const ThreadInfo &thread)
+{
+    return (thread.periodic && thread.periodic->config.preciseWake) ? &thread.periodic->waiter : nullptr;
+}
+
+int GetThreadTimeInfo(const ThreadInfo &thread, ThreadTimeInfo &timeInfo)
+{
+    PeriodicStatsData s;
+    if (!thread.periodic || !thread.periodic->stats.Read(s))
+    {
+        return -1;
+    }
+    timeInfo.targetPeriod_ms = s.targetPeriod_ns * 1e-6;
+    timeInfo.period_ms = s.period_ns * 1e-6;
+    timeInfo.algo_ms = s.compute_ns * 1e-6;
+    timeInfo.algoAvg_ms = s.computeAvg_ns * 1e-6;
+    timeInfo.algoMax_ms = s.computeMax_ns * 1e-6;
+    timeInfo.overrun = (int)s.overruns;
+    return 0;
+}
+#endif
+
+} // namespace Thread
+} // namespace dt
@@ -0,0 +1,121 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/preciseWait.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtLock.hpp"
+#include "dtCore/src/dtUtils/dtTimeUtil.hpp"
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Functions Definition ---------------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+static inline void SleepUntilNs(int64_t deadline_ns)
+{
+    struct timespec ts;
+    ts.tv_sec = deadline_ns / 1000000000LL;
+    ts.tv_nsec = deadline_ns % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+}
+#endif
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+int64_t GetMonotonicNs()
+{
+    return dt::Utils::MonotonicNs();
+}
+
+PreciseWaiter::PreciseWaiter(const PreciseWaitConfig &config) noexcept
+{
+    Configure(config);
+}
+
+void PreciseWaiter::Configure(const PreciseWaitConfig &config) noexcept
+{
+    m_config = config;
+    m_config.minMargin_ns = std::max<int64_t>(0, m_config.minMargin_ns);
+    m_config.maxMargin_ns = std::max(m_config.minMargin_ns, m_config.maxMargin_ns);
+    m_config.quantile = std::min(std::max(m_config.quantile, 0.5), 0.9999);
+    m_margin_ns = std::min(std::max(config.margin_ns, m_config.minMargin_ns), m_config.maxMargin_ns);
+    m_stepUp_ns = (int64_t)((double)m_config.step_ns * m_config.quantile + 0.5);
+    m_stepDown_ns = std::max<int64_t>(m_config.step_ns > 0 ? 1 : 0, (int64_t)((double)m_config.step_ns * (1.0 - m_config.quantile) + 0.5));
+    ResetStats();
+}
+
+void PreciseWaiter::ResetStats() noexcept
+{
+    m_cur = PreciseWaitStats{};
+    m_cur.margin_ns = m_margin_ns;
+    m_spinSum_ns = 0;
+    m_stats.Store(m_cur);
+}
+
+void PreciseWaiter::Adapt(int64_t latency_ns) noexcept
+{
+    // equilibrium where P(latency + guard > margin) = 1 - quantile
+    if (latency_ns + m_config.guard_ns > m_margin_ns)
+    {
+        m_margin_ns += m_stepUp_ns;
+    }
+    else
+    {
+        m_margin_ns -= m_stepDown_ns;
+    }
+    m_margin_ns = std::min(std::max(m_margin_ns, m_config.minMargin_ns), m_config.maxMargin_ns);
+}
+
+int64_t PreciseWaiter::WaitUntil(int64_t deadline_ns) noexcept
+{
+    PreciseWaitStats &c = m_cur;
+    int64_t now = GetMonotonicNs();
+
+    const int64_t sleepEnd = deadline_ns - m_margin_ns;
+    if (sleepEnd > now)
+    {
+        SleepUntilNs(sleepEnd);
+        now = GetMonotonicNs();
+        c.sleepLatency_ns = now - sleepEnd;
+        c.sleepLatencyMax_ns = std::max(c.sleepLatencyMax_ns, c.sleepLatency_ns);
+        c.misses += (now >= deadline_ns) ? 1 : 0;
+        Adapt(c.sleepLatency_ns);
+    }
+
+    const int64_t spinStart = now;
+    while (now < deadline_ns)
+    {
+        dt::Utils::CpuRelax();
+        now = GetMonotonicNs();
+    }
+
+    c.waits++;
+    c.margin_ns = m_margin_ns;
+    c.spin_ns = now - spinStart;
+    m_spinSum_ns += c.spin_ns;
+    c.spinAvg_ns = m_spinSum_ns / (int64_t)c.waits;
+    c.lateMax_ns = std::max(c.lateMax_ns, now - deadline_ns);
+    m_stats.Store(c);
+    return now;
+}
+
+int64_t PreciseWaiter::WaitFor(int64_t duration_ns) noexcept
+{
+    return WaitUntil(GetMonotonicNs() + duration_ns);
+}
+#endif
+
+} // namespace Thread
+} // namespace dt
@@ -1,14 +1,25 @@
 //* Related Headers ----------------------------------------------------------*/
 #include "dtCore/src/dtThread/threadImp.h"
+#include "dtCore/src/dtThread/periodicTask.h"
+#include "dtCore/src/dtThread/cpuTopology.h"
 
 //* C/C++ System Headers -----------------------------------------------------*/
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #if defined(_WIN32) || defined(__CYGWIN__)
 #else
 #include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/syscall.h>
+#endif
 #endif
 
 //* Other Lib Headers --------------------------------------------------------*/
@@ -91,18 +102,158 @@ int pthread_attr_setaffinity_np(pthread_attr_t *attr, size_t cpusetsize, const c
 }
 #endif
 
+/**
+ * Registry entry of a thread created with addList.
+ */
+typedef struct _threadEntry
+{
+    ThreadInfo *info = nullptr;
+    bool realtime = false;
+    void *(*procFunc)(void *arg) = nullptr;
+    void *procFuncArg = nullptr;
+    std::atomic<int> tid{0}; // kernel thread id, set when the thread starts
+} ThreadEntry;
+
+/**
+ * Growable, lock-protected list of handles. An index (listIdx) stays valid until the item is
+ * removed; freed slots are reused.
+ */
+template <typename T>
+class HandleList
+{
+public:
+    int Add(T *item)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (!m_free.empty())
+        {
+            int idx = m_free.back();
+            m_free.pop_back();
+            m_slots[idx] = item;
+            return idx;
+        }
+        m_slots.push_back(item);
+        return (int)m_slots.size() - 1;
+    }
+
+    // expected: remove only if the slot still holds this item (not a reuse of the index)
+    T *Remove(int idx, const T *expected = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (idx < 0 || idx >= (int)m_slots.size() || !m_slots[idx]) return nullptr;
+        if (expected && m_slots[idx] != expected) return nullptr;
+        T *item = m_slots[idx];
+        m_slots[idx] = nullptr;
+        m_free.push_back(idx);
+        return item;
+    }
+
+    // live items with their index, newest first (reverse creation order)
+    std::vector<std::pair<int, T *>> Snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        std::vector<std::pair<int, T *>> items;
+        for (int idx = (int)m_slots.size() - 1; idx >= 0; idx--)
+        {
+            if (m_slots[idx]) items.emplace_back(idx, m_slots[idx]);
+        }
+        return items;
+    }
+
+    // Items may be deleted as soon as the lock is released: ForEach() / Find() hand them to
+    // 'func' / 'copy' under the lock, which must copy out what the caller needs.
+    // func(idx, item) for the live items, newest first
+    template <typename Func>
+    void ForEach(Func &&func) const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        for (int idx = (int)m_slots.size() - 1; idx >= 0; idx--)
+        {
+            if (m_slots[idx]) func(idx, *m_slots[idx]);
+        }
+    }
+
+    // copy(item) for the first item that matches; returns false if there is none
+    template <typename Match, typename Copy>
+    bool Find(Match &&match, Copy &&copy) const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        for (T *item : m_slots)
+        {
+            if (item && match(*item))
+            {
+                copy(*item);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int Count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return (int)(m_slots.size() - m_free.size());
+    }
+
+private:
+    mutable std::mutex m_mtx;
+    std::vector<T *> m_slots;
+    std::vector<int> m_free;
+};
+
+#if defined(__linux__)
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+/**
+ * struct sched_attr of sched_setattr(2) (no glibc wrapper before 2.41).
+ */
+typedef struct _dlSchedAttr
+{
+    uint32_t size;
+    uint32_t schedPolicy;
+    uint64_t schedFlags;
+    int32_t schedNice;
+    uint32_t schedPriority;
+    uint64_t schedRuntime;
+    uint64_t schedDeadline;
+    uint64_t schedPeriod;
+} DlSchedAttr;
+
+/**
+ * Start-up handshake of a SCHED_DEADLINE thread. The policy can only be set on a running
+ * thread (sched_setattr), so the new thread applies it, or the fallback, and reports back to
+ * CreateThread() before it runs the thread function.
+ */
+typedef struct _deadlineStart
+{
+    ThreadInfo *info = nullptr;
+    ThreadEntry *entry = nullptr; // registered threads continue through ThreadStart()
+    cpu_set_t cpuset;             // affinity after a fallback
+    sem_t done;
+    int err = 0;                  // errno of sched_setattr() (0: admitted)
+    int policy = -1;              // policy applied
+    bool run = false;             // false: refused without fallback, the thread has returned
+} DeadlineStart;
+#endif
+
 //* Private Variables --------------------------------------------------------*/
-static int threadNum = 0; // thread list number
-static int semNum = 0;
-static int mtxNum = 0;
-static dt_thread_t *threadList[32];
-static dt_sem_t *semList[64];
-static dt_mutex_t *mtxList[64];
-static int maxCpuCnt = 0;
+static HandleList<ThreadEntry> threadList;
+static HandleList<dt_sem_t> semList;
+static HandleList<dt_mutex_t> mtxList;
+static std::atomic<int> maxCpuCnt{0};
 //* Private Functions --------------------------------------------------------*/
 #if defined(_WIN32) || defined(__CYGWIN__)
 #else
 int PrintThreadAttr(const pthread_attr_t *attr);
+void *ThreadStart(void *arg);
+#if defined(__linux__)
+void *DeadlineThreadStart(void *arg);
+const char *DeadlineErrorHint(int err);
+#endif
+int ReadTaskStatus(int tid, ThreadStatus &status);
+int PickThreadCpu(bool realtime);
 #endif
 
 //* Private Functions Definition ---------------------------------------------*/
@@ -155,6 +306,143 @@ error:
     LOG(err).printf("!Error! PrintThreadAttr() : %s(%d)\n", strerror(errno), errno);
     return -1;
 }
+
+void *ThreadStart(void *arg)
+{
+    ThreadEntry *entry = (ThreadEntry *)arg;
+#if defined(__linux__)
+    entry->tid.store((int)syscall(SYS_gettid), std::memory_order_release);
+#endif
+    return entry->procFunc(entry->procFuncArg);
+}
+
+#if defined(__linux__)
+void *DeadlineThreadStart(void *arg)
+{
+    DeadlineStart *start = (DeadlineStart *)arg;
+    ThreadInfo *info = start->info;
+    ThreadEntry *entry = start->entry;
+    void *(*procFunc)(void *arg) = info->procFunc;
+    void *procFuncArg = info->procFuncArg;
+
+    DlSchedAttr attr = {};
+    attr.size = sizeof(attr);
+    attr.schedPolicy = SCHED_DEADLINE;
+    attr.schedRuntime = (uint64_t)info->dlRuntime_ns;
+    attr.schedDeadline = (uint64_t)info->dlDeadline_ns;
+    attr.schedPeriod = (uint64_t)info->dlPeriod_ns;
+
+    start->run = true;
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) == 0)
+    {
+        start->policy = SCHED_DEADLINE;
+    }
+    else
+    {
+        start->err = errno;
+        struct sched_param param = {.sched_priority = info->priority};
+        switch (info->dlFallback)
+        {
+        case DeadlineFallback::None:
+            start->run = false;
+            break;
+        case DeadlineFallback::Fifo:
+            pthread_setaffinity_np(pthread_self(), sizeof(start->cpuset), &start->cpuset);
+            start->policy = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) ? SCHED_OTHER : SCHED_FIFO;
+            break;
+        case DeadlineFallback::Other:
+            pthread_setaffinity_np(pthread_self(), sizeof(start->cpuset), &start->cpuset);
+            start->policy = SCHED_OTHER;
+            break;
+        }
+    }
+
+    const bool run = start->run;
+    sem_post(&start->done); // 'start' is released by CreateThread() from here on
+    if (!run) return nullptr;
+    return entry ? ThreadStart(entry) : procFunc(procFuncArg);
+}
+
+const char *DeadlineErrorHint(int err)
+{
+    switch (err)
+    {
+    case EBUSY: return "admission control: not enough bandwidth left (other deadline tasks, kernel.sched_rt_runtime_us)";
+    case EPERM: return "no CAP_SYS_NICE / RLIMIT_RTPRIO, or affinity narrower than the root domain";
+    case EINVAL: return "invalid runtime/deadline/period";
+    case ENOSYS: return "kernel without SCHED_DEADLINE";
+    default: return "";
+    }
+}
+#endif
+
+int ReadTaskStatus(int tid, ThreadStatus &status)
+{
+#if defined(__linux__)
+    char path[64];
+    char buf[1024];
+    FILE *fp;
+    size_t len;
+
+    // /proc/self/task/<tid>/stat: fields after "(comm)" start at 3 (state)
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+    if (!(fp = fopen(path, "r"))) return -1;
+    len = fread(buf, 1, sizeof(buf) - 1, fp);
+    fclose(fp);
+    buf[len] = '\0';
+
+    char *p = strrchr(buf, ')');
+    if (!p) return -1;
+    unsigned long long utime = 0, stime = 0;
+    int field = 2;
+    char *save = nullptr;
+    for (char *tok = strtok_r(p + 1, " ", &save); tok; tok = strtok_r(nullptr, " ", &save))
+    {
+        field++;
+        if (field == 14) utime = strtoull(tok, nullptr, 10);
+        else if (field == 15) stime = strtoull(tok, nullptr, 10);
+        else if (field == 39) status.lastCpu = atoi(tok);
+        else if (field == 40) status.priority = atoi(tok);
+        else if (field == 41) { status.policy = atoi(tok); break; }
+    }
+    const double msPerTick = 1000.0 / (double)sysconf(_SC_CLK_TCK);
+    status.userTime_ms = (double)utime * msPerTick;
+    status.sysTime_ms = (double)stime * msPerTick;
+
+    // /proc/self/task/<tid>/status: context switches, affinity
+    snprintf(path, sizeof(path), "/proc/self/task/%d/status", tid);
+    if (!(fp = fopen(path, "r"))) return -1;
+    while (fgets(buf, sizeof(buf), fp))
+    {
+        if (sscanf(buf, "voluntary_ctxt_switches: %ld", &status.volCtxSwitches) == 1) continue;
+        if (sscanf(buf, "nonvoluntary_ctxt_switches: %ld", &status.involCtxSwitches) == 1) continue;
+        if (strncmp(buf, "Cpus_allowed_list:", 18) == 0)
+        {
+            char *v = buf + 18;
+            while (*v == ' ' || *v == '\t') v++;
+            v[strcspn(v, "\n")] = '\0';
+            strncpy(status.cpusAllowed, v, sizeof(status.cpusAllowed) - 1);
+            status.cpusAllowed[sizeof(status.cpusAllowed) - 1] = '\0';
+        }
+    }
+    fclose(fp);
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int PickThreadCpu(bool realtime)
+{
+    // CPUs of the registered threads: RT ones are avoided, the rest spread the load
+    std::vector<int> rtCpus, busyCpus;
+    threadList.ForEach([&rtCpus, &busyCpus](int, const ThreadEntry &e) {
+        (e.realtime ? rtCpus : busyCpus).push_back(e.info->cpuIdx);
+    });
+    const CpuTopology &topo = GetCpuTopology();
+    if (realtime) return PickRtCpu(topo, rtCpus);
+    return PickHousekeepingCpu(topo, rtCpus, -1, busyCpus);
+}
 #endif
 
 //* Public(Exported) Functions Definition ------------------------------------*/
@@ -174,7 +462,7 @@ int GetCpuCount(void)
             // success
             // maxCpuCnt = CPU_COUNT_S(setsize, cpusetp);
             maxCpuCnt = sysconf(_SC_NPROCESSORS_ONLN);
-            LOG_CONT(info).printf("Max CPU Core Count: %d\n", maxCpuCnt);
+            LOG_CONT(info).printf("Max CPU Core Count: %d\n", maxCpuCnt.load());
             CPU_FREE(cpusetp);
             break;
         }
@@ -195,11 +483,24 @@ int CreateThread(ThreadInfo &thread, bool realtime, bool addList)
     cpu_set_t cpuset;
     pthread_attr_t taskAttr;
     struct sched_param taskParam = {.sched_priority = thread.priority};
+    ThreadEntry *entry = nullptr;
+#if defined(__linux__)
+    const bool deadline = realtime && thread.dlRuntime_ns > 0;
+    DeadlineStart *dlStart = nullptr;
+#else
+    const bool deadline = false;
+#endif
     LOG(info).printf("========= %s =========", realtime ? "CreateRtThread()": "CreateNonRtThread()");
     if (maxCpuCnt == 0) GetCpuCount();
     LOG_CONT(info).printf("Thread Name: %s\n", thread.name);
+    thread.policy = -1;
 
     /* Step 1. Check CPU assign */
+    if (thread.cpuIdx == CPU_AUTO)
+    {
+        thread.cpuIdx = PickThreadCpu(realtime);
+        LOG_CONT(info).printf("CPU Index: auto(%d) ... %s\n", thread.cpuIdx, thread.cpuIdx >= 0 ? "ok" : "failed");
+    }
     if (thread.cpuIdx < 0 || thread.cpuIdx >= maxCpuCnt)
     {
         LOG_CONT(info).printf("CPU Index: %d ... user error: Check the CPU Index\n", thread.cpuIdx);
@@ -211,20 +512,54 @@ int CreateThread(ThreadInfo &thread, bool realtime, bool addList)
     CPU_ZERO(&cpuset);               // removes all CPUs from cpuset
     CPU_SET(thread.cpuIdx, &cpuset); // add CPU idx to the cpuset
 
+#if defined(__linux__)
+    if (deadline)
+    {
+        // deadline defaults to the period and vice versa; the kernel needs runtime <= deadline <= period
+        if (thread.dlDeadline_ns == 0) thread.dlDeadline_ns = thread.dlPeriod_ns;
+        if (thread.dlPeriod_ns == 0) thread.dlPeriod_ns = thread.dlDeadline_ns;
+        LOG_CONT(info).printf("SCHED_DEADLINE: runtime %lld ns, deadline %lld ns, period %lld ns ... ",
+                              (long long)thread.dlRuntime_ns, (long long)thread.dlDeadline_ns, (long long)thread.dlPeriod_ns);
+        if (thread.dlRuntime_ns < 1024 || thread.dlRuntime_ns > thread.dlDeadline_ns || thread.dlDeadline_ns > thread.dlPeriod_ns)
+        {
+            LOG_CONT(info).printf("user error: 1 us <= runtime <= deadline <= period\n");
+            errno = EINVAL;
+            goto error_no_destroy;
+        }
+        LOG_CONT(info).printf("ok (CPU %d after a fallback only)\n", thread.cpuIdx);
+        dlStart = new DeadlineStart();
+        dlStart->info = &thread;
+        dlStart->cpuset = cpuset;
+        sem_init(&dlStart->done, 0, 0);
+    }
+#endif
+
     /* Step 2. Thread attribute setting */
     LOG_CONT(info).printf("Set pthread attribute ... ");
-    if (pthread_attr_init(&taskAttr)) goto error;
+    if (pthread_attr_init(&taskAttr)) goto error_no_destroy;
     if (pthread_attr_setinheritsched(&taskAttr, PTHREAD_EXPLICIT_SCHED)) goto error;
-    if (realtime)
+    if (realtime && !deadline)
     {
         if (pthread_attr_setschedpolicy(&taskAttr, SCHED_FIFO)) goto error;
         if (pthread_attr_setschedparam(&taskAttr, &taskParam)) goto error;
     }
     else
     {
+        // deadline threads start as SCHED_OTHER and switch themselves (DeadlineThreadStart)
         if (pthread_attr_setschedpolicy(&taskAttr, SCHED_OTHER)) goto error;
     }
-    if (pthread_attr_setaffinity_np(&taskAttr, sizeof(cpuset), &cpuset)) goto error;
+    if (deadline)
+    {
+        // SCHED_DEADLINE admission requires an affinity spanning the root domain: all CPUs
+        cpu_set_t allCpus;
+        CPU_ZERO(&allCpus);
+        for (int cpu = 0; cpu < maxCpuCnt && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &allCpus);
+        if (pthread_attr_setaffinity_np(&taskAttr, sizeof(allCpus), &allCpus)) goto error;
+    }
+    else
+    {
+        if (pthread_attr_setaffinity_np(&taskAttr, sizeof(cpuset), &cpuset)) goto error;
+    }
     if (pthread_attr_setdetachstate(&taskAttr, PTHREAD_CREATE_JOINABLE)) goto error;
     
     if (thread.stackSz > 0)
@@ -235,35 +570,90 @@ int CreateThread(ThreadInfo &thread, bool realtime, bool addList)
 
     /* Step 3. Thread Create */
     LOG_CONT(info).printf("Create %s Thread ... ", realtime ? "RT" : "Non-RT");
-    if (pthread_create(&thread.id, &taskAttr, thread.procFunc, thread.procFuncArg)) goto error;
+    if (addList)
+    {
+        // registered threads start through ThreadStart() to record their kernel tid
+        entry = new ThreadEntry();
+        entry->info = &thread;
+        entry->realtime = realtime;
+        entry->procFunc = thread.procFunc;
+        entry->procFuncArg = thread.procFuncArg;
+        // listed before it runs: the thread may look itself up (FindThread) right away
+        thread.listIdx = threadList.Add(entry);
+    }
+    else
+    {
+        thread.listIdx = (-1);
+    }
+#if defined(__linux__)
+    if (deadline)
+    {
+        dlStart->entry = entry;
+        if (pthread_create(&thread.id, &taskAttr, DeadlineThreadStart, dlStart)) goto error;
+        while (sem_wait(&dlStart->done) && errno == EINTR) {}
+        thread.policy = dlStart->policy;
+        if (dlStart->err)
+        {
+            const char *fallback = dlStart->run ? (dlStart->policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_OTHER") : "none";
+            LOG_CONT(warn).printf("SCHED_DEADLINE refused: %s(%d) %s ... fallback: %s\n", strerror(dlStart->err), dlStart->err,
+                                  DeadlineErrorHint(dlStart->err), fallback);
+        }
+        if (!dlStart->run)
+        {
+            pthread_join(thread.id, nullptr);
+            errno = dlStart->err;
+            goto error;
+        }
+    }
+    else
+#endif
+    if (addList)
+    {
+        if (pthread_create(&thread.id, &taskAttr, ThreadStart, entry)) goto error;
+    }
+    else
+    {
+        if (pthread_create(&thread.id, &taskAttr, thread.procFunc, thread.procFuncArg)) goto error;
+    }
 #if defined(__APPLE__)
     if (pthread_setaffinity_np(thread.id, CPU_SETSIZE, &cpuset)) goto error;
 #endif
     pthread_setname_np(thread.id, thread.name);
+    if (!deadline) thread.policy = realtime ? SCHED_FIFO : SCHED_OTHER;
     LOG_CONT(info).printf("ok\n");
 
     /* Step 4. Check and Destroy the Attribute */
     PrintThreadAttr(&taskAttr);
     if (pthread_attr_destroy(&taskAttr)) goto error_no_destroy;
     LOG_CONT(info).printf("Complete\n");
-    
-    if (addList)
-    {
-        threadList[threadNum] = &thread.id;
-        thread.listIdx = threadNum;
-        threadNum++;
-    }
-    else
+#if defined(__linux__)
+    if (dlStart)
     {
-        thread.listIdx = (-1);
+        sem_destroy(&dlStart->done);
+        delete dlStart;
     }
+#endif
+
     LOG_CONT(info).printf("------------------------------------");
 
     return 0;
 
 error:
     pthread_attr_destroy(&taskAttr);
+    if (entry)
+    {
+        threadList.Remove(thread.listIdx, entry);
+        thread.listIdx = (-1);
+        delete entry;
+    }
 error_no_destroy:
+#if defined(__linux__)
+    if (dlStart)
+    {
+        sem_destroy(&dlStart->done);
+        delete dlStart;
+    }
+#endif
     LOG_CONT(err).printf("!Error! %s : %s(%d)", realtime ? "CreateRtThread()": "CreateNonRtThread()", strerror(errno), errno);
     LOG_CONT(info).printf("------------------------------------\n");
     return (-1);
@@ -284,13 +674,16 @@ int DeleteThread(ThreadInfo &thread)
     LOG(info).printf("Delete Thread ");
     LOG_CONT(info).printf("  Delete %s ... ", thread.name);
 
+    StopPeriodicThread(thread);
     if (pthread_join(thread.id, NULL)) goto error;
+    ReleasePeriodicTask(thread);
     LOG_CONT(info).printf("  ok\n");
     LOG_CONT(info).printf("  Complete\n");
 
     if (thread.listIdx >= 0)
     {
-        threadList[thread.listIdx] = nullptr;
+        delete threadList.Remove(thread.listIdx);
+        thread.listIdx = (-1);
     }
 
     return 0;
@@ -305,10 +698,22 @@ int DeleteAllThread()
     int num = 0;
 
     LOG(info).printf("Delete All Thread ");
-    for (int idx = threadNum - 1; idx >= 0; idx--)
+    struct Item
     {
-        if (threadList[idx] == nullptr) continue;
-        if (pthread_join(*threadList[idx], NULL)) goto error;
+        int idx;
+        const ThreadEntry *entry; // identity only, not dereferenced
+        ThreadInfo *info;
+    };
+    std::vector<Item> items;
+    threadList.ForEach([&items](int idx, const ThreadEntry &e) { items.push_back({idx, &e, e.info}); });
+    StopAllPeriodicThreads();
+    for (const Item &item : items)
+    {
+        ThreadInfo &thread = *item.info;
+        if (pthread_join(thread.id, NULL)) goto error;
+        ReleasePeriodicTask(thread);
+        delete threadList.Remove(item.idx, item.entry);
+        thread.listIdx = (-1);
         num++;
     }
     LOG_CONT(info).printf("  Delete %d thread ... ok\n", num);
@@ -321,6 +726,58 @@ error:
     return -1;
 }
 
+int GetThreadCount()
+{
+    return threadList.Count();
+}
+
+ThreadInfo *FindThread(const char *name)
+{
+    if (!name) return nullptr;
+    ThreadInfo *info = nullptr;
+    threadList.Find([name](const ThreadEntry &e) { return e.info->name && strcmp(e.info->name, name) == 0; },
+                    [&info](const ThreadEntry &e) { info = e.info; });
+    return info;
+}
+
+static void FillThreadStatus(const ThreadEntry &entry, ThreadStatus &status)
+{
+    status = ThreadStatus();
+    status.name = entry.info->name;
+    status.info = entry.info;
+    status.tid = entry.tid.load(std::memory_order_acquire);
+    status.realtime = entry.realtime;
+    status.cpuIdx = entry.info->cpuIdx;
+}
+
+int GetThreadStatus(const ThreadInfo &thread, ThreadStatus &status)
+{
+    // fields are copied under the list lock; /proc is read after it is released
+    if (!threadList.Find([&thread](const ThreadEntry &e) { return e.info == &thread; },
+                         [&status](const ThreadEntry &e) { FillThreadStatus(e, status); }))
+    {
+        return -1;
+    }
+    if (status.tid == 0) return -1;
+    return ReadTaskStatus(status.tid, status);
+}
+
+int GetAllThreadStatus(std::vector<ThreadStatus> &list)
+{
+    list.clear();
+    threadList.ForEach([&list](int, const ThreadEntry &e) {
+        ThreadStatus status;
+        FillThreadStatus(e, status);
+        list.push_back(status);
+    });
+    std::reverse(list.begin(), list.end()); // creation order
+    for (ThreadStatus &status : list)
+    {
+        if (status.tid != 0) ReadTaskStatus(status.tid, status);
+    }
+    return (int)list.size();
+}
+
 
 int CreateSemaphore(SemInfo &semInfo, unsigned int initValue)
 {
@@ -334,9 +791,7 @@ int CreateSemaphore(SemInfo &semInfo, unsigned int initValue)
 #endif
     LOG_CONT(info).printf("ok\n");
     LOG_CONT(info).printf("Complete\n");
-    semList[semNum] = &semInfo.sem;
-    semInfo.listIdx = semNum;
-    semNum++;
+    semInfo.listIdx = semList.Add(&semInfo.sem);
 
     return 0;
 
@@ -347,13 +802,12 @@ error:
 
 void PostAllSemaphore()
 {
-    for (int idx = semNum - 1; idx >= 0; idx--)
+    for (const auto &item : semList.Snapshot())
     {
-        if (semList[idx] == nullptr) continue;
 #if defined(__APPLE__)
-        dispatch_semaphore_signal(*semList[idx]);
+        dispatch_semaphore_signal(*item.second);
 #else
-        sem_post(semList[idx]);
+        sem_post(item.second);
 #endif
     }
 }
@@ -369,7 +823,7 @@ int DeleteSemaphore(SemInfo &semInfo)
 #endif
     LOG_CONT(info).printf("ok\n");
     LOG_CONT(info).printf("Complete\n");
-    semList[semInfo.listIdx] = nullptr;
+    semList.Remove(semInfo.listIdx);
     // LOG_CONT(info).printfEndLine();
 
     return 0;
@@ -384,14 +838,14 @@ int DeleteAllSemaphore()
     int num = 0;
 
     LOG(info).printf("Delete All Semaphore ");
-    for (int idx = semNum - 1; idx >= 0; idx--)
+    for (const auto &item : semList.Snapshot())
     {
-        if (semList[idx] == nullptr) continue;
 #if defined(__APPLE__)
-        dispatch_release(*semList[idx]);
+        dispatch_release(*item.second);
 #else
-        if (sem_destroy(semList[idx])) goto error;
+        if (sem_destroy(item.second)) goto error;
 #endif
+        semList.Remove(item.first);
         num++;
     }
     LOG_CONT(info).printf("  Delete %d semaphore ... ok\n", num);
@@ -404,21 +858,28 @@ error:
     return -1;
 }
 
-int CreateMutex(MtxInfo &mtxInfo)
+int CreateMutex(MtxInfo &mtxInfo, bool prioInherit)
 {
+    pthread_mutexattr_t attr;
+    int rtn = 0;
     LOG(info).printf("Create Mutex ");
-    LOG_CONT(info).printf("  Initialize Mutex ... ");
-    if (pthread_mutex_init(&mtxInfo.mutex, NULL)) goto error;
+    LOG_CONT(info).printf("  Initialize Mutex%s ... ", prioInherit ? " (PRIO_INHERIT)" : "");
+    if ((rtn = pthread_mutexattr_init(&attr))) goto error;
+    if (prioInherit && (rtn = pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT))) goto error_attr;
+    if ((rtn = pthread_mutex_init(&mtxInfo.mutex, &attr))) goto error_attr;
+    pthread_mutexattr_destroy(&attr);
     LOG_CONT(info).printf("ok\n");
     LOG_CONT(info).printf("Complete\n");
-    mtxList[mtxNum] = &mtxInfo.mutex;
-    mtxInfo.listIdx = mtxNum;
-    mtxNum++;
+    mtxInfo.prioInherit = prioInherit;
+    mtxInfo.listIdx = mtxList.Add(&mtxInfo.mutex);
 
     return 0;
 
+error_attr:
+    pthread_mutexattr_destroy(&attr);
 error:
-    LOG(err).printf("!Error! CreateMutex() : %s(%d)\n", strerror(errno), errno);
+    // pthread_mutex* functions return the error code instead of setting errno
+    LOG(err).printf("!Error! CreateMutex() : %s(%d)\n", strerror(rtn), rtn);
     return -1;
 }
 
@@ -429,7 +890,7 @@ int DeleteMutex(MtxInfo &mtxInfo)
     if (pthread_mutex_destroy(&mtxInfo.mutex)) goto error;
     LOG_CONT(info).printf("ok\n");
     LOG_CONT(info).printf("Complete\n");
-    mtxList[mtxInfo.listIdx] = nullptr;
+    mtxList.Remove(mtxInfo.listIdx);
 
     return 0;
 
@@ -443,10 +904,10 @@ int DeleteAllMutex()
     int num = 0;
 
     LOG(info).printf("Delete All Mutex ");
-    for (int idx = mtxNum - 1; idx >= 0; idx--)
+    for (const auto &item : mtxList.Snapshot())
     {
-        if (mtxList[idx] == nullptr) continue;
-        if (pthread_mutex_destroy(mtxList[idx])) goto error;
+        if (pthread_mutex_destroy(item.second)) goto error;
+        mtxList.Remove(item.first);
         num++;
     }
     LOG_CONT(info).printf("  Delete %d mutex ... ok\n", num);
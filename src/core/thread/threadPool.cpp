@@ -0,0 +1,390 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtThread/threadPool.h"
+#include "dtCore/src/dtThread/cpuTopology.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <sched.h>
+#include <stdio.h>
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include <dtCore/dtLog>
+
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Thread
+{
+//* Private Variables --------------------------------------------------------*/
+static thread_local const ThreadPool *tlsPool = nullptr; // pool of the calling worker
+static thread_local int tlsWorkerIdx = -1;
+static thread_local uint32_t tlsRand = 0;
+
+//* Private Functions Definition ---------------------------------------------*/
+static inline uint32_t NextRand()
+{
+    // xorshift32, only used to spread steal attempts over the victims
+    uint32_t x = tlsRand ? tlsRand : (uint32_t)(uintptr_t)&tlsRand | 1u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    tlsRand = x;
+    return x;
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+static void GetAffinityCpus(std::vector<int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+        {
+            if (CPU_ISSET(i, &set)) cpus.push_back(i);
+        }
+    }
+    if (cpus.empty()) cpus.push_back(0);
+}
+
+static void GetDefaultCpus(std::vector<int> &cpus)
+{
+    // housekeeping CPUs sharing neither a core nor an L2 with the registered RT threads
+    std::vector<ThreadStatus> threads;
+    std::vector<int> rtCpus;
+    GetAllThreadStatus(threads);
+    for (const ThreadStatus &t : threads)
+    {
+        if (t.realtime) rtCpus.push_back(t.cpuIdx);
+    }
+    cpus = GetHousekeepingCpus(GetCpuTopology(), rtCpus);
+    if (cpus.empty()) GetAffinityCpus(cpus); // process confined to isolated CPUs
+}
+#endif
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+ThreadPool::ThreadPool(const ThreadPoolConfig &config)
+    : m_config(config)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    Stop();
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+int ThreadPool::Start()
+{
+    if (!m_workers.empty())
+    {
+        LOG(err).printf("!Error! ThreadPool::Start() : %s is already started", m_config.name);
+        return -1;
+    }
+
+    std::vector<int> cpus = m_config.cpus;
+    if (cpus.empty()) GetDefaultCpus(cpus);
+    const int cpuMax = GetCpuCount();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= cpuMax || cpu >= CPU_SETSIZE)
+        {
+            LOG(err).printf("!Error! ThreadPool::Start() : invalid CPU index %d", cpu);
+            return -1;
+        }
+        CPU_SET(cpu, &set);
+    }
+    const int count = (m_config.numThreads > 0) ? m_config.numThreads : (int)cpus.size();
+
+    m_running.store(true);
+    m_workers.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(new Worker());
+        Worker &w = *m_workers.back();
+        w.pool = this;
+        w.index = i;
+        snprintf(w.name, sizeof(w.name), "%.20s/%d", m_config.name, i);
+    }
+    // workers only look at m_workers after the whole vector is built
+    for (int i = 0; i < count; ++i)
+    {
+        Worker &w = *m_workers[i];
+        w.info.name = w.name;
+        w.info.procFunc = WorkerProc;
+        w.info.procFuncArg = &w;
+        w.info.cpuIdx = cpus[i % cpus.size()];
+        w.info.stackSz = m_config.stackSz;
+        if (CreateNonRtThread(w.info))
+        {
+            // join the ones already running, drop the rest
+            m_running.store(false);
+            m_sleepCv.notify_all();
+            for (int k = 0; k < i; ++k)
+            {
+                DeleteThread(m_workers[k]->info);
+            }
+            m_workers.clear();
+            return -1;
+        }
+        // CreateThread() pins to one CPU: let the worker float over the whole set
+        if (!m_config.pinEach && cpus.size() > 1)
+        {
+            pthread_setaffinity_np(w.info.id, sizeof(set), &set);
+        }
+    }
+    return 0;
+}
+
+void ThreadPool::Stop()
+{
+    if (m_workers.empty())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMtx);
+        m_running.store(false);
+    }
+    m_sleepCv.notify_all();
+    for (auto &w : m_workers)
+    {
+        DeleteThread(w->info);
+    }
+
+    // tasks posted from outside while the workers were leaving
+    std::function<void()> task;
+    for (auto &w : m_workers)
+    {
+        while (PopLocal(*w, task))
+        {
+            task();
+        }
+    }
+    m_workers.clear();
+}
+#endif
+
+void ThreadPool::Post(std::function<void()> task)
+{
+    if (m_workers.empty() || (!m_running.load(std::memory_order_relaxed) && CurrentWorker() < 0))
+    {
+        task();
+        return;
+    }
+    Push(std::move(task));
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    const size_t n = end - begin;
+    if (grain == 0)
+    {
+        // ~4 chunks per worker leaves room for stealing without too much per-task overhead
+        const size_t parts = (size_t)std::max(1, GetThreadCount()) * 4;
+        grain = std::max<size_t>(1, (n + parts - 1) / parts);
+    }
+    if (n <= grain || m_workers.empty())
+    {
+        body(begin, end);
+        return;
+    }
+
+    struct Shared
+    {
+        std::atomic<size_t> remaining{0};
+        std::mutex errMtx;
+        std::exception_ptr error;
+    } shared;
+    const size_t chunks = (n + grain - 1) / grain;
+    shared.remaining.store(chunks);
+
+    auto runChunk = [&shared, &body](size_t b, size_t e) {
+        try
+        {
+            body(b, e);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(shared.errMtx);
+            if (!shared.error) shared.error = std::current_exception();
+        }
+        shared.remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    // the first chunk is run here, the rest go to the pool
+    for (size_t c = 1; c < chunks; ++c)
+    {
+        const size_t b = begin + c * grain;
+        const size_t e = std::min(end, b + grain);
+        Push([runChunk, b, e]() { runChunk(b, e); });
+    }
+    runChunk(begin, std::min(end, begin + grain));
+    HelpUntil([&shared]() { return shared.remaining.load(std::memory_order_acquire) == 0; });
+
+    if (shared.error)
+    {
+        std::rethrow_exception(shared.error);
+    }
+}
+
+void ThreadPool::HelpUntil(const std::function<bool()> &done)
+{
+    const int self = CurrentWorker();
+    while (!done())
+    {
+        if (!RunOne(self))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::GetStats(std::vector<ThreadPoolWorkerStats> &stats) const
+{
+    stats.resize(m_workers.size());
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        stats[i].executed = m_workers[i]->executed.load(std::memory_order_relaxed);
+        stats[i].stolen = m_workers[i]->stolen.load(std::memory_order_relaxed);
+        stats[i].sleeps = m_workers[i]->sleeps.load(std::memory_order_relaxed);
+    }
+}
+
+//* Private Member Functions Definition --------------------------------------*/
+void *ThreadPool::WorkerProc(void *arg)
+{
+    Worker *w = static_cast<Worker *>(arg);
+    ThreadPool *pool = w->pool;
+    tlsPool = pool;
+    tlsWorkerIdx = w->index;
+
+    while (true)
+    {
+        if (pool->RunOne(w->index))
+        {
+            continue;
+        }
+
+        // nothing to run or steal: sleep until Push() or Stop().
+        // m_sleepers is raised before m_pending is checked, and Push() raises m_pending before
+        // reading m_sleepers, so one of the two always sees the other.
+        std::unique_lock<std::mutex> lock(pool->m_sleepMtx);
+        pool->m_sleepers.fetch_add(1);
+        if (pool->m_pending.load() == 0)
+        {
+            if (!pool->m_running.load())
+            {
+                pool->m_sleepers.fetch_sub(1);
+                break;
+            }
+            w->sleeps.fetch_add(1, std::memory_order_relaxed);
+            pool->m_sleepCv.wait(lock, [pool]() { return pool->m_pending.load() > 0 || !pool->m_running.load(); });
+        }
+        pool->m_sleepers.fetch_sub(1);
+    }
+
+    tlsPool = nullptr;
+    tlsWorkerIdx = -1;
+    return nullptr;
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    int idx = CurrentWorker();
+    if (idx < 0)
+    {
+        idx = (int)(m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size());
+    }
+    {
+        Worker &w = *m_workers[idx];
+        std::lock_guard<std::mutex> lock(w.dequeMtx);
+        w.tasks.push_back(std::move(task));
+    }
+    m_pending.fetch_add(1);
+    if (m_sleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMtx);
+        m_sleepCv.notify_one();
+    }
+}
+
+bool ThreadPool::PopLocal(Worker &w, std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> lock(w.dequeMtx);
+    if (w.tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    m_pending.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::Steal(int thief, std::function<void()> &task)
+{
+    const size_t n = m_workers.size();
+    const size_t start = NextRand() % n;
+    for (size_t k = 0; k < n; ++k)
+    {
+        const size_t victim = (start + k) % n;
+        if ((int)victim == thief)
+        {
+            continue;
+        }
+        Worker &w = *m_workers[victim];
+        std::unique_lock<std::mutex> lock(w.dequeMtx, std::try_to_lock);
+        if (!lock.owns_lock() || w.tasks.empty())
+        {
+            continue;
+        }
+        task = std::move(w.tasks.front());
+        w.tasks.pop_front();
+        m_pending.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::RunOne(int self)
+{
+    std::function<void()> task;
+    if (self >= 0 && PopLocal(*m_workers[self], task))
+    {
+        task();
+        m_workers[self]->executed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (Steal(self, task))
+    {
+        task();
+        if (self >= 0)
+        {
+            m_workers[self]->executed.fetch_add(1, std::memory_order_relaxed);
+            m_workers[self]->stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+int ThreadPool::CurrentWorker() const
+{
+    return (tlsPool == this) ? tlsWorkerIdx : -1;
+}
+
+} // namespace Thread
+} // namespace dt
@@ -0,0 +1,522 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtProfiler.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include <dtCore/dtLog>
+
+//* System-Specific Headers --------------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace dt
+{
+namespace Utils
+{
+//* Private Types ------------------------------------------------------------*/
+// written by the owner thread only (relaxed load / store), read by snapshots
+struct ProfileAccum
+{
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> self;
+    std::atomic<uint64_t> min;
+    std::atomic<uint64_t> max;
+    std::atomic<uint64_t> hist[PROFILE_HIST_BUCKETS];
+};
+
+struct ProfileThreadData
+{
+    ProfileAccum zones[PROFILE_MAX_ZONES];
+    std::atomic<uint32_t> gen;  // reset generation the counters belong to
+    bool inUse;
+    ProfileThreadData *next;
+};
+
+// plain copy of ProfileAccum for merging
+struct ProfileSum
+{
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t self = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    int threads = 0;
+    uint64_t hist[PROFILE_HIST_BUCKETS] = {};
+};
+
+//* Private Variables --------------------------------------------------------*/
+static std::mutex profileMtx;                  // zones, thread blocks, exited sums
+static ProfileZone *profileZones = nullptr;    // registration order
+static int profileZoneCount = 0;
+static bool profileEnabled = true;
+static ProfileThreadData *profileThreads = nullptr;
+static ProfileSum profileExited[PROFILE_MAX_ZONES]; // threads that have exited
+static std::atomic<uint32_t> profileGen{0};
+static pthread_key_t profileKey;
+static std::once_flag profileKeyOnce;
+
+static thread_local ProfileThreadData *tlsProfile;
+static thread_local ProfileScope *tlsScope;    // innermost open zone
+
+//* Private Functions Definition ---------------------------------------------*/
+static bool DetectInvariantTsc()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)))
+    {
+        return true;
+    }
+    // hypervisors often hide the bit: trust the TSC if the kernel does
+    char src[32] = {0};
+    FILE *fp = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+    if (fp)
+    {
+        if (!fgets(src, sizeof(src), fp))
+        {
+            src[0] = '\0';
+        }
+        fclose(fp);
+    }
+    return strncmp(src, "tsc", 3) == 0;
+#else
+    return false;
+#endif
+}
+
+static void ClearThreadData(ProfileThreadData *td)
+{
+    for (ProfileAccum &a : td->zones)
+    {
+        a.count.store(0, std::memory_order_relaxed);
+        a.total.store(0, std::memory_order_relaxed);
+        a.self.store(0, std::memory_order_relaxed);
+        a.min.store(UINT64_MAX, std::memory_order_relaxed);
+        a.max.store(0, std::memory_order_relaxed);
+        for (auto &h : a.hist)
+        {
+            h.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+static void MergeAccum(ProfileSum &sum, const ProfileAccum &a)
+{
+    const uint64_t count = a.count.load(std::memory_order_relaxed);
+    if (count == 0)
+    {
+        return;
+    }
+    sum.count += count;
+    sum.total += a.total.load(std::memory_order_relaxed);
+    sum.self += a.self.load(std::memory_order_relaxed);
+    sum.min = std::min(sum.min, a.min.load(std::memory_order_relaxed));
+    sum.max = std::max(sum.max, a.max.load(std::memory_order_relaxed));
+    sum.threads++;
+    for (int b = 0; b < PROFILE_HIST_BUCKETS; ++b)
+    {
+        sum.hist[b] += a.hist[b].load(std::memory_order_relaxed);
+    }
+}
+
+static void OnThreadExit(void *data)
+{
+    ProfileThreadData *td = static_cast<ProfileThreadData *>(data);
+    std::lock_guard<std::mutex> lock(profileMtx);
+    if (td->gen.load(std::memory_order_relaxed) == profileGen.load(std::memory_order_relaxed))
+    {
+        for (int i = 0; i < profileZoneCount; ++i)
+        {
+            MergeAccum(profileExited[i], td->zones[i]);
+        }
+    }
+    td->inUse = false; // kept for the next thread
+}
+
+static ProfileThreadData *AttachThread() noexcept
+{
+    std::call_once(profileKeyOnce, [] { pthread_key_create(&profileKey, OnThreadExit); });
+    std::lock_guard<std::mutex> lock(profileMtx);
+    ProfileThreadData *td = profileThreads;
+    while (td && td->inUse)
+    {
+        td = td->next;
+    }
+    if (!td)
+    {
+        td = new (std::nothrow) ProfileThreadData;
+        if (!td)
+        {
+            return nullptr;
+        }
+        td->next = profileThreads;
+        profileThreads = td;
+    }
+    ClearThreadData(td);
+    td->gen.store(profileGen.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    td->inUse = true;
+    pthread_setspecific(profileKey, td);
+    tlsProfile = td;
+    return td;
+}
+
+static void UpdateActive(ProfileZone *z)
+{
+    z->active.store(profileEnabled && z->enabled && z->id >= 0, std::memory_order_relaxed);
+}
+
+static inline int BucketOf(uint64_t ticks)
+{
+    const int b = 63 - __builtin_clzll(ticks | 1);
+    return std::min(b, PROFILE_HIST_BUCKETS - 1);
+}
+
+// q-quantile (ns), interpolated inside its log2 bucket and clamped to [min, max]
+static double HistQuantile(const ProfileSum &s, double q, double nsPerTick)
+{
+    const double rank = q * (double)s.count;
+    uint64_t seen = 0;
+    for (int b = 0; b < PROFILE_HIST_BUCKETS; ++b)
+    {
+        if (s.hist[b] && (double)(seen + s.hist[b]) >= rank)
+        {
+            const double lower = b ? (double)(1ULL << b) : 0.0;
+            const double upper = (b == PROFILE_HIST_BUCKETS - 1) ? (double)s.max : (double)(2ULL << b);
+            const double v = lower + (upper - lower) * (rank - (double)seen) / (double)s.hist[b];
+            return std::max((double)s.min, std::min(v, (double)s.max)) * nsPerTick;
+        }
+        seen += s.hist[b];
+    }
+    return (double)s.max * nsPerTick;
+}
+
+static void JsonString(FILE *fp, const std::string &s)
+{
+    fputc('"', fp);
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', fp);
+            fputc(c, fp);
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+std::atomic<bool> ProfileClock::s_tsc{DetectInvariantTsc()};
+
+// calibration base, taken at start-up: the longer the interval, the better the ratio
+static const uint64_t profileBaseTicks = ProfileClock::Now();
+static const uint64_t profileBaseNs = MonotonicNs();
+
+double ProfileClock::NsPerTick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (!s_tsc.load(std::memory_order_relaxed))
+    {
+        return 1.0;
+    }
+    uint64_t ns = MonotonicNs() - profileBaseNs;
+    if (ns < 10000000)
+    {
+        struct timespec ts = {0, (long)(10000000 - ns)};
+        nanosleep(&ts, nullptr);
+    }
+    const uint64_t ticks = ProfileClock::Now() - profileBaseTicks;
+    ns = MonotonicNs() - profileBaseNs;
+    return ticks ? (double)ns / (double)ticks : 1.0;
+#elif defined(__aarch64__)
+    uint64_t freq;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+    return freq ? 1e9 / (double)freq : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+const char *ProfileClock::Source() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return s_tsc.load(std::memory_order_relaxed) ? "tsc" : "monotonic";
+#elif defined(__aarch64__)
+    return "cntvct";
+#else
+    return "monotonic";
+#endif
+}
+
+ProfileZone::ProfileZone(const char *zoneName, const char *srcFile, int srcLine) noexcept
+    : name(zoneName), file(srcFile), line(srcLine), id(-1), active(false), enabled(true), next(nullptr)
+{
+    std::lock_guard<std::mutex> lock(profileMtx);
+    if (profileZoneCount < PROFILE_MAX_ZONES)
+    {
+        id = profileZoneCount++;
+    }
+    else
+    {
+        LOG(warn).printf("ProfileZone : more than %d zones, '%s' (%s:%d) is not measured",
+                         PROFILE_MAX_ZONES, zoneName, srcFile, srcLine);
+    }
+    // append: zone ids follow the list order
+    ProfileZone **tail = &profileZones;
+    while (*tail)
+    {
+        tail = &(*tail)->next;
+    }
+    *tail = this;
+    UpdateActive(this);
+}
+
+void ProfileScope::Enter() noexcept
+{
+    if (!tlsProfile && !AttachThread())
+    {
+        m_zone = nullptr;
+        return;
+    }
+    m_parent = tlsScope;
+    tlsScope = this;
+}
+
+void ProfileScope::Leave(uint64_t end) noexcept
+{
+    ProfileThreadData *td = tlsProfile;
+    tlsScope = m_parent;
+    const uint64_t ticks = end - m_start;
+    if (m_parent)
+    {
+        m_parent->m_child += ticks;
+    }
+
+    const uint32_t gen = profileGen.load(std::memory_order_relaxed);
+    if (td->gen.load(std::memory_order_relaxed) != gen)
+    {
+        ClearThreadData(td); // ProfilerReset() since the last zone of this thread
+        td->gen.store(gen, std::memory_order_release);
+    }
+    ProfileAccum &a = td->zones[m_zone->id];
+    a.count.store(a.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    a.total.store(a.total.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    a.self.store(a.self.load(std::memory_order_relaxed) + (ticks > m_child ? ticks - m_child : 0), std::memory_order_relaxed);
+    if (ticks < a.min.load(std::memory_order_relaxed))
+    {
+        a.min.store(ticks, std::memory_order_relaxed);
+    }
+    if (ticks > a.max.load(std::memory_order_relaxed))
+    {
+        a.max.store(ticks, std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t> &h = a.hist[BucketOf(ticks)];
+    h.store(h.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+bool ProfilerRegisterThread() noexcept
+{
+    return tlsProfile || AttachThread();
+}
+
+void ProfilerSetEnabled(bool enable)
+{
+    std::lock_guard<std::mutex> lock(profileMtx);
+    profileEnabled = enable;
+    for (ProfileZone *z = profileZones; z; z = z->next)
+    {
+        UpdateActive(z);
+    }
+}
+
+bool ProfilerIsEnabled()
+{
+    std::lock_guard<std::mutex> lock(profileMtx);
+    return profileEnabled;
+}
+
+bool ProfileSetZoneEnabled(const char *name, bool enable)
+{
+    bool found = false;
+    std::lock_guard<std::mutex> lock(profileMtx);
+    for (ProfileZone *z = profileZones; z; z = z->next)
+    {
+        if (strcmp(z->name, name) == 0)
+        {
+            z->enabled = enable;
+            UpdateActive(z);
+            found = true;
+        }
+    }
+    return found;
+}
+
+void ProfilerReset()
+{
+    std::lock_guard<std::mutex> lock(profileMtx);
+    for (ProfileSum &s : profileExited)
+    {
+        s = ProfileSum();
+    }
+    profileGen.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t ProfileSnapshot(std::vector<ProfileZoneStats> &zones)
+{
+    const double nsPerTick = ProfileClock::NsPerTick();
+    zones.clear();
+
+    std::lock_guard<std::mutex> lock(profileMtx);
+    const uint32_t gen = profileGen.load(std::memory_order_relaxed);
+    std::vector<ProfileSum> sums(profileExited, profileExited + profileZoneCount);
+    for (ProfileThreadData *td = profileThreads; td; td = td->next)
+    {
+        if (!td->inUse || td->gen.load(std::memory_order_acquire) != gen)
+        {
+            continue; // free, or not used since the last reset
+        }
+        for (int i = 0; i < profileZoneCount; ++i)
+        {
+            MergeAccum(sums[i], td->zones[i]);
+        }
+    }
+
+    for (ProfileZone *z = profileZones; z; z = z->next)
+    {
+        if (z->id < 0 || sums[z->id].count == 0)
+        {
+            continue;
+        }
+        const ProfileSum &s = sums[z->id];
+        ProfileZoneStats st;
+        st.name = z->name;
+        st.file = z->file;
+        st.line = z->line;
+        st.threads = s.threads;
+        st.count = s.count;
+        st.total_ns = (double)s.total * nsPerTick;
+        st.self_ns = (double)s.self * nsPerTick;
+        st.min_ns = (double)s.min * nsPerTick;
+        st.max_ns = (double)s.max * nsPerTick;
+        st.mean_ns = st.total_ns / (double)s.count;
+        st.p50_ns = HistQuantile(s, 0.50, nsPerTick);
+        st.p99_ns = HistQuantile(s, 0.99, nsPerTick);
+        std::copy(s.hist, s.hist + PROFILE_HIST_BUCKETS, st.hist);
+        zones.push_back(std::move(st));
+    }
+    std::sort(zones.begin(), zones.end(),
+              [](const ProfileZoneStats &a, const ProfileZoneStats &b) { return a.total_ns > b.total_ns; });
+    return zones.size();
+}
+
+double ProfileBucketNs(int bucket)
+{
+    return (bucket <= 0 ? 0.0 : (double)(1ULL << bucket)) * ProfileClock::NsPerTick();
+}
+
+bool ProfileWriteJson(const std::string &path, const std::vector<ProfileZoneStats> &zones)
+{
+    const std::string tmp = path + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "w");
+    if (!fp)
+    {
+        LOG(err).printf("!Error! ProfileWriteJson() : cannot open %s", tmp.c_str());
+        return false;
+    }
+    const double nsPerTick = ProfileClock::NsPerTick();
+    fprintf(fp, "{\n  \"clock\": \"%s\",\n  \"nsPerTick\": %.6f,\n  \"zones\": [", ProfileClock::Source(), nsPerTick);
+    for (size_t i = 0; i < zones.size(); ++i)
+    {
+        const ProfileZoneStats &z = zones[i];
+        fprintf(fp, "%s\n    {\"name\": ", i ? "," : "");
+        JsonString(fp, z.name);
+        fprintf(fp, ", \"file\": ");
+        JsonString(fp, z.file);
+        fprintf(fp, ", \"line\": %d, \"threads\": %d, \"count\": %llu, \"total_ns\": %.0f, \"self_ns\": %.0f, "
+                    "\"min_ns\": %.1f, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, \"hist\": [",
+                z.line, z.threads, (unsigned long long)z.count, z.total_ns, z.self_ns, z.min_ns, z.mean_ns, z.p50_ns,
+                z.p99_ns, z.max_ns);
+        // [lower bound ns, count] of the non-empty buckets
+        bool first = true;
+        for (int b = 0; b < PROFILE_HIST_BUCKETS; ++b)
+        {
+            if (z.hist[b])
+            {
+                fprintf(fp, "%s[%.0f, %llu]", first ? "" : ", ", (b ? (double)(1ULL << b) : 0.0) * nsPerTick,
+                        (unsigned long long)z.hist[b]);
+                first = false;
+            }
+        }
+        fprintf(fp, "]}");
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    const bool ok = (fflush(fp) == 0);
+    fclose(fp);
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        LOG(err).printf("!Error! ProfileWriteJson() : cannot write %s", path.c_str());
+        remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ProfileReport(const ProfileReportConfig &config)
+{
+    std::vector<ProfileZoneStats> zones;
+    ProfileSnapshot(zones);
+    if (config.reset)
+    {
+        ProfilerReset();
+    }
+    const size_t shown = std::min(zones.size(), config.maxZones);
+
+    if (config.log)
+    {
+        LOG(info).printf("profile (%s): %zu zones", ProfileClock::Source(), zones.size());
+        for (size_t i = 0; i < shown; ++i)
+        {
+            const ProfileZoneStats &z = zones[i];
+            LOG(info).printf("  %-24s n %-9llu mean %9.2f us  p99 %9.2f us  max %9.2f us  self %5.1f %%",
+                             z.name.c_str(), (unsigned long long)z.count, z.mean_ns * 1e-3, z.p99_ns * 1e-3,
+                             z.max_ns * 1e-3, z.total_ns > 0 ? 100.0 * z.self_ns / z.total_ns : 0.0);
+        }
+    }
+    if (config.tuiLayout >= 0)
+    {
+        TUI_SET_GROUP(config.tuiLayout, config.tuiGroup, "Profile", "count", "mean us", "p99 us", "max us", "self %");
+        const size_t rows = std::min(shown, (size_t)dt::Log::RtTui::TUI_MAX_ROWS_PER_GROUP);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const ProfileZoneStats &z = zones[i];
+            TUI_SET_ROW_COLS(config.tuiLayout, config.tuiGroup, (int)i, z.name.c_str(),
+                             TUI_COL("%llu", (unsigned long long)z.count), TUI_COL("%.2f", z.mean_ns * 1e-3),
+                             TUI_COL("%.2f", z.p99_ns * 1e-3), TUI_COL("%.2f", z.max_ns * 1e-3),
+                             TUI_COL("%.1f", z.total_ns > 0 ? 100.0 * z.self_ns / z.total_ns : 0.0));
+        }
+    }
+    if (!config.jsonFile.empty())
+    {
+        ProfileWriteJson(config.jsonFile, zones);
+    }
+}
+
+} // namespace Utils
+} // namespace dt
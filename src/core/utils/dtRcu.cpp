@@ -0,0 +1,247 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtRcu.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Utils
+{
+//* Private Types ------------------------------------------------------------*/
+struct alignas(64) RcuSlot
+{
+    std::atomic<uint64_t> epoch; // 0: outside a read section, else the global epoch at entry
+    std::atomic<bool> used;
+};
+
+struct RcuRetired
+{
+    void *ptr;
+    void (*deleter)(void *);
+    uint64_t epoch; // global epoch when it was unlinked
+};
+
+//* Private Variables --------------------------------------------------------*/
+static RcuSlot rcuSlots[RCU_MAX_READERS];
+static std::atomic<int> rcuSlotHigh{0};      // slots [0, high) have been used
+static std::atomic<uint64_t> rcuEpoch{1};
+static std::atomic<int> rcuOverflow{0};      // readers without a slot inside a section
+static pthread_key_t rcuKey;                 // its destructor returns the slot
+static std::once_flag rcuKeyOnce;
+
+static std::mutex retireMtx;
+static std::vector<RcuRetired> retireList;
+static std::atomic<uint64_t> rcuRetired{0};
+static std::atomic<uint64_t> rcuReclaimed{0};
+
+// trivial TLS: no constructor / destructor call on the RT path
+static thread_local RcuSlot *tlsSlot;
+static thread_local uint32_t tlsNest;
+static thread_local bool tlsNoSlot;           // all slots were taken when this thread asked
+
+//* Private Functions Definition ---------------------------------------------*/
+static void OnThreadExit(void *slot)
+{
+    RcuSlot *s = static_cast<RcuSlot *>(slot);
+    s->epoch.store(0, std::memory_order_release);
+    s->used.store(false, std::memory_order_release);
+}
+
+static RcuSlot *ClaimSlot() noexcept
+{
+    std::call_once(rcuKeyOnce, [] { pthread_key_create(&rcuKey, OnThreadExit); });
+    for (int i = 0; i < RCU_MAX_READERS; ++i)
+    {
+        bool expected = false;
+        if (!rcuSlots[i].used.load(std::memory_order_relaxed) &&
+            rcuSlots[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            int high = rcuSlotHigh.load(std::memory_order_relaxed);
+            while (high < i + 1 && !rcuSlotHigh.compare_exchange_weak(high, i + 1, std::memory_order_acq_rel))
+            {
+            }
+            rcuSlots[i].epoch.store(0, std::memory_order_relaxed);
+            pthread_setspecific(rcuKey, &rcuSlots[i]);
+            tlsSlot = &rcuSlots[i];
+            return tlsSlot;
+        }
+    }
+    tlsNoSlot = true;
+    return nullptr;
+}
+
+static inline void SleepUs(long us)
+{
+    struct timespec ts = {0, us * 1000};
+    nanosleep(&ts, nullptr);
+}
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+bool RcuRegisterThread() noexcept
+{
+    return tlsSlot || ClaimSlot();
+}
+
+void RcuReadLock() noexcept
+{
+    if (tlsNest++ > 0)
+    {
+        return;
+    }
+    RcuSlot *s = tlsSlot;
+    if (!s && !tlsNoSlot)
+    {
+        s = ClaimSlot();
+    }
+    if (s)
+    {
+        s->epoch.store(rcuEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    else
+    {
+        rcuOverflow.fetch_add(1, std::memory_order_relaxed);
+    }
+    // the slot store is visible to a reclaimer before any pointer this section loads
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void RcuReadUnlock() noexcept
+{
+    if (--tlsNest > 0)
+    {
+        return;
+    }
+    if (tlsSlot)
+    {
+        tlsSlot->epoch.store(0, std::memory_order_release);
+    }
+    else
+    {
+        rcuOverflow.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool RcuInReadSection() noexcept
+{
+    return tlsNest > 0;
+}
+
+void RcuRetire(void *ptr, void (*deleter)(void *))
+{
+    if (!ptr || !deleter)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(retireMtx);
+    // readers entering from now on see the new epoch and, with it, the new version
+    const uint64_t epoch = rcuEpoch.fetch_add(1, std::memory_order_seq_cst);
+    retireList.push_back(RcuRetired{ptr, deleter, epoch});
+    rcuRetired.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t RcuReclaim()
+{
+    // candidates first: their unlinking happened before this point, so a reader the scan below
+    // does not see can only load the new versions
+    std::vector<RcuRetired> candidates;
+    {
+        std::lock_guard<std::mutex> lock(retireMtx);
+        if (retireList.empty())
+        {
+            return 0;
+        }
+        candidates.swap(retireList);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t minActive = UINT64_MAX;
+    if (rcuOverflow.load(std::memory_order_acquire) != 0)
+    {
+        minActive = 0; // a reader without a slot: its epoch is unknown
+    }
+    const int high = rcuSlotHigh.load(std::memory_order_acquire);
+    for (int i = 0; i < high; ++i)
+    {
+        const uint64_t e = rcuSlots[i].epoch.load(std::memory_order_acquire);
+        if (e != 0)
+        {
+            minActive = std::min(minActive, e);
+        }
+    }
+
+    auto it = std::partition(candidates.begin(), candidates.end(),
+                             [minActive](const RcuRetired &r) { return r.epoch >= minActive; });
+    const size_t count = (size_t)(candidates.end() - it);
+    // outside the lock: a deleter may retire more (e.g. an RcuPtr inside the object)
+    for (auto r = it; r != candidates.end(); ++r)
+    {
+        r->deleter(r->ptr);
+    }
+    candidates.erase(it, candidates.end());
+    if (!candidates.empty())
+    {
+        std::lock_guard<std::mutex> lock(retireMtx);
+        retireList.insert(retireList.end(), candidates.begin(), candidates.end());
+    }
+    rcuReclaimed.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+void RcuSynchronize()
+{
+    const uint64_t target = rcuEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int high = rcuSlotHigh.load(std::memory_order_acquire);
+    for (int i = 0; i < high; ++i)
+    {
+        if (&rcuSlots[i] == tlsSlot && tlsNest > 0)
+        {
+            continue; // called from a read section: cannot wait for itself
+        }
+        for (;;)
+        {
+            const uint64_t e = rcuSlots[i].epoch.load(std::memory_order_acquire);
+            if (e == 0 || e >= target)
+            {
+                break;
+            }
+            SleepUs(50);
+        }
+    }
+    while (rcuOverflow.load(std::memory_order_acquire) > (tlsNoSlot && tlsNest > 0 ? 1 : 0))
+    {
+        SleepUs(50);
+    }
+    RcuReclaim();
+}
+
+void GetRcuStats(RcuStats &stats)
+{
+    stats.epoch = rcuEpoch.load(std::memory_order_relaxed);
+    stats.retired = rcuRetired.load(std::memory_order_relaxed);
+    stats.reclaimed = rcuReclaimed.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(retireMtx);
+        stats.pending = retireList.size();
+    }
+    stats.readers = 0;
+    stats.activeReaders = rcuOverflow.load(std::memory_order_relaxed);
+    const int high = rcuSlotHigh.load(std::memory_order_acquire);
+    for (int i = 0; i < high; ++i)
+    {
+        stats.readers += rcuSlots[i].used.load(std::memory_order_relaxed) ? 1 : 0;
+        stats.activeReaders += (rcuSlots[i].epoch.load(std::memory_order_relaxed) != 0) ? 1 : 0;
+    }
+}
+
+} // namespace Utils
+} // namespace dt
@@ -0,0 +1,550 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtRtAlloc.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <mutex>
+#if defined(DT_RT_ALLOC_TRAP)
+#include <execinfo.h>
+#endif
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+//* System-Specific Headers --------------------------------------------------*/
+
+namespace dt
+{
+namespace Utils
+{
+//* Private Types ------------------------------------------------------------*/
+// one pool's free blocks cached by a thread (trivial type: no TLS constructor / destructor)
+struct PoolCache
+{
+    RtBlockPool *pool;
+    uint64_t id;
+    void *head;
+    uint32_t count;
+};
+
+struct ThreadCaches
+{
+    PoolCache slot[RtBlockPool::RTPOOL_CACHE_POOLS];
+    bool registered;
+};
+
+//* Private Variables --------------------------------------------------------*/
+static std::mutex poolMtx;
+static std::vector<RtBlockPool *> poolList;   // live pools, checked when a thread exits
+static std::atomic<uint64_t> poolId{0};
+static pthread_key_t cacheKey;              // its destructor returns the cached blocks
+static std::once_flag cacheKeyOnce;
+
+static thread_local ThreadCaches tlsCaches;
+static thread_local bool tlsRtThread;
+
+//* Private Functions Definition ---------------------------------------------*/
+// @return the calling thread's cache of the pool, or nullptr if all slots are used
+static PoolCache *GetCache(RtBlockPool *pool, uint64_t id) noexcept
+{
+    ThreadCaches &tc = tlsCaches;
+    PoolCache *empty = nullptr;
+    for (PoolCache &c : tc.slot)
+    {
+        if (c.pool == pool)
+        {
+            if (c.id == id)
+            {
+                return &c;
+            }
+            c = PoolCache{}; // the pool was released and allocated again
+        }
+        if (!c.pool && !empty)
+        {
+            empty = &c;
+        }
+    }
+    if (!empty)
+    {
+        return nullptr;
+    }
+    if (!tc.registered)
+    {
+        RtAllocAllowed allowed; // pthread_setspecific() may allocate the key's second level table
+        pthread_setspecific(cacheKey, &tc);
+        tc.registered = true;
+    }
+    empty->pool = pool;
+    empty->id = id;
+    return empty;
+}
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+bool RtBlockPool::Allocate(size_t blockSize, size_t blockCount, const RtMemOptions &opt)
+{
+    Release();
+    std::call_once(cacheKeyOnce, [] { pthread_key_create(&cacheKey, RtBlockPool::OnThreadExit); });
+    if (blockSize == 0 || blockCount == 0)
+    {
+        return false;
+    }
+
+    const size_t size = (std::max(blockSize, MIN_ALIGN) + MIN_ALIGN - 1) & ~(MIN_ALIGN - 1);
+    if (!AllocRtMem(size * blockCount, opt, m_mem))
+    {
+        return false;
+    }
+    m_begin = static_cast<char *>(m_mem.ptr);
+    m_blockSize = size;
+    m_blockCount = blockCount;
+
+    // free list in address order
+    m_free = nullptr;
+    for (size_t i = blockCount; i-- > 0;)
+    {
+        FreeBlock *b = reinterpret_cast<FreeBlock *>(m_begin + i * size);
+        b->next = m_free;
+        m_free = b;
+    }
+    m_freeCount = blockCount;
+    m_failures.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(poolMtx);
+    m_id = ++poolId;
+    poolList.push_back(this);
+    return true;
+}
+
+void RtBlockPool::Release()
+{
+    if (!m_begin)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(poolMtx);
+        poolList.erase(std::remove(poolList.begin(), poolList.end(), this), poolList.end());
+    }
+    for (PoolCache &c : tlsCaches.slot)
+    {
+        if (c.pool == this)
+        {
+            c = PoolCache{};
+        }
+    }
+    FreeRtMem(m_mem);
+    m_begin = nullptr;
+    m_blockSize = m_blockCount = 0;
+    m_id = 0;
+    m_free = nullptr;
+    m_freeCount = 0;
+}
+
+void *RtBlockPool::Alloc() noexcept
+{
+    if (!m_begin)
+    {
+        return nullptr;
+    }
+    FreeBlock *b = nullptr;
+    PoolCache *c = GetCache(this, m_id);
+    if (!c)
+    {
+        if (Take(b, 1) == 0)
+        {
+            m_failures.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return b;
+    }
+    if (c->count == 0)
+    {
+        FreeBlock *head = nullptr;
+        c->count = Take(head, RTPOOL_CACHE_BATCH);
+        c->head = head;
+        if (c->count == 0)
+        {
+            m_failures.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+    b = static_cast<FreeBlock *>(c->head);
+    c->head = b->next;
+    c->count--;
+    return b;
+}
+
+void RtBlockPool::Free(void *p) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+    FreeBlock *b = static_cast<FreeBlock *>(p);
+    PoolCache *c = GetCache(this, m_id);
+    if (!c)
+    {
+        Give(b, b, 1);
+        return;
+    }
+    b->next = static_cast<FreeBlock *>(c->head);
+    c->head = b;
+    if (++c->count >= 2 * RTPOOL_CACHE_BATCH)
+    {
+        // keep one batch, hand one back (blocks freed by a consumer thread flow back to the pool)
+        FreeBlock *first = static_cast<FreeBlock *>(c->head);
+        FreeBlock *last = first;
+        for (uint32_t i = 1; i < RTPOOL_CACHE_BATCH; ++i)
+        {
+            last = last->next;
+        }
+        c->head = last->next;
+        c->count -= RTPOOL_CACHE_BATCH;
+        Give(first, last, RTPOOL_CACHE_BATCH);
+    }
+}
+
+void RtBlockPool::WarmUp() noexcept
+{
+    if (!m_begin)
+    {
+        return;
+    }
+    PoolCache *c = GetCache(this, m_id);
+    if (c && c->count < RTPOOL_CACHE_BATCH)
+    {
+        FreeBlock *head = nullptr;
+        const uint32_t n = Take(head, RTPOOL_CACHE_BATCH - c->count);
+        if (n > 0)
+        {
+            FreeBlock *tail = head;
+            for (uint32_t i = 1; i < n; ++i)
+            {
+                tail = tail->next;
+            }
+            tail->next = static_cast<FreeBlock *>(c->head);
+            c->head = head;
+            c->count += n;
+        }
+    }
+}
+
+size_t RtBlockPool::CentralFree() const noexcept
+{
+    std::lock_guard<AdaptiveMutex> guard(m_lock);
+    return m_freeCount;
+}
+
+uint32_t RtBlockPool::Take(FreeBlock *&head, uint32_t n) noexcept
+{
+    std::lock_guard<AdaptiveMutex> guard(m_lock);
+    head = m_free;
+    uint32_t taken = 0;
+    FreeBlock *last = nullptr;
+    for (FreeBlock *b = m_free; b && taken < n; b = b->next)
+    {
+        last = b;
+        ++taken;
+    }
+    if (last)
+    {
+        m_free = last->next;
+        last->next = nullptr;
+    }
+    m_freeCount -= taken;
+    return taken;
+}
+
+void RtBlockPool::Give(FreeBlock *head, FreeBlock *tail, uint32_t n) noexcept
+{
+    std::lock_guard<AdaptiveMutex> guard(m_lock);
+    tail->next = m_free;
+    m_free = head;
+    m_freeCount += n;
+}
+
+void RtBlockPool::OnThreadExit(void *caches)
+{
+    ThreadCaches *tc = static_cast<ThreadCaches *>(caches);
+    std::lock_guard<std::mutex> guard(poolMtx);
+    for (PoolCache &c : tc->slot)
+    {
+        // the pool may be gone: look it up before touching it
+        if (c.pool && c.count > 0 && std::find(poolList.begin(), poolList.end(), c.pool) != poolList.end() &&
+            c.pool->m_id == c.id)
+        {
+            FreeBlock *head = static_cast<FreeBlock *>(c.head);
+            FreeBlock *tail = head;
+            while (tail->next)
+            {
+                tail = tail->next;
+            }
+            c.pool->Give(head, tail, c.count);
+        }
+        c = PoolCache{};
+    }
+    tc->registered = false;
+}
+
+bool RtPoolSet::Allocate(const std::vector<RtPoolClass> &classes, const RtMemOptions &opt)
+{
+    Release();
+    if (classes.empty() || classes.size() > (size_t)MAX_CLASSES)
+    {
+        return false;
+    }
+    std::vector<RtPoolClass> sorted(classes);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const RtPoolClass &a, const RtPoolClass &b) { return a.blockSize < b.blockSize; });
+    for (const RtPoolClass &cls : sorted)
+    {
+        if (!m_pools[m_count].Allocate(cls.blockSize, cls.blockCount, opt))
+        {
+            Release();
+            return false;
+        }
+        m_count++;
+    }
+    return true;
+}
+
+bool RtPoolSet::Allocate(size_t blocksPerClass, const RtMemOptions &opt)
+{
+    std::vector<RtPoolClass> classes;
+    for (size_t size = 32; size <= 4096; size <<= 1)
+    {
+        classes.push_back({size, blocksPerClass});
+    }
+    return Allocate(classes, opt);
+}
+
+void RtPoolSet::Release()
+{
+    for (int i = 0; i < m_count; ++i)
+    {
+        m_pools[i].Release();
+    }
+    m_count = 0;
+}
+
+void *RtPoolSet::Alloc(size_t size) noexcept
+{
+    for (int i = 0; i < m_count; ++i)
+    {
+        if (m_pools[i].BlockSize() >= size)
+        {
+            if (void *p = m_pools[i].Alloc())
+            {
+                return p;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void RtPoolSet::Free(void *p) noexcept
+{
+    for (int i = 0; i < m_count; ++i)
+    {
+        if (m_pools[i].Owns(p))
+        {
+            m_pools[i].Free(p);
+            return;
+        }
+    }
+}
+
+void RtPoolSet::WarmUp() noexcept
+{
+    for (int i = 0; i < m_count; ++i)
+    {
+        m_pools[i].WarmUp();
+    }
+}
+
+bool RtPoolSet::Owns(const void *p) const noexcept
+{
+    for (int i = 0; i < m_count; ++i)
+    {
+        if (m_pools[i].Owns(p))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SetRtThread(bool rt) noexcept
+{
+    tlsRtThread = rt;
+}
+
+bool IsRtThread() noexcept
+{
+    return tlsRtThread;
+}
+
+#if defined(DT_RT_ALLOC_TRAP)
+static std::atomic<int> trapAction{(int)RtAllocTrapAction::Report};
+static std::atomic<uint64_t> trapAllocs{0};
+static std::atomic<uint64_t> trapFrees{0};
+static std::atomic<uint64_t> trapBytes{0};
+static std::atomic<size_t> trapLastSize{0};
+static std::atomic<void *> trapLastCaller{nullptr};
+
+// called from operator new / delete on a thread marked RT
+static void TrapRtAlloc(size_t size, void *caller, bool isFree) noexcept
+{
+    tlsRtThread = false; // reporting (backtrace, abort) may allocate itself
+    if (isFree)
+    {
+        trapFrees.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        trapAllocs.fetch_add(1, std::memory_order_relaxed);
+        trapBytes.fetch_add(size, std::memory_order_relaxed);
+        trapLastSize.store(size, std::memory_order_relaxed);
+    }
+    trapLastCaller.store(caller, std::memory_order_relaxed);
+
+    const RtAllocTrapAction action = (RtAllocTrapAction)trapAction.load(std::memory_order_relaxed);
+    if (action != RtAllocTrapAction::Count)
+    {
+        char msg[160];
+        const int n = snprintf(msg, sizeof(msg), "[RtAllocTrap] %s %zu bytes on an RT thread, caller %p\n",
+                               isFree ? "free of" : "new of", size, caller);
+        (void)!write(STDERR_FILENO, msg, (n > 0) ? (size_t)n : 0);
+        void *frames[32];
+        backtrace_symbols_fd(frames, backtrace(frames, 32), STDERR_FILENO);
+    }
+    if (action == RtAllocTrapAction::Abort)
+    {
+        abort();
+    }
+    tlsRtThread = true;
+}
+
+bool RtAllocTrapCompiled() noexcept
+{
+    return true;
+}
+
+void SetRtAllocTrapAction(RtAllocTrapAction action) noexcept
+{
+    void *frame;
+    (void)backtrace(&frame, 1); // first call loads libgcc (allocates): do it here, not on the RT thread
+    trapAction.store((int)action, std::memory_order_relaxed);
+}
+
+void GetRtAllocTrapStats(RtAllocTrapStats &stats) noexcept
+{
+    stats.allocs = trapAllocs.load(std::memory_order_relaxed);
+    stats.frees = trapFrees.load(std::memory_order_relaxed);
+    stats.bytes = trapBytes.load(std::memory_order_relaxed);
+    stats.lastSize = trapLastSize.load(std::memory_order_relaxed);
+    stats.lastCaller = trapLastCaller.load(std::memory_order_relaxed);
+}
+
+void ResetRtAllocTrapStats() noexcept
+{
+    trapAllocs.store(0, std::memory_order_relaxed);
+    trapFrees.store(0, std::memory_order_relaxed);
+    trapBytes.store(0, std::memory_order_relaxed);
+    trapLastSize.store(0, std::memory_order_relaxed);
+    trapLastCaller.store(nullptr, std::memory_order_relaxed);
+}
+#else
+bool RtAllocTrapCompiled() noexcept
+{
+    return false;
+}
+
+void SetRtAllocTrapAction(RtAllocTrapAction) noexcept
+{
+}
+
+void GetRtAllocTrapStats(RtAllocTrapStats &stats) noexcept
+{
+    stats = RtAllocTrapStats{};
+}
+
+void ResetRtAllocTrapStats() noexcept
+{
+}
+#endif
+
+} // namespace Utils
+} // namespace dt
+
+#if defined(DT_RT_ALLOC_TRAP)
+// Replacement of the global allocation functions. libstdc++ routes the new[], delete[] and
+// nothrow variants through these, so every C++ heap allocation passes the RT thread check.
+static void *TrapNew(std::size_t size, std::size_t align, void *caller)
+{
+    if (dt::Utils::tlsRtThread)
+    {
+        dt::Utils::TrapRtAlloc(size, caller, false);
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+    for (;;)
+    {
+        void *p = nullptr;
+        if (align <= alignof(std::max_align_t) ? (p = malloc(size)) != nullptr
+                                               : posix_memalign(&p, align, size) == 0)
+        {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+static void TrapDelete(void *p, void *caller) noexcept
+{
+    if (p && dt::Utils::tlsRtThread)
+    {
+        dt::Utils::TrapRtAlloc(0, caller, true);
+    }
+    free(p);
+}
+
+void *operator new(std::size_t size)
+{
+    return TrapNew(size, 0, __builtin_return_address(0));
+}
+
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    return TrapNew(size, std::max((std::size_t)align, sizeof(void *)), __builtin_return_address(0));
+}
+
+void operator delete(void *p) noexcept
+{
+    TrapDelete(p, __builtin_return_address(0));
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    TrapDelete(p, __builtin_return_address(0));
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+    TrapDelete(p, __builtin_return_address(0));
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    TrapDelete(p, __builtin_return_address(0));
+}
+#endif
@@ -0,0 +1,406 @@
+//* Related Headers ----------------------------------------------------------*/
+#include "dtCore/src/dtUtils/dtWatchdogBank.h"
+
+//* C/C++ System Headers -----------------------------------------------------*/
+#include <new>
+
+//* Other Lib Headers --------------------------------------------------------*/
+//* Project Headers ----------------------------------------------------------*/
+#include <dtCore/dtLog>
+
+//* System-Specific Headers --------------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace dt
+{
+namespace Utils
+{
+//* Private Types ------------------------------------------------------------*/
+// bit i of the result: d[i] < now, for the 64 deadlines of one word (64-byte aligned)
+using ScanFunc = uint64_t (*)(const int64_t *d, int64_t now);
+
+//* Private Variables --------------------------------------------------------*/
+static constexpr int64_t WATCHDOG_DISABLED = INT64_MAX / 4; // timeout of a disabled channel: never reached
+static constexpr int64_t WATCHDOG_NEVER = INT64_MAX;        // deadline of padding / disabled channels
+
+// the monitor reads the deadlines as plain 64-bit lanes: each aligned lane is one single-copy
+// atomic load on x86_64 / aarch64, which is all a relaxed load of std::atomic<int64_t> is
+static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t) && std::atomic<int64_t>::is_always_lock_free,
+              "deadline lanes must be plain 64-bit words");
+
+//* Private Functions Definition ---------------------------------------------*/
+static uint64_t ScanScalar(const int64_t *d, int64_t now)
+{
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        mask |= (uint64_t)(d[i] < now) << i;
+    }
+    return mask;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) static uint64_t ScanAvx2(const int64_t *d, int64_t now)
+{
+    const __m256i n = _mm256_set1_epi64x(now);
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i += 4)
+    {
+        const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(d + i));
+        const __m256i gt = _mm256_cmpgt_epi64(n, v);
+        mask |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(gt)) << i;
+    }
+    return mask;
+}
+
+__attribute__((target("sse4.2"))) static uint64_t ScanSse42(const int64_t *d, int64_t now)
+{
+    const __m128i n = _mm_set1_epi64x(now);
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i += 2)
+    {
+        const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i *>(d + i));
+        const __m128i gt = _mm_cmpgt_epi64(n, v);
+        mask |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(gt)) << i;
+    }
+    return mask;
+}
+#elif defined(__aarch64__)
+static uint64_t ScanNeon(const int64_t *d, int64_t now)
+{
+    const int64x2_t n = vdupq_n_s64(now);
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i += 2)
+    {
+        const uint64x2_t gt = vcgtq_s64(n, vld1q_s64(d + i));
+        mask |= (vgetq_lane_u64(gt, 0) & 1) << i;
+        mask |= (vgetq_lane_u64(gt, 1) & 1) << (i + 1);
+    }
+    return mask;
+}
+#endif
+
+static ScanFunc SelectScan(const char **name)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        *name = "avx2";
+        return ScanAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        *name = "sse4.2";
+        return ScanSse42;
+    }
+#elif defined(__aarch64__)
+    *name = "neon";
+    return ScanNeon;
+#endif
+    *name = "scalar";
+    return ScanScalar;
+}
+
+static const char *scanName = "scalar";
+static const ScanFunc scanFunc = SelectScan(&scanName);
+
+static inline size_t AlignUp(size_t v)
+{
+    return (v + 63) & ~(size_t)63;
+}
+
+//* Public(Exported) Functions Definition ------------------------------------*/
+bool WatchdogBank::Allocate(int capacity, const RtMemOptions &opt) noexcept
+{
+    Release();
+    if (capacity <= 0)
+    {
+        return false;
+    }
+    const int words = (capacity + 63) / 64;
+    const size_t lanes = (size_t)words * 64;
+    const size_t offTimeout = AlignUp(lanes * sizeof(int64_t));
+    const size_t offSetTimeout = offTimeout + AlignUp(lanes * sizeof(int64_t));
+    const size_t offExpired = offSetTimeout + AlignUp(lanes * sizeof(int64_t));
+    const size_t offExpiries = offExpired + AlignUp((size_t)words * sizeof(uint64_t));
+    const size_t bytes = offExpiries + AlignUp(lanes * sizeof(uint32_t));
+    if (!AllocRtMem(bytes, opt, m_mem))
+    {
+        LOG(err).printf("!Error! WatchdogBank::Allocate() : cannot map %zu bytes", bytes);
+        return false;
+    }
+    char *base = static_cast<char *>(m_mem.ptr); // page aligned
+    m_deadline = reinterpret_cast<std::atomic<int64_t> *>(base);
+    m_timeout = reinterpret_cast<std::atomic<int64_t> *>(base + offTimeout);
+    m_setTimeout = reinterpret_cast<int64_t *>(base + offSetTimeout);
+    m_expired = reinterpret_cast<std::atomic<uint64_t> *>(base + offExpired);
+    m_expiries = reinterpret_cast<uint32_t *>(base + offExpiries);
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        new (&m_deadline[i]) std::atomic<int64_t>(WATCHDOG_NEVER);
+        new (&m_timeout[i]) std::atomic<int64_t>(WATCHDOG_DISABLED);
+        m_setTimeout[i] = 0;
+        m_expiries[i] = 0;
+    }
+    for (int w = 0; w < words; ++w)
+    {
+        new (&m_expired[w]) std::atomic<uint64_t>(0);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_names.clear();
+        m_names.reserve(capacity);
+    }
+    m_words = words;
+    m_capacity = capacity;
+    m_count.store(0, std::memory_order_release);
+    m_expiredNow.store(0, std::memory_order_relaxed);
+    m_totalExpiries.store(0, std::memory_order_relaxed);
+    m_recoveries.store(0, std::memory_order_relaxed);
+    m_checks.store(0, std::memory_order_relaxed);
+    m_lastScan_ns.store(0, std::memory_order_relaxed);
+    m_maxScan_ns.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void WatchdogBank::Release() noexcept
+{
+    m_capacity = 0;
+    m_words = 0;
+    m_count.store(0, std::memory_order_release);
+    FreeRtMem(m_mem);
+    m_deadline = nullptr;
+    m_timeout = nullptr;
+    m_setTimeout = nullptr;
+    m_expired = nullptr;
+    m_expiries = nullptr;
+}
+
+void WatchdogBank::SetCallback(WatchdogCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_callback = std::move(callback);
+}
+
+int WatchdogBank::AddChannel(const std::string &name, int64_t timeout_ns, int64_t grace_ns)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    const int ch = m_count.load(std::memory_order_relaxed);
+    if (ch >= m_capacity || timeout_ns <= 0 || timeout_ns >= WATCHDOG_DISABLED)
+    {
+        LOG(err).printf("!Error! WatchdogBank::AddChannel() : cannot add '%s' (%d / %d channels, timeout %lld ns)",
+                        name.c_str(), ch, m_capacity, (long long)timeout_ns);
+        return -1;
+    }
+    m_names.push_back(name);
+    m_setTimeout[ch] = timeout_ns;
+    m_expiries[ch] = 0;
+    m_timeout[ch].store(timeout_ns, std::memory_order_relaxed);
+    m_deadline[ch].store(MonotonicNs() + (grace_ns > 0 ? grace_ns : timeout_ns), std::memory_order_relaxed);
+    m_count.store(ch + 1, std::memory_order_release); // Check() sees the channel set up
+    return ch;
+}
+
+int WatchdogBank::FindChannel(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    for (size_t i = 0; i < m_names.size(); ++i)
+    {
+        if (m_names[i] == name)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void WatchdogBank::SetEnabled(int ch, bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (ch < 0 || ch >= m_count.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    if (enable)
+    {
+        m_timeout[ch].store(m_setTimeout[ch], std::memory_order_relaxed);
+        m_deadline[ch].store(MonotonicNs() + m_setTimeout[ch], std::memory_order_relaxed);
+    }
+    else
+    {
+        // a Feed() racing this may re-arm the channel once, for WATCHDOG_DISABLED
+        m_timeout[ch].store(WATCHDOG_DISABLED, std::memory_order_relaxed);
+        m_deadline[ch].store(WATCHDOG_NEVER, std::memory_order_relaxed);
+    }
+}
+
+void WatchdogBank::SetTimeout(int ch, int64_t timeout_ns)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (ch < 0 || ch >= m_count.load(std::memory_order_relaxed) || timeout_ns <= 0 || timeout_ns >= WATCHDOG_DISABLED)
+    {
+        return;
+    }
+    m_setTimeout[ch] = timeout_ns;
+    if (m_timeout[ch].load(std::memory_order_relaxed) != WATCHDOG_DISABLED)
+    {
+        m_timeout[ch].store(timeout_ns, std::memory_order_relaxed); // from the next heartbeat
+    }
+}
+
+int WatchdogBank::Check(int64_t now_ns)
+{
+    if (!m_capacity)
+    {
+        return 0;
+    }
+    const int64_t t0 = MonotonicNs();
+    const int64_t now = now_ns ? now_ns : t0;
+    const int words = (m_count.load(std::memory_order_acquire) + 63) / 64;
+    const int64_t *deadlines = reinterpret_cast<const int64_t *>(m_deadline);
+
+    int expired = 0;
+    int delta = 0;
+    for (int w = 0; w < words; ++w)
+    {
+        const uint64_t mask = scanFunc(deadlines + (size_t)w * 64, now);
+        const uint64_t prev = m_expired[w].load(std::memory_order_relaxed);
+        uint64_t changed = mask ^ prev;
+        if (!changed)
+        {
+            continue;
+        }
+        m_expired[w].store(mask, std::memory_order_relaxed);
+        while (changed)
+        {
+            const int bit = __builtin_ctzll(changed);
+            changed &= changed - 1;
+            const bool isExpired = (mask >> bit) & 1;
+            const int ch = w * 64 + bit;
+            if (isExpired)
+            {
+                m_expiries[ch]++;
+                expired++;
+            }
+            delta += isExpired ? 1 : -1;
+            Raise(ch, isExpired, now);
+        }
+    }
+
+    m_expiredNow.fetch_add(delta, std::memory_order_relaxed);
+    m_totalExpiries.fetch_add(expired, std::memory_order_relaxed);
+    m_recoveries.fetch_add(expired - delta, std::memory_order_relaxed);
+    m_checks.fetch_add(1, std::memory_order_relaxed);
+    const int64_t cost = MonotonicNs() - t0;
+    m_lastScan_ns.store(cost, std::memory_order_relaxed);
+    if (cost > m_maxScan_ns.load(std::memory_order_relaxed))
+    {
+        m_maxScan_ns.store(cost, std::memory_order_relaxed);
+    }
+    return expired;
+}
+
+void WatchdogBank::Raise(int ch, bool expired, int64_t now)
+{
+    const int64_t timeout = m_timeout[ch].load(std::memory_order_relaxed);
+    if (timeout == WATCHDOG_DISABLED)
+    {
+        return; // recovered by SetEnabled(false): no event
+    }
+    WatchdogEvent ev;
+    ev.channel = ch;
+    ev.name = m_names[ch].c_str();
+    ev.expired = expired;
+    ev.age_ns = now - (m_deadline[ch].load(std::memory_order_relaxed) - timeout);
+    ev.now_ns = now;
+    ev.expiries = m_expiries[ch];
+
+    if (m_logEvents.load(std::memory_order_relaxed))
+    {
+        if (expired)
+        {
+            LOG(warn).printf("WatchdogBank : '%s' expired, no heartbeat for %.3f ms (#%u)", ev.name,
+                             (double)ev.age_ns * 1e-6, ev.expiries);
+        }
+        else
+        {
+            LOG(info).printf("WatchdogBank : '%s' recovered", ev.name);
+        }
+    }
+    if (m_callback)
+    {
+        m_callback(ev);
+    }
+}
+
+bool WatchdogBank::IsExpired(int ch) const noexcept
+{
+    if (ch < 0 || ch >= m_count.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    return (m_expired[ch / 64].load(std::memory_order_relaxed) >> (ch % 64)) & 1;
+}
+
+int64_t WatchdogBank::Age_ns(int ch, int64_t now_ns) const noexcept
+{
+    if (ch < 0 || ch >= m_count.load(std::memory_order_acquire))
+    {
+        return -1;
+    }
+    const int64_t timeout = m_timeout[ch].load(std::memory_order_relaxed);
+    if (timeout == WATCHDOG_DISABLED)
+    {
+        return -1;
+    }
+    return (now_ns ? now_ns : MonotonicNs()) - (m_deadline[ch].load(std::memory_order_relaxed) - timeout);
+}
+
+const char *WatchdogBank::ChannelName(int ch) const noexcept
+{
+    if (ch < 0 || ch >= m_count.load(std::memory_order_acquire))
+    {
+        return "";
+    }
+    return m_names[ch].c_str();
+}
+
+void WatchdogBank::GetExpired(std::vector<int> &channels) const
+{
+    channels.clear();
+    const int words = (m_count.load(std::memory_order_acquire) + 63) / 64;
+    for (int w = 0; w < words; ++w)
+    {
+        uint64_t bits = m_expired[w].load(std::memory_order_relaxed);
+        while (bits)
+        {
+            channels.push_back(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+void WatchdogBank::GetStats(WatchdogBankStats &stats) const
+{
+    stats.channels = m_count.load(std::memory_order_acquire);
+    stats.expired = m_expiredNow.load(std::memory_order_relaxed);
+    stats.expiries = m_totalExpiries.load(std::memory_order_relaxed);
+    stats.recoveries = m_recoveries.load(std::memory_order_relaxed);
+    stats.checks = m_checks.load(std::memory_order_relaxed);
+    stats.lastScan_ns = m_lastScan_ns.load(std::memory_order_relaxed);
+    stats.maxScan_ns = m_maxScan_ns.load(std::memory_order_relaxed);
+}
+
+const char *WatchdogBank::ScanKernel() noexcept
+{
+    return scanName;
+}
+
+} // namespace Utils
+} // namespace dt